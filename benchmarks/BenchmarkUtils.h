@@ -0,0 +1,115 @@
+/*
+ * BenchmarkUtils.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef BENCHMARK_UTILS_H_
+#define BENCHMARK_UTILS_H_
+
+#include <stdint.h>
+
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+typedef chrono::steady_clock Clock;
+
+static inline double elapsedMs( Clock::time_point _start )
+{
+	return chrono::duration< double, milli >( Clock::now() - _start ).count();
+}
+
+// focal length in pixel for the horizontal fov of the sensor model
+static inline float sceneFocal( int _width )
+{
+	return _width / 2 / tan( 0.280273934 / 2 );
+}
+
+// ************************************************************************************************ //
+// bin floor at 800 mm with boxes on it, shadows & sparse dropouts are NaN, x & y lie on pixel rays //
+// ************************************************************************************************ //
+// _points needs x, y & z in millimeter, sensor noise of sigma _noise is on z only like DepthPostProcessKernel.
+// _labels gets 0 for the floor & 1 ~ 12 for the boxes, if not NULL.
+template< class PointT >
+static void makeScene(	int				_width,
+						int				_height,
+						float			_fx,
+						float			_fy,
+						float			_cx,
+						float			_cy,
+						float			_noise,
+						unsigned int	_seed,
+						PointT			*_points,
+						uint32_t		*_labels = NULL )
+{
+	mt19937 rng( _seed );
+	normal_distribution< float > noise( 0.f, _noise );
+	uniform_real_distribution< float > uniform( 0.f, 1.f );
+
+	struct Box
+	{
+		int x0, y0, x1, y1;
+		float top;
+		float tilt;
+	};
+	vector< Box > boxes;
+	for( int b = 0; b < 12; b++ )
+	{
+		Box box;
+		box.x0 = uniform( rng ) * _width * 0.8f;
+		box.y0 = uniform( rng ) * _height * 0.8f;
+		box.x1 = box.x0 + _width * ( 0.05f + uniform( rng ) * 0.15f );
+		box.y1 = box.y0 + _height * ( 0.05f + uniform( rng ) * 0.15f );
+		box.top = 700.f + uniform( rng ) * 80.f;
+		box.tilt = ( uniform( rng ) - 0.5f ) * 0.2f;
+		boxes.push_back( box );
+	}
+
+	for( int j = 0; j < _height; j++ )
+	{
+		for( int i = 0; i < _width; i++ )
+		{
+			PointT &p = _points[ i + j * _width ];
+			float depth = 800.f + 0.02f * j;
+			uint32_t label = 0;
+			bool shadow = false;
+			for( unsigned int b = 0; b < boxes.size(); b++ )
+			{
+				const Box &box = boxes[b];
+				if( i >= box.x0 && i < box.x1 && j >= box.y0 && j < box.y1 )
+				{
+					// boxes are scaled with the resolution, so is their tilt per pixel
+					depth = box.top + box.tilt * ( i - box.x0 ) * 640 / _width;
+					label = b + 1;
+					shadow = false;
+				}
+				// occlusion shadow on the right of every box
+				else if( i >= box.x1 && i < box.x1 + 12 && j >= box.y0 && j < box.y1 )
+				{
+					shadow = true;
+				}
+			}
+
+			if( _labels )
+			{
+				_labels[ i + j * _width ] = label;
+			}
+			if( shadow || uniform( rng ) < 0.01f )
+			{
+				p.x = p.y = p.z = NAN;
+				continue;
+			}
+
+			// rays from the ideal depth
+			p.x = ( i - _cx ) / _fx * depth;
+			p.y = -( j - _cy ) / _fy * depth;
+			p.z = -depth + noise( rng );
+		}
+	}
+}
+
+#endif /* BENCHMARK_UTILS_H_ */
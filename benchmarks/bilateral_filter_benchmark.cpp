@@ -0,0 +1,111 @@
+/*
+ * bilateral_filter_benchmark.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+// DepthBilateralFilter vs pcl::FastBilateralFilterOMP ( sigma_s 2.5, sigma_r 5 as the depth sensor ) on a synthetic
+// bin picking scene at 640 x 480, 1280 x 960 & 1920 x 1440 : time per frame of both, and the difference of z on
+// every valid point. Invalid points are NaN in both inputs, pcl writes a z for them, DepthBilateralFilter keeps NaN.
+// usage : bilateral_filter_benchmark [ frames ] [ threads ] [ tolerance in mm ]
+// exit code is 1 if any valid point differs more than the tolerance
+
+#include <omp.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+#include <pcl/filters/fast_bilateral_omp.h>
+
+#include "BenchmarkUtils.h"
+#include "DepthBilateralFilter.h"
+
+using namespace std;
+
+// ****************************************************** //
+// run both filters on the same frames of one resolution  //
+// return false if a valid point is out of _tolerance     //
+// ****************************************************** //
+static bool compare( int _width, int _height, int _frames, WorkerPool &_pool, float _tolerance )
+{
+	DepthBilateralFilter filter( _width, _height, 2.5f, 5.f, &_pool );
+	pcl::FastBilateralFilterOMP< pcl::PointXYZ > pcl_filter;
+	pcl_filter.setSigmaS( 2.5 );
+	pcl_filter.setSigmaR( 5 );
+	pcl_filter.setNumberOfThreads( _pool.getNumThreads() );
+
+	pcl::PointCloud< pcl::PointXYZ >::Ptr input( new pcl::PointCloud< pcl::PointXYZ > );
+	pcl::PointCloud< pcl::PointXYZ > pcl_output;
+	pcl::PointCloud< pcl::PointXYZ > output;
+
+	float focal = sceneFocal( _width );
+	input->width = _width;
+	input->height = _height;
+	input->is_dense = false;
+	input->points.resize( _width * _height );
+
+	double filter_ms = 0, pcl_ms = 0;
+	double max_diff = 0, sum_diff = 0;
+	long valid = 0, out_of_tolerance = 0, mismatch_nan = 0;
+
+	for( int frame = 0; frame < _frames; frame++ )
+	{
+		makeScene( _width, _height, focal, focal, _width / 2 - 0.5f, _height / 2 - 0.5f, 1.f, frame, &input->points[0] );
+
+		Clock::time_point start = Clock::now();
+		pcl_filter.setInputCloud( input );
+		pcl_filter.filter( pcl_output );
+		pcl_ms += elapsedMs( start );
+
+		output = *input;
+		start = Clock::now();
+		filter.filter( &output.points[0].z, sizeof( pcl::PointXYZ ) / sizeof( float ) );
+		filter_ms += elapsedMs( start );
+
+		for( unsigned int i = 0; i < output.points.size(); i++ )
+		{
+			if( std::isnan( input->points[i].z ) )
+			{
+				mismatch_nan += !std::isnan( output.points[i].z );
+				continue;
+			}
+			double diff = fabs( output.points[i].z - pcl_output.points[i].z );
+			if( !( diff <= _tolerance ) )
+			{
+				out_of_tolerance++;
+			}
+			max_diff = max( max_diff, diff );
+			sum_diff += diff;
+			valid++;
+		}
+	}
+
+	printf( "%4d x %4d  pcl %8.2f ms  simd %8.2f ms  x %5.2f  grid %6.2f M cells  diff mean %.5f max %.5f mm  out of tolerance %ld  NaN %ld\n",
+			_width, _height, pcl_ms / _frames, filter_ms / _frames, pcl_ms / filter_ms, filter.getGridCells() / 1e6,
+			valid > 0 ? sum_diff / valid : 0, max_diff, out_of_tolerance, mismatch_nan );
+
+	return out_of_tolerance == 0 && mismatch_nan == 0;
+}
+
+int main( int argc, char **argv )
+{
+	int frames = argc > 1 ? atoi( argv[1] ) : 10;
+	int threads = argc > 2 ? atoi( argv[2] ) : thread::hardware_concurrency();
+	float tolerance = argc > 3 ? atof( argv[3] ) : 0.01f;
+
+	WorkerPool pool( max( 1, threads ) - 1 );
+	omp_set_num_threads( pool.getNumThreads() );
+	printf( "%d frames, %u threads, tolerance %g mm\n", frames, pool.getNumThreads(), tolerance );
+
+	const int resolutions[3][2] = { { 640, 480 }, { 1280, 960 }, { 1920, 1440 } };
+	bool success = true;
+	for( int r = 0; r < 3; r++ )
+	{
+		success &= compare( resolutions[r][0], resolutions[r][1], frames, pool, tolerance );
+	}
+
+	return success ? 0 : 1;
+}
@@ -0,0 +1,128 @@
+/*
+ * depth_codec_benchmark.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+// Round trip of DepthStreamCodec on a synthetic bin picking scene seen by the depth sensor :
+// compressed size vs float x, y, z ( 12 bytes / point ) & PackedPointCloud ( 16 bytes / point ),
+// encode / decode / reconstruct throughput, and the error of every reconstructed point.
+// usage : depth_codec_benchmark [ width ] [ height ] [ frames ] [ min depth step in mm ]
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "BenchmarkUtils.h"
+#include "DepthStreamCodec.h"
+
+using namespace std;
+
+// layout of a PackedPointCloud point, the scene labels are encoded from their own buffer
+struct Point
+{
+	float x;
+	float y;
+	float z;
+	uint32_t label;
+};
+
+int main( int argc, char **argv )
+{
+	int width = argc > 1 ? atoi( argv[1] ) : 1280;
+	int height = argc > 2 ? atoi( argv[2] ) : 960;
+	int frames = argc > 3 ? atoi( argv[3] ) : 20;
+	float min_depth_step = argc > 4 ? atof( argv[4] ) : 0.1f;
+
+	// horizontal fov of the sensor model
+	DepthStreamCodec::Intrinsics intr;
+	intr.fx = sceneFocal( width );
+	intr.fy = intr.fx;
+	intr.cx = width / 2 - 0.5f;
+	intr.cy = height / 2 - 0.5f;
+
+	DepthStreamCodec encoder( width, height, intr, min_depth_step );
+	DepthStreamCodec decoder( width, height, intr, min_depth_step );
+
+	vector< Point > cloud( width * height );
+	vector< uint32_t > scene_labels( width * height );
+	vector< Point > decoded( width * height );
+	vector< unsigned char > labels( width * height );
+	// class << 24 | instance segment ids, instances beyond 16 bits
+	vector< uint32_t > ids( width * height );
+	string stream;
+	string id_stream;
+
+	double encode_ms = 0, decode_ms = 0, reconstruct_ms = 0;
+	size_t stream_bytes = 0;
+	double max_z_error = 0, max_xy_error = 0;
+	long mismatch_nan = 0, mismatch_label = 0, mismatch_id = 0;
+	bool all_decoded = true;
+
+	for( int f = 0; f < frames; f++ )
+	{
+		makeScene( width, height, intr.fx, intr.fy, intr.cx, intr.cy, 0.3f, f, &cloud[0], &scene_labels[0] );
+		for( int i = 0; i < width * height; i++ )
+		{
+			uint32_t label = scene_labels[i];
+			labels[i] = label;
+			ids[i] = label ? ( (uint32_t)( label % 7 + 1 ) << 24 ) | ( 65536 + label * 257 ) : 0;
+		}
+
+		Clock::time_point start = Clock::now();
+		encoder.encode( &cloud[0], sizeof( Point ), &labels[0], 1, stream );
+		encode_ms += elapsedMs( start );
+		stream_bytes += stream.size();
+
+		start = Clock::now();
+		all_decoded &= decoder.decode( stream );
+		decode_ms += elapsedMs( start );
+
+		start = Clock::now();
+		decoder.reconstruct( &decoded[0], sizeof( Point ) );
+		reconstruct_ms += elapsedMs( start );
+
+		for( int i = 0; i < width * height; i++ )
+		{
+			const Point &a = cloud[i];
+			const Point &b = decoded[i];
+			if( std::isnan( a.z ) != std::isnan( b.z ) )
+			{
+				mismatch_nan++;
+				continue;
+			}
+			if( decoder.getLabel()[i] != labels[i] )
+			{
+				mismatch_label++;
+			}
+			if( !std::isnan( a.z ) )
+			{
+				max_z_error = max( max_z_error, (double)fabs( a.z - b.z ) );
+				max_xy_error = max( max_xy_error, (double)max( fabs( a.x - b.x ), fabs( a.y - b.y ) ) );
+			}
+		}
+
+		encoder.encode( &cloud[0], sizeof( Point ), (const unsigned char*)&ids[0], 4, id_stream, 4 );
+		all_decoded &= decoder.decode( id_stream );
+		for( int i = 0; i < width * height; i++ )
+		{
+			if( decoder.getLabel()[i] != ids[i] )
+			{
+				mismatch_id++;
+			}
+		}
+	}
+
+	double raw_mb = (double)width * height * 12 / 1024 / 1024;
+	double mean_bytes = (double)stream_bytes / frames;
+	printf( "%d x %d, %d frames, depth step >= %g mm\n", width, height, frames, min_depth_step );
+	printf( "stream      %10.1f KB / frame   %6.3f bytes / point\n", mean_bytes / 1024, mean_bytes / width / height );
+	printf( "ratio       %10.1f x vs xyz float   %6.1f x vs packed xyzl\n",
+			(double)width * height * 12 / mean_bytes, (double)width * height * 16 / mean_bytes );
+	printf( "encode      %10.3f ms   %8.1f MB/s of xyz\n", encode_ms / frames, raw_mb / ( encode_ms / frames / 1000 ) );
+	printf( "decode      %10.3f ms   %8.1f MB/s of xyz\n", decode_ms / frames, raw_mb / ( decode_ms / frames / 1000 ) );
+	printf( "reconstruct %10.3f ms\n", reconstruct_ms / frames );
+	printf( "max error   z %.4f mm ( step / 2 = %.4f ), x & y %.4f mm\n", max_z_error, decoder.getHeader().depth_step / 2, max_xy_error );
+	printf( "mismatch    NaN %ld, label %ld, 32 bit id %ld, %s\n", mismatch_nan, mismatch_label, mismatch_id, all_decoded ? "every frame decoded" : "DECODE FAILED" );
+
+	return all_decoded && mismatch_nan == 0 && mismatch_label == 0 && mismatch_id == 0 ? 0 : 1;
+}
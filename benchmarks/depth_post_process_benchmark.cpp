@@ -0,0 +1,296 @@
+/*
+ * depth_post_process_benchmark.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+// DepthPostProcessKernel vs the step by step post processing of DepthSensorPlugin::_postProcessReference()
+// on random depth, rayconf & specular buffers of every RenderTargetLayout, single thread & on a WorkerPool :
+//   invalidMask() & maskFlags() vs depth out of range, intensity saturation & confidence checked one after the other,
+//   extractCloud() vs point cloud extraction followed by sensor noise, compared bit by bit.
+// The occlusion edge step between them is checked by occlusion_edge_benchmark, here both sides use the same mask.
+// isBelowCos() is compared with _value < cos( _degree * M_PI / 180.f ) on random values, on values next to the threshold
+// ( the exact fallback of the lookup table ) & on degrees outside of the table.
+// usage : depth_post_process_benchmark [ frames ] [ width ] [ height ]
+// exit code is 1 on any mismatch
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+#include "BenchmarkUtils.h"
+#include "DepthPostProcessKernel.h"
+
+using namespace std;
+
+// one frame of render target buffers & noise
+struct Frame
+{
+	vector< float > depth;
+	vector< float > rayconf;
+	vector< unsigned char > rgb;
+	vector< float > noise_40;
+	vector< float > conf_noise;
+	vector< float > sensor_noise;
+};
+
+// ************************************************************************************* //
+// random buffers, with depth around 1 ( out of range ), unreachable pixels & background //
+// ************************************************************************************* //
+static void makeFrame( int _width, int _height, const RenderTargetLayout &_layout, unsigned int _seed, Frame &_frame )
+{
+	mt19937 rng( _seed );
+	uniform_real_distribution< float > uniform( 0.f, 1.f );
+	normal_distribution< float > gaussian( 0.f, 1.f );
+	int size = _width * _height;
+
+	_frame.depth.assign( size * _layout.depthChannels(), 0.f );
+	_frame.rayconf.assign( size * 4, 0.f );
+	_frame.rgb.resize( size * 3 );
+	_frame.noise_40.resize( size );
+	_frame.conf_noise.resize( size );
+	_frame.sensor_noise.resize( size );
+
+	uint16_t *half = (uint16_t*)&_frame.rayconf[0];
+	for( int idx = 0; idx < size; idx++ )
+	{
+		float depth = uniform( rng );
+		float pick = uniform( rng );
+		if( pick < 0.05f )
+		{
+			depth = 1.f;
+		}
+		else if( pick < 0.1f )
+		{
+			// a few ulp below 1, depth * 255 may round to 255
+			depth = 1.f - ( rng() % 8 ) * numeric_limits< float >::epsilon() / 2;
+		}
+		else if( pick < 0.15f )
+		{
+			depth = 1.f + uniform( rng );
+		}
+		_frame.depth[ idx * _layout.depthChannels() ] = depth;
+
+		bool unreachable = uniform( rng ) < 0.05f;
+		float confidence = unreachable ? -1.f : uniform( rng );
+		switch( _layout.getRayConfFormat() )
+		{
+		case RAYCONF_FORMAT_C32F:
+			_frame.rayconf[ idx ] = confidence;
+			break;
+		case RAYCONF_FORMAT_C16F:
+			// -1 or a half in [ 0, 1 ]
+			half[ idx ] = unreachable ? 0xbc00 : rng() % 0x3c01;
+			break;
+		default:
+			_frame.rayconf[ 4 * idx + 0 ] = gaussian( rng ) * 0.1f;
+			_frame.rayconf[ 4 * idx + 1 ] = gaussian( rng ) * 0.1f;
+			// background is white
+			_frame.rayconf[ 4 * idx + 2 ] = uniform( rng ) < 0.05f ? 1.f : -0.3f - uniform( rng );
+			_frame.rayconf[ 4 * idx + 3 ] = confidence;
+			break;
+		}
+
+		for( int c = 0; c < 3; c++ )
+		{
+			_frame.rgb[ 3 * idx + c ] = rng() % 256;
+		}
+		_frame.noise_40[ idx ] = uniform( rng ) * 2 - 1;
+		_frame.conf_noise[ idx ] = ( uniform( rng ) * 2 - 1 ) * 10;
+		_frame.sensor_noise[ idx ] = gaussian( rng );
+	}
+}
+
+// ********************************************************************* //
+// reference : every step over the whole image, as the step by step path //
+// ********************************************************************* //
+static void referenceInvalid( int _size, const RenderTargetLayout &_layout, const Frame &_frame, vector< unsigned char > &_invalid )
+{
+	_invalid.assign( _size, 0 );
+
+	// depth out of range
+	for( int idx = 0; idx < _size; idx++ )
+	{
+		if( DepthMask::outOfRange( _layout.depth( &_frame.depth[0], idx ) ) )
+		{
+			_invalid[ idx ] = 1;
+		}
+	}
+
+	// intensity saturation
+	for( int idx = 0; idx < _size; idx++ )
+	{
+		float thres = 180 + _frame.noise_40[ idx ] * 10;
+		thres = thres > 0 ? thres : 1;
+		if( _frame.rgb[ 3 * idx ] > thres )
+		{
+			_invalid[ idx ] = 1;
+		}
+	}
+}
+
+static void referenceCloud(	int								_size,
+							const RenderTargetLayout		&_layout,
+							const Frame						&_frame,
+							const vector< unsigned char >	&_invalid,
+							vector< pcl::PointXYZ >			&_points )
+{
+	const float nan = numeric_limits< float >::quiet_NaN();
+	const float *depth = &_frame.depth[0];
+	const float *rayconf = &_frame.rayconf[0];
+	vector< unsigned char > invalid( _invalid );
+
+	// confidence threshold
+	for( int idx = 0; idx < _size; idx++ )
+	{
+		float conf_thres = 75.f + _frame.conf_noise[ idx ];
+		if( _layout.confidence( rayconf, idx ) < cos( conf_thres * M_PI / 180.f ) )
+		{
+			invalid[ idx ] = 1;
+		}
+	}
+
+	// point cloud in millimeter
+	_points.resize( _size );
+	for( int idx = 0; idx < _size; idx++ )
+	{
+		if( _layout.hasPoint( depth, rayconf, idx ) && !invalid[ idx ] )
+		{
+			float xyz[3];
+			_layout.point( depth, rayconf, idx, xyz );
+			_points[ idx ].x = xyz[0] * 1000;
+			_points[ idx ].y = xyz[1] * 1000;
+			_points[ idx ].z = xyz[2] * 1000;
+		}
+		else
+		{
+			_points[ idx ].x = nan;
+			_points[ idx ].y = nan;
+			_points[ idx ].z = nan;
+		}
+	}
+
+	// sensor noise
+	for( int idx = 0; idx < _size; idx++ )
+	{
+		if( pcl::isFinite( _points[ idx ] ) )
+		{
+			_points[ idx ].z += _frame.sensor_noise[ idx ] * 3;
+		}
+	}
+}
+
+// same bits, NaN included
+static bool samePoint( const pcl::PointXYZ &_a, const pcl::PointXYZ &_b )
+{
+	return memcmp( &_a.x, &_b.x, sizeof( float ) ) == 0 &&
+		   memcmp( &_a.y, &_b.y, sizeof( float ) ) == 0 &&
+		   memcmp( &_a.z, &_b.z, sizeof( float ) ) == 0;
+}
+
+// **************************************** //
+// lookup table & its exact fallback vs cos //
+// **************************************** //
+static long checkCos( const DepthPostProcessKernel &_kernel, int _samples )
+{
+	mt19937 rng( 1 );
+	uniform_real_distribution< float > uniform( 0.f, 1.f );
+	long mismatch = 0;
+
+	for( int s = 0; s < _samples; s++ )
+	{
+		// mostly inside the table [ 0, 180 ), some outside of it
+		float degree = uniform( rng ) < 0.9f ? uniform( rng ) * 180 : uniform( rng ) * 400 - 110;
+		float threshold = cos( degree * M_PI / 180.f );
+
+		float values[] =
+		{
+			uniform( rng ) * 2 - 1,
+			threshold,
+			nextafterf( threshold, 2.f ),
+			nextafterf( threshold, -2.f ),
+			threshold + ( uniform( rng ) * 2 - 1 ) * 1e-6f,
+			-1.f
+		};
+		for( float value : values )
+		{
+			mismatch += _kernel.isBelowCos( value, degree ) != ( value < cos( degree * M_PI / 180.f ) );
+		}
+	}
+	return mismatch;
+}
+
+int main( int argc, char **argv )
+{
+	int frames = argc > 1 ? atoi( argv[1] ) : 4;
+	int width = argc > 2 ? atoi( argv[2] ) : 640;
+	int height = argc > 3 ? atoi( argv[3] ) : 480;
+	if( frames < 1 || width < 1 || height < 1 )
+	{
+		fprintf( stderr, "usage : depth_post_process_benchmark [ frames ] [ width ] [ height ]\n" );
+		return 1;
+	}
+	int size = width * height;
+
+	const DepthFormat depth_formats[] = { DEPTH_FORMAT_RGBA32F, DEPTH_FORMAT_R32F };
+	const RayConfFormat rayconf_formats[] = { RAYCONF_FORMAT_XYZC32F, RAYCONF_FORMAT_C32F, RAYCONF_FORMAT_C16F };
+
+	WorkerPool pool( 3 );
+	long mismatch_invalid = 0, mismatch_flags = 0, mismatch_cloud = 0, mismatch_cos = 0;
+	double reference_ms = 0, fused_ms = 0;
+
+	Frame frame;
+	vector< unsigned char > ref_invalid, invalid( size ), flags( size );
+	vector< pcl::PointXYZ > ref_points, points( size );
+
+	for( DepthFormat depth_format : depth_formats )
+	{
+		for( RayConfFormat rayconf_format : rayconf_formats )
+		{
+			RenderTargetLayout layout( depth_format, rayconf_format );
+			layout.setCamera( width, height, 2000, 2000, width / 2 - 0.5f, height / 2 - 0.5f, 0.3f, 1.5f );
+
+			for( int threads = 0; threads < 2; threads++ )
+			{
+				DepthPostProcessKernel kernel( width, height, threads ? &pool : NULL, &layout );
+				mismatch_cos += checkCos( kernel, 20000 );
+
+				for( int f = 0; f < frames; f++ )
+				{
+					makeFrame( width, height, layout, f * 31 + depth_format * 7 + rayconf_format, frame );
+
+					Clock::time_point start = Clock::now();
+					referenceInvalid( size, layout, frame, ref_invalid );
+					referenceCloud( size, layout, frame, ref_invalid, ref_points );
+					reference_ms += elapsedMs( start );
+
+					start = Clock::now();
+					kernel.invalidMask( &frame.depth[0], &frame.rgb[0], &frame.noise_40[0], &invalid[0] );
+					kernel.extractCloud( &frame.depth[0], &frame.rayconf[0], &invalid[0], &frame.conf_noise[0], &frame.sensor_noise[0], &points[0] );
+					fused_ms += elapsedMs( start );
+
+					kernel.maskFlags( &frame.depth[0], &frame.rayconf[0], &frame.rgb[0], &frame.noise_40[0], &frame.conf_noise[0], &flags[0] );
+
+					for( int idx = 0; idx < size; idx++ )
+					{
+						mismatch_invalid += ( invalid[ idx ] != 0 ) != ( ref_invalid[ idx ] != 0 );
+						mismatch_cloud += !samePoint( points[ idx ], ref_points[ idx ] );
+
+						// a pixel without flags is exactly a point of the reference without its occlusion edge step
+						bool invalid_flag = ( flags[ idx ] & DepthMask::MASK_INVALID ) != 0;
+						mismatch_flags += invalid_flag != ( ref_invalid[ idx ] != 0 ) || ( flags[ idx ] == 0 ) != !std::isnan( ref_points[ idx ].z );
+					}
+				}
+			}
+		}
+	}
+
+	int runs = 2 * 3 * 2 * frames;
+	printf( "%d x %d, %d frames of 6 layouts, 1 & 4 threads\n", width, height, frames );
+	printf( "step by step %8.3f ms   fused %8.3f ms\n", reference_ms / runs, fused_ms / runs );
+	printf( "mismatch     invalid %ld, flags %ld, cloud %ld, cos %ld\n", mismatch_invalid, mismatch_flags, mismatch_cloud, mismatch_cos );
+
+	bool identical = mismatch_invalid == 0 && mismatch_flags == 0 && mismatch_cloud == 0 && mismatch_cos == 0;
+	printf( "%s\n", identical ? "identical" : "MISMATCH" );
+	return identical ? 0 : 1;
+}
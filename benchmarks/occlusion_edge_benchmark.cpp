@@ -0,0 +1,201 @@
+/*
+ * occlusion_edge_benchmark.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+// OcclusionEdgeEroder vs stamping a diamond of radius r on every invalid edge pixel, as _disturbOcclusionEdge() used to,
+// on random invalid masks for 1 ~ 4 row bands and odd resolutions :
+//   sparse : shadows & up to 5 % dropouts, radii 0 ~ 20
+//   dense  : shadows & 30 % dropouts, radius 20 everywhere, most invalid pixels are edge pixels
+// Prints the time per frame of both at 1280 x 960 for each kind of mask, the eroder for each thread count.
+// usage : occlusion_edge_benchmark [ masks per resolution ]
+// exit code is 1 if any pixel of any mask differs
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+#include "BenchmarkUtils.h"
+#include "OcclusionEdgeEroder.h"
+
+using namespace std;
+
+enum MaskKind
+{
+	MASK_SPARSE,
+	MASK_DENSE,
+	NUM_MASK_KINDS
+};
+
+static const char *MASK_KIND_NAMES[ NUM_MASK_KINDS ] = { "sparse", "dense" };
+
+// ******************************************************************************************** //
+// invalid rectangles ( shadows ) & dropouts, sparse with radius 0 ~ 20 or dense with radius 20 //
+// ******************************************************************************************** //
+static void makeMask(	int						_width,
+						int						_height,
+						MaskKind				_kind,
+						unsigned int			_seed,
+						vector< unsigned char >	&_invalid,
+						vector< unsigned char >	&_radius )
+{
+	mt19937 rng( _seed );
+	uniform_real_distribution< float > uniform( 0.f, 1.f );
+
+	_invalid.assign( _width * _height, 0 );
+	_radius.resize( _width * _height );
+
+	int num_shadows = 1 + rng() % 12;
+	for( int s = 0; s < num_shadows; s++ )
+	{
+		int x0 = rng() % _width;
+		int y0 = rng() % _height;
+		int x1 = min( _width, x0 + 1 + (int)( rng() % max( 1, _width / 4 ) ) );
+		int y1 = min( _height, y0 + 1 + (int)( rng() % max( 1, _height / 4 ) ) );
+		for( int j = y0; j < y1; j++ )
+		{
+			for( int i = x0; i < x1; i++ )
+			{
+				_invalid[ i + j * _width ] = 1;
+			}
+		}
+	}
+
+	float dropout = _kind == MASK_DENSE ? 0.3f : uniform( rng ) * 0.05f;
+	for( int i = 0; i < _width * _height; i++ )
+	{
+		if( uniform( rng ) < dropout )
+		{
+			_invalid[i] = 1;
+		}
+		_radius[i] = _kind == MASK_DENSE ? 20 : rng() % 21;
+	}
+}
+
+// ****************************************************************************** //
+// reference : diamond of radius r around every invalid pixel next to a valid one //
+// ****************************************************************************** //
+static void stampDiamonds(	int								_width,
+							int								_height,
+							const vector< unsigned char >	&_invalid,
+							const vector< unsigned char >	&_radius,
+							vector< unsigned char >			&_eroded )
+{
+	// the center is stamped too, _disturbOcclusionEdge() skipped it as it was invalid already
+	_eroded.assign( _width * _height, 0 );
+
+	for( int j = 1; j < _height - 1; j++ )
+	{
+		for( int i = 1; i < _width - 1; i++ )
+		{
+			int idx = i + j * _width;
+			int radius = _radius[ idx ];
+			if(	!_invalid[ idx ] ||
+				radius < 1 ||
+				(	_invalid[ idx - 1 ] &&
+					_invalid[ idx + 1 ] &&
+					_invalid[ idx - _width ] &&
+					_invalid[ idx + _width ] ) )
+			{
+				continue;
+			}
+
+			for( int y = max( 0, j - radius ); y <= min( _height - 1, j + radius ); y++ )
+			{
+				int half = radius - abs( y - j );
+				for( int x = max( 0, i - half ); x <= min( _width - 1, i + half ); x++ )
+				{
+					_eroded[ x + y * _width ] = 255;
+				}
+			}
+		}
+	}
+}
+
+int main( int argc, char **argv )
+{
+	int masks = argc > 1 ? atoi( argv[1] ) : 10;
+	if( masks < 1 )
+	{
+		fprintf( stderr, "usage : occlusion_edge_benchmark [ masks per resolution ]\n" );
+		return 1;
+	}
+
+	// odd sizes leave a tail behind the 16 pixel SSE2 blocks & the 16 row blocks of the row pass
+	const int resolutions[][2] = { { 3, 3 }, { 37, 23 }, { 64, 48 }, { 333, 197 }, { 640, 480 }, { 1280, 960 } };
+	const int max_threads = 4;
+	long mismatch = 0;
+	int checked = 0;
+	// at 1280 x 960, stamping is single thread whatever the eroder uses
+	double stamp_ms[ NUM_MASK_KINDS ] = { 0 };
+	double erode_ms[ NUM_MASK_KINDS ][ max_threads ] = { { 0 } };
+	int stamp_timed[ NUM_MASK_KINDS ] = { 0 };
+	int erode_timed[ NUM_MASK_KINDS ][ max_threads ] = { { 0 } };
+
+	vector< unsigned char > invalid, radius, reference, eroded;
+	for( int threads = 1; threads <= max_threads; threads++ )
+	{
+		WorkerPool pool( threads - 1 );
+		for( const auto &resolution : resolutions )
+		{
+			int width = resolution[0];
+			int height = resolution[1];
+			OcclusionEdgeEroder eroder( width, height, threads > 1 ? &pool : NULL );
+			eroded.resize( width * height );
+
+			for( int kind = 0; kind < NUM_MASK_KINDS; kind++ )
+			{
+				for( int m = 0; m < masks; m++ )
+				{
+					makeMask( width, height, (MaskKind)kind, m * 7919 + width, invalid, radius );
+
+					Clock::time_point start = Clock::now();
+					stampDiamonds( width, height, invalid, radius, reference );
+					double ms = elapsedMs( start );
+
+					start = Clock::now();
+					eroder.erode( &invalid[0], &radius[0], &eroded[0] );
+					if( width == 1280 )
+					{
+						erode_ms[ kind ][ threads - 1 ] += elapsedMs( start );
+						erode_timed[ kind ][ threads - 1 ]++;
+						stamp_ms[ kind ] += ms;
+						stamp_timed[ kind ]++;
+					}
+
+					long differ = 0;
+					for( int i = 0; i < width * height; i++ )
+					{
+						differ += reference[i] != eroded[i];
+					}
+					if( differ > 0 )
+					{
+						printf( "MISMATCH %d x %d, %s, %d threads, mask %d : %ld pixels\n", width, height, MASK_KIND_NAMES[ kind ], threads, m, differ );
+					}
+					mismatch += differ;
+					checked++;
+				}
+			}
+		}
+	}
+
+	printf( "1280 x 960   stamping   eroder" );
+	for( int threads = 1; threads <= max_threads; threads++ )
+	{
+		printf( "  %d thread%s", threads, threads > 1 ? "s" : " " );
+	}
+	printf( "\n" );
+	for( int kind = 0; kind < NUM_MASK_KINDS; kind++ )
+	{
+		printf( "%-10s %8.3f ms        ", MASK_KIND_NAMES[ kind ], stamp_ms[ kind ] / max( 1, stamp_timed[ kind ] ) );
+		for( int threads = 1; threads <= max_threads; threads++ )
+		{
+			printf( " %7.3f ms", erode_ms[ kind ][ threads - 1 ] / max( 1, erode_timed[ kind ][ threads - 1 ] ) );
+		}
+		printf( "\n" );
+	}
+	printf( "%d masks, %ld differing pixels, %s\n", checked, mismatch, mismatch == 0 ? "identical" : "MISMATCH" );
+
+	return mismatch == 0 ? 0 : 1;
+}
@@ -0,0 +1,229 @@
+/*
+ * rt_layout_benchmark.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+// GPU -> CPU transfer & capture latency of the depth sensor's depth & rayconf render targets for every RenderTargetLayout.
+// A pile of cubes is rendered into a depth & a rayconf render texture of each layout, like one sequential capture,
+// then both are read back with copyContentsToMemory() in the format of the render texture, like the RT listeners do.
+// render : update() of both render targets & glFinish(), so the transfer doesn't include waiting for the GPU
+// transfer : copyContentsToMemory() of both render targets
+// decode : organized point cloud in millimeter from the buffers, with xyz reconstructed from depth when the layout has no xyz
+// capture : render + transfer + decode
+// The scene uses fixed function materials, not the depth shadow map shaders, the buffers are only timed.
+// usage : rt_layout_benchmark [ width ] [ height ] [ frames ]   ( needs an X display, e.g. xvfb-run )
+
+#include <GL/gl.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <OGRE/Ogre.h>
+
+#include "BenchmarkUtils.h"
+#include "RenderTargetLayout.h"
+
+using namespace std;
+
+static Ogre::PixelFormat depthPixelFormat( DepthFormat _format )
+{
+	return _format == DEPTH_FORMAT_R32F ? Ogre::PF_FLOAT32_R : Ogre::PF_FLOAT32_RGBA;
+}
+
+static Ogre::PixelFormat rayconfPixelFormat( RayConfFormat _format )
+{
+	switch( _format )
+	{
+	case RAYCONF_FORMAT_C32F:
+		return Ogre::PF_FLOAT32_R;
+	case RAYCONF_FORMAT_C16F:
+		return Ogre::PF_FLOAT16_R;
+	default:
+		return Ogre::PF_FLOAT32_RGBA;
+	}
+}
+
+static Ogre::RenderTexture *createRenderTexture(	const string		&_name,
+													int					_width,
+													int					_height,
+													Ogre::PixelFormat	_format,
+													Ogre::Camera		*_camera )
+{
+	Ogre::TexturePtr texture = Ogre::TextureManager::getSingleton().createManual(	_name,
+																					Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME,
+																					Ogre::TEX_TYPE_2D,
+																					_width,
+																					_height,
+																					0,
+																					_format,
+																					Ogre::TU_RENDERTARGET );
+	Ogre::RenderTexture *rt = texture->getBuffer()->getRenderTarget();
+	rt->setAutoUpdated( false );
+	rt->addViewport( _camera );
+	rt->getViewport( 0 )->setClearEveryFrame( true );
+	rt->getViewport( 0 )->setBackgroundColour( Ogre::ColourValue::White );
+	rt->getViewport( 0 )->setOverlaysEnabled( false );
+	return rt;
+}
+
+static void readBack( Ogre::RenderTexture *_rt, void *_buffer )
+{
+	Ogre::PixelBox box( _rt->getWidth(), _rt->getHeight(), 1, _rt->suggestPixelFormat(), _buffer );
+	_rt->copyContentsToMemory( box, Ogre::RenderTarget::FB_AUTO );
+}
+
+int main( int argc, char **argv )
+{
+	int width = argc > 1 ? atoi( argv[1] ) : 1280;
+	int height = argc > 2 ? atoi( argv[2] ) : 960;
+	int frames = argc > 3 ? atoi( argv[3] ) : 100;
+	if( width <= 0 || height <= 0 || frames <= 0 )
+	{
+		printf( "usage : rt_layout_benchmark [ width ] [ height ] [ frames ]\n" );
+		return 1;
+	}
+
+	// ************************************* //
+	// GL render system with a hidden window //
+	// ************************************* //
+	Ogre::Root *root = new Ogre::Root( "", "", "rt_layout_benchmark.log" );
+	root->loadPlugin( string( OGRE_PLUGIN_DIR ) + "/RenderSystem_GL" );
+	Ogre::RenderSystem *render_system = root->getRenderSystemByName( "OpenGL Rendering Subsystem" );
+	if( !render_system )
+	{
+		printf( "OpenGL render system not found in %s\n", OGRE_PLUGIN_DIR );
+		return 1;
+	}
+	root->setRenderSystem( render_system );
+	root->initialise( false );
+
+	Ogre::NameValuePairList params;
+	params[ "hidden" ] = "true";
+	root->createRenderWindow( "rt_layout_benchmark", 64, 64, false, &params );
+	Ogre::ResourceGroupManager::getSingleton().initialiseAllResourceGroups();
+
+	// ******************************************* //
+	// pile of cubes in front of the sensor camera //
+	// ******************************************* //
+	Ogre::SceneManager *scene_mgr = root->createSceneManager( Ogre::ST_GENERIC );
+	scene_mgr->setAmbientLight( Ogre::ColourValue( 0.5f, 0.5f, 0.5f ) );
+
+	Ogre::Camera *camera = scene_mgr->createCamera( "sensor_camera" );
+	camera->setNearClipDistance( 0.1f );
+	camera->setFarClipDistance( 10.f );
+	camera->setFOVy( Ogre::Degree( 45 ) );
+	camera->setAspectRatio( (Ogre::Real)width / height );
+
+	for( int j = 0; j < 10; j++ )
+	{
+		for( int i = 0; i < 10; i++ )
+		{
+			// prefab cube is 100 units wide, 10 cm cubes 1 ~ 1.5 m away
+			Ogre::Entity *cube = scene_mgr->createEntity( Ogre::SceneManager::PT_CUBE );
+			Ogre::SceneNode *node = scene_mgr->getRootSceneNode()->createChildSceneNode( Ogre::Vector3( ( i - 4.5f ) * 0.12f, ( j - 4.5f ) * 0.12f, -1.f - ( ( i + j ) % 5 ) * 0.1f ) );
+			node->setScale( 0.001f, 0.001f, 0.001f );
+			node->yaw( Ogre::Degree( ( i * 10 + j ) * 7.f ) );
+			node->pitch( Ogre::Degree( ( i * 10 + j ) * 3.f ) );
+			node->attachObject( cube );
+		}
+	}
+
+	// intrinsics of pixel centers from the projection matrix, as the depth sensor plugin computes them
+	Ogre::Matrix4 proj = camera->getProjectionMatrix();
+	float fx = proj[0][0] * width / 2;
+	float fy = proj[1][1] * height / 2;
+	float cx = ( 1 + proj[0][2] ) * width / 2 - 0.5f;
+	float cy = ( 1 - proj[1][2] ) * height / 2 - 0.5f;
+
+	const int num_layouts = 4;
+	RenderTargetLayout layouts[ num_layouts ] = {	RenderTargetLayout( DEPTH_FORMAT_RGBA32F, RAYCONF_FORMAT_XYZC32F ),
+													RenderTargetLayout( DEPTH_FORMAT_R32F, RAYCONF_FORMAT_XYZC32F ),
+													RenderTargetLayout( DEPTH_FORMAT_R32F, RAYCONF_FORMAT_C32F ),
+													RenderTargetLayout( DEPTH_FORMAT_R32F, RAYCONF_FORMAT_C16F ) };
+	const char *names[ num_layouts ] = { "rgba32f + xyzc32f", "r32f + xyzc32f", "r32f + c32f", "r32f + c16f" };
+
+	printf( "%d x %d, %d frames\n", width, height, frames );
+	printf( "%18s | %10s | %10s %12s %10s %11s\n", "layout", "readback", "render ms", "transfer ms", "decode ms", "capture ms" );
+
+	vector< float > cloud( width * height * 3 );
+	const float nan = numeric_limits< float >::quiet_NaN();
+	for( int l = 0; l < num_layouts; l++ )
+	{
+		RenderTargetLayout &layout = layouts[l];
+		layout.setCamera( width, height, fx, fy, cx, cy, camera->getNearClipDistance(), camera->getFarClipDistance() );
+
+		Ogre::PixelFormat depth_format = depthPixelFormat( layout.getDepthFormat() );
+		Ogre::PixelFormat rayconf_format = rayconfPixelFormat( layout.getRayConfFormat() );
+		if(	!Ogre::TextureManager::getSingleton().isFormatSupported( Ogre::TEX_TYPE_2D, depth_format, Ogre::TU_RENDERTARGET ) ||
+			!Ogre::TextureManager::getSingleton().isFormatSupported( Ogre::TEX_TYPE_2D, rayconf_format, Ogre::TU_RENDERTARGET ) )
+		{
+			printf( "%18s | render target format not supported\n", names[l] );
+			continue;
+		}
+
+		Ogre::RenderTexture *depth_rt = createRenderTexture( "depth_" + Ogre::StringConverter::toString( l ), width, height, depth_format, camera );
+		Ogre::RenderTexture *rayconf_rt = createRenderTexture( "rayconf_" + Ogre::StringConverter::toString( l ), width, height, rayconf_format, camera );
+
+		vector< float > depth( width * height * layout.depthPixelBytes() / sizeof( float ) );
+		vector< float > rayconf( ( width * height * layout.rayconfPixelBytes() + sizeof( float ) - 1 ) / sizeof( float ) );
+
+		double render_ms = 0;
+		double transfer_ms = 0;
+		double decode_ms = 0;
+		// first frame only warms up
+		for( int f = 0; f <= frames; f++ )
+		{
+			Clock::time_point start = Clock::now();
+			depth_rt->update( true );
+			rayconf_rt->update( true );
+			glFinish();
+			double render = elapsedMs( start );
+
+			start = Clock::now();
+			readBack( depth_rt, &depth[0] );
+			readBack( rayconf_rt, &rayconf[0] );
+			double transfer = elapsedMs( start );
+
+			start = Clock::now();
+			for( int idx = 0; idx < width * height; idx++ )
+			{
+				float *point = &cloud[ 3 * idx ];
+				if( layout.confidence( &rayconf[0], idx ) > 0.2588f && layout.hasPoint( &depth[0], &rayconf[0], idx ) )
+				{
+					layout.point( &depth[0], &rayconf[0], idx, point );
+					point[0] *= 1000;
+					point[1] *= 1000;
+					point[2] *= 1000;
+				}
+				else
+				{
+					point[0] = point[1] = point[2] = nan;
+				}
+			}
+			double decode = elapsedMs( start );
+
+			if( f > 0 )
+			{
+				render_ms += render;
+				transfer_ms += transfer;
+				decode_ms += decode;
+			}
+		}
+
+		double readback_mb = (double)width * height * ( layout.depthPixelBytes() + layout.rayconfPixelBytes() ) / ( 1 << 20 );
+		printf( "%18s | %7.2f MB | %10.3f %12.3f %10.3f %11.3f\n",
+				names[l],
+				readback_mb,
+				render_ms / frames,
+				transfer_ms / frames,
+				decode_ms / frames,
+				( render_ms + transfer_ms + decode_ms ) / frames );
+	}
+
+	delete root;
+	return 0;
+}
@@ -0,0 +1,147 @@
+/*
+ * segment_label_benchmark.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+// Labeling the segment proxies of a pile of N models, each with a few entities, for N from 9 to 1000.
+// scan : what SegmentRTListener did every capture, count the models with a duplicate check over a vector,
+//        then match every model against the model name of every entity ( N * entities string compares ).
+// table : ModelLabelTable as used by EntityProxyCache now, one hashed lookup per entity, and only when a model
+//         or a proxy was added or removed ( a capture of an unchanged scene costs nothing ).
+// usage : segment_label_benchmark [ entities per model ] [ repeats ]
+// exit code is 1 if both give a different label to any entity
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+#include "ModelLabelTable.h"
+
+using namespace std;
+
+// an entity of a proxy, as EntityProxyCache keeps it
+struct Entity
+{
+	string model_name;
+	float label;
+};
+
+static void labelScan( const vector< string > &_visual_names, vector< Entity > &_entities )
+{
+	// **************** //
+	// count all models //
+	// **************** //
+	vector< string > model_names;
+	for( unsigned int i = 0; i < _visual_names.size(); i++ )
+	{
+		if( _visual_names[i].rfind( "::" ) != string::npos )
+		{
+			continue;
+		}
+		if( find( model_names.begin(), model_names.end(), _visual_names[i] ) == model_names.end() )
+		{
+			model_names.push_back( _visual_names[i] );
+		}
+	}
+
+	// ********************************************* //
+	// label of every entity, one model at a time    //
+	// ********************************************* //
+	for( unsigned int i = 0; i < model_names.size(); i++ )
+	{
+		float label = ( i + 1.0f ) / model_names.size();
+		for( unsigned int j = 0; j < _entities.size(); j++ )
+		{
+			if( _entities[j].model_name == model_names[i] )
+			{
+				_entities[j].label = label;
+			}
+		}
+	}
+}
+
+static void labelTable( const ModelLabelTable &_models, vector< Entity > &_entities )
+{
+	for( unsigned int j = 0; j < _entities.size(); j++ )
+	{
+		int idx = _models.find( _entities[j].model_name );
+		_entities[j].label = idx >= 0 ? _models.getLabel( idx ) : 0.f;
+	}
+}
+
+int main( int argc, char **argv )
+{
+	int entities_per_model = argc > 1 ? atoi( argv[1] ) : 3;
+	int repeats = argc > 2 ? atoi( argv[2] ) : 20;
+
+	const int pile_sizes[] = { 9, 50, 100, 200, 500, 1000 };
+	bool mismatch = false;
+
+	printf( "%6s %9s | %12s %12s | %12s %12s | %8s\n", "models", "entities", "scan ms", "ns/entity", "table ms", "ns/entity", "speedup" );
+	for( unsigned int p = 0; p < sizeof( pile_sizes ) / sizeof( pile_sizes[0] ); p++ )
+	{
+		int num_models = pile_sizes[p];
+
+		// visuals of the scene : model, link & visuals of every model, registered in this order
+		vector< string > visual_names;
+		vector< Entity > entities;
+		ModelLabelTable models;
+		for( int m = 0; m < num_models; m++ )
+		{
+			char name[32];
+			snprintf( name, sizeof( name ), "object_%d", m );
+			visual_names.push_back( name );
+			visual_names.push_back( string( name ) + "::link" );
+			models.insert( name );
+			for( int e = 0; e < entities_per_model; e++ )
+			{
+				visual_names.push_back( string( name ) + "::link::visual_" + to_string( e ) );
+				Entity entity;
+				entity.model_name = name;
+				entity.label = 0.f;
+				entities.push_back( entity );
+			}
+		}
+		vector< Entity > scan_entities = entities;
+		vector< Entity > table_entities = entities;
+
+		Clock::time_point start = Clock::now();
+		for( int r = 0; r < repeats; r++ )
+		{
+			labelScan( visual_names, scan_entities );
+		}
+		double scan_ms = elapsedMs( start ) / repeats;
+
+		start = Clock::now();
+		for( int r = 0; r < repeats; r++ )
+		{
+			labelTable( models, table_entities );
+		}
+		double table_ms = elapsedMs( start ) / repeats;
+
+		for( unsigned int j = 0; j < entities.size(); j++ )
+		{
+			if( scan_entities[j].label != table_entities[j].label )
+			{
+				mismatch = true;
+			}
+		}
+
+		printf( "%6d %9d | %12.4f %12.1f | %12.4f %12.1f | %7.1fx\n",
+				num_models, (int)entities.size(),
+				scan_ms, scan_ms * 1e6 / entities.size(),
+				table_ms, table_ms * 1e6 / entities.size(),
+				scan_ms / table_ms );
+	}
+
+	if( mismatch )
+	{
+		printf( "labels differ\n" );
+		return 1;
+	}
+	return 0;
+}
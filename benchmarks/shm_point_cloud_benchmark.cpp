@@ -0,0 +1,367 @@
+/*
+ * shm_point_cloud_benchmark.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+// End-to-end latency of one organized cloud from the sensor side to a consumer :
+//   shm     : SharedMemoryRingWriter -> ShmPointCloudReader ( zero-copy read )
+//   legacy  : pcl::msgs::PointCloudXYZL, serialized, sent over loopback TCP, parsed
+//   packed  : pcl::msgs::PackedPointCloud, serialized, sent over loopback TCP, parsed
+// Loopback TCP stands in for gazebo transport, which also adds its own framing & callback dispatch.
+// usage : shm_point_cloud_benchmark [ width ] [ height ] [ frames ]
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <thread>
+
+#include "BenchmarkUtils.h"
+#include "point_cloud.pb.h"
+#include "packed_point_cloud.pb.h"
+#include "ShmPointCloudReader.h"
+
+using namespace std;
+
+struct Point
+{
+	float x;
+	float y;
+	float z;
+	uint32_t label;
+};
+
+// ********************************* //
+// consumer side work on every point //
+// ********************************* //
+static double g_checksum = 0;
+
+static void consume( const Point *_points, size_t _size )
+{
+	double sum = 0;
+	for( size_t i = 0; i < _size; i++ )
+	{
+		if( !std::isnan( _points[i].z ) )
+		{
+			sum += _points[i].z + _points[i].label;
+		}
+	}
+	g_checksum += sum;
+}
+
+static void printResult( const char *_name, vector< double > &_latency_ms, size_t _payload_bytes )
+{
+	sort( _latency_ms.begin(), _latency_ms.end() );
+	double mean = 0;
+	for( unsigned int i = 0; i < _latency_ms.size(); i++ )
+	{
+		mean += _latency_ms[i];
+	}
+	mean /= _latency_ms.size();
+
+	printf( "%-8s payload %8.2f MB   mean %8.3f ms   p50 %8.3f ms   p99 %8.3f ms   max %8.3f ms\n",
+			_name,
+			_payload_bytes / 1024.0 / 1024.0,
+			mean,
+			_latency_ms[ _latency_ms.size() / 2 ],
+			_latency_ms[ min( _latency_ms.size() - 1, _latency_ms.size() * 99 / 100 ) ],
+			_latency_ms.back() );
+}
+
+// ******************************************************** //
+// shared memory : writer copies the cloud, reader reads it //
+// ******************************************************** //
+static void benchmarkShm( const vector< Point > &_cloud, const vector< unsigned char > &_rgb, int _width, int _height, int _frames )
+{
+	SharedMemoryRingWriter writer( "shm_point_cloud_benchmark", _width, _height, 4 );
+	ShmPointCloudReader reader;
+	if( !writer.isValid() || !reader.open( "shm_point_cloud_benchmark" ) )
+	{
+		printf( "shm : ring not available\n" );
+		return;
+	}
+
+	atomic< Clock::rep > start_time( 0 );
+	vector< double > latency_ms;
+	// frames done by the consumer
+	atomic< int > num_done( 0 );
+
+	thread consumer( [&]
+	{
+		uint64_t last = 0;
+		for( int f = 0; f < _frames; f++ )
+		{
+			last = reader.waitForFrame( last, -1 );
+
+			ShmPointCloudReader::Frame frame;
+			if( reader.acquireLastFrame( frame ) )
+			{
+				consume( (const Point*)frame.points, (size_t)frame.width * frame.height );
+			}
+			if( !reader.validateFrame( frame ) )
+			{
+				printf( "shm : frame %lu overwritten while reading\n", (unsigned long)frame.frame );
+			}
+
+			latency_ms.push_back( chrono::duration< double, milli >( Clock::now().time_since_epoch() ).count() -
+								  chrono::duration< double, milli >( Clock::duration( start_time.load() ) ).count() );
+			num_done++;
+		}
+	} );
+
+	for( int f = 0; f < _frames; f++ )
+	{
+		// let the reader wait first, so only one frame is in flight
+		this_thread::sleep_for( chrono::milliseconds( 5 ) );
+		start_time = Clock::now().time_since_epoch().count();
+
+		int slot = writer.beginFrame();
+		memcpy( writer.getPoints( slot ), &_cloud[0], _cloud.size() * sizeof( Point ) );
+		memcpy( writer.getRGB( slot ), &_rgb[0], _rgb.size() );
+		writer.commitFrame( slot, true, true );
+
+		while( num_done <= f )
+		{
+			this_thread::yield();
+		}
+	}
+	consumer.join();
+
+	printResult( "shm", latency_ms, _cloud.size() * sizeof( Point ) + _rgb.size() );
+}
+
+// *************************************************** //
+// protobuf : serialize, send over loopback TCP, parse //
+// *************************************************** //
+static bool sendAll( int _fd, const char *_data, size_t _size )
+{
+	while( _size > 0 )
+	{
+		ssize_t sent = send( _fd, _data, _size, 0 );
+		if( sent <= 0 )
+		{
+			return false;
+		}
+		_data += sent;
+		_size -= sent;
+	}
+	return true;
+}
+
+static bool recvAll( int _fd, char *_data, size_t _size )
+{
+	while( _size > 0 )
+	{
+		ssize_t received = recv( _fd, _data, _size, 0 );
+		if( received <= 0 )
+		{
+			return false;
+		}
+		_data += received;
+		_size -= received;
+	}
+	return true;
+}
+
+// _serialize builds & serializes a message, _parse parses & consumes it
+static void benchmarkProtobuf(	const char								*_name,
+								int										_frames,
+								const function< void( string& ) >		&_serialize,
+								const function< void( const string& ) >	&_parse )
+{
+	int server = socket( AF_INET, SOCK_STREAM, 0 );
+	sockaddr_in addr;
+	memset( &addr, 0, sizeof( addr ) );
+	addr.sin_family = AF_INET;
+	addr.sin_addr.s_addr = htonl( INADDR_LOOPBACK );
+	addr.sin_port = 0;
+	socklen_t addr_len = sizeof( addr );
+	if( bind( server, (sockaddr*)&addr, sizeof( addr ) ) != 0 || listen( server, 1 ) != 0 || getsockname( server, (sockaddr*)&addr, &addr_len ) != 0 )
+	{
+		printf( "%s : loopback socket not available\n", _name );
+		::close( server );
+		return;
+	}
+
+	atomic< Clock::rep > start_time( 0 );
+	vector< double > latency_ms;
+	// frames done by the consumer
+	atomic< int > num_done( 0 );
+	size_t payload_bytes = 0;
+
+	thread consumer( [&]
+	{
+		int fd = accept( server, NULL, NULL );
+		string buffer;
+		for( int f = 0; f < _frames; f++ )
+		{
+			uint64_t size = 0;
+			if( !recvAll( fd, (char*)&size, sizeof( size ) ) )
+			{
+				break;
+			}
+			buffer.resize( size );
+			if( !recvAll( fd, &buffer[0], size ) )
+			{
+				break;
+			}
+			_parse( buffer );
+
+			latency_ms.push_back( chrono::duration< double, milli >( Clock::now().time_since_epoch() ).count() -
+								  chrono::duration< double, milli >( Clock::duration( start_time.load() ) ).count() );
+			num_done++;
+		}
+		::close( fd );
+	} );
+
+	int client = socket( AF_INET, SOCK_STREAM, 0 );
+	int no_delay = 1;
+	setsockopt( client, IPPROTO_TCP, TCP_NODELAY, &no_delay, sizeof( no_delay ) );
+	if( connect( client, (sockaddr*)&addr, sizeof( addr ) ) != 0 )
+	{
+		printf( "%s : connect failed\n", _name );
+	}
+
+	string buffer;
+	for( int f = 0; f < _frames; f++ )
+	{
+		this_thread::sleep_for( chrono::milliseconds( 5 ) );
+		start_time = Clock::now().time_since_epoch().count();
+
+		_serialize( buffer );
+		payload_bytes = buffer.size();
+		uint64_t size = buffer.size();
+		if( !sendAll( client, (const char*)&size, sizeof( size ) ) || !sendAll( client, buffer.data(), buffer.size() ) )
+		{
+			printf( "%s : send failed\n", _name );
+			break;
+		}
+
+		while( num_done <= f )
+		{
+			this_thread::yield();
+		}
+	}
+
+	::close( client );
+	consumer.join();
+	::close( server );
+
+	printResult( _name, latency_ms, payload_bytes );
+}
+
+// positive decimal integer, the whole argument must be a number
+static bool parseSize( const char *_arg, int &_value )
+{
+	char *end;
+	errno = 0;
+	long value = strtol( _arg, &end, 10 );
+	if( end == _arg || *end != '\0' || errno != 0 || value <= 0 || value > INT_MAX )
+	{
+		return false;
+	}
+	_value = value;
+	return true;
+}
+
+int main( int argc, char **argv )
+{
+	int width = 1280;
+	int height = 960;
+	int frames = 50;
+	if(	argc > 4 ||
+		( argc > 1 && !parseSize( argv[1], width ) ) ||
+		( argc > 2 && !parseSize( argv[2], height ) ) ||
+		( argc > 3 && !parseSize( argv[3], frames ) ) )
+	{
+		printf( "usage : shm_point_cloud_benchmark [ width ] [ height ] [ frames ]\n" );
+		return 1;
+	}
+
+	// about a third of an organized cloud is NaN, the rest is a bin of smooth z
+	mt19937 rng( 0 );
+	uniform_real_distribution< float > noise( -0.5f, 0.5f );
+	vector< Point > cloud( width * height );
+	vector< unsigned char > rgb( width * height * 3, 128 );
+	for( int j = 0; j < height; j++ )
+	{
+		for( int i = 0; i < width; i++ )
+		{
+			Point &p = cloud[ i + j * width ];
+			bool valid = ( i / 64 + j / 64 ) % 3 != 0;
+			p.x = valid ? ( i - width / 2 ) * 0.5f : NAN;
+			p.y = valid ? ( j - height / 2 ) * 0.5f : NAN;
+			p.z = valid ? -800.f + noise( rng ) : NAN;
+			p.label = ( i / 100 + j / 100 ) % 8;
+		}
+	}
+
+	printf( "%d x %d, %d frames\n", width, height, frames );
+
+	benchmarkShm( cloud, rgb, width, height, frames );
+
+	benchmarkProtobuf( "legacy", frames,
+		[&]( string &_buffer )
+		{
+			pcl::msgs::PointCloudXYZL msgs;
+			msgs.set_width( width );
+			msgs.set_height( height );
+			msgs.set_is_dense( false );
+			for( unsigned int i = 0; i < cloud.size(); i++ )
+			{
+				pcl::msgs::PointXYZL point;
+				point.set_x( cloud[i].x );
+				point.set_y( cloud[i].y );
+				point.set_z( cloud[i].z );
+				point.set_label( cloud[i].label );
+				msgs.add_points()->CopyFrom( point );
+			}
+			msgs.SerializeToString( &_buffer );
+		},
+		[&]( const string &_buffer )
+		{
+			pcl::msgs::PointCloudXYZL msgs;
+			msgs.ParseFromString( _buffer );
+			vector< Point > points( msgs.points_size() );
+			for( int i = 0; i < msgs.points_size(); i++ )
+			{
+				const pcl::msgs::PointXYZL &point = msgs.points( i );
+				points[i].x = point.x();
+				points[i].y = point.y();
+				points[i].z = point.z();
+				points[i].label = point.label();
+			}
+			consume( &points[0], points.size() );
+		} );
+
+	benchmarkProtobuf( "packed", frames,
+		[&]( string &_buffer )
+		{
+			pcl::msgs::PackedPointCloud msgs;
+			msgs.set_width( width );
+			msgs.set_height( height );
+			msgs.set_is_dense( false );
+			msgs.set_point_step( sizeof( Point ) );
+			msgs.mutable_data()->assign( (const char*)&cloud[0], cloud.size() * sizeof( Point ) );
+			msgs.SerializeToString( &_buffer );
+		},
+		[&]( const string &_buffer )
+		{
+			pcl::msgs::PackedPointCloud msgs;
+			msgs.ParseFromString( _buffer );
+			consume( (const Point*)msgs.data().data(), msgs.data().size() / sizeof( Point ) );
+		} );
+
+	printf( "checksum %g\n", g_checksum );
+	return 0;
+}
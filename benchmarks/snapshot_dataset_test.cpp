@@ -0,0 +1,124 @@
+/*
+ * snapshot_dataset_test.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+// Resume of a snapshot dataset with gaps in its frame numbers :
+//   frames 0, 1, 3 are written ( 2 was dropped ), the run is resumed and appends behind frame 3,
+//   then the index & footer are cut off ( crashed run ) and the recovered file is resumed again.
+// Every resumed run must continue behind the largest frame, so the reader finds every frame exactly once.
+// usage : snapshot_dataset_test [ dataset path ], exit code 1 on any failure
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "SnapshotDataset.h"
+
+using namespace std;
+
+static const int WIDTH = 16;
+static const int HEIGHT = 8;
+
+static int failures = 0;
+
+static void check( bool _condition, const char *_what )
+{
+	if( !_condition )
+	{
+		printf( "FAILED : %s\n", _what );
+		failures++;
+	}
+}
+
+static bool appendFrame( SnapshotDatasetWriter &_writer, uint64_t _frame )
+{
+	// label section filled with the frame number, to check the record found for a frame
+	vector< unsigned char > label( WIDTH * HEIGHT, (unsigned char)_frame );
+
+	SnapshotDatasetWriter::Record record;
+	memset( &record, 0, sizeof( record ) );
+	record.frame = _frame;
+	record.sim_time = _frame * 0.1;
+	record.section[ SNAPSHOT_SECTION_LABEL ] = &label[0];
+	record.section_bytes[ SNAPSHOT_SECTION_LABEL ] = label.size();
+	return _writer.append( record );
+}
+
+// every frame of _frames is found once with its own record, and the file has nothing else
+static void checkFrames( const string &_path, const vector< uint64_t > &_frames, bool _recovered, const char *_what )
+{
+	SnapshotDatasetReader reader;
+	if( !reader.open( _path ) )
+	{
+		check( false, _what );
+		return;
+	}
+
+	bool valid = reader.getNumRecords() == (int)_frames.size() && reader.isRecovered() == _recovered;
+	for( unsigned int i = 0; i < _frames.size() && valid; i++ )
+	{
+		int idx = reader.findFrame( _frames[i] );
+		SnapshotDatasetReader::Record record;
+		valid = idx == (int)i && reader.getRecord( idx, record ) && record.frame == _frames[i] &&
+				record.label && record.label[0] == (unsigned char)_frames[i];
+	}
+	valid = valid && reader.findFrame( 2 ) < 0;
+	check( valid, _what );
+}
+
+int main( int argc, char **argv )
+{
+	string path = argc > 1 ? argv[1] : "snapshot_dataset_test.gzds";
+	unlink( path.c_str() );
+
+	vector< uint64_t > frames;
+	{
+		SnapshotDatasetWriter writer( path, WIDTH, HEIGHT, SNAPSHOT_CLOUD_FORMAT_NONE );
+		check( writer.isValid(), "create dataset" );
+		check( writer.getNextFrame() == 0, "next frame of an empty dataset" );
+		for( uint64_t frame : { 0, 1, 3 } )
+		{
+			check( appendFrame( writer, frame ), "append" );
+			frames.push_back( frame );
+		}
+	}
+	checkFrames( path, frames, false, "frames 0, 1, 3" );
+
+	// resume after the gap
+	{
+		SnapshotDatasetWriter writer( path, WIDTH, HEIGHT, SNAPSHOT_CLOUD_FORMAT_NONE );
+		check( writer.getNumRecords() == 3, "records of the resumed dataset" );
+		check( writer.getNextFrame() == 4, "next frame after a gap is behind the largest frame, not the record count" );
+		uint64_t frame = writer.getNextFrame();
+		check( appendFrame( writer, frame ), "append after resume" );
+		frames.push_back( frame );
+	}
+	checkFrames( path, frames, false, "resumed behind frame 3" );
+
+	// crashed run : drop index & footer behind the last record, the index is recovered from the record headers
+	{
+		struct stat st;
+		stat( path.c_str(), &st );
+		// the file ends with the index of every record & the footer
+		off_t end = st.st_size - frames.size() * sizeof( SnapshotIndexEntry ) - sizeof( SnapshotDatasetFooter );
+		check( truncate( path.c_str(), end ) == 0, "truncate index & footer" );
+	}
+	checkFrames( path, frames, true, "recovered without index" );
+
+	{
+		SnapshotDatasetWriter writer( path, WIDTH, HEIGHT, SNAPSHOT_CLOUD_FORMAT_NONE );
+		check( writer.isRecovered(), "resumed dataset is recovered" );
+		check( writer.getNextFrame() == 5, "next frame of a recovered dataset" );
+		uint64_t frame = writer.getNextFrame();
+		check( appendFrame( writer, frame ), "append after recovery" );
+		frames.push_back( frame );
+	}
+	checkFrames( path, frames, false, "resumed behind a recovered dataset" );
+
+	unlink( path.c_str() );
+	printf( "%s, %d failures\n", failures == 0 ? "passed" : "FAILED", failures );
+	return failures == 0 ? 0 : 1;
+}
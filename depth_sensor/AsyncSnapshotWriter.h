@@ -0,0 +1,200 @@
+/*
+ * AsyncSnapshotWriter.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef ASYNC_SNAPSHOT_WRITER_H_
+#define ASYNC_SNAPSHOT_WRITER_H_
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// Encodes & writes snapshot files on background threads, so the render thread only copies frame buffers.
+// A job owns copies of everything it writes ( captured by value ) and returns false if writing failed.
+// The queue is bounded : when it is full submit() either waits for a free place ( block ) or discards the job ( drop ).
+class AsyncSnapshotWriter
+{
+public:
+	enum Policy
+	{
+		POLICY_BLOCK,		// submit() waits until the queue has room
+		POLICY_DROP			// submit() discards the job if the queue is full
+	};
+
+	typedef function< bool() > Job;
+
+public:
+	// _num_threads == 0 runs every job inside submit()
+	AsyncSnapshotWriter(	int		_num_threads,
+							int		_queue_size,
+							Policy	_policy )
+		: m_queue_size( max( 1, _queue_size ) ),
+		  m_policy( _policy ),
+		  m_stop( false ),
+		  m_running( 0 ),
+		  m_written( 0 ),
+		  m_failed( 0 ),
+		  m_dropped( 0 )
+	{
+		for( int i = 0; i < _num_threads; i++ )
+		{
+			m_threads.push_back( thread( &AsyncSnapshotWriter::_threadLoop, this ) );
+		}
+	}
+	~AsyncSnapshotWriter()
+	{
+		// every queued file is still written
+		flush();
+		{
+			lock_guard< mutex > lock( m_mutex );
+			m_stop = true;
+		}
+		m_job_cv.notify_all();
+
+		for( unsigned int i = 0; i < m_threads.size(); i++ )
+		{
+			m_threads[i].join();
+		}
+	}
+
+	// queue _job, return false if it was dropped
+	bool submit( const Job &_job )
+	{
+		if( m_threads.empty() )
+		{
+			bool success = _job();
+			{
+				lock_guard< mutex > lock( m_mutex );
+				_count( success );
+			}
+			return true;
+		}
+
+		{
+			unique_lock< mutex > lock( m_mutex );
+			if( (int)m_queue.size() >= m_queue_size )
+			{
+				if( m_policy == POLICY_DROP )
+				{
+					m_dropped++;
+					return false;
+				}
+				m_space_cv.wait( lock, [this]{ return (int)m_queue.size() < m_queue_size; } );
+			}
+			m_queue.push_back( _job );
+		}
+		m_job_cv.notify_one();
+		return true;
+	}
+
+	// block until every submitted job is done
+	void flush()
+	{
+		unique_lock< mutex > lock( m_mutex );
+		m_idle_cv.wait( lock, [this]{ return m_queue.empty() && m_running == 0; } );
+	}
+
+	// jobs waiting in queue
+	int getQueueDepth()
+	{
+		lock_guard< mutex > lock( m_mutex );
+		return m_queue.size();
+	}
+
+	unsigned long getWritten()
+	{
+		lock_guard< mutex > lock( m_mutex );
+		return m_written;
+	}
+
+	unsigned long getFailed()
+	{
+		lock_guard< mutex > lock( m_mutex );
+		return m_failed;
+	}
+
+	unsigned long getDropped()
+	{
+		lock_guard< mutex > lock( m_mutex );
+		return m_dropped;
+	}
+
+private:
+	void _threadLoop()
+	{
+		while( true )
+		{
+			Job job;
+			{
+				unique_lock< mutex > lock( m_mutex );
+				m_job_cv.wait( lock, [this]{ return m_stop || !m_queue.empty(); } );
+				if( m_queue.empty() )
+				{
+					return;
+				}
+				job = m_queue.front();
+				m_queue.pop_front();
+				m_running++;
+			}
+			m_space_cv.notify_one();
+
+			bool success = job();
+			// captured references ( e.g. frame slots ) are released before flush() returns
+			job = Job();
+
+			{
+				lock_guard< mutex > lock( m_mutex );
+				m_running--;
+				_count( success );
+			}
+			m_idle_cv.notify_all();
+		}
+	}
+
+	// m_mutex must be locked
+	void _count( bool _success )
+	{
+		if( _success )
+		{
+			m_written++;
+		}
+		else
+		{
+			m_failed++;
+		}
+	}
+
+public:
+
+private:
+	vector< thread > m_threads;
+	// maximum number of queued jobs
+	int m_queue_size;
+	Policy m_policy;
+
+	// guards everything below
+	mutex m_mutex;
+	condition_variable m_job_cv;
+	condition_variable m_space_cv;
+	condition_variable m_idle_cv;
+	deque< Job > m_queue;
+	bool m_stop;
+	// jobs being run by threads
+	int m_running;
+
+	// results
+	unsigned long m_written;
+	unsigned long m_failed;
+	unsigned long m_dropped;
+};
+
+#endif /* ASYNC_SNAPSHOT_WRITER_H_ */
@@ -0,0 +1,366 @@
+/*
+ * CaptureStateGuard.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef CAPTURE_STATE_GUARD_H_
+#define CAPTURE_STATE_GUARD_H_
+
+#include <vector>
+
+#include <OGRE/Ogre.h>
+
+#include <gazebo/rendering/rendering.hh>
+
+#include "ShadowSettings.h"
+
+using namespace gazebo;
+using namespace std;
+
+// Render state of one capture, shared by every render target listener.
+// Gazebo's shadow settings & ambient light are saved once when the capture begins, every pass applies the profile it needs,
+// only the settings that differ from the current ones are set, and gazebo's state is restored once when the capture ends.
+// Between two passes of the same profile nothing is touched, so the shadow texture isn't reallocated.
+class CaptureStateGuard
+{
+public:
+	enum Profile
+	{
+		PROFILE_GAZEBO,		// gazebo's own state
+		PROFILE_RGB,		// specular map : IR projector is the only light, black ambient, gazebo's shadows
+		PROFILE_DEPTH		// depth, rayconf, segment & MRT passes : IR projector is the only light, depth shadow map
+	};
+
+public:
+	CaptureStateGuard(	rendering::ScenePtr 	_scene,
+						rendering::CameraPtr	_camera,
+						Ogre::SceneManager		*_scene_mgr,
+						Ogre::Light				*_ir_projector,
+						Ogre::Real				*_base_dist )
+		: m_scene( _scene ),
+		  m_camera( _camera ),
+		  m_scene_mgr( _scene_mgr ),
+		  m_ir_projector( _ir_projector ),
+		  m_base_dist( _base_dist ),
+		  m_active( false ),
+		  m_profile( PROFILE_GAZEBO ),
+		  m_lights_set( false )
+	{
+		_buildDepthProfile();
+	}
+	~CaptureStateGuard()
+	{
+		end();
+	}
+
+	// save gazebo's state & hide the grids, nothing else changes until apply()
+	void begin()
+	{
+		if( m_active )
+		{
+			return;
+		}
+
+		_saveShadowSettings( m_gazebo_shadow );
+		m_current_shadow = m_gazebo_shadow;
+		m_gazebo_ambient = m_scene_mgr->getAmbientLight();
+		m_current_ambient = m_gazebo_ambient;
+
+		// hide the grid if it is visible
+		m_hidden_grids.clear();
+		unsigned int grid_count = m_scene->GetGridCount();
+		for( unsigned int i = 0; i < grid_count; i++ )
+		{
+			if( m_scene->GetGrid( i )->GetSceneNode()->getAttachedObject( 0 )->getVisible() )	// should have only one attachment on this scenenode
+			{
+				m_hidden_grids.push_back( i );
+				m_scene->GetGrid( i )->Enable( false );
+			}
+		}
+
+		m_profile = PROFILE_GAZEBO;
+		m_active = true;
+	}
+
+	// called in preRenderTargetUpdate() of every pass, begin() if the capture hasn't begun
+	void apply( Profile _profile )
+	{
+		if( !m_active )
+		{
+			begin();
+		}
+		if( _profile == m_profile )
+		{
+			return;
+		}
+
+		// every capture profile uses the same lights
+		bool ir_only = _profile != PROFILE_GAZEBO;
+		if( ir_only && !m_lights_set )
+		{
+			_setLightSettings();
+		}
+		else if( !ir_only && m_lights_set )
+		{
+			_resetLightSettings();
+		}
+
+		_applyShadowSettings( _profile == PROFILE_DEPTH ? m_depth_shadow : m_gazebo_shadow );
+
+		Ogre::ColourValue ambient = _profile == PROFILE_RGB ? Ogre::ColourValue::Black : m_gazebo_ambient;
+		if( ambient != m_current_ambient )
+		{
+			m_scene_mgr->setAmbientLight( ambient );
+			m_current_ambient = ambient;
+		}
+
+		m_profile = _profile;
+	}
+
+	// restore gazebo's state & show the grids again
+	void end()
+	{
+		if( !m_active )
+		{
+			return;
+		}
+
+		apply( PROFILE_GAZEBO );
+
+		for( unsigned int i = 0; i < m_hidden_grids.size(); i++ )
+		{
+			m_scene->GetGrid( m_hidden_grids[i] )->Enable( true );
+		}
+		m_hidden_grids.clear();
+
+		m_active = false;
+	}
+
+	bool isActive() const
+	{
+		return m_active;
+	}
+
+private:
+	void _buildDepthProfile()
+	{
+		// ************************************ //
+		// shadow settings for depth shadow map //
+		// ************************************ //
+
+		// Finally enable the shadows using texture additive integrated
+		m_depth_shadow.shadow_tech = Ogre::SHADOWTYPE_TEXTURE_ADDITIVE_INTEGRATED;
+		// reset the shadow setting that GAZEBO modified in RTShaderSystem, only the spot light ( IR projector ) casts shadow
+		m_depth_shadow.texture_count_dir = 0;		// this one is essential for shadowmap
+		m_depth_shadow.texture_count_point = 0;		// this one is essential for shadowmap
+		m_depth_shadow.texture_count_spot = 1;		// this one is essential for shadowmap
+		m_depth_shadow.texture_count = 1;
+
+		// floating point texture, bigger texture size, more smooth, see http://www.ogre3d.org/docs/manual/manual_72.html
+		Ogre::ShadowTextureConfig config;
+		config.width = 2048;
+		config.height = 2048;
+		config.format = Ogre::PF_FLOAT32_R;
+		m_depth_shadow.texture_configs.assign( 1, config );
+
+		// Allow self shadowing (note: this only works in conjunction with the shaders defined above)
+		m_depth_shadow.self_shadow = true;
+		// You can switch this on or off, I suggest you try both and see which works best for you
+		m_depth_shadow.render_back_faces = false;
+		m_depth_shadow.dir_light_extrusion_dist = 10000;	// this is ogre's default
+		m_depth_shadow.dir_light_texture_offset = 0.6;		// this is ogre's default
+		m_depth_shadow.far_dist = 0;						// this is ogre's default
+		// Set the caster material which uses the shaders defined above
+		m_depth_shadow.caster_material = "Ogre/DepthShadowmap/Caster/Float";
+	}
+
+	void _saveShadowSettings( ShadowSettings &_settings )
+	{
+		// ************************************ //
+		// get gazebo's default shadow settings //
+		// ************************************ //
+		_settings.shadow_tech = 			m_scene_mgr->getShadowTechnique();
+		_settings.texture_count_dir = 		m_scene_mgr->getShadowTextureCountPerLightType( Ogre::Light::LT_DIRECTIONAL );
+		_settings.texture_count_point = 	m_scene_mgr->getShadowTextureCountPerLightType( Ogre::Light::LT_POINT );
+		_settings.texture_count_spot = 		m_scene_mgr->getShadowTextureCountPerLightType( Ogre::Light::LT_SPOTLIGHT );
+		_settings.texture_count = 			m_scene_mgr->getShadowTextureCount();
+
+		_settings.texture_configs.clear();
+		Ogre::ConstShadowTextureConfigIterator config_iter = m_scene_mgr->getShadowTextureConfigIterator();
+		while( config_iter.hasMoreElements() )
+		{
+			_settings.texture_configs.push_back( config_iter.getNext() );
+		}
+
+		_settings.self_shadow = 				m_scene_mgr->getShadowTextureSelfShadow();
+		_settings.render_back_faces = 			m_scene_mgr->getShadowCasterRenderBackFaces();
+		_settings.dir_light_extrusion_dist =	m_scene_mgr->getShadowDirectionalLightExtrusionDistance();
+		_settings.dir_light_texture_offset =	m_scene_mgr->getShadowDirLightTextureOffset();
+		_settings.far_dist =					m_scene_mgr->getShadowFarDistance();
+		// TODO can't get shadow texture caster material from scenemanager   ( see if can find a way
+		_settings.caster_material = 			"Gazebo/shadow_caster";
+	}
+
+	// set the settings of _target that differ from m_current_shadow
+	void _applyShadowSettings( const ShadowSettings &_target )
+	{
+		if( _target.shadow_tech != m_current_shadow.shadow_tech )
+		{
+			m_scene_mgr->setShadowTechnique( _target.shadow_tech );
+		}
+
+		// a new texture count resizes the texture configs, every config is set again
+		bool count_changed = _target.texture_count != m_current_shadow.texture_count;
+		if( count_changed )
+		{
+			m_scene_mgr->setShadowTextureCount( _target.texture_count );
+		}
+		if( _target.texture_count_dir != m_current_shadow.texture_count_dir )
+		{
+			m_scene_mgr->setShadowTextureCountPerLightType( Ogre::Light::LT_DIRECTIONAL, _target.texture_count_dir );
+		}
+		if( _target.texture_count_point != m_current_shadow.texture_count_point )
+		{
+			m_scene_mgr->setShadowTextureCountPerLightType( Ogre::Light::LT_POINT, _target.texture_count_point );
+		}
+		if( _target.texture_count_spot != m_current_shadow.texture_count_spot )
+		{
+			m_scene_mgr->setShadowTextureCountPerLightType( Ogre::Light::LT_SPOTLIGHT, _target.texture_count_spot );
+		}
+
+		for( unsigned int i = 0; i < _target.texture_configs.size(); i++ )
+		{
+			if( count_changed || i >= m_current_shadow.texture_configs.size() || _target.texture_configs[i] != m_current_shadow.texture_configs[i] )
+			{
+				m_scene_mgr->setShadowTextureConfig(	i,
+														_target.texture_configs[i].width,
+														_target.texture_configs[i].height,
+														_target.texture_configs[i].format,
+														_target.texture_configs[i].fsaa,
+														_target.texture_configs[i].depthBufferPoolId );
+			}
+		}
+
+		if( _target.self_shadow != m_current_shadow.self_shadow )
+		{
+			m_scene_mgr->setShadowTextureSelfShadow( _target.self_shadow );
+		}
+		if( _target.render_back_faces != m_current_shadow.render_back_faces )
+		{
+			m_scene_mgr->setShadowCasterRenderBackFaces( _target.render_back_faces );
+		}
+		if( _target.dir_light_extrusion_dist != m_current_shadow.dir_light_extrusion_dist )
+		{
+			m_scene_mgr->setShadowDirectionalLightExtrusionDistance( _target.dir_light_extrusion_dist );
+		}
+		if( _target.dir_light_texture_offset != m_current_shadow.dir_light_texture_offset )
+		{
+			m_scene_mgr->setShadowDirLightTextureOffset( _target.dir_light_texture_offset );
+		}
+		if( _target.far_dist != m_current_shadow.far_dist )
+		{
+			m_scene_mgr->setShadowFarDistance( _target.far_dist );
+		}
+		if( _target.caster_material != m_current_shadow.caster_material )
+		{
+			m_scene_mgr->setShadowTextureCasterMaterial( _target.caster_material );
+		}
+
+		m_current_shadow = _target;
+	}
+
+	void _setLightSettings()
+	{
+		// turn off the gazebo's light ( turn off the light & visual representation )
+		unsigned int num_lights = m_scene->GetLightCount();
+		for( unsigned int i = 0; i < num_lights; i++ )
+		{
+			m_scene->GetLight( i )->ShowVisual( false );
+		}
+
+		// turn off those light which is not created by gazebo,  except ours ( IR projector )
+		// radius = m_base_dist, the shader only consider the nearest lights, so just disable the light which is closer than IR Projector
+		m_turned_off_lights.clear();
+
+		Ogre::HashedVector< Ogre::Light * > light_list;
+		gazebo::math::Vector3 cam_pos = m_camera->GetWorldPosition();
+		Ogre::Vector3 cam_pos_ogre( cam_pos.x, cam_pos.y, cam_pos.z );
+		m_scene_mgr->_populateLightList( cam_pos_ogre, *m_base_dist, light_list );
+		for( Ogre::HashedVector< Ogre::Light * >::iterator iter = light_list.begin(); iter != light_list.end(); iter++ )
+		{
+			if( (*iter)->isVisible() && (*iter) != m_ir_projector )
+			{
+				(*iter)->setVisible( false );
+				m_turned_off_lights.push_back( (*iter) );
+			}
+		}
+
+		// turn on IR Projector
+		m_ir_projector->setVisible( true );
+
+		m_lights_set = true;
+	}
+
+	void _resetLightSettings()
+	{
+		// turn on the gazebo's light ( turn on the light & visual representation )
+		unsigned int num_lights = m_scene->GetLightCount();
+		for( unsigned int i = 0; i < num_lights; i++ )
+		{
+			m_scene->GetLight( i )->ShowVisual( true );
+		}
+
+		// turn on the light being turned off manually
+		for( vector<Ogre::Light *>::iterator iter = m_turned_off_lights.begin(); iter != m_turned_off_lights.end(); iter++ )
+		{
+			(*iter)->setVisible( true );
+		}
+		m_turned_off_lights.clear();
+
+		// turn off IR Projector
+		m_ir_projector->setVisible( false );
+
+		m_lights_set = false;
+	}
+
+public:
+
+private:
+	// the pointer to gazebo::rendering::Scene that contain the sensor camera
+	rendering::ScenePtr m_scene;
+	// gazebo::rendering::camera pointer of the sensor
+	rendering::CameraPtr m_camera;
+	// Ogre::SceneManager
+	Ogre::SceneManager *m_scene_mgr;
+	// Sensor IR Projector as Ogre::Light
+	Ogre::Light *m_ir_projector;
+	// distance between IR camera & IR projector
+	Ogre::Real *m_base_dist;
+
+	// between begin() & end()
+	bool m_active;
+	// profile applied to the scene
+	Profile m_profile;
+
+	// gazebo's shadow settings, saved when the capture begins
+	ShadowSettings m_gazebo_shadow;
+	// shadow settings for depth shadow map, built once
+	ShadowSettings m_depth_shadow;
+	// shadow settings set to the scene manager
+	ShadowSettings m_current_shadow;
+
+	// gazebo's ambient light, saved when the capture begins
+	Ogre::ColourValue m_gazebo_ambient;
+	// ambient light set to the scene manager
+	Ogre::ColourValue m_current_ambient;
+
+	// IR projector is the only light
+	bool m_lights_set;
+	// this vector contain lights being turned off by this class
+	vector<Ogre::Light *> m_turned_off_lights;
+	// grids hidden during the capture
+	vector<uint32_t> m_hidden_grids;
+};
+
+#endif /* CAPTURE_STATE_GUARD_H_ */
@@ -4,5 +4,5 @@
 
 USER_OBJS :=
 
-LIBS := -lpcl_io -lpcl_kdtree -lpcl_sample_consensus -lpcl_registration -lpcl_filters -lpcl_features -lpcl_common -lpcl_keypoints -lpcl_search -lpcl_visualization -lgazebo -lgazebo_msgs -lgazebo_transport -lgazebo_sensors -lgazebo_rendering -lgazebo_math -lgazebo_common -lopencv_highgui -lopencv_imgproc -lopencv_core -lopencv_video -lprotobuf -lOgreMain -lOIS -lfreetype -lpose_estimation_result -lpoint_type -lmatrix -lpoint_cloud -lboost_serialization -lboost_system -lboost_filesystem
+LIBS := -lpcl_io -lpcl_kdtree -lpcl_sample_consensus -lpcl_registration -lpcl_filters -lpcl_features -lpcl_common -lpcl_keypoints -lpcl_search -lpcl_visualization -lgazebo -lgazebo_msgs -lgazebo_transport -lgazebo_sensors -lgazebo_rendering -lgazebo_math -lgazebo_common -lopencv_highgui -lopencv_imgproc -lopencv_core -lopencv_video -lprotobuf -lOgreMain -lOIS -lfreetype -lpose_estimation_result -lpoint_type -lmatrix -lpoint_cloud -lboost_serialization -lboost_system -lboost_filesystem -lrt
 
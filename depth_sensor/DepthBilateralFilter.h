@@ -0,0 +1,394 @@
+/*
+ * DepthBilateralFilter.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef DEPTH_BILATERAL_FILTER_H_
+#define DEPTH_BILATERAL_FILTER_H_
+
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "WorkerPool.h"
+
+#if defined( __GNUC__ ) && ( defined( __x86_64__ ) || defined( __i386__ ) )
+#include <immintrin.h>
+#define DEPTH_BILATERAL_X86
+#endif
+
+using namespace std;
+
+// Bilateral filter of the z of an organized depth image, same bilateral grid as pcl::FastBilateralFilter :
+// every valid pixel is splatted ( z, 1 ) into a cell of sigma_s x sigma_s pixels & sigma_r of depth,
+// the grid is blurred with [ 1 2 1 ] / 4 twice along every axis, then sliced back with trilinear interpolation.
+// z is filtered in place, invalid pixels ( NaN z or set in the mask ) are neither splatted nor written.
+// ( z, weight ) pairs are interleaved & depth is the fastest axis of the grid, so every blur pass is a
+// contiguous row kernel ( SSE / AVX ) & slicing reads two adjacent depth cells with one load.
+// The grid keeps its capacity between frames, it only grows with the depth range of the scene.
+class DepthBilateralFilter
+{
+public:
+	// tiles are split over _pool if not NULL
+	DepthBilateralFilter(	int			_width,
+							int			_height,
+							float		_sigma_s,
+							float		_sigma_r,
+							WorkerPool	*_pool = NULL )
+		: m_width( _width ),
+		  m_height( _height ),
+		  m_sigma_s( _sigma_s ),
+		  m_sigma_r( _sigma_r ),
+		  m_pool( _pool ),
+		  m_use_avx( false ),
+		  m_depth_cells( 0 ),
+		  m_depth_stride( 0 )
+	{
+		m_grid_width = (int)( ( _width - 1 ) / _sigma_s ) + 1 + 2 * PADDING;
+		m_grid_height = (int)( ( _height - 1 ) / _sigma_s ) + 1 + 2 * PADDING;
+
+		// splat cell & slice position of every column and row
+		m_column_cell.resize( _width );
+		m_column_index.resize( _width );
+		m_column_alpha.resize( _width );
+		for( int x = 0; x < _width; x++ )
+		{
+			m_column_cell[x] = (int)( x / _sigma_s + 0.5f ) + PADDING;
+			float position = x / _sigma_s + PADDING;
+			m_column_index[x] = min( (int)position, m_grid_width - 2 );
+			m_column_alpha[x] = position - m_column_index[x];
+		}
+
+		m_row_index.resize( _height );
+		m_row_alpha.resize( _height );
+		m_cell_rows.assign( m_grid_height + 1, _height );
+		for( int y = _height - 1; y >= 0; y-- )
+		{
+			float position = y / _sigma_s + PADDING;
+			m_row_index[y] = min( (int)position, m_grid_height - 2 );
+			m_row_alpha[y] = position - m_row_index[y];
+
+			// rows are splatted into increasing grid rows, m_cell_rows[ gy ] is the first one of gy
+			int cell = (int)( y / _sigma_s + 0.5f ) + PADDING;
+			for( int gy = cell; gy >= 0 && m_cell_rows[ gy ] > y; gy-- )
+			{
+				m_cell_rows[ gy ] = y;
+			}
+		}
+
+		m_row_min.resize( _height );
+		m_row_max.resize( _height );
+
+#ifdef DEPTH_BILATERAL_X86
+		m_use_avx = __builtin_cpu_supports( "avx" );
+#endif
+	}
+	~DepthBilateralFilter()
+	{
+	}
+
+	// _z : z of pixel i at _z[ i * _stride ] ( 4 for the z of pcl::PointXYZ ), filtered in place
+	// _invalid : 1 byte per pixel, non zero pixels are skipped, NULL to skip NaN z only
+	void filter( float *_z, int _stride, const unsigned char *_invalid = NULL )
+	{
+		// ***************************** //
+		// depth range of valid pixels   //
+		// ***************************** //
+		_forEachTile( 0, m_height, [&]( int _y0, int _y1 )
+		{
+			for( int y = _y0; y < _y1; y++ )
+			{
+				float row_min = numeric_limits< float >::infinity();
+				float row_max = -numeric_limits< float >::infinity();
+				for( int idx = y * m_width; idx < ( y + 1 ) * m_width; idx++ )
+				{
+					float z = _z[ (size_t)idx * _stride ];
+					if( _isValid( z, _invalid, idx ) )
+					{
+						row_min = min( row_min, z );
+						row_max = max( row_max, z );
+					}
+				}
+				m_row_min[y] = row_min;
+				m_row_max[y] = row_max;
+			}
+		} );
+		float base_min = *min_element( m_row_min.begin(), m_row_min.end() );
+		float base_max = *max_element( m_row_max.begin(), m_row_max.end() );
+		if( !( base_min <= base_max ) )
+		{
+			// no valid pixel
+			return;
+		}
+
+		m_depth_cells = (int)( ( base_max - base_min ) / m_sigma_r ) + 1 + 2 * PADDING;
+		if( m_depth_cells > m_depth_stride )
+		{
+			// cells of the border stay zero from here on, only the inner cells are written
+			m_depth_stride = m_depth_cells;
+			size_t size = (size_t)m_grid_width * m_grid_height * m_depth_stride * 2;
+			m_grid.assign( size, 0.f );
+			m_buffer.assign( size, 0.f );
+		}
+
+		// ******************************************************** //
+		// splat, every task owns whole grid rows ( no two threads  //
+		// add to the same cell )                                   //
+		// ******************************************************** //
+		_forEachTile( 1, m_grid_height - 1, [&]( int _gy0, int _gy1 )
+		{
+			for( int gy = _gy0; gy < _gy1; gy++ )
+			{
+				for( int gx = 1; gx < m_grid_width - 1; gx++ )
+				{
+					memset( _cell( &m_grid[0], gx, gy, 0 ), 0, m_depth_cells * 2 * sizeof( float ) );
+				}
+
+				for( int y = m_cell_rows[ gy ]; y < m_cell_rows[ gy + 1 ]; y++ )
+				{
+					for( int x = 0; x < m_width; x++ )
+					{
+						int idx = x + y * m_width;
+						float z = _z[ (size_t)idx * _stride ];
+						if( !_isValid( z, _invalid, idx ) )
+						{
+							continue;
+						}
+						int gz = (int)( ( z - base_min ) / m_sigma_r + 0.5f ) + PADDING;
+						float *cell = _cell( &m_grid[0], m_column_cell[x], gy, gz );
+						cell[0] += z;
+						cell[1] += 1.f;
+					}
+				}
+			}
+		} );
+
+		// ************************************** //
+		// blur twice along depth, x & y          //
+		// ************************************** //
+		int offsets[3] = { 2, 2 * m_depth_stride, 2 * m_depth_stride * m_grid_width };
+		for( int axis = 0; axis < 3; axis++ )
+		{
+			for( int iteration = 0; iteration < 2; iteration++ )
+			{
+				m_grid.swap( m_buffer );
+				_blurPass( &m_buffer[0], &m_grid[0], axis, offsets[ axis ] );
+			}
+		}
+
+		// ***************************************** //
+		// slice, trilinear interpolation of z / w   //
+		// ***************************************** //
+		_forEachTile( 0, m_height, [&]( int _y0, int _y1 )
+		{
+			for( int y = _y0; y < _y1; y++ )
+			{
+				int gy = m_row_index[y];
+				float ay = m_row_alpha[y];
+				for( int x = 0; x < m_width; x++ )
+				{
+					int idx = x + y * m_width;
+					float &z = _z[ (size_t)idx * _stride ];
+					if( !_isValid( z, _invalid, idx ) )
+					{
+						continue;
+					}
+					float position = ( z - base_min ) / m_sigma_r + PADDING;
+					int gz = min( (int)position, m_depth_cells - 2 );
+					z = _slice( m_column_index[x], gy, gz, m_column_alpha[x], ay, position - gz );
+				}
+			}
+		} );
+	}
+
+	// cells of the grid in the last filter(), for benchmarks
+	size_t getGridCells() const
+	{
+		return (size_t)m_grid_width * m_grid_height * m_depth_cells;
+	}
+
+private:
+	static bool _isValid( float _z, const unsigned char *_invalid, int _idx )
+	{
+		return _z == _z && ( !_invalid || !_invalid[ _idx ] );
+	}
+
+	// ( z, weight ) of cell ( _gx, _gy, _gz )
+	float *_cell( float *_grid, int _gx, int _gy, int _gz ) const
+	{
+		return _grid + ( ( (size_t)_gy * m_grid_width + _gx ) * m_depth_stride + _gz ) * 2;
+	}
+
+	// _out = ( _in[ -offset ] + 2 _in + _in[ +offset ] ) / 4 for the inner cells along _axis ( 0 depth, 1 x, 2 y )
+	void _blurPass( const float *_in, float *_out, int _axis, int _offset )
+	{
+		_forEachTile( 1, m_grid_height - 1, [&]( int _gy0, int _gy1 )
+		{
+			for( int gy = _gy0; gy < _gy1; gy++ )
+			{
+				for( int gx = 1; gx < m_grid_width - 1; gx++ )
+				{
+					const float *in = _cell( (float*)_in, gx, gy, 0 );
+					float *out = _cell( _out, gx, gy, 0 );
+					if( _axis == 0 )
+					{
+						// first & last depth cell are the border
+						_rowKernel( in + 2, out + 2, ( m_depth_cells - 2 ) * 2, _offset );
+						out[0] = out[1] = 0.f;
+						out[ ( m_depth_cells - 1 ) * 2 ] = out[ ( m_depth_cells - 1 ) * 2 + 1 ] = 0.f;
+					}
+					else
+					{
+						_rowKernel( in, out, m_depth_cells * 2, _offset );
+					}
+				}
+			}
+		} );
+	}
+
+	void _rowKernel( const float *_in, float *_out, int _count, int _offset )
+	{
+		int i = 0;
+#ifdef DEPTH_BILATERAL_X86
+		if( m_use_avx )
+		{
+			i = _rowKernelAVX( _in, _out, _count, _offset );
+		}
+		else
+		{
+			i = _rowKernelSSE( _in, _out, _count, _offset );
+		}
+#endif
+		for( ; i < _count; i++ )
+		{
+			_out[i] = ( _in[ i - _offset ] + _in[ i + _offset ] + 2.f * _in[i] ) * 0.25f;
+		}
+	}
+
+#ifdef DEPTH_BILATERAL_X86
+	// return number of floats processed
+	int _rowKernelSSE( const float *_in, float *_out, int _count, int _offset )
+	{
+		__m128 two = _mm_set1_ps( 2.f );
+		__m128 quarter = _mm_set1_ps( 0.25f );
+
+		int i = 0;
+		for( ; i + 4 <= _count; i += 4 )
+		{
+			__m128 sum = _mm_add_ps( _mm_loadu_ps( _in + i - _offset ), _mm_loadu_ps( _in + i + _offset ) );
+			sum = _mm_add_ps( sum, _mm_mul_ps( two, _mm_loadu_ps( _in + i ) ) );
+			_mm_storeu_ps( _out + i, _mm_mul_ps( sum, quarter ) );
+		}
+		return i;
+	}
+
+	__attribute__(( target( "avx" ) ))
+	int _rowKernelAVX( const float *_in, float *_out, int _count, int _offset )
+	{
+		__m256 two = _mm256_set1_ps( 2.f );
+		__m256 quarter = _mm256_set1_ps( 0.25f );
+
+		int i = 0;
+		for( ; i + 8 <= _count; i += 8 )
+		{
+			__m256 sum = _mm256_add_ps( _mm256_loadu_ps( _in + i - _offset ), _mm256_loadu_ps( _in + i + _offset ) );
+			sum = _mm256_add_ps( sum, _mm256_mul_ps( two, _mm256_loadu_ps( _in + i ) ) );
+			_mm256_storeu_ps( _out + i, _mm256_mul_ps( sum, quarter ) );
+		}
+		return i;
+	}
+#endif
+
+	// z / weight at ( _gx + _ax, _gy + _ay, _gz + _az )
+	float _slice( int _gx, int _gy, int _gz, float _ax, float _ay, float _az ) const
+	{
+		const float *grid = &m_grid[0];
+		const float *c00 = _cell( (float*)grid, _gx, _gy, _gz );
+		const float *c10 = _cell( (float*)grid, _gx + 1, _gy, _gz );
+		const float *c01 = _cell( (float*)grid, _gx, _gy + 1, _gz );
+		const float *c11 = _cell( (float*)grid, _gx + 1, _gy + 1, _gz );
+		float w00 = ( 1.f - _ax ) * ( 1.f - _ay );
+		float w10 = _ax * ( 1.f - _ay );
+		float w01 = ( 1.f - _ax ) * _ay;
+		float w11 = _ax * _ay;
+
+#ifdef DEPTH_BILATERAL_X86
+		// z & weight of depth cell _gz & _gz + 1 in one register
+		__m128 sum = _mm_mul_ps( _mm_set1_ps( w00 ), _mm_loadu_ps( c00 ) );
+		sum = _mm_add_ps( sum, _mm_mul_ps( _mm_set1_ps( w10 ), _mm_loadu_ps( c10 ) ) );
+		sum = _mm_add_ps( sum, _mm_mul_ps( _mm_set1_ps( w01 ), _mm_loadu_ps( c01 ) ) );
+		sum = _mm_add_ps( sum, _mm_mul_ps( _mm_set1_ps( w11 ), _mm_loadu_ps( c11 ) ) );
+		float values[4];
+		_mm_storeu_ps( values, sum );
+#else
+		float values[4];
+		for( int k = 0; k < 4; k++ )
+		{
+			values[k] = w00 * c00[k] + w10 * c10[k] + w01 * c01[k] + w11 * c11[k];
+		}
+#endif
+		float z = ( 1.f - _az ) * values[0] + _az * values[2];
+		float weight = ( 1.f - _az ) * values[1] + _az * values[3];
+		return z / weight;
+	}
+
+	// call _func( first, last + 1 ) for every tile of [ _begin, _end )
+	template< typename Func >
+	void _forEachTile( int _begin, int _end, const Func &_func )
+	{
+		if( m_pool )
+		{
+			m_pool->parallelFor( _begin, _end, TILE_ROWS, _func );
+			return;
+		}
+
+		for( int y0 = _begin; y0 < _end; y0 += TILE_ROWS )
+		{
+			_func( y0, min( y0 + TILE_ROWS, _end ) );
+		}
+	}
+
+public:
+
+private:
+	// empty cells around the splatted ones, as pcl
+	static const int PADDING = 2;
+	static const int TILE_ROWS = 8;
+
+	// image resolution
+	int m_width;
+	int m_height;
+	// cell size in pixels & in depth
+	float m_sigma_s;
+	float m_sigma_r;
+	// split tiles over threads ( NULL for single thread )
+	WorkerPool *m_pool;
+	bool m_use_avx;
+
+	// grid size, m_depth_cells follows the depth range of the frame
+	int m_grid_width;
+	int m_grid_height;
+	int m_depth_cells;
+	// allocated depth cells of every ( x, y ), >= m_depth_cells
+	int m_depth_stride;
+	// ( z, weight ) of every cell, blurred back & forth with m_buffer
+	vector< float > m_grid;
+	vector< float > m_buffer;
+
+	// grid column of every image column when splatting, cell & weight of the next cell when slicing
+	vector< int > m_column_cell;
+	vector< int > m_column_index;
+	vector< float > m_column_alpha;
+	vector< int > m_row_index;
+	vector< float > m_row_alpha;
+	// first image row splatted into every grid row ( m_height past the last )
+	vector< int > m_cell_rows;
+	// depth range of every image row
+	vector< float > m_row_min;
+	vector< float > m_row_max;
+};
+
+#endif /* DEPTH_BILATERAL_FILTER_H_ */
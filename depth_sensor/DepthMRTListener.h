@@ -0,0 +1,148 @@
+/*
+ * DepthMRTListener.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <Ogre.h>
+
+#include <gazebo/rendering/rendering.hh>
+
+#include "EntityProxyCache.h"
+#include "CaptureStateGuard.h"
+
+using namespace gazebo;
+using namespace std;
+
+// Renders depth, rayconf & segmentation label in one geometry pass.
+// The MultiRenderTarget binds the depth and rayconf textures, so the IR projector's shadow map is only rendered once.
+class DepthMRTListener: public Ogre::RenderTargetListener
+{
+public:
+	DepthMRTListener(	EntityProxyCache		*_entity_cache,
+						Ogre::TexturePtr		_depth_texture,
+						Ogre::TexturePtr		_rayconf_texture,
+						float					*_depth_buffer,
+						float					*_rayconf_buffer,
+						unsigned char			*_segment_buffer,
+						CaptureStateGuard		*_capture_state,
+						SegmentEncoding			_encoding = SEGMENT_ENCODING_GREY )
+		: m_entity_cache( _entity_cache ),
+		  m_depth_texture( _depth_texture ),
+		  m_rayconf_texture( _rayconf_texture ),
+		  m_depth_buffer( _depth_buffer ),
+		  m_rayconf_buffer( _rayconf_buffer ),
+		  m_segment_buffer( _segment_buffer ),
+		  m_capture_state( _capture_state ),
+		  m_encoding( _encoding ),
+		  m_label_version( (unsigned long)-1 )
+	{
+	}
+	~DepthMRTListener()
+	{
+	}
+
+	void preRenderTargetUpdate( const Ogre::RenderTargetEvent& evt )
+	{
+		// shadow & light settings for depth shadow map, restored when the capture ends
+		m_capture_state->apply( CaptureStateGuard::PROFILE_DEPTH );
+
+		// same labels as SegmentRTListener, ( i + 1 ) / number of models, only set again when the models change
+		if( m_entity_cache->getVersion() != m_label_version )
+		{
+			m_entity_cache->setModelLabels( EntityProxyCache::PASS_MRT, m_encoding == SEGMENT_ENCODING_ID );
+			m_label_version = m_entity_cache->getVersion();
+		}
+
+		// show MRT proxies instead of all objects
+		m_entity_cache->showProxies( EntityProxyCache::PASS_MRT );
+	}
+
+	void postRenderTargetUpdate( const Ogre::RenderTargetEvent& evt )
+	{
+		_textureToPixmap();
+
+		// hide proxies and show original visuals
+		m_entity_cache->hideProxies();
+	}
+
+	// frame buffers of the next update, _segment_buffer is ignored if segmentation is not used
+	void setBuffers( float *_depth_buffer, float *_rayconf_buffer, unsigned char *_segment_buffer )
+	{
+		m_depth_buffer = _depth_buffer;
+		m_rayconf_buffer = _rayconf_buffer;
+		if( m_segment_buffer )
+		{
+			m_segment_buffer = _segment_buffer;
+		}
+	}
+
+private:
+	void _textureToPixmap()
+	{
+		// *********************************************************** //
+		// MultiRenderTarget can't be copied, read every bound texture //
+		// *********************************************************** //
+		unsigned int width = m_depth_texture->getWidth();
+		unsigned int height = m_depth_texture->getHeight();
+
+		Ogre::PixelBox depth_box(	width,
+									height,
+									1,
+									Ogre::PF_FLOAT32_RGBA,
+									m_depth_buffer );
+		m_depth_texture->getBuffer()->blitToMemory( depth_box );
+
+		Ogre::PixelBox rayconf_box(	width,
+									height,
+									1,
+									Ogre::PF_FLOAT32_RGBA,
+									m_rayconf_buffer );
+		m_rayconf_texture->getBuffer()->blitToMemory( rayconf_box );
+
+		// ************************************************* //
+		// decode label, same value as the segment texture   //
+		// ************************************************* //
+		if( m_segment_buffer && m_encoding == SEGMENT_ENCODING_GREY )
+		{
+			for( unsigned int i = 0; i < width * height; i++ )
+			{
+				// green channel of depth keeps ( 1 - label ), background is white
+				m_segment_buffer[i] = (unsigned char)( ( 1.0f - m_depth_buffer[ 4 * i + 1 ] ) * 255 + 0.5f );
+			}
+		}
+		else if( m_segment_buffer )
+		{
+			uint32_t *ids = (uint32_t*)m_segment_buffer;
+			for( unsigned int i = 0; i < width * height; i++ )
+			{
+				// green & blue keep ( 1 - instance id ) & ( 1 - class id ), exact in float
+				uint32_t instance_id = (uint32_t)( 1.0f - m_depth_buffer[ 4 * i + 1 ] + 0.5f );
+				uint32_t class_id = (uint32_t)( 1.0f - m_depth_buffer[ 4 * i + 2 ] + 0.5f );
+				ids[i] = class_id << 24 | instance_id;
+			}
+		}
+	}
+
+public:
+
+private:
+	// proxies of every model entity, shared with other listeners
+	EntityProxyCache *m_entity_cache;
+	// texture bound to surface 0 of MultiRenderTarget ( depth, 1 - label )
+	Ogre::TexturePtr m_depth_texture;
+	// texture bound to surface 1 of MultiRenderTarget ( ray, confidence )
+	Ogre::TexturePtr m_rayconf_texture;
+	// depth frame buffer, same layout as DepthRTListener's
+	float *m_depth_buffer;
+	// rayconf frame buffer, same layout as RayConfRTListener's
+	float *m_rayconf_buffer;
+	// segment frame buffer, same layout as SegmentRTListener's ( NULL if segmentation is not used )
+	unsigned char *m_segment_buffer;
+	// shadow & light settings of the capture, shared with other listeners
+	CaptureStateGuard *m_capture_state;
+	// grey levels or ids, same as SegmentRTListener
+	SegmentEncoding m_encoding;
+	// EntityProxyCache::getVersion() when the labels were set
+	unsigned long m_label_version;
+};
@@ -0,0 +1,44 @@
+/*
+ * DepthMask.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef DEPTH_MASK_H_
+#define DEPTH_MASK_H_
+
+// Depth / flags buffer of the masking pass, one float per pixel, written by DepthMaskPass on the gpu
+// & checked against DepthPostProcessKernel::maskFlags() on the cpu.
+// A pixel with flags is never a point, so it stores -flags & only a pixel without flags stores its normalized depth.
+class DepthMask
+{
+public:
+	// bits of the flags
+	enum Flag
+	{
+		MASK_INVALID = 1,		// depth out of range or intensity saturation
+		MASK_REJECTED = 2		// confidence below threshold or no point
+	};
+
+public:
+	// normalized _depth is out of range, the rule of DepthShadowmap_Mask.frag too ( depth * 255.0 >= 255.0 ),
+	// compared as float so depth above 1 never goes through an 8 bit cast
+	static bool outOfRange( float _depth )
+	{
+		return _depth * 255.f >= 255.f;
+	}
+
+	// flags of pixel _idx in a mask buffer
+	static int flags( const float *_mask, int _idx )
+	{
+		return _mask[ _idx ] < 0 ? (int)-_mask[ _idx ] : 0;
+	}
+
+	// normalized depth of pixel _idx in a mask buffer, only if it has no flags
+	static float depth( const float *_mask, int _idx )
+	{
+		return _mask[ _idx ];
+	}
+};
+
+#endif /* DEPTH_MASK_H_ */
@@ -0,0 +1,171 @@
+/*
+ * DepthMaskPass.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef DEPTH_MASK_PASS_H_
+#define DEPTH_MASK_PASS_H_
+
+#include <string>
+
+#include <OGRE/Ogre.h>
+
+#include "RenderTargetLayout.h"
+#include "DepthMask.h"
+
+using namespace std;
+
+// Masking pass of <mask_pass> gpu, runs after the depth, rayconf & rgb passes of a capture.
+// A fullscreen quad in a private scene manager samples the three render targets & two perlin noise textures,
+// DepthShadowmap_Mask.frag applies the saturation & confidence rules of DepthPostProcessKernel::maskFlags() per pixel,
+// and only its PF_FLOAT32_R render target is read back instead of the depth & rayconf buffers.
+// Flags are DepthMask::MASK_INVALID ( before the occlusion edge is disturbed ) & DepthMask::MASK_REJECTED,
+// the buffer is read with DepthMask::flags() & DepthMask::depth().
+// The private scene has no lights, shadows or compositors, so the pass costs one quad & one readback.
+class DepthMaskPass : public Ogre::RenderTargetListener
+{
+public:
+	// textures are the sensor's render targets, _layout tells where the confidence is
+	DepthMaskPass(	const string				&_camera_name,
+					Ogre::TexturePtr			_depth_texture,
+					Ogre::TexturePtr			_rayconf_texture,
+					Ogre::TexturePtr			_rgb_texture,
+					const RenderTargetLayout	&_layout,
+					float						*_mask_buffer )
+		: m_mask_buffer( _mask_buffer ),
+		  m_width( _depth_texture->getWidth() ),
+		  m_height( _depth_texture->getHeight() )
+	{
+		// ************************************ //
+		// private scene with a fullscreen quad //
+		// ************************************ //
+		m_scene_mgr = Ogre::Root::getSingleton().createSceneManager( Ogre::ST_GENERIC, "DepthMaskPass_" + _camera_name );
+		m_camera = m_scene_mgr->createCamera( "DepthMaskPass_Camera_" + _camera_name );
+
+		m_quad = new Ogre::Rectangle2D( true );
+		m_quad->setCorners( -1, 1, 1, -1 );
+		m_quad->setBoundingBox( Ogre::AxisAlignedBox::BOX_INFINITE );
+		m_scene_mgr->getRootSceneNode()->attachObject( m_quad );
+
+		// ************************************ //
+		// perlin noise, uploaded every capture //
+		// ************************************ //
+		m_noise_40_texture = _createTexture( "RttTex_MASK_NOISE40_" + _camera_name, Ogre::PF_FLOAT32_R, Ogre::TU_DYNAMIC_WRITE_ONLY );
+		m_conf_noise_texture = _createTexture( "RttTex_MASK_CONFNOISE_" + _camera_name, Ogre::PF_FLOAT32_R, Ogre::TU_DYNAMIC_WRITE_ONLY );
+
+		// ************************************* //
+		// material sampling every render target //
+		// ************************************* //
+		m_material = Ogre::MaterialManager::getSingleton().getByName( "Ogre/DepthShadowmap_Mask/BasicTemplateMaterial" )->clone( "DepthMaskPass_Material_" + _camera_name );
+		Ogre::Pass *pass = m_material->getTechnique( 0 )->getPass( 0 );
+		pass->getTextureUnitState( "depth" )->setTextureName( _depth_texture->getName() );
+		pass->getTextureUnitState( "rayconf" )->setTextureName( _rayconf_texture->getName() );
+		pass->getTextureUnitState( "rgb" )->setTextureName( _rgb_texture->getName() );
+		pass->getTextureUnitState( "noise_40" )->setTextureName( m_noise_40_texture->getName() );
+		pass->getTextureUnitState( "conf_noise" )->setTextureName( m_conf_noise_texture->getName() );
+		pass->getFragmentProgramParameters()->setNamedConstant( "confChannel", _layout.reconstructsXYZ() ? 0.f : 1.f );
+		m_material->load();
+		m_quad->setMaterial( m_material->getName() );
+
+		// ******************** //
+		// depth / flags target //
+		// ******************** //
+		m_mask_texture = _createTexture( "RttTex_MASK_" + _camera_name, Ogre::PF_FLOAT32_R, Ogre::TU_RENDERTARGET );
+		m_render_texture = m_mask_texture->getBuffer()->getRenderTarget();
+		m_render_texture->setAutoUpdated( false );
+		m_render_texture->addViewport( m_camera );
+		m_render_texture->getViewport( 0 )->setClearEveryFrame( true );
+		// background decodes as out of range & rejected
+		m_render_texture->getViewport( 0 )->setBackgroundColour( Ogre::ColourValue( -( DepthMask::MASK_INVALID | DepthMask::MASK_REJECTED ), 0, 0, 1 ) );
+		m_render_texture->getViewport( 0 )->setOverlaysEnabled( false );
+		m_render_texture->getViewport( 0 )->setShadowsEnabled( false );
+		m_render_texture->addListener( this );
+	}
+	~DepthMaskPass()
+	{
+		m_render_texture->removeAllListeners();
+		m_scene_mgr->getRootSceneNode()->detachObject( m_quad );
+		delete m_quad;
+		Ogre::Root::getSingleton().destroySceneManager( m_scene_mgr );
+
+		Ogre::MaterialManager::getSingleton().remove( m_material->getHandle() );
+		Ogre::TextureManager::getSingleton().remove( m_mask_texture->getHandle() );
+		Ogre::TextureManager::getSingleton().remove( m_noise_40_texture->getHandle() );
+		Ogre::TextureManager::getSingleton().remove( m_conf_noise_texture->getHandle() );
+	}
+
+	// perlin noise of the next update, W * H floats each
+	void setNoise( const float *_noise_40, const float *_conf_noise )
+	{
+		_upload( m_noise_40_texture, _noise_40 );
+		_upload( m_conf_noise_texture, _conf_noise );
+	}
+
+	// render the quad & read depth / flags back, after the depth, rayconf & rgb render targets are updated
+	void update()
+	{
+		m_render_texture->update( true );
+	}
+
+	void postRenderTargetUpdate( const Ogre::RenderTargetEvent& evt )
+	{
+		Ogre::PixelBox pixelBox(	m_width,
+									m_height,
+									1,
+									Ogre::PF_FLOAT32_R,
+									m_mask_buffer );
+
+		m_render_texture->copyContentsToMemory( pixelBox, Ogre::RenderTarget::FB_AUTO );
+	}
+
+	// frame buffer of the next update, W * H floats
+	void setBuffer( float *_mask_buffer )
+	{
+		m_mask_buffer = _mask_buffer;
+	}
+
+private:
+	Ogre::TexturePtr _createTexture( const string &_name, Ogre::PixelFormat _format, int _usage )
+	{
+		return Ogre::TextureManager::getSingleton().createManual(	_name,
+																	Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME,
+																	Ogre::TEX_TYPE_2D,
+																	m_width,
+																	m_height,
+																	0,
+																	_format,
+																	_usage );
+	}
+
+	void _upload( Ogre::TexturePtr _texture, const float *_noise )
+	{
+		Ogre::PixelBox pixelBox( m_width, m_height, 1, Ogre::PF_FLOAT32_R, (void*)_noise );
+		_texture->getBuffer()->blitFromMemory( pixelBox );
+	}
+
+public:
+
+private:
+	// this buffer that contain depth / flags of the render texture
+	float *m_mask_buffer;
+	// image resolution
+	unsigned int m_width;
+	unsigned int m_height;
+
+	// private scene manager & camera, the quad ignores the camera ( identity projection )
+	Ogre::SceneManager *m_scene_mgr;
+	Ogre::Camera *m_camera;
+	Ogre::Rectangle2D *m_quad;
+	// clone of the template material, bound to the render targets of this sensor
+	Ogre::MaterialPtr m_material;
+
+	// perlin noise textures, PF_FLOAT32_R
+	Ogre::TexturePtr m_noise_40_texture;
+	Ogre::TexturePtr m_conf_noise_texture;
+	// depth / flags texture, PF_FLOAT32_R
+	Ogre::TexturePtr m_mask_texture;
+	Ogre::RenderTexture *m_render_texture;
+};
+
+#endif /* DEPTH_MASK_PASS_H_ */
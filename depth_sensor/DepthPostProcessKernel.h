@@ -0,0 +1,242 @@
+/*
+ * DepthPostProcessKernel.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef DEPTH_POST_PROCESS_KERNEL_H_
+#define DEPTH_POST_PROCESS_KERNEL_H_
+
+#include <math.h>
+#include <limits>
+#include <vector>
+
+#include <pcl/point_types.h>
+#include <pcl/common/point_tests.h>
+
+#include "WorkerPool.h"
+#include "RenderTargetLayout.h"
+#include "DepthMask.h"
+
+using namespace std;
+
+// Fused per pixel steps of DepthSensorPlugin::_saveSensorData(), processed tile by tile ( a few rows at a time ).
+// Invalid pixels are kept in a one byte mask instead of 255 in three channels of an 8 bit depth image.
+// Every decision and every float operation is the same as the step by step implementation, so results are bit-exact.
+class DepthPostProcessKernel
+{
+public:
+	// tiles are split over _pool if not NULL, buffers are read with _layout ( full RGBA float buffers if NULL )
+	DepthPostProcessKernel(	int							_width,
+							int							_height,
+							WorkerPool					*_pool = NULL,
+							const RenderTargetLayout	*_layout = NULL )
+		: m_width( _width ),
+		  m_height( _height ),
+		  m_pool( _pool ),
+		  m_layout( _layout ? _layout : &m_default_layout )
+	{
+		// cos of confidence threshold for every 0.01 degree in [ 0, 180 ]
+		m_cos_lut.resize( COS_LUT_SIZE + 1 );
+		for( int i = 0; i <= COS_LUT_SIZE; i++ )
+		{
+			m_cos_lut[i] = cos( (double)i / COS_LUT_STEPS_PER_DEGREE * M_PI / 180 );
+		}
+	}
+	~DepthPostProcessKernel()
+	{
+	}
+
+	// ***************************************************** //
+	// depth out of range & intensity saturation -> _invalid //
+	// ***************************************************** //
+	// _depth : depth buffer of the layout, _rgb : PF_BYTE_RGB specular buffer, _noise_40 : perlin noise of grid 40
+	void invalidMask(	const float			*_depth,
+						const unsigned char	*_rgb,
+						const float			*_noise_40,
+						unsigned char		*_invalid )
+	{
+		_forEachTile( [&]( int _y0, int _y1 )
+		{
+			for( int idx = _y0 * m_width; idx < _y1 * m_width; idx++ )
+			{
+				float thres = 180 + _noise_40[ idx ] * 10;
+				thres = thres > 0 ? thres : 1;
+
+				_invalid[ idx ] = DepthMask::outOfRange( m_layout->depth( _depth, idx ) ) || _rgb[ 3 * idx ] > thres;
+			}
+		} );
+	}
+
+	// ************************************************************** //
+	// confidence threshold, point cloud in millimeter & sensor noise //
+	// ************************************************************** //
+	// _depth & _rayconf : buffers of the layout ( xyz is reconstructed from _depth if _rayconf is confidence only ),
+	// _invalid : mask after disturbing occlusion edge,
+	// _conf_noise : perlin noise added to confidence threshold, _sensor_noise : noise added to z, _points : organized cloud
+	void extractCloud(	const float			*_depth,
+						const float			*_rayconf,
+						const unsigned char	*_invalid,
+						const float			*_conf_noise,
+						const float			*_sensor_noise,
+						pcl::PointXYZ		*_points )
+	{
+		const float nan = std::numeric_limits<float>::quiet_NaN();
+
+		_forEachTile( [&]( int _y0, int _y1 )
+		{
+			for( int idx = _y0 * m_width; idx < _y1 * m_width; idx++ )
+			{
+				// disturb confidence threshold with pelin noise
+				float conf_thres = 75.f + _conf_noise[ idx ];
+
+				// check validatioin of data, in depth range & confidence != 0
+				if(	!_invalid[ idx ] &&
+					!isBelowCos( m_layout->confidence( _rayconf, idx ), conf_thres ) &&
+					m_layout->hasPoint( _depth, _rayconf, idx ) )
+				{
+					float xyz[3];
+					m_layout->point( _depth, _rayconf, idx, xyz );
+					_points[ idx ].x = xyz[0] * 1000;
+					_points[ idx ].y = xyz[1] * 1000;
+					_points[ idx ].z = xyz[2] * 1000;
+
+					// add sensor noise
+					if( pcl::isFinite( _points[ idx ] ) )
+					{
+						_points[ idx ].z += _sensor_noise[ idx ] * 3;
+					}
+				}
+				else
+				{
+					_points[ idx ].x = nan;
+					_points[ idx ].y = nan;
+					_points[ idx ].z = nan;
+				}
+			}
+		} );
+	}
+
+	// ******************************************************* //
+	// flags of the masking pass, DepthMask::Flag per byte //
+	// ******************************************************* //
+	// same rules as invalidMask() & the confidence threshold of extractCloud(), what DepthShadowmap_Mask.frag computes
+	void maskFlags(	const float			*_depth,
+					const float			*_rayconf,
+					const unsigned char	*_rgb,
+					const float			*_noise_40,
+					const float			*_conf_noise,
+					unsigned char		*_flags )
+	{
+		_forEachTile( [&]( int _y0, int _y1 )
+		{
+			for( int idx = _y0 * m_width; idx < _y1 * m_width; idx++ )
+			{
+				float thres = 180 + _noise_40[ idx ] * 10;
+				thres = thres > 0 ? thres : 1;
+
+				bool invalid = DepthMask::outOfRange( m_layout->depth( _depth, idx ) ) || _rgb[ 3 * idx ] > thres;
+				bool rejected =	!m_layout->hasPoint( _depth, _rayconf, idx ) ||
+								isBelowCos( m_layout->confidence( _rayconf, idx ), 75.f + _conf_noise[ idx ] );
+
+				_flags[ idx ] = ( invalid ? DepthMask::MASK_INVALID : 0 ) | ( rejected ? DepthMask::MASK_REJECTED : 0 );
+			}
+		} );
+	}
+
+	// *********************************************************** //
+	// point cloud in millimeter & sensor noise from the mask pass //
+	// *********************************************************** //
+	// _mask : depth / flags buffer of DepthMaskPass, _invalid : its MASK_INVALID after disturbing occlusion edge,
+	// xyz is reconstructed from depth on the rays of pixel centers
+	void extractMaskedCloud(	const float			*_mask,
+								const unsigned char	*_invalid,
+								const float			*_sensor_noise,
+								pcl::PointXYZ		*_points )
+	{
+		const float nan = std::numeric_limits<float>::quiet_NaN();
+
+		_forEachTile( [&]( int _y0, int _y1 )
+		{
+			for( int idx = _y0 * m_width; idx < _y1 * m_width; idx++ )
+			{
+				if( !_invalid[ idx ] && DepthMask::flags( _mask, idx ) == 0 )
+				{
+					float xyz[3];
+					m_layout->pointFromDepth( DepthMask::depth( _mask, idx ), idx, xyz );
+					_points[ idx ].x = xyz[0] * 1000;
+					_points[ idx ].y = xyz[1] * 1000;
+					_points[ idx ].z = xyz[2] * 1000 + _sensor_noise[ idx ] * 3;
+				}
+				else
+				{
+					_points[ idx ].x = nan;
+					_points[ idx ].y = nan;
+					_points[ idx ].z = nan;
+				}
+			}
+		} );
+	}
+
+	// same as _value < cos( _degree * M_PI / 180.f ), cos is only evaluated when the lookup table is too close to tell
+	bool isBelowCos( float _value, float _degree ) const
+	{
+		double pos = (double)_degree * COS_LUT_STEPS_PER_DEGREE;
+		if( pos >= 0 && pos < COS_LUT_SIZE )
+		{
+			int i = (int)pos;
+			double t = pos - i;
+			double approx = m_cos_lut[i] + ( m_cos_lut[ i + 1 ] - m_cos_lut[i] ) * t;
+
+			// linear interpolation error is below ( step in radian )^2 / 8 ~ 4e-9
+			if( _value < approx - COS_LUT_MARGIN )
+			{
+				return true;
+			}
+			if( _value > approx + COS_LUT_MARGIN )
+			{
+				return false;
+			}
+		}
+		return _value < cos( _degree * M_PI / 180.f );
+	}
+
+private:
+	// call _func( first row, last row + 1 ) for every tile
+	template< typename Func >
+	void _forEachTile( const Func &_func )
+	{
+		if( m_pool )
+		{
+			m_pool->parallelFor( 0, m_height, TILE_ROWS, _func );
+			return;
+		}
+
+		for( int y0 = 0; y0 < m_height; y0 += TILE_ROWS )
+		{
+			_func( y0, min( y0 + TILE_ROWS, m_height ) );
+		}
+	}
+
+public:
+
+private:
+	static const int TILE_ROWS = 16;
+	static const int COS_LUT_STEPS_PER_DEGREE = 100;
+	static const int COS_LUT_SIZE = 180 * COS_LUT_STEPS_PER_DEGREE;
+	static constexpr double COS_LUT_MARGIN = 1e-6;
+
+	// image resolution
+	int m_width;
+	int m_height;
+	// split tiles over threads ( NULL for single thread )
+	WorkerPool *m_pool;
+	// how depth & rayconf buffers are read
+	const RenderTargetLayout *m_layout;
+	// full RGBA float buffers, used without a layout
+	RenderTargetLayout m_default_layout;
+	// cos of every 1 / COS_LUT_STEPS_PER_DEGREE degree
+	vector< double > m_cos_lut;
+};
+
+#endif /* DEPTH_POST_PROCESS_KERNEL_H_ */
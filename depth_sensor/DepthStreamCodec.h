@@ -0,0 +1,583 @@
+/*
+ * DepthStreamCodec.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef DEPTH_STREAM_CODEC_H_
+#define DEPTH_STREAM_CODEC_H_
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Compressed organized depth stream, instead of float x, y, z of every pixel :
+//   depth d = -z is quantized to uint16 with a per frame step ( 0 for NaN ),
+//   labels are split into a low 16 bit plane and, for 4 byte labels, a high 16 bit plane ( class byte of segment ids ),
+//   each plane is predicted from the left pixel ( the pixel above for the first column ),
+//   residuals are coded with adaptive Golomb-Rice codes and runs of equal pixels ( NaN regions, label areas ) with run lengths.
+// The receiver rebuilds x & y from the camera intrinsics :
+//   x = ( u - cx ) * d / fx, y = -( v - cy ) * d / fy, z = -d, for pixel u ( column ), v ( row ).
+// Stream : DepthStreamCodec::Header, depth_bytes of depth plane, label_bytes of low label plane,
+//          label_high_bytes of high label plane, all little endian.
+class DepthStreamCodec
+{
+public:
+	struct Intrinsics
+	{
+		float fx;
+		float fy;
+		float cx;
+		float cy;
+	};
+
+	struct Header
+	{
+		uint32_t magic;
+		uint16_t version;
+		uint16_t flags;
+		uint32_t width;
+		uint32_t height;
+		// millimeter per quantization step
+		float depth_step;
+		Intrinsics intrinsics;
+		uint32_t depth_bytes;
+		uint32_t label_bytes;
+		uint32_t label_high_bytes;
+	};
+
+	static const uint32_t MAGIC = 0x5a445a47;	// "GZDZ"
+	static const uint16_t VERSION = 2;
+	static const uint16_t FLAG_LABEL = 1;
+	// labels have a high 16 bit plane
+	static const uint16_t FLAG_LABEL_HIGH = 2;
+
+public:
+	// _min_depth_step : finest quantization step in millimeter, coarser if the farthest point doesn't fit in 16 bits
+	DepthStreamCodec(	int					_width,
+						int					_height,
+						const Intrinsics	&_intrinsics,
+						float				_min_depth_step = 0.1f )
+		: m_width( _width ),
+		  m_height( _height ),
+		  m_intrinsics( _intrinsics ),
+		  m_min_depth_step( _min_depth_step ),
+		  m_depth( _width * _height ),
+		  m_label_low( _width * _height ),
+		  m_label_high( _width * _height ),
+		  m_label( _width * _height )
+	{
+		memset( &m_header, 0, sizeof( m_header ) );
+	}
+	~DepthStreamCodec()
+	{
+	}
+
+	const Intrinsics &getIntrinsics() const
+	{
+		return m_intrinsics;
+	}
+
+	float getMinDepthStep() const
+	{
+		return m_min_depth_step;
+	}
+
+	// ****** //
+	// encode //
+	// ****** //
+	// _points : organized cloud in millimeter, float x, y, z at the start of every _point_step bytes
+	// _labels : one label every _label_step bytes, NULL for no label
+	// _label_bytes : 1, 2 or 4 bytes little endian labels, all 32 bits of 4 byte labels are kept
+	void encode(	const void			*_points,
+					int					_point_step,
+					const unsigned char	*_labels,
+					int					_label_step,
+					string				&_stream,
+					int					_label_bytes = 1 )
+	{
+		int size = m_width * m_height;
+
+		// farthest valid point sets the step
+		float max_depth = 0;
+		for( int i = 0; i < size; i++ )
+		{
+			float depth = -_pointZ( _points, _point_step, i );
+			if( depth > max_depth && depth < numeric_limits< float >::infinity() )
+			{
+				max_depth = depth;
+			}
+		}
+		float depth_step = max( m_min_depth_step, max_depth / 65535 );
+
+		for( int i = 0; i < size; i++ )
+		{
+			float depth = -_pointZ( _points, _point_step, i );
+			// NaN fails every comparison
+			if( depth > 0 && depth <= max_depth )
+			{
+				m_depth[i] = (uint16_t)min( 65535.f, max( 1.f, roundf( depth / depth_step ) ) );
+			}
+			else
+			{
+				m_depth[i] = 0;
+			}
+		}
+
+		Header header;
+		memset( &header, 0, sizeof( header ) );
+		header.magic = MAGIC;
+		header.version = VERSION;
+		header.flags = _labels ? FLAG_LABEL : 0;
+		if( _labels && _label_bytes == 4 )
+		{
+			header.flags |= FLAG_LABEL_HIGH;
+		}
+		header.width = m_width;
+		header.height = m_height;
+		header.depth_step = depth_step;
+		header.intrinsics = m_intrinsics;
+
+		_stream.assign( sizeof( Header ), 0 );
+		header.depth_bytes = _encodePlane( &m_depth[0], _stream );
+		if( _labels )
+		{
+			for( int i = 0; i < size; i++ )
+			{
+				const unsigned char *label = _labels + (size_t)i * _label_step;
+				if( _label_bytes == 1 )
+				{
+					m_label_low[i] = label[0];
+				}
+				else if( _label_bytes == 2 )
+				{
+					memcpy( &m_label_low[i], label, sizeof( uint16_t ) );
+				}
+				else
+				{
+					uint32_t id;
+					memcpy( &id, label, sizeof( id ) );
+					m_label_low[i] = (uint16_t)id;
+					m_label_high[i] = (uint16_t)( id >> 16 );
+				}
+			}
+			header.label_bytes = _encodePlane( &m_label_low[0], _stream );
+			if( header.flags & FLAG_LABEL_HIGH )
+			{
+				header.label_high_bytes = _encodePlane( &m_label_high[0], _stream );
+			}
+		}
+		memcpy( &_stream[0], &header, sizeof( header ) );
+	}
+
+	// ****** //
+	// decode //
+	// ****** //
+	// read header & planes of _stream, false if it is not a valid stream of this resolution
+	bool decode( const string &_stream )
+	{
+		return decode( (const unsigned char*)_stream.data(), _stream.size() );
+	}
+
+	bool decode( const unsigned char *_data, size_t _size )
+	{
+		if( _size < sizeof( Header ) )
+		{
+			return false;
+		}
+		memcpy( &m_header, _data, sizeof( Header ) );
+		if(	m_header.magic != MAGIC ||
+			m_header.version != VERSION ||
+			(int)m_header.width != m_width ||
+			(int)m_header.height != m_height ||
+			sizeof( Header ) + (size_t)m_header.depth_bytes + m_header.label_bytes + m_header.label_high_bytes > _size )
+		{
+			return false;
+		}
+
+		const unsigned char *plane = _data + sizeof( Header );
+		if( !_decodePlane( plane, m_header.depth_bytes, &m_depth[0] ) )
+		{
+			return false;
+		}
+		if( !hasLabel() )
+		{
+			return true;
+		}
+		plane += m_header.depth_bytes;
+		if( !_decodePlane( plane, m_header.label_bytes, &m_label_low[0] ) )
+		{
+			return false;
+		}
+		bool high = ( m_header.flags & FLAG_LABEL_HIGH ) != 0;
+		if( high && !_decodePlane( plane + m_header.label_bytes, m_header.label_high_bytes, &m_label_high[0] ) )
+		{
+			return false;
+		}
+		for( int i = 0; i < m_width * m_height; i++ )
+		{
+			m_label[i] = high ? ( (uint32_t)m_label_high[i] << 16 ) | m_label_low[i] : m_label_low[i];
+		}
+		return true;
+	}
+
+	// header of the last decoded stream
+	const Header &getHeader() const
+	{
+		return m_header;
+	}
+
+	bool hasLabel() const
+	{
+		return ( m_header.flags & FLAG_LABEL ) != 0;
+	}
+
+	// quantized depth of the last decoded stream, 0 for NaN, multiply by getHeader().depth_step for millimeter
+	const uint16_t *getDepth() const
+	{
+		return &m_depth[0];
+	}
+
+	// labels of the last decoded stream, as encoded up to 32 bits
+	const uint32_t *getLabel() const
+	{
+		return &m_label[0];
+	}
+
+	// x, y, z in millimeter of the last decoded stream into float x, y, z at the start of every _point_step bytes
+	void reconstruct( void *_points, int _point_step ) const
+	{
+		const Intrinsics &intr = m_header.intrinsics;
+		const float nan = numeric_limits< float >::quiet_NaN();
+
+		for( int j = 0; j < m_height; j++ )
+		{
+			float ray_y = -( j - intr.cy ) / intr.fy;
+			for( int i = 0; i < m_width; i++ )
+			{
+				int idx = i + j * m_width;
+				float *point = (float*)( (unsigned char*)_points + (size_t)idx * _point_step );
+				if( m_depth[ idx ] == 0 )
+				{
+					point[0] = point[1] = point[2] = nan;
+					continue;
+				}
+
+				float depth = m_depth[ idx ] * m_header.depth_step;
+				point[0] = ( i - intr.cx ) / intr.fx * depth;
+				point[1] = ray_y * depth;
+				point[2] = -depth;
+			}
+		}
+	}
+
+private:
+	static float _pointZ( const void *_points, int _point_step, int _idx )
+	{
+		float z;
+		memcpy( &z, (const unsigned char*)_points + (size_t)_idx * _point_step + 2 * sizeof( float ), sizeof( z ) );
+		return z;
+	}
+
+	// *********************************************************** //
+	// bit I/O, least significant bit first, unary codes are zeros //
+	// *********************************************************** //
+	struct BitWriter
+	{
+		string *out;
+		uint64_t bits;
+		int count;
+
+		void put( uint32_t _value, int _length )
+		{
+			bits |= (uint64_t)_value << count;
+			count += _length;
+			if( count >= 32 )
+			{
+				uint32_t word = (uint32_t)bits;
+				out->append( (const char*)&word, 4 );
+				bits >>= 32;
+				count -= 32;
+			}
+		}
+
+		void flush()
+		{
+			while( count > 0 )
+			{
+				out->push_back( (char)( bits & 0xff ) );
+				bits >>= 8;
+				count -= 8;
+			}
+			bits = 0;
+			count = 0;
+		}
+	};
+
+	struct BitReader
+	{
+		const unsigned char *data;
+		size_t size;
+		size_t pos;
+		uint64_t bits;
+		int count;
+		// set when reading past the end
+		bool error;
+
+		void refill()
+		{
+			while( count <= 56 && pos < size )
+			{
+				bits |= (uint64_t)data[ pos++ ] << count;
+				count += 8;
+			}
+		}
+
+		uint32_t get( int _length )
+		{
+			refill();
+			if( count < _length )
+			{
+				error = true;
+				return 0;
+			}
+			uint32_t value = (uint32_t)( bits & ( ( (uint64_t)1 << _length ) - 1 ) );
+			bits >>= _length;
+			count -= _length;
+			return value;
+		}
+
+		// number of zeros before the next one, at most _limit zeros are consumed
+		int zeros( int _limit )
+		{
+			refill();
+			int n = bits == 0 ? 64 : __builtin_ctzll( bits );
+			n = min( n, _limit );
+			if( count < n )
+			{
+				error = true;
+				return _limit;
+			}
+			bits >>= n;
+			count -= n;
+			return n;
+		}
+
+		// false if more bits were read than the stream has
+		bool valid() const
+		{
+			return !error;
+		}
+	};
+
+	// ************************************************************ //
+	// adaptive Golomb-Rice codes of zigzag residuals & run lengths //
+	// ************************************************************ //
+	// unary prefix longer than this is an escape followed by the raw value
+	static const int UNARY_LIMIT = 24;
+	static const int RAW_BITS = 17;
+	// running mean is halved every RESET_COUNT values
+	static const int RESET_COUNT = 64;
+
+	struct RiceState
+	{
+		uint32_t sum;
+		uint32_t count;
+
+		int k() const
+		{
+			int k = 0;
+			while( ( count << k ) < sum && k < 16 )
+			{
+				k++;
+			}
+			return k;
+		}
+
+		void update( uint32_t _value )
+		{
+			sum += _value;
+			count++;
+			if( count >= RESET_COUNT )
+			{
+				sum >>= 1;
+				count >>= 1;
+			}
+		}
+	};
+
+	static void _putRice( BitWriter &_writer, RiceState &_state, uint32_t _value )
+	{
+		int k = _state.k();
+		uint32_t q = _value >> k;
+		if( q < UNARY_LIMIT )
+		{
+			// q zeros, a one, then the k low bits
+			_writer.put( 1u << q, q + 1 );
+			_writer.put( _value & ( ( 1u << k ) - 1 ), k );
+		}
+		else
+		{
+			_writer.put( 0, UNARY_LIMIT );
+			_writer.put( _value, RAW_BITS );
+		}
+		_state.update( _value );
+	}
+
+	static uint32_t _getRice( BitReader &_reader, RiceState &_state )
+	{
+		int k = _state.k();
+		uint32_t value;
+		int q = _reader.zeros( UNARY_LIMIT );
+		if( q < UNARY_LIMIT )
+		{
+			_reader.get( 1 );
+			value = ( (uint32_t)q << k ) | _reader.get( k );
+		}
+		else
+		{
+			value = _reader.get( RAW_BITS );
+		}
+		_state.update( value );
+		return value;
+	}
+
+	// Elias gamma of _value >= 1 : floor( log2 ) as unary, then the bits below the leading one
+	static void _putGamma( BitWriter &_writer, uint32_t _value )
+	{
+		int length = 31 - __builtin_clz( _value );
+		_writer.put( 1u << length, length + 1 );
+		_writer.put( _value & ( ( 1u << length ) - 1 ), length );
+	}
+
+	static uint32_t _getGamma( BitReader &_reader )
+	{
+		int length = _reader.zeros( 31 );
+		_reader.get( 1 );
+		return ( 1u << length ) | _reader.get( length );
+	}
+
+	static uint32_t _zigzag( int _value )
+	{
+		return ( (uint32_t)_value << 1 ) ^ (uint32_t)( _value >> 31 );
+	}
+
+	static int _unzigzag( uint32_t _value )
+	{
+		return (int)( _value >> 1 ) ^ -(int)( _value & 1 );
+	}
+
+	// append the coded plane to _stream, return its size in bytes
+	uint32_t _encodePlane( const uint16_t *_plane, string &_stream )
+	{
+		size_t start = _stream.size();
+		BitWriter writer = { &_stream, 0, 0 };
+		RiceState state = { 4, 1 };
+
+		for( int j = 0; j < m_height; j++ )
+		{
+			const uint16_t *row = _plane + j * m_width;
+			// the first pixel is predicted from above, then every pixel from its left
+			int pred = j > 0 ? row[ -m_width ] : 0;
+			bool run_mode = false;
+			int i = 0;
+			while( i < m_width )
+			{
+				if( run_mode )
+				{
+					// pixels equal to the left one, up to the end of the row
+					int run = 0;
+					while( i + run < m_width && row[ i + run ] == pred )
+					{
+						run++;
+					}
+					_putGamma( writer, run + 1 );
+					i += run;
+					run_mode = false;
+					continue;
+				}
+
+				uint32_t value = _zigzag( (int)row[i] - pred );
+				_putRice( writer, state, value );
+				pred = row[i];
+				run_mode = value == 0;
+				i++;
+			}
+		}
+		writer.flush();
+
+		return _stream.size() - start;
+	}
+
+	bool _decodePlane( const unsigned char *_data, size_t _size, uint16_t *_plane )
+	{
+		BitReader reader = { _data, _size, 0, 0, 0, false };
+		RiceState state = { 4, 1 };
+
+		for( int j = 0; j < m_height; j++ )
+		{
+			uint16_t *row = _plane + j * m_width;
+			int pred = j > 0 ? row[ -m_width ] : 0;
+			bool run_mode = false;
+			int i = 0;
+			while( i < m_width )
+			{
+				if( run_mode )
+				{
+					uint32_t gamma = _getGamma( reader );
+					if( !reader.valid() || gamma > (uint32_t)( m_width - i + 1 ) )
+					{
+						return false;
+					}
+					int run = gamma - 1;
+					for( int r = 0; r < run; r++ )
+					{
+						row[ i + r ] = pred;
+					}
+					i += run;
+					run_mode = false;
+					continue;
+				}
+
+				uint32_t value = _getRice( reader, state );
+				row[i] = (uint16_t)( pred + _unzigzag( value ) );
+				pred = row[i];
+				run_mode = value == 0;
+				i++;
+			}
+
+			if( !reader.valid() )
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+public:
+
+private:
+	// image resolution
+	int m_width;
+	int m_height;
+	// intrinsics written into every stream
+	Intrinsics m_intrinsics;
+	// finest quantization step in millimeter
+	float m_min_depth_step;
+	// quantized depth & 16 bit label planes of the current frame
+	vector< uint16_t > m_depth;
+	vector< uint16_t > m_label_low;
+	vector< uint16_t > m_label_high;
+	// labels of the last decoded stream
+	vector< uint32_t > m_label;
+	// header of the last decoded stream
+	Header m_header;
+};
+
+#endif /* DEPTH_STREAM_CODEC_H_ */
@@ -0,0 +1,675 @@
+/*
+ * EntityProxyCache.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef ENTITY_PROXY_CACHE_H_
+#define ENTITY_PROXY_CACHE_H_
+
+#include <algorithm>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include <iostream>
+
+#include <OGRE/Ogre.h>
+
+#include <gazebo/common/Events.hh>
+#include <gazebo/rendering/rendering.hh>
+
+#include "ModelLabelTable.h"
+
+using namespace gazebo;
+using namespace std;
+
+// Keeps cloned entities ( proxies ) of every model visual for the depth, rayconf, segment and MRT passes.
+// Proxies are cloned once when a visual appears, destroyed when the visual is removed,
+// and only toggled visible while the corresponding render texture is updated.
+// Visuals are kept in a flat registry, classified once when registered. The registry starts from the children
+// of the world visual & follows gazebo's add / delete entity events, so update() never probes visual ids.
+class EntityProxyCache
+{
+public:
+	enum ProxyPass
+	{
+		PASS_DEPTH = 0,
+		PASS_RAYCONF,
+		PASS_SEGMENT,
+		PASS_MRT,
+		NUM_PROXY_PASS,
+		PASS_NONE = NUM_PROXY_PASS
+	};
+
+	// what a registered visual is used for, decided once by its names
+	enum VisualClass
+	{
+		VISUAL_MODEL = 0,	// cloned for every enabled pass
+		VISUAL_COLLISION,	// "__COLLISION_VISUAL__", hidden during proxy passes but never cloned
+		VISUAL_HELPER		// "_MATERIAL_" in it's material name, never touched
+	};
+
+private:
+	// an object attached to a child SceneNode of a gazebo visual
+	struct CachedObject
+	{
+		// gazebo's object, hidden during proxy passes
+		Ogre::MovableObject *object;
+		// proxies cloned from object ( NULL if object is not a model entity )
+		Ogre::Entity *proxies[ NUM_PROXY_PASS ];
+		// SceneNode that carries the proxies, follows object's parent SceneNode
+		Ogre::SceneNode *proxy_node;
+		// name of the model this object belongs to ( only for model entities )
+		string model_name;
+	};
+
+	// everything cached for one rendering::Visual
+	struct CachedVisual
+	{
+		rendering::VisualPtr visual;
+		uint32_t id;
+		VisualClass visual_class;
+		// used to find out whether gazebo rebuilt or removed the visual, every object attached to a child SceneNode in order
+		// ( Visual::UpdateFromMsg swaps entities of a geometry change & keeps their count )
+		Ogre::SceneNode *scene_node;
+		vector< Ogre::MovableObject* > attached_objects;
+		// children registered so far, gazebo may attach links & visuals after the model visual
+		unsigned int num_children;
+		vector< CachedObject > objects;
+	};
+
+public:
+	EntityProxyCache(	rendering::ScenePtr		_scene,
+						Ogre::SceneManager		*_scene_mgr )
+		: m_scene( _scene ),
+		  m_scene_mgr( _scene_mgr ),
+		  m_populated( false ),
+		  m_version( 0 ),
+		  m_active_pass( PASS_NONE )
+	{
+		m_pass_prefix[ PASS_DEPTH ] = "DEPTH_PROXY_";
+		m_pass_prefix[ PASS_RAYCONF ] = "RAYCONF_PROXY_";
+		m_pass_prefix[ PASS_SEGMENT ] = "SEGMENT_PROXY_";
+		m_pass_prefix[ PASS_MRT ] = "MRT_PROXY_";
+
+		m_pass_material[ PASS_DEPTH ] = "Ogre/DepthShadowmap_Depth/BasicTemplateMaterial";
+		m_pass_material[ PASS_RAYCONF ] = "Ogre/DepthShadowmap_RayConf/BasicTemplateMaterial";
+		m_pass_material[ PASS_SEGMENT ] = "";	// set per model by setModelMaterials()
+		m_pass_material[ PASS_MRT ] = "Ogre/DepthShadowmap_MRT/BasicTemplateMaterial";
+
+		// only clone proxies for passes that will be rendered
+		for( int pass = 0; pass < NUM_PROXY_PASS; pass++ )
+		{
+			m_pass_enabled[ pass ] = false;
+		}
+
+		// fired by the world thread, handled by the next update()
+		m_add_connection = event::Events::ConnectAddEntity( std::bind( &EntityProxyCache::_onAddEntity, this, std::placeholders::_1 ) );
+		m_delete_connection = event::Events::ConnectDeleteEntity( std::bind( &EntityProxyCache::_onDeleteEntity, this, std::placeholders::_1 ) );
+	}
+
+	~EntityProxyCache()
+	{
+		m_add_connection.reset();
+		m_delete_connection.reset();
+
+		hideProxies();
+
+		for( unsigned int i = 0; i < m_visuals.size(); i++ )
+		{
+			_destroyProxies( m_visuals[i] );
+		}
+		m_visuals.clear();
+	}
+
+	// must be called before the first update()
+	void enablePass( ProxyPass _pass, bool _enable )
+	{
+		m_pass_enabled[ _pass ] = _enable;
+	}
+
+	// material of every proxy of _pass instead of the template material, must be called before the first update()
+	void setPassMaterial( ProxyPass _pass, const string &_material )
+	{
+		m_pass_material[ _pass ] = _material;
+	}
+
+	// synchronize the cache with rendering::Scene, call once per capture before any pass
+	void update()
+	{
+		// ************************************************ //
+		// first call : every visual below the world visual //
+		// ************************************************ //
+		if( !m_populated )
+		{
+			rendering::VisualPtr world_visual = m_scene->GetWorldVisual();
+			if( world_visual )
+			{
+				for( unsigned int i = 0; i < world_visual->GetChildCount(); i++ )
+				{
+					_registerTree( world_visual->GetChild( i ) );
+				}
+				m_populated = true;
+			}
+		}
+
+		// ************************************************** //
+		// entities added & deleted since the last update()   //
+		// ************************************************** //
+		vector< string > added;
+		vector< string > deleted;
+		{
+			lock_guard< mutex > lock( m_event_mutex );
+			added.swap( m_added_entities );
+			deleted.swap( m_deleted_entities );
+		}
+
+		for( unsigned int i = 0; i < deleted.size(); i++ )
+		{
+			_unregisterModel( deleted[i] );
+		}
+
+		vector< string > pending;
+		for( unsigned int i = 0; i < added.size(); i++ )
+		{
+			// the render thread creates the visual some frames after the entity
+			rendering::VisualPtr visual = m_scene->GetVisual( added[i] );
+			if( visual && visual->GetSceneNode() )
+			{
+				_registerTree( visual );
+			}
+			else if( find( deleted.begin(), deleted.end(), added[i] ) == deleted.end() )
+			{
+				pending.push_back( added[i] );
+			}
+		}
+		if( !pending.empty() )
+		{
+			lock_guard< mutex > lock( m_event_mutex );
+			m_added_entities.insert( m_added_entities.end(), pending.begin(), pending.end() );
+		}
+
+		// *************************************************** //
+		// visuals rebuilt, removed or grown by gazebo         //
+		// *************************************************** //
+		for( unsigned int i = 0; i < m_visuals.size(); )
+		{
+			CachedVisual &cached = m_visuals[i];
+			Ogre::SceneNode *scene_node = cached.visual->GetSceneNode();
+			if( !scene_node )
+			{
+				// removed from the scene
+				_unregister( i );
+				continue;
+			}
+
+			if( scene_node != cached.scene_node || !_sameAttachedObjects( scene_node, cached.attached_objects ) )
+			{
+				// rebuilt, cloned again in place
+				_destroyProxies( cached );
+				_cacheVisual( cached );
+			}
+
+			if( cached.visual->GetChildCount() != cached.num_children )
+			{
+				// links & visuals attached after the parent was registered, appended behind it
+				cached.num_children = cached.visual->GetChildCount();
+				rendering::VisualPtr visual = cached.visual;
+				for( unsigned int j = 0; j < visual->GetChildCount(); j++ )
+				{
+					_registerTree( visual->GetChild( j ) );
+				}
+			}
+			i++;
+		}
+
+		// ********************************************** //
+		// move proxies to where gazebo's objects are now //
+		// ********************************************** //
+		for( unsigned int i = 0; i < m_visuals.size(); i++ )
+		{
+			vector< CachedObject > &objects = m_visuals[i].objects;
+			for( unsigned int j = 0; j < objects.size(); j++ )
+			{
+				if( !objects[j].proxy_node )
+				{
+					continue;
+				}
+
+				// detached by gazebo since the visual was cached
+				Ogre::SceneNode *src_node = objects[j].object->getParentSceneNode();
+				if( !src_node )
+				{
+					continue;
+				}
+				objects[j].proxy_node->setPosition( src_node->_getDerivedPosition() );
+				objects[j].proxy_node->setOrientation( src_node->_getDerivedOrientation() );
+				objects[j].proxy_node->setScale( src_node->_getDerivedScale() );
+			}
+		}
+	}
+
+	// hide gazebo's visible objects and show the proxies of _pass instead
+	void showProxies( ProxyPass _pass )
+	{
+		if( m_active_pass != PASS_NONE )
+		{
+			hideProxies();
+		}
+
+		for( unsigned int v = 0; v < m_visuals.size(); v++ )
+		{
+			CachedVisual &cached = m_visuals[v];
+			if( cached.visual_class == VISUAL_HELPER || !cached.visual->GetVisible() )
+			{
+				continue;
+			}
+
+			for( unsigned int i = 0; i < cached.objects.size(); i++ )
+			{
+				CachedObject &cur_object = cached.objects[i];
+				if( !cur_object.object->getParentSceneNode() || !cur_object.object->getVisible() )
+				{
+					continue;
+				}
+
+				Ogre::Entity *proxy = cur_object.proxies[ _pass ];
+				if( proxy )
+				{
+					// gazebo may change materials of every entity under a visual ( e.g. SetTransparency ), make sure ours stay
+					if( !m_pass_material[ _pass ].empty() &&
+						proxy->getSubEntity( 0 )->getMaterialName() != m_pass_material[ _pass ] )
+					{
+						proxy->setMaterialName( m_pass_material[ _pass ] );
+					}
+					proxy->setVisible( true );
+					m_shown_proxies.push_back( proxy );
+				}
+
+				cur_object.object->setVisible( false );
+				m_hidden_objects.push_back( cur_object.object );
+			}
+		}
+
+		m_active_pass = _pass;
+	}
+
+	// hide the proxies and show gazebo's objects which were hidden by showProxies()
+	void hideProxies()
+	{
+		// turn on original visual
+		for( vector< Ogre::MovableObject* >::iterator iter = m_hidden_objects.begin(); iter != m_hidden_objects.end(); iter++ )
+		{
+			( *iter )->setVisible( true );
+		}
+		m_hidden_objects.clear();
+
+		for( vector< Ogre::Entity* >::iterator iter = m_shown_proxies.begin(); iter != m_shown_proxies.end(); iter++ )
+		{
+			( *iter )->setVisible( false );
+		}
+		m_shown_proxies.clear();
+
+		m_active_pass = PASS_NONE;
+	}
+
+	// set material of every _pass proxy, _materials[ i ] for the proxies of model i of countSceneModels()
+	// return number of proxies whose model is unknown, those keep their material
+	int setModelMaterials( ProxyPass _pass, const vector< Ogre::MaterialPtr > &_materials )
+	{
+		int unknown = 0;
+		for( unsigned int v = 0; v < m_visuals.size(); v++ )
+		{
+			vector< CachedObject > &objects = m_visuals[v].objects;
+			for( unsigned int i = 0; i < objects.size(); i++ )
+			{
+				if( !objects[i].proxies[ _pass ] )
+				{
+					continue;
+				}
+
+				int idx = m_models.find( objects[i].model_name );
+				if( idx < 0 || idx >= (int)_materials.size() )
+				{
+					unknown++;
+					continue;
+				}
+				objects[i].proxies[ _pass ]->setMaterial( _materials[ idx ] );
+			}
+		}
+		return unknown;
+	}
+
+	// write the label of it's model into every _pass proxy ( custom parameter 0 of MRT shader ), the grey level
+	// or with _ids the instance id & class id of ModelLabelTable::getId() in x & y
+	// return number of proxies whose model is unknown
+	int setModelLabels( ProxyPass _pass, bool _ids = false )
+	{
+		int unknown = 0;
+		for( unsigned int v = 0; v < m_visuals.size(); v++ )
+		{
+			vector< CachedObject > &objects = m_visuals[v].objects;
+			for( unsigned int i = 0; i < objects.size(); i++ )
+			{
+				Ogre::Entity *proxy = objects[i].proxies[ _pass ];
+				if( !proxy )
+				{
+					continue;
+				}
+
+				int idx = m_models.find( objects[i].model_name );
+				if( idx < 0 )
+				{
+					unknown++;
+					continue;
+				}
+
+				Ogre::Vector4 label;
+				if( _ids )
+				{
+					// both are exact in a float
+					uint32_t id = m_models.getId( idx );
+					label = Ogre::Vector4( ModelLabelTable::getInstanceId( id ), ModelLabelTable::getClassId( id ), 0, 1 );
+				}
+				else
+				{
+					Ogre::Real grey = m_models.getLabel( idx );
+					label = Ogre::Vector4( grey, grey, grey, 1 );
+				}
+				for( unsigned int j = 0; j < proxy->getNumSubEntities(); j++ )
+				{
+					proxy->getSubEntity( j )->setCustomParameter( 0, label );
+				}
+			}
+		}
+		return unknown;
+	}
+
+	// names of every model in the scene, the order decides the label of each model
+	// ( top level visuals in the order they were registered, safe to call from any thread )
+	// _ids gets ModelLabelTable::getId() of every model if not NULL
+	vector< string > countSceneModels( vector< uint32_t > *_ids = NULL )
+	{
+		lock_guard< mutex > lock( m_model_mutex );
+		if( _ids )
+		{
+			*_ids = m_models.getIds();
+		}
+		return m_models.getNames();
+	}
+
+	// changed whenever a model or a proxy is added or removed, materials & labels must be set again
+	unsigned long getVersion() const
+	{
+		return m_version;
+	}
+
+private:
+	void _onAddEntity( const string &_name )
+	{
+		lock_guard< mutex > lock( m_event_mutex );
+		m_added_entities.push_back( _name );
+	}
+
+	void _onDeleteEntity( const string &_name )
+	{
+		lock_guard< mutex > lock( m_event_mutex );
+		m_deleted_entities.push_back( _name );
+	}
+
+	// register _visual & every visual below it which is not registered yet
+	void _registerTree( rendering::VisualPtr _visual )
+	{
+		if( !_visual || !_visual->GetSceneNode() )
+		{
+			return;
+		}
+
+		if( m_registered_ids.insert( _visual->GetId() ).second )
+		{
+			CachedVisual cached;
+			cached.visual = _visual;
+			cached.id = _visual->GetId();
+			cached.num_children = _visual->GetChildCount();
+			cached.visual_class = _classify( _visual );
+			_cacheVisual( cached );
+			m_visuals.push_back( cached );
+
+			// get only model names
+			string name = _visual->GetName();
+			if( name.rfind( "::" ) == string::npos )
+			{
+				lock_guard< mutex > lock( m_model_mutex );
+				if( !m_models.insert( name ) )	// should not happen
+				{
+					cout << "ERROR : u have two same visual name!" << endl;
+				}
+			}
+		}
+
+		for( unsigned int i = 0; i < _visual->GetChildCount(); i++ )
+		{
+			_registerTree( _visual->GetChild( i ) );
+		}
+	}
+
+	// drop m_visuals[ _idx ] & it's proxies, the order of the others is kept
+	void _unregister( unsigned int _idx )
+	{
+		CachedVisual &cached = m_visuals[ _idx ];
+		_destroyProxies( cached );
+		m_registered_ids.erase( cached.id );
+
+		string name = cached.visual->GetName();
+		if( name.rfind( "::" ) == string::npos )
+		{
+			lock_guard< mutex > lock( m_model_mutex );
+			m_models.remove( name );
+		}
+
+		m_visuals.erase( m_visuals.begin() + _idx );
+		m_version++;
+	}
+
+	// drop the visual of a deleted model & every visual below it
+	void _unregisterModel( const string &_model_name )
+	{
+		string prefix = _model_name + "::";
+		for( unsigned int i = 0; i < m_visuals.size(); )
+		{
+			const string &name = m_visuals[i].visual->GetName();
+			if( name == _model_name || name.compare( 0, prefix.size(), prefix ) == 0 )
+			{
+				_unregister( i );
+			}
+			else
+			{
+				i++;
+			}
+		}
+	}
+
+	static VisualClass _classify( rendering::VisualPtr _visual )
+	{
+		// only visual with NO "_MATERIAL_" in it's Visual material name will pass through
+		if( _visual->GetMaterialName().rfind( "_MATERIAL_" ) != string::npos )
+		{
+			return VISUAL_HELPER;
+		}
+		if( _visual->GetName().rfind( "__COLLISION_VISUAL__" ) != string::npos )
+		{
+			return VISUAL_COLLISION;
+		}
+		return VISUAL_MODEL;
+	}
+
+	// find gazebo's objects of _cached & clone proxies of model entities
+	void _cacheVisual( CachedVisual &_cached )
+	{
+		_cached.scene_node = _cached.visual->GetSceneNode();
+		_cached.attached_objects.clear();
+		for( unsigned int i = 0; i < _cached.scene_node->numChildren(); ++i )
+		{
+			Ogre::SceneNode *sn = (Ogre::SceneNode*)( _cached.scene_node->getChild(i) );
+			for( int j = 0; j < sn->numAttachedObjects(); j++ )
+			{
+				_cached.attached_objects.push_back( sn->getAttachedObject( j ) );
+			}
+		}
+		m_version++;
+		if( _cached.visual_class == VISUAL_HELPER )
+		{
+			return;
+		}
+
+		// clone objects attached to all child scene nodes
+		Ogre::SceneNode *scene_node = _cached.scene_node;
+		for( unsigned int i = 0; i < scene_node->numChildren(); ++i )
+		{
+			Ogre::SceneNode *sn = (Ogre::SceneNode*)(scene_node->getChild(i));
+			for( int j = 0; j < sn->numAttachedObjects(); j++ )
+			{
+				Ogre::MovableObject *mobj = sn->getAttachedObject( j );
+				Ogre::Entity *entity = dynamic_cast<Ogre::Entity*>( mobj );
+
+				if( !entity && !dynamic_cast<Ogre::SimpleRenderable*>( mobj ) )	// not sure
+				{
+					cerr << "Something didn't handled in EntityProxyCache!" << endl;
+					continue;
+				}
+
+				CachedObject cur_object;
+				cur_object.object = mobj;
+				cur_object.proxy_node = NULL;
+				for( int pass = 0; pass < NUM_PROXY_PASS; pass++ )
+				{
+					cur_object.proxies[ pass ] = NULL;
+				}
+
+				// clone only model visualize object ( those dosen't have "__COLLISION_VISUAL__" in it's entity name
+				string entity_name = entity ? entity->getName() : "";
+				if( entity && _cached.visual_class == VISUAL_MODEL && entity_name.rfind( "__COLLISION_VISUAL__" ) == string::npos )
+				{
+					int pos = entity_name.find( "::" );
+					cur_object.model_name = entity_name.substr( 7, pos - 7 );
+					cur_object.proxy_node = m_scene_mgr->getRootSceneNode()->createChildSceneNode();
+
+					for( int pass = 0; pass < NUM_PROXY_PASS; pass++ )
+					{
+						if( !m_pass_enabled[ pass ] )
+						{
+							continue;
+						}
+
+						string proxy_name = m_pass_prefix[ pass ] + entity_name;
+						// left behind if gazebo re-created a visual with the same name
+						if( m_scene_mgr->hasEntity( proxy_name ) )
+						{
+							m_scene_mgr->destroyEntity( proxy_name );
+						}
+
+						Ogre::Entity *proxy = entity->clone( proxy_name );
+						if( !m_pass_material[ pass ].empty() )
+						{
+							proxy->setMaterialName( m_pass_material[ pass ] );
+						}
+						// segmentation must not be occluded by shadow
+						proxy->setCastShadows( pass != PASS_SEGMENT );
+						proxy->setVisible( false );
+						cur_object.proxy_node->attachObject( proxy );
+
+						cur_object.proxies[ pass ] = proxy;
+					}
+				}
+
+				_cached.objects.push_back( cur_object );
+			}
+		}
+	}
+
+	void _destroyProxies( CachedVisual &_cached )
+	{
+		for( unsigned int i = 0; i < _cached.objects.size(); i++ )
+		{
+			CachedObject &cur_object = _cached.objects[i];
+			if( !cur_object.proxy_node )
+			{
+				continue;
+			}
+
+			for( int pass = 0; pass < NUM_PROXY_PASS; pass++ )
+			{
+				if( !cur_object.proxies[ pass ] )
+				{
+					continue;
+				}
+				cur_object.proxy_node->detachObject( cur_object.proxies[ pass ] );
+				m_scene_mgr->destroyEntity( cur_object.proxies[ pass ] );
+			}
+			m_scene_mgr->destroySceneNode( cur_object.proxy_node );
+		}
+		_cached.objects.clear();
+	}
+
+	// objects attached to the child SceneNodes of _scene_node are still _objects, only the live nodes are dereferenced
+	bool _sameAttachedObjects( Ogre::SceneNode *_scene_node, const vector< Ogre::MovableObject* > &_objects )
+	{
+		unsigned int count = 0;
+		for( unsigned int i = 0; i < _scene_node->numChildren(); ++i )
+		{
+			Ogre::SceneNode *sn = (Ogre::SceneNode*)( _scene_node->getChild(i) );
+			for( int j = 0; j < sn->numAttachedObjects(); j++ )
+			{
+				if( count >= _objects.size() || sn->getAttachedObject( j ) != _objects[ count ] )
+				{
+					return false;
+				}
+				count++;
+			}
+		}
+		return count == _objects.size();
+	}
+
+public:
+
+private:
+	// the pointer to gazebo::rendering::Scene that contain the listened camera
+	rendering::ScenePtr m_scene;
+	// Ogre::SceneManager
+	Ogre::SceneManager *m_scene_mgr;
+	// registered visuals, parents before their children
+	vector< CachedVisual > m_visuals;
+	// ids of m_visuals
+	unordered_set< uint32_t > m_registered_ids;
+	// the world visual has been walked
+	bool m_populated;
+	// top level visuals, written under m_model_mutex ( read by the snapshot job )
+	ModelLabelTable m_models;
+	mutex m_model_mutex;
+	// bumped by every change of m_visuals or m_models
+	unsigned long m_version;
+
+	// add / delete entity events, guarded by m_event_mutex
+	event::ConnectionPtr m_add_connection;
+	event::ConnectionPtr m_delete_connection;
+	mutex m_event_mutex;
+	vector< string > m_added_entities;
+	vector< string > m_deleted_entities;
+
+	// name prefix of proxies for each pass
+	string m_pass_prefix[ NUM_PROXY_PASS ];
+	// material of proxies for each pass ( empty if material is set per model )
+	string m_pass_material[ NUM_PROXY_PASS ];
+	// whether proxies are cloned for each pass
+	bool m_pass_enabled[ NUM_PROXY_PASS ];
+	// pass whose proxies are currently shown
+	ProxyPass m_active_pass;
+	// MovableObject being hidden by showProxies()
+	vector< Ogre::MovableObject * > m_hidden_objects;
+	// proxies being shown by showProxies()
+	vector< Ogre::Entity * > m_shown_proxies;
+};
+
+#endif /* ENTITY_PROXY_CACHE_H_ */
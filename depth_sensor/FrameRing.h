@@ -0,0 +1,492 @@
+/*
+ * FrameRing.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef FRAME_RING_H_
+#define FRAME_RING_H_
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <gazebo/common/Time.hh>
+
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+
+#include "WorkerPool.h"
+#include "SnapshotDataset.h"
+
+using namespace std;
+
+// outputs of one frame, bits of FrameSlot::outputs
+enum FrameOutput
+{
+	OUTPUT_CLOUD = 1,			// noisy point cloud, published or saved
+	OUTPUT_LABELS = 2,			// segment labels, embedded in the cloud & published on their topic
+	OUTPUT_RGB = 4,				// gazebo camera image on its topic
+	OUTPUT_CONFIDENCE = 8,		// confidence of every pixel on its topic
+	OUTPUT_RGB_PNG = 16			// rgb_sensor.png of the gazebo camera
+};
+
+// wall time of every stage of one frame, stages the frame didn't need are skipped
+struct FrameStages
+{
+	enum Stage
+	{
+		STAGE_RGB,				// specular map pass
+		STAGE_DEPTH,
+		STAGE_RAYCONF,
+		STAGE_SEGMENT,
+		STAGE_MRT,				// depth, rayconf & label in one pass
+		STAGE_MASK,				// DepthMaskPass
+		STAGE_POST_PROCESS,		// masks, occlusion edge & point cloud
+		STAGE_FILTER,			// bilateral filter
+		STAGE_PUBLISH,			// messages & snapshot jobs
+		NUM_STAGES
+	};
+
+	// every stage is skipped until it is timed
+	void reset()
+	{
+		for( int i = 0; i < NUM_STAGES; i++ )
+		{
+			seconds[i] = -1;
+		}
+	}
+
+	// _stage ran from _start until now, a stage running more than once adds up
+	void stop( Stage _stage, double _start )
+	{
+		seconds[ _stage ] = max( 0.0, seconds[ _stage ] ) + gazebo::common::Time::GetWallTime().Double() - _start;
+	}
+
+	bool isSkipped( int _stage ) const
+	{
+		return seconds[ _stage ] < 0;
+	}
+
+	static const char *getName( int _stage )
+	{
+		static const char *names[ NUM_STAGES ] = { "rgb", "depth", "rayconf", "segment", "mrt", "mask", "post process", "filter", "publish" };
+		return names[ _stage ];
+	}
+
+	double seconds[ NUM_STAGES ];
+};
+
+// Every buffer of one captured frame, allocated once with the ring.
+struct FrameSlot
+{
+	// ******************************************* //
+	// render targets, written by the RT listeners //
+	// ******************************************* //
+	// specular map, W * H * 3
+	unsigned char *rgb;
+	// depth, W * H * RenderTargetLayout::depthChannels()
+	float *depth;
+	// ray & confidence, W * H * RenderTargetLayout::rayconfPixelBytes() bytes ( confidence only if xyz is reconstructed )
+	float *rayconf;
+	// label of every pixel, W * H * segmentBytes() ( room for 4 bytes per pixel )
+	unsigned char *segment;
+	// depth / flags of DepthMaskPass, W * H ( NULL without the mask pass )
+	float *mask;
+	// perlin noise uploaded to the mask pass, drawn on the sensor thread ( NULL without the mask pass )
+	float *noise_40;
+	float *conf_noise;
+
+	// ********************************** //
+	// scene state, only set for snapshot //
+	// ********************************** //
+	// gazebo camera image, W * H * 3
+	unsigned char *camera_rgb;
+	// ground truth of every model ( capacity is kept between frames )
+	vector< SnapshotPose > poses;
+
+	// noisy point cloud, smoothed in place by the bilateral filter, then published & saved
+	pcl::PointCloud< pcl::PointXYZ >::Ptr cloud;
+
+	// ************ //
+	// capture info //
+	// ************ //
+	// frames captured before this one
+	uint64_t frame;
+	// sequence number of the capture, frames dropped by stream backpressure leave gaps
+	uint64_t sequence;
+	double sim_time;
+	// wall time the capture started
+	double start_time;
+	// FrameOutput bits this frame was rendered for
+	unsigned int outputs;
+	// timing of render passes & post processing
+	FrameStages stages;
+	// captured by <capture_trigger> stream, degrade is the backpressure level it was rendered with ( 0 for a full frame )
+	bool stream;
+	int degrade;
+	// only_snapshot mode, save_count & save_file_number are valid
+	bool snapshot;
+	int save_count;
+	int save_file_number;
+
+	// position in the ring
+	int index;
+	// capture, pipeline & snapshot jobs holding this slot, guarded by the ring
+	int references;
+};
+
+// Scratch buffers of post processing, used by the pipeline thread only.
+struct FrameScratch
+{
+	// perlin noise
+	float *noise_40;
+	float *edge_noise;
+	float *conf_noise;
+	// edge noise normalized to -10 ~ 10
+	float *edge_noise_normalized;
+	// 1 byte per pixel
+	unsigned char *invalid_mask;
+	unsigned char *erosion_size;
+	unsigned char *eroded_mask;
+	// 8 bit depth of the reference post process, W * H * 3
+	unsigned char *depth_8u;
+	// DepthMask::Flag of the cpu fallback, for <post_process> verify with the mask pass
+	unsigned char *mask_flags;
+	// copy of the cloud for <post_process> verify, sized on first use
+	pcl::PointCloud< pcl::PointXYZ > reference_cloud;
+};
+
+// Frames are rendered into a ring of preallocated slots & post processed by one pipeline thread,
+// so the sensor thread renders frame k + 1 while frame k is post processed & published.
+// A slot is reused only when nothing references it : the pipeline holds it until the process callback returns,
+// snapshot jobs hold it through share() until their file is written.
+class FrameRing
+{
+public:
+	typedef function< void( FrameSlot& ) > Process;
+
+public:
+	// _num_slots == 1 runs _process inside submit(), the pipeline thread is pinned to _cpus if not empty
+	// depth & rayconf buffers have _depth_pixel_bytes & _rayconf_pixel_bytes per pixel ( see RenderTargetLayout ),
+	// mask & its noise are allocated only with _mask_pass
+	FrameRing(	int					_width,
+				int					_height,
+				int					_num_slots,
+				const Process		&_process,
+				const vector< int >	&_cpus = vector< int >(),
+				int					_depth_pixel_bytes = 4 * sizeof( float ),
+				int					_rayconf_pixel_bytes = 4 * sizeof( float ),
+				bool				_mask_pass = false )
+		: m_process( _process ),
+		  m_cpus( _cpus ),
+		  m_stop( false ),
+		  m_processing( 0 ),
+		  m_next_slot( 0 ),
+		  m_captured( 0 ),
+		  m_stalls( 0 ),
+		  m_stall_time( 0 )
+	{
+		int size = _width * _height;
+		for( int i = 0; i < max( 1, _num_slots ); i++ )
+		{
+			FrameSlot *slot = new FrameSlot();
+			slot->rgb = (unsigned char*)_allocate( size * 3 );
+			slot->depth = (float*)_allocate( size * _depth_pixel_bytes );
+			slot->rayconf = (float*)_allocate( size * _rayconf_pixel_bytes );
+			slot->segment = (unsigned char*)_allocate( size * 4 );
+			slot->mask = _mask_pass ? (float*)_allocate( size * sizeof( float ) ) : NULL;
+			slot->noise_40 = _mask_pass ? (float*)_allocate( size * sizeof( float ) ) : NULL;
+			slot->conf_noise = _mask_pass ? (float*)_allocate( size * sizeof( float ) ) : NULL;
+			slot->camera_rgb = (unsigned char*)_allocate( size * 3 );
+			slot->cloud.reset( new pcl::PointCloud< pcl::PointXYZ >( _width, _height ) );
+			slot->cloud->is_dense = false;
+			slot->frame = 0;
+			slot->sequence = 0;
+			slot->sim_time = 0;
+			slot->start_time = 0;
+			slot->outputs = 0;
+			slot->stages.reset();
+			slot->stream = false;
+			slot->degrade = 0;
+			slot->snapshot = false;
+			slot->save_count = 0;
+			slot->save_file_number = 0;
+			slot->index = i;
+			slot->references = 0;
+			m_slots.push_back( slot );
+		}
+
+		m_scratch.noise_40 = (float*)_allocate( size * sizeof( float ) );
+		m_scratch.edge_noise = (float*)_allocate( size * sizeof( float ) );
+		m_scratch.conf_noise = (float*)_allocate( size * sizeof( float ) );
+		m_scratch.edge_noise_normalized = (float*)_allocate( size * sizeof( float ) );
+		m_scratch.invalid_mask = (unsigned char*)_allocate( size );
+		m_scratch.erosion_size = (unsigned char*)_allocate( size );
+		m_scratch.eroded_mask = (unsigned char*)_allocate( size );
+		m_scratch.depth_8u = (unsigned char*)_allocate( size * 3 );
+		m_scratch.mask_flags = _mask_pass ? (unsigned char*)_allocate( size ) : NULL;
+
+		if( m_slots.size() > 1 )
+		{
+			m_thread = thread( &FrameRing::_threadLoop, this );
+		}
+	}
+	// every submitted frame is still processed, shared slots must be released before
+	~FrameRing()
+	{
+		flush();
+		if( m_thread.joinable() )
+		{
+			{
+				lock_guard< mutex > lock( m_mutex );
+				m_stop = true;
+			}
+			m_submit_cv.notify_all();
+			m_thread.join();
+		}
+
+		for( unsigned int i = 0; i < m_slots.size(); i++ )
+		{
+			free( m_slots[i]->rgb );
+			free( m_slots[i]->depth );
+			free( m_slots[i]->rayconf );
+			free( m_slots[i]->segment );
+			free( m_slots[i]->mask );
+			free( m_slots[i]->noise_40 );
+			free( m_slots[i]->conf_noise );
+			free( m_slots[i]->camera_rgb );
+			delete m_slots[i];
+		}
+		free( m_scratch.noise_40 );
+		free( m_scratch.edge_noise );
+		free( m_scratch.conf_noise );
+		free( m_scratch.edge_noise_normalized );
+		free( m_scratch.invalid_mask );
+		free( m_scratch.erosion_size );
+		free( m_scratch.eroded_mask );
+		free( m_scratch.depth_8u );
+		free( m_scratch.mask_flags );
+	}
+
+	// slot for the next capture, waits while every slot is referenced, the caller holds the first reference
+	FrameSlot *acquire()
+	{
+		unique_lock< mutex > lock( m_mutex );
+		FrameSlot *slot = _findFreeSlot();
+		if( !slot )
+		{
+			double time = gazebo::common::Time::GetWallTime().Double();
+			m_free_cv.wait( lock, [ this, &slot ]{ return ( slot = _findFreeSlot() ) != NULL; } );
+			m_stalls++;
+			m_stall_time += gazebo::common::Time::GetWallTime().Double() - time;
+		}
+
+		_hold( slot );
+		return slot;
+	}
+
+	// slot for the next capture, NULL instead of waiting while every slot is referenced
+	FrameSlot *tryAcquire()
+	{
+		lock_guard< mutex > lock( m_mutex );
+		FrameSlot *slot = _findFreeSlot();
+		if( slot )
+		{
+			_hold( slot );
+		}
+		return slot;
+	}
+
+	// hand a captured slot to the pipeline, its reference is dropped after processing
+	void submit( FrameSlot *_slot )
+	{
+		if( !m_thread.joinable() )
+		{
+			m_process( *_slot );
+			release( _slot );
+			return;
+		}
+
+		{
+			lock_guard< mutex > lock( m_mutex );
+			m_queue.push_back( _slot );
+		}
+		m_submit_cv.notify_one();
+	}
+
+	// one more reference of _slot, dropped with the last copy of the returned pointer
+	shared_ptr< FrameSlot > share( FrameSlot *_slot )
+	{
+		{
+			lock_guard< mutex > lock( m_mutex );
+			_slot->references++;
+		}
+		return shared_ptr< FrameSlot >( _slot, [ this ]( FrameSlot *_shared ){ release( _shared ); } );
+	}
+
+	void release( FrameSlot *_slot )
+	{
+		bool is_free;
+		{
+			lock_guard< mutex > lock( m_mutex );
+			is_free = --_slot->references == 0;
+		}
+		if( is_free )
+		{
+			m_free_cv.notify_all();
+		}
+	}
+
+	// block until every submitted frame is processed
+	void flush()
+	{
+		unique_lock< mutex > lock( m_mutex );
+		m_idle_cv.wait( lock, [this]{ return m_queue.empty() && m_processing == 0; } );
+	}
+
+	FrameSlot *getSlot( int _index )
+	{
+		return m_slots[ _index ];
+	}
+
+	FrameScratch &getScratch()
+	{
+		return m_scratch;
+	}
+
+	int getNumSlots() const
+	{
+		return m_slots.size();
+	}
+
+	// frames acquired so far
+	unsigned long getCaptured()
+	{
+		lock_guard< mutex > lock( m_mutex );
+		return m_captured;
+	}
+
+	// acquire() calls that had to wait for a slot & the seconds they waited
+	unsigned long getStalls()
+	{
+		lock_guard< mutex > lock( m_mutex );
+		return m_stalls;
+	}
+
+	double getStallTime()
+	{
+		lock_guard< mutex > lock( m_mutex );
+		return m_stall_time;
+	}
+
+private:
+	// cache line aligned, so row tiles of different workers never share a line at a buffer's start
+	static void *_allocate( size_t _bytes )
+	{
+		void *ptr = NULL;
+		if( posix_memalign( &ptr, CACHE_LINE_SIZE, _bytes ) != 0 )
+		{
+			throw bad_alloc();
+		}
+		return ptr;
+	}
+
+	// m_mutex must be locked, slots are handed out in ring order if possible
+	FrameSlot *_findFreeSlot()
+	{
+		for( unsigned int i = 0; i < m_slots.size(); i++ )
+		{
+			FrameSlot *slot = m_slots[ ( m_next_slot + i ) % m_slots.size() ];
+			if( slot->references == 0 )
+			{
+				return slot;
+			}
+		}
+		return NULL;
+	}
+
+	// m_mutex must be locked, the capture holds the first reference
+	void _hold( FrameSlot *_slot )
+	{
+		_slot->references = 1;
+		_slot->frame = m_captured++;
+		m_next_slot = ( _slot->index + 1 ) % m_slots.size();
+	}
+
+	void _threadLoop()
+	{
+		if( !m_cpus.empty() && !WorkerPool::pinCurrentThread( m_cpus ) )
+		{
+			cerr << "[FrameRing] failed to pin pipeline thread" << endl;
+		}
+
+		while( true )
+		{
+			FrameSlot *slot;
+			{
+				unique_lock< mutex > lock( m_mutex );
+				m_submit_cv.wait( lock, [this]{ return m_stop || !m_queue.empty(); } );
+				if( m_queue.empty() )
+				{
+					return;
+				}
+				slot = m_queue.front();
+				m_queue.pop_front();
+				m_processing++;
+			}
+
+			m_process( *slot );
+			release( slot );
+
+			{
+				lock_guard< mutex > lock( m_mutex );
+				m_processing--;
+			}
+			m_idle_cv.notify_all();
+		}
+	}
+
+public:
+
+private:
+	static const size_t CACHE_LINE_SIZE = 64;
+
+	vector< FrameSlot* > m_slots;
+	FrameScratch m_scratch;
+
+	// post process & publish of one slot
+	Process m_process;
+	// cpus of the pipeline thread ( empty if not pinned )
+	vector< int > m_cpus;
+	// not started with a single slot
+	thread m_thread;
+
+	// guards everything below & the references of every slot
+	mutex m_mutex;
+	condition_variable m_submit_cv;
+	condition_variable m_free_cv;
+	condition_variable m_idle_cv;
+	deque< FrameSlot* > m_queue;
+	bool m_stop;
+	// slots being processed by the pipeline thread
+	int m_processing;
+	// where _findFreeSlot() starts
+	int m_next_slot;
+
+	// metrics
+	unsigned long m_captured;
+	unsigned long m_stalls;
+	double m_stall_time;
+};
+
+#endif /* FRAME_RING_H_ */
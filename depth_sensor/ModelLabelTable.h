@@ -0,0 +1,211 @@
+/*
+ * ModelLabelTable.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef MODEL_LABEL_TABLE_H_
+#define MODEL_LABEL_TABLE_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+// how models are written into the segment buffer
+enum SegmentEncoding
+{
+	// 1 byte per pixel, ( i + 1 ) / number of models * 255 for model i, collides above 255 models
+	SEGMENT_ENCODING_GREY = 0,
+	// 4 bytes per pixel, ModelLabelTable::getId() : class id << 24 | instance id, stable while models come & go
+	SEGMENT_ENCODING_ID
+};
+
+inline int segmentBytes( SegmentEncoding _encoding )
+{
+	return _encoding == SEGMENT_ENCODING_ID ? 4 : 1;
+}
+
+// label of pixel _idx in a segment buffer
+inline uint32_t segmentLabel( const unsigned char *_segment, SegmentEncoding _encoding, size_t _idx )
+{
+	if( _encoding == SEGMENT_ENCODING_GREY )
+	{
+		return _segment[ _idx ];
+	}
+	uint32_t label;
+	memcpy( &label, _segment + _idx * 4, sizeof( label ) );
+	return label;
+}
+
+// Models of the scene in insertion order, model i is labeled ( i + 1 ) / number of models.
+// Names are hashed when a model is inserted, so finding the model of an entity doesn't depend on the pile size.
+// Every model also gets a stable id : an instance id that is never reused by another name, and the id of its class,
+// the model name without the "_N" suffix of spawned parts ( "part_12" & "part_13" are both of class "part" ).
+// Both are packed in 32 bits as class id << 24 | instance id, 0 is left for the background.
+class ModelLabelTable
+{
+public:
+	static const uint32_t MAX_INSTANCE_ID = ( 1u << 24 ) - 1;
+	static const uint32_t MAX_CLASS_ID = 255;
+
+public:
+	ModelLabelTable()
+		: m_next_instance_id( 1 ),
+		  m_next_class_id( 1 )
+	{
+	}
+	~ModelLabelTable()
+	{
+	}
+
+	// false if _name is already in the table
+	bool insert( const string &_name )
+	{
+		if( !m_index.insert( make_pair( _name, (int)m_names.size() ) ).second )
+		{
+			return false;
+		}
+		m_names.push_back( _name );
+		m_ids.push_back( _assignId( _name ) );
+		return true;
+	}
+
+	// models behind _name move one index forward
+	bool remove( const string &_name )
+	{
+		unordered_map< string, int >::iterator iter = m_index.find( _name );
+		if( iter == m_index.end() )
+		{
+			return false;
+		}
+
+		int idx = iter->second;
+		m_index.erase( iter );
+		m_names.erase( m_names.begin() + idx );
+		m_ids.erase( m_ids.begin() + idx );
+		for( unsigned int i = idx; i < m_names.size(); i++ )
+		{
+			m_index[ m_names[i] ] = i;
+		}
+		return true;
+	}
+
+	// ids stay assigned, a model inserted again gets the same id
+	void clear()
+	{
+		m_index.clear();
+		m_names.clear();
+		m_ids.clear();
+	}
+
+	// index of _name, -1 if it is not in the table
+	int find( const string &_name ) const
+	{
+		unordered_map< string, int >::const_iterator iter = m_index.find( _name );
+		return iter != m_index.end() ? iter->second : -1;
+	}
+
+	// label of model _idx in 0 ~ 1, 0 is left for the background
+	float getLabel( int _idx ) const
+	{
+		return ( _idx + 1.0f ) / m_names.size();
+	}
+
+	// class id << 24 | instance id of model _idx
+	uint32_t getId( int _idx ) const
+	{
+		return m_ids[ _idx ];
+	}
+
+	static uint32_t getInstanceId( uint32_t _id )
+	{
+		return _id & MAX_INSTANCE_ID;
+	}
+
+	static uint32_t getClassId( uint32_t _id )
+	{
+		return _id >> 24;
+	}
+
+	const vector< string > &getNames() const
+	{
+		return m_names;
+	}
+
+	// in the order of getNames()
+	const vector< uint32_t > &getIds() const
+	{
+		return m_ids;
+	}
+
+	int size() const
+	{
+		return m_names.size();
+	}
+
+private:
+	uint32_t _assignId( const string &_name )
+	{
+		unordered_map< string, uint32_t >::iterator iter = m_assigned_ids.find( _name );
+		if( iter != m_assigned_ids.end() )
+		{
+			return iter->second;
+		}
+
+		// "part_12" => "part"
+		string class_name = _name;
+		size_t pos = _name.find_last_not_of( "0123456789" );
+		if( pos != string::npos && pos + 1 < _name.size() && _name[ pos ] == '_' && pos > 0 )
+		{
+			class_name = _name.substr( 0, pos );
+		}
+
+		uint32_t class_id;
+		unordered_map< string, uint32_t >::iterator class_iter = m_class_ids.find( class_name );
+		if( class_iter != m_class_ids.end() )
+		{
+			class_id = class_iter->second;
+		}
+		else
+		{
+			// classes beyond MAX_CLASS_ID share the last one
+			class_id = m_next_class_id;
+			if( m_next_class_id < MAX_CLASS_ID )
+			{
+				m_next_class_id++;
+			}
+			m_class_ids[ class_name ] = class_id;
+		}
+
+		// instances beyond MAX_INSTANCE_ID wrap around, 16 million spawns before it happens
+		uint32_t instance_id = m_next_instance_id;
+		m_next_instance_id = m_next_instance_id % MAX_INSTANCE_ID + 1;
+
+		uint32_t id = class_id << 24 | instance_id;
+		m_assigned_ids[ _name ] = id;
+		return id;
+	}
+
+public:
+
+private:
+	vector< string > m_names;
+	// id of every model in m_names
+	vector< uint32_t > m_ids;
+	// name => index in m_names
+	unordered_map< string, int > m_index;
+
+	// id of every name ever inserted, so a model keeps it's id when others come & go
+	unordered_map< string, uint32_t > m_assigned_ids;
+	// class name => class id
+	unordered_map< string, uint32_t > m_class_ids;
+	uint32_t m_next_instance_id;
+	uint32_t m_next_class_id;
+};
+
+#endif /* MODEL_LABEL_TABLE_H_ */
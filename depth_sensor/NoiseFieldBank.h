@@ -0,0 +1,273 @@
+/*
+ * NoiseFieldBank.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef NOISE_FIELD_BANK_H_
+#define NOISE_FIELD_BANK_H_
+
+#include <math.h>
+#include <string.h>
+#include <random>
+#include <vector>
+#include <iostream>
+
+#include "PerlinNoiseEngine.h"
+
+using namespace std;
+
+// Large tileable perlin noise fields ( one per grid size ) generated once.
+// Each sample() reads a sensor sized window of every field at a random toroidal offset, optionally flipped,
+// which is statistically the same as generating new perlin noise but only costs memory reads.
+class NoiseFieldBank
+{
+private:
+	struct Field
+	{
+		int grid_size;
+		vector< float > data;
+	};
+
+	// window of a field read by one octave of sample()
+	struct Window
+	{
+		const Field *field;
+		int offset_x;
+		int offset_y;
+		bool flip_x;
+		bool flip_y;
+	};
+
+public:
+	// _budget_bytes limits the memory of all fields, fields are never smaller than the sensor
+	// generating & sampling are split over _pool if not NULL
+	NoiseFieldBank(	const vector< int >	&_grid_sizes,
+					int					_width,
+					int					_height,
+					size_t				_budget_bytes,
+					unsigned int		_seed = random_device()(),
+					WorkerPool			*_pool = NULL )
+		: m_width( _width ),
+		  m_height( _height ),
+		  m_pool( _pool ),
+		  m_field_width( 0 ),
+		  m_field_height( 0 ),
+		  m_rng( _seed )
+	{
+		// fields must be multiples of every grid size to be tileable
+		int period = 1;
+		for( unsigned int i = 0; i < _grid_sizes.size(); i++ )
+		{
+			period = _lcm( period, _grid_sizes[i] );
+		}
+
+		int min_width = _roundUp( _width, period );
+		int min_height = _roundUp( _height, period );
+		size_t min_bytes = _grid_sizes.size() * sizeof( float ) * min_width * min_height;
+		if( _grid_sizes.empty() || _budget_bytes < min_bytes )
+		{
+			cerr << "NoiseFieldBank : budget " << _budget_bytes << " bytes is less than " << min_bytes << " bytes, bank is not built" << endl;
+			return;
+		}
+
+		// grow both sides by the same factor to fill the budget
+		double factor = sqrt( (double)_budget_bytes / min_bytes );
+		m_field_width = max( min_width, (int)( min_width * factor ) / period * period );
+		m_field_height = max( min_height, (int)( min_height * factor ) / period * period );
+
+		PerlinNoiseEngine engine( m_field_width, m_field_height, m_rng(), m_pool );
+		m_fields.resize( _grid_sizes.size() );
+		for( unsigned int i = 0; i < _grid_sizes.size(); i++ )
+		{
+			m_fields[i].grid_size = _grid_sizes[i];
+			m_fields[i].data.resize( m_field_width * m_field_height );
+			engine.generateTileable( _grid_sizes[i], &m_fields[i].data[0] );
+		}
+		m_windows.resize( m_fields.size() );
+	}
+	~NoiseFieldBank()
+	{
+	}
+
+	// false if the budget couldn't hold fields of sensor size
+	bool isValid() const
+	{
+		return !m_fields.empty();
+	}
+
+	bool hasGridSize( int _grid_size ) const
+	{
+		return _findField( _grid_size ) != NULL;
+	}
+
+	int getFieldWidth() const
+	{
+		return m_field_width;
+	}
+
+	int getFieldHeight() const
+	{
+		return m_field_height;
+	}
+
+	size_t getBytes() const
+	{
+		return m_fields.size() * sizeof( float ) * m_field_width * m_field_height;
+	}
+
+	// single octave, _noise must hold width * height floats
+	void sample( int _grid_size, float *_noise )
+	{
+		sample( &_grid_size, 1, _noise );
+	}
+
+	// sum of octaves of _grid_sizes, every grid size must be in the bank, _noise must hold width * height floats
+	void sample( const vector< int > &_grid_sizes, float *_noise )
+	{
+		sample( _grid_sizes.data(), _grid_sizes.size(), _noise );
+	}
+
+	// sum of _num_octaves octaves of _grid_sizes, octaves beyond the number of fields are left out
+	void sample( const int *_grid_sizes, int _num_octaves, float *_noise )
+	{
+		// random toroidal offset & flip of every octave
+		int num_windows = min( _num_octaves, (int)m_windows.size() );
+		for( int o = 0; o < num_windows; o++ )
+		{
+			Window &window = m_windows[o];
+			window.field = _findField( _grid_sizes[o] );
+			window.offset_x = m_rng() % m_field_width;
+			window.offset_y = m_rng() % m_field_height;
+			window.flip_x = m_rng() & 1;
+			window.flip_y = m_rng() & 1;
+		}
+
+		// sum every octave row by row, so the output row stays in cache
+		auto sample_rows = [&]( int _y0, int _y1 )
+		{
+			for( int j = _y0; j < _y1; j++ )
+			{
+				for( int o = 0; o < num_windows; o++ )
+				{
+					const Window &window = m_windows[o];
+					int src_y = window.flip_y ? window.offset_y - j : window.offset_y + j;
+					src_y = ( src_y % m_field_height + m_field_height ) % m_field_height;
+
+					_sampleRow(	&window.field->data[ src_y * m_field_width ],
+								window.offset_x,
+								window.flip_x,
+								_noise + j * m_width,
+								o != 0 );
+				}
+			}
+		};
+
+		if( m_pool )
+		{
+			m_pool->parallelFor( 0, m_height, TILE_ROWS, sample_rows );
+		}
+		else
+		{
+			sample_rows( 0, m_height );
+		}
+	}
+
+private:
+	// read m_width values of a field row starting from _offset_x, wrapping around the field
+	void _sampleRow( const float *_src, int _offset_x, bool _flip, float *_dst, bool _accumulate )
+	{
+		int i = 0;
+		int src_x = _offset_x;
+		while( i < m_width )
+		{
+			// values left before wrapping around
+			int run = _flip ? src_x + 1 : m_field_width - src_x;
+			run = min( run, m_width - i );
+
+			if( !_flip && !_accumulate )
+			{
+				memcpy( _dst + i, _src + src_x, run * sizeof( float ) );
+			}
+			else
+			{
+				_copyRun( _src + src_x, _flip, _dst + i, run, _accumulate );
+			}
+
+			i += run;
+			src_x = _flip ? m_field_width - 1 : 0;
+		}
+	}
+
+	// _dst[k] ( += ) _src[k], or _src[-k] if _reverse
+	void _copyRun( const float *_src, bool _reverse, float *_dst, int _length, bool _accumulate )
+	{
+		int k = 0;
+#ifdef PERLIN_NOISE_X86
+		for( ; k + 4 <= _length; k += 4 )
+		{
+			__m128 value = _reverse ?	_mm_shuffle_ps( _mm_loadu_ps( _src - k - 3 ), _mm_loadu_ps( _src - k - 3 ), _MM_SHUFFLE( 0, 1, 2, 3 ) ) :
+										_mm_loadu_ps( _src + k );
+			if( _accumulate )
+			{
+				value = _mm_add_ps( _mm_loadu_ps( _dst + k ), value );
+			}
+			_mm_storeu_ps( _dst + k, value );
+		}
+#endif
+		for( ; k < _length; k++ )
+		{
+			float value = _reverse ? _src[ -k ] : _src[k];
+			_dst[k] = _accumulate ? _dst[k] + value : value;
+		}
+	}
+
+	const Field *_findField( int _grid_size ) const
+	{
+		for( unsigned int i = 0; i < m_fields.size(); i++ )
+		{
+			if( m_fields[i].grid_size == _grid_size )
+			{
+				return &m_fields[i];
+			}
+		}
+		return NULL;
+	}
+
+	static int _gcd( int _a, int _b )
+	{
+		return _b == 0 ? _a : _gcd( _b, _a % _b );
+	}
+
+	static int _lcm( int _a, int _b )
+	{
+		return _a / _gcd( _a, _b ) * _b;
+	}
+
+	static int _roundUp( int _value, int _multiple )
+	{
+		return ( _value + _multiple - 1 ) / _multiple * _multiple;
+	}
+
+public:
+
+private:
+	static const int TILE_ROWS = 32;
+
+	// sensor resolution
+	int m_width;
+	int m_height;
+	// split rows into tiles ( NULL for single thread )
+	WorkerPool *m_pool;
+	// resolution of every field
+	int m_field_width;
+	int m_field_height;
+	// one tileable field per grid size
+	vector< Field > m_fields;
+	// window of every octave of the current sample(), one per field
+	vector< Window > m_windows;
+	// random offsets & flips
+	mt19937 m_rng;
+};
+
+#endif /* NOISE_FIELD_BANK_H_ */
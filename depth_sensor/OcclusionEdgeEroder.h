@@ -0,0 +1,381 @@
+/*
+ * OcclusionEdgeEroder.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef OCCLUSION_EDGE_ERODER_H_
+#define OCCLUSION_EDGE_ERODER_H_
+
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+#if defined( __SSE2__ )
+#include <emmintrin.h>
+#endif
+
+#include "WorkerPool.h"
+
+using namespace std;
+
+// Grows invalid pixels on the border of invalid regions by a per pixel radius ( diamond shaped, L1 distance ).
+// Same result as stamping a diamond of radius r on every invalid edge pixel, but in O( width * height ):
+//   a pixel is eroded if max over edge pixels s of ( r(s) - |p - s|_1 ) >= 0,
+// which is a max-plus L1 distance transform, separable into one pass along rows and one along columns.
+// Values are kept in one byte as r + 1 ( 0 means not reached ), both passes run in parallel over row bands of a WorkerPool.
+class OcclusionEdgeEroder
+{
+public:
+	// one row band per thread of _pool, single band if NULL
+	OcclusionEdgeEroder(	int				_width,
+							int				_height,
+							WorkerPool		*_pool = NULL )
+		: m_width( _width ),
+		  m_height( _height ),
+		  m_pool( _pool ),
+		  m_row_pass( _width * _height )
+	{
+		m_num_bands = m_pool ? m_pool->getNumThreads() : 1;
+		// bands shorter than a few rows are not worth a thread
+		m_num_bands = min( m_num_bands, max( 1, m_height / 16 ) );
+		m_band_max_radius.resize( m_num_bands );
+		m_band_column.resize( m_num_bands * m_width );
+		m_band_transposed.resize( m_num_bands * 16 * m_width );
+	}
+	~OcclusionEdgeEroder()
+	{
+	}
+
+	// _invalid : 1 byte per pixel, nonzero if the pixel is invalid
+	// _radius : 1 byte per pixel, erosion radius if the pixel is an invalid edge pixel
+	// _eroded : 1 byte per pixel, 255 if the pixel is reached by erosion, 0 otherwise ( must not alias the inputs )
+	// only pixels not on the image border with a valid 4-neighbor are edge pixels
+	void erode( const unsigned char *_invalid, const unsigned char *_radius, unsigned char *_eroded )
+	{
+		// ********************************** //
+		// seed edge pixels & pass along rows //
+		// ********************************** //
+		_runBands( [&]( int _band, int _y0, int _y1 )
+		{
+			m_band_max_radius[ _band ] = _rowPass( _invalid, _radius, _y0, _y1, &m_band_transposed[ _band * 16 * m_width ] );
+		} );
+
+		int max_radius = *max_element( m_band_max_radius.begin(), m_band_max_radius.end() );
+
+		// ********************************************************** //
+		// pass along columns, a band only needs max_radius more rows //
+		// ********************************************************** //
+		_runBands( [&]( int _band, int _y0, int _y1 )
+		{
+			_columnPass( max_radius, _y0, _y1, &m_band_column[ _band * m_width ], _eroded );
+		} );
+	}
+
+private:
+	// seed r + 1 on edge pixels and spread it along each row of [ _y0, _y1 ), return the largest radius
+	// _transposed is the band's scratch of 16 * width bytes
+	int _rowPass( const unsigned char *_invalid, const unsigned char *_radius, int _y0, int _y1, unsigned char *_transposed )
+	{
+		int max_radius = 0;
+
+		for( int j = _y0; j < _y1; j++ )
+		{
+			unsigned char *row = &m_row_pass[ j * m_width ];
+			memset( row, 0, m_width );
+
+			if( j == 0 || j == m_height - 1 )
+			{
+				continue;
+			}
+
+			max_radius = max( max_radius, _seedRow( _invalid + j * m_width, _radius + j * m_width, row ) );
+		}
+
+		int j = _y0;
+#if defined( __SSE2__ )
+		// 16 rows at once, one column of the block per vector
+		for( ; j + 16 <= _y1; j += 16 )
+		{
+			_spreadRowBlock( &m_row_pass[ j * m_width ], _transposed );
+		}
+#endif
+		for( ; j < _y1; j++ )
+		{
+			unsigned char *row = &m_row_pass[ j * m_width ];
+
+			// forward & backward, each step costs 1
+			for( int i = 1; i < m_width; i++ )
+			{
+				row[i] = max( row[i], _decrease( row[ i - 1 ] ) );
+			}
+			for( int i = m_width - 2; i >= 0; i-- )
+			{
+				row[i] = max( row[i], _decrease( row[ i + 1 ] ) );
+			}
+		}
+
+		return max_radius;
+	}
+
+	// r + 1 on edge pixels of an inner row, return the largest radius
+	int _seedRow( const unsigned char *_invalid, const unsigned char *_radius, unsigned char *_row )
+	{
+		int max_radius = 0;
+		int i = 1;
+#if defined( __SSE2__ )
+		__m128i zero = _mm_setzero_si128();
+		__m128i one = _mm_set1_epi8( 1 );
+		__m128i limit = _mm_set1_epi8( (char)254 );
+		__m128i max_vec = zero;
+		for( ; i + 16 <= m_width - 1; i += 16 )
+		{
+			// 0xff where a 4-neighbor is valid
+			__m128i valid_neighbor = _mm_or_si128(
+				_mm_or_si128(	_mm_cmpeq_epi8( _mm_loadu_si128( (const __m128i*)( _invalid + i - 1 ) ), zero ),
+								_mm_cmpeq_epi8( _mm_loadu_si128( (const __m128i*)( _invalid + i + 1 ) ), zero ) ),
+				_mm_or_si128(	_mm_cmpeq_epi8( _mm_loadu_si128( (const __m128i*)( _invalid + i - m_width ) ), zero ),
+								_mm_cmpeq_epi8( _mm_loadu_si128( (const __m128i*)( _invalid + i + m_width ) ), zero ) ) );
+			__m128i radius = _mm_min_epu8( _mm_loadu_si128( (const __m128i*)( _radius + i ) ), limit );
+
+			// invalid, radius >= 1 & a valid 4-neighbor
+			__m128i not_edge = _mm_or_si128(	_mm_cmpeq_epi8( _mm_loadu_si128( (const __m128i*)( _invalid + i ) ), zero ),
+												_mm_cmpeq_epi8( radius, zero ) );
+			__m128i edge = _mm_andnot_si128( not_edge, valid_neighbor );
+
+			_mm_storeu_si128( (__m128i*)( _row + i ), _mm_and_si128( edge, _mm_add_epi8( radius, one ) ) );
+			max_vec = _mm_max_epu8( max_vec, _mm_and_si128( edge, radius ) );
+		}
+		unsigned char lanes[16];
+		_mm_storeu_si128( (__m128i*)lanes, max_vec );
+		max_radius = *max_element( lanes, lanes + 16 );
+#endif
+		for( ; i < m_width - 1; i++ )
+		{
+			int radius = min( (int)_radius[i], 254 );
+
+			// check if is NaN point && do erosion if noise >= 1 ( erosion size )
+			if(	_invalid[i] &&
+				radius >= 1 &&
+				(	!_invalid[ i - 1 ] ||
+					!_invalid[ i + 1 ] ||
+					!_invalid[ i - m_width ] ||
+					!_invalid[ i + m_width ] ) )
+			{
+				_row[i] = radius + 1;
+				max_radius = max( max_radius, radius );
+			}
+		}
+
+		return max_radius;
+	}
+
+#if defined( __SSE2__ )
+	// forward & backward along 16 rows starting at _rows, transposed into _transposed so each step is one vector
+	void _spreadRowBlock( unsigned char *_rows, unsigned char *_transposed )
+	{
+		int full = m_width & ~15;
+		for( int i = 0; i < full; i += 16 )
+		{
+			_transpose16( _rows + i, m_width, _transposed + i * 16, 16 );
+		}
+		for( int i = full; i < m_width; i++ )
+		{
+			for( int r = 0; r < 16; r++ )
+			{
+				_transposed[ i * 16 + r ] = _rows[ i + r * m_width ];
+			}
+		}
+
+		__m128i one = _mm_set1_epi8( 1 );
+		__m128i cur = _mm_loadu_si128( (const __m128i*)_transposed );
+		for( int i = 1; i < m_width; i++ )
+		{
+			__m128i *column = (__m128i*)( _transposed + i * 16 );
+			cur = _mm_max_epu8( _mm_loadu_si128( column ), _mm_subs_epu8( cur, one ) );
+			_mm_storeu_si128( column, cur );
+		}
+		for( int i = m_width - 2; i >= 0; i-- )
+		{
+			__m128i *column = (__m128i*)( _transposed + i * 16 );
+			cur = _mm_max_epu8( _mm_loadu_si128( column ), _mm_subs_epu8( cur, one ) );
+			_mm_storeu_si128( column, cur );
+		}
+
+		for( int i = 0; i < full; i += 16 )
+		{
+			_transpose16( _transposed + i * 16, 16, _rows + i, m_width );
+		}
+		for( int i = full; i < m_width; i++ )
+		{
+			for( int r = 0; r < 16; r++ )
+			{
+				_rows[ i + r * m_width ] = _transposed[ i * 16 + r ];
+			}
+		}
+	}
+
+	// 16 x 16 bytes from _src to _dst, rows become columns
+	static void _transpose16( const unsigned char *_src, int _src_stride, unsigned char *_dst, int _dst_stride )
+	{
+		__m128i a[16], b[16];
+		for( int k = 0; k < 16; k++ )
+		{
+			a[k] = _mm_loadu_si128( (const __m128i*)( _src + k * _src_stride ) );
+		}
+		// rows 2k & 2k + 1 : columns 0 ~ 7, 8 ~ 15
+		for( int k = 0; k < 8; k++ )
+		{
+			b[ 2 * k ] = _mm_unpacklo_epi8( a[ 2 * k ], a[ 2 * k + 1 ] );
+			b[ 2 * k + 1 ] = _mm_unpackhi_epi8( a[ 2 * k ], a[ 2 * k + 1 ] );
+		}
+		// rows 4k ~ 4k + 3 : columns 0 ~ 3, 4 ~ 7, 8 ~ 11, 12 ~ 15
+		for( int k = 0; k < 4; k++ )
+		{
+			a[ 4 * k ] = _mm_unpacklo_epi16( b[ 4 * k ], b[ 4 * k + 2 ] );
+			a[ 4 * k + 1 ] = _mm_unpackhi_epi16( b[ 4 * k ], b[ 4 * k + 2 ] );
+			a[ 4 * k + 2 ] = _mm_unpacklo_epi16( b[ 4 * k + 1 ], b[ 4 * k + 3 ] );
+			a[ 4 * k + 3 ] = _mm_unpackhi_epi16( b[ 4 * k + 1 ], b[ 4 * k + 3 ] );
+		}
+		// rows 8k ~ 8k + 7 : columns 2m & 2m + 1 in b[ 8k + m ]
+		for( int k = 0; k < 2; k++ )
+		{
+			for( int m = 0; m < 4; m++ )
+			{
+				b[ 8 * k + 2 * m ] = _mm_unpacklo_epi32( a[ 8 * k + m ], a[ 8 * k + 4 + m ] );
+				b[ 8 * k + 2 * m + 1 ] = _mm_unpackhi_epi32( a[ 8 * k + m ], a[ 8 * k + 4 + m ] );
+			}
+		}
+		for( int m = 0; m < 8; m++ )
+		{
+			_mm_storeu_si128( (__m128i*)( _dst + 2 * m * _dst_stride ), _mm_unpacklo_epi64( b[m], b[ 8 + m ] ) );
+			_mm_storeu_si128( (__m128i*)( _dst + ( 2 * m + 1 ) * _dst_stride ), _mm_unpackhi_epi64( b[m], b[ 8 + m ] ) );
+		}
+	}
+#endif
+
+	// spread row pass results along columns into rows [ _y0, _y1 ) of _eroded, _cur is a row of the band's scratch
+	void _columnPass( int _max_radius, int _y0, int _y1, unsigned char *_cur, unsigned char *_eroded )
+	{
+		int start = max( 0, _y0 - _max_radius );
+		int end = min( m_height, _y1 + _max_radius );
+
+		// forward, downward from start, kept in _eroded
+		memcpy( _cur, &m_row_pass[ start * m_width ], m_width );
+		for( int j = start; j < _y1; j++ )
+		{
+			if( j > start )
+			{
+				_maxDecreased( &m_row_pass[ j * m_width ], _cur, _cur );
+			}
+			if( j >= _y0 )
+			{
+				memcpy( _eroded + j * m_width, _cur, m_width );
+			}
+		}
+
+		// backward, upward from end, merged with forward
+		memcpy( _cur, &m_row_pass[ ( end - 1 ) * m_width ], m_width );
+		for( int j = end - 1; j >= _y0; j-- )
+		{
+			if( j < end - 1 )
+			{
+				_maxDecreased( &m_row_pass[ j * m_width ], _cur, _cur );
+			}
+			if( j < _y1 )
+			{
+				_finalize( _cur, _eroded + j * m_width );
+			}
+		}
+	}
+
+	// _dst = max( _row, _prev - 1 )
+	void _maxDecreased( const unsigned char *_row, const unsigned char *_prev, unsigned char *_dst )
+	{
+		int i = 0;
+#if defined( __SSE2__ )
+		__m128i one = _mm_set1_epi8( 1 );
+		for( ; i + 16 <= m_width; i += 16 )
+		{
+			__m128i prev = _mm_subs_epu8( _mm_loadu_si128( (const __m128i*)( _prev + i ) ), one );
+			_mm_storeu_si128( (__m128i*)( _dst + i ), _mm_max_epu8( _mm_loadu_si128( (const __m128i*)( _row + i ) ), prev ) );
+		}
+#endif
+		for( ; i < m_width; i++ )
+		{
+			_dst[i] = max( _row[i], _decrease( _prev[i] ) );
+		}
+	}
+
+	// _eroded = 255 if max( _eroded, _backward ) reached a pixel
+	void _finalize( const unsigned char *_backward, unsigned char *_eroded )
+	{
+		int i = 0;
+#if defined( __SSE2__ )
+		__m128i zero = _mm_setzero_si128();
+		for( ; i + 16 <= m_width; i += 16 )
+		{
+			__m128i value = _mm_max_epu8( _mm_loadu_si128( (const __m128i*)( _eroded + i ) ), _mm_loadu_si128( (const __m128i*)( _backward + i ) ) );
+			// 0xff where value != 0
+			_mm_storeu_si128( (__m128i*)( _eroded + i ), _mm_xor_si128( _mm_cmpeq_epi8( value, zero ), _mm_set1_epi8( -1 ) ) );
+		}
+#endif
+		for( ; i < m_width; i++ )
+		{
+			_eroded[i] = ( _eroded[i] || _backward[i] ) ? 255 : 0;
+		}
+	}
+
+	static unsigned char _decrease( unsigned char _value )
+	{
+		return _value > 0 ? _value - 1 : 0;
+	}
+
+	// call _func( band, first row, last row + 1 ) for every row band
+	template< typename Func >
+	void _runBands( const Func &_func )
+	{
+		auto run_bands = [&]( int _first, int _last )
+		{
+			for( int band = _first; band < _last; band++ )
+			{
+				_func( band, _bandStart( band ), _bandStart( band + 1 ) );
+			}
+		};
+
+		if( m_pool )
+		{
+			m_pool->parallelFor( 0, m_num_bands, 1, run_bands );
+		}
+		else
+		{
+			run_bands( 0, m_num_bands );
+		}
+	}
+
+	int _bandStart( int _band )
+	{
+		return (int)( (long)m_height * _band / m_num_bands );
+	}
+
+public:
+
+private:
+	// image resolution
+	int m_width;
+	int m_height;
+	// split row bands over threads ( NULL for single thread )
+	WorkerPool *m_pool;
+	// number of row bands
+	int m_num_bands;
+	// r + 1 spread along rows
+	vector< unsigned char > m_row_pass;
+	// largest radius of each band
+	vector< int > m_band_max_radius;
+	// one row per band, column pass state
+	vector< unsigned char > m_band_column;
+	// 16 rows per band, row pass of a block of rows, transposed
+	vector< unsigned char > m_band_transposed;
+};
+
+#endif /* OCCLUSION_EDGE_ERODER_H_ */
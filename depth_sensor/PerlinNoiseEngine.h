@@ -0,0 +1,390 @@
+/*
+ * PerlinNoiseEngine.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef PERLIN_NOISE_ENGINE_H_
+#define PERLIN_NOISE_ENGINE_H_
+
+#include <math.h>
+#include <random>
+#include <vector>
+
+#include "WorkerPool.h"
+
+#if defined( __GNUC__ ) && ( defined( __x86_64__ ) || defined( __i386__ ) )
+#include <immintrin.h>
+#define PERLIN_NOISE_X86
+#endif
+
+using namespace std;
+
+// Generates perlin noise ( same gradient & interpolation as Ken Perlin's improved noise ) of a fixed resolution.
+// Every generate() draws new gradients from the engine's own random generator, so noises generated in the same second differ.
+// Several octaves are summed in one pass into a caller provided buffer.
+class PerlinNoiseEngine
+{
+private:
+	// lookup tables of one grid size, built once
+	struct Octave
+	{
+		int grid_size;
+		int grid_width;
+		int grid_height;
+		// fade curve of every local coordinate in a grid, 6t^5 - 15t^4 + 10t^3
+		vector< float > fade;
+		// grid index of every column
+		vector< int > grid_x;
+		// ( 1 - wx ) * lx, ( 1 - wx ), wx * ( lx - grid_size + 1 ), wx of every column
+		vector< float > col_p, col_q, col_r, col_s;
+		// pseudorandom gradient of every grid point
+		vector< float > grad_x, grad_y;
+	};
+
+public:
+	// rows are split over _pool if not NULL
+	PerlinNoiseEngine(	int				_width,
+						int				_height,
+						unsigned int	_seed = random_device()(),
+						WorkerPool		*_pool = NULL )
+		: m_width( _width ),
+		  m_height( _height ),
+		  m_pool( _pool ),
+		  m_rng( _seed ),
+		  m_degree_dist( 0, 35999 )
+	{
+		// gradient directions are 0.01 degree apart
+		m_dir_cos.resize( 36000 );
+		m_dir_sin.resize( 36000 );
+		for( int i = 0; i < 36000; i++ )
+		{
+			float degree = i / 100.f;
+			m_dir_cos[i] = cos( degree * M_PI / 180.f );
+			m_dir_sin[i] = sin( degree * M_PI / 180.f );
+		}
+
+#ifdef PERLIN_NOISE_X86
+		m_use_avx = __builtin_cpu_supports( "avx" );
+#endif
+	}
+	~PerlinNoiseEngine()
+	{
+	}
+
+	void seed( unsigned int _seed )
+	{
+		m_rng.seed( _seed );
+	}
+
+	int getWidth() const
+	{
+		return m_width;
+	}
+
+	int getHeight() const
+	{
+		return m_height;
+	}
+
+	// single octave, _noise must hold width * height floats
+	void generate( int _grid_size, float *_noise )
+	{
+		generate( &_grid_size, 1, _noise );
+	}
+
+	// sum of octaves of _grid_sizes, _noise must hold width * height floats
+	void generate( const vector< int > &_grid_sizes, float *_noise )
+	{
+		generate( _grid_sizes.data(), _grid_sizes.size(), _noise );
+	}
+
+	// sum of _num_octaves octaves of _grid_sizes, _noise must hold width * height floats
+	void generate( const int *_grid_sizes, int _num_octaves, float *_noise )
+	{
+		_generate( _grid_sizes, NULL, _num_octaves, _noise, false );
+	}
+
+	// weighted sum of octaves of _grid_sizes, _noise must hold width * height floats
+	void generate( const vector< int > &_grid_sizes, const vector< float > &_weights, float *_noise )
+	{
+		_generate( _grid_sizes.data(), _weights.data(), _grid_sizes.size(), _noise, false );
+	}
+
+	// single octave which repeats seamlessly in both directions, width & height must be multiples of _grid_size
+	void generateTileable( int _grid_size, float *_noise )
+	{
+		_generate( &_grid_size, NULL, 1, _noise, true );
+	}
+
+private:
+	// _weights of every octave, 1 if NULL
+	void _generate( const int *_grid_sizes, const float *_weights, int _num_octaves, float *_noise, bool _tileable )
+	{
+		// build lookup tables first, m_octaves may grow
+		for( int o = 0; o < _num_octaves; o++ )
+		{
+			_getOctave( _grid_sizes[o] );
+		}
+
+		// scratch only grows for more octaves than any call before
+		m_active_octaves.resize( _num_octaves );
+		size_t coeff_size = (size_t)( ( m_height + TILE_ROWS - 1 ) / TILE_ROWS ) * _num_octaves * 4 * m_width;
+		if( m_coeff.size() < coeff_size )
+		{
+			m_coeff.resize( coeff_size );
+		}
+
+		for( int o = 0; o < _num_octaves; o++ )
+		{
+			m_active_octaves[o] = &_getOctave( _grid_sizes[o] );
+			_randomizeGradient( *m_active_octaves[o] );
+			if( _tileable )
+			{
+				_wrapGradient( *m_active_octaves[o] );
+			}
+		}
+
+		// rows only depend on gradients, split them into tiles
+		if( m_pool )
+		{
+			m_pool->parallelFor( 0, m_height, TILE_ROWS, [&]( int _y0, int _y1 )
+			{
+				_generateRows( _weights, _noise, _y0, _y1 );
+			} );
+		}
+		else
+		{
+			_generateRows( _weights, _noise, 0, m_height );
+		}
+	}
+
+	void _generateRows( const float *_weights, float *_noise, int _y0, int _y1 )
+	{
+		// noise of a row = c0 + wy * c1 + ly * ( c2 + wy * c3 ), constant inside one grid row
+		int num_octaves = m_active_octaves.size();
+		float *coeff = &m_coeff[ (size_t)( _y0 / TILE_ROWS ) * num_octaves * 4 * m_width ];
+
+		for( int j = _y0; j < _y1; j++ )
+		{
+			float *row = _noise + j * m_width;
+
+			for( int o = 0; o < num_octaves; o++ )
+			{
+				Octave &octave = *m_active_octaves[o];
+				int local_y = j % octave.grid_size;
+				float *c = coeff + o * 4 * m_width;
+
+				// entering a new grid row
+				if( local_y == 0 || j == _y0 )
+				{
+					_prepareGridRow( octave, j / octave.grid_size, _weights ? _weights[o] : 1.f, c );
+				}
+
+				_rowKernel(	row,
+							c, c + m_width, c + 2 * m_width, c + 3 * m_width,
+							octave.fade[ local_y ],
+							(float)local_y,
+							o != 0 );
+			}
+		}
+	}
+
+	Octave &_getOctave( int _grid_size )
+	{
+		for( unsigned int i = 0; i < m_octaves.size(); i++ )
+		{
+			if( m_octaves[i].grid_size == _grid_size )
+			{
+				return m_octaves[i];
+			}
+		}
+
+		m_octaves.push_back( Octave() );
+		Octave &octave = m_octaves.back();
+
+		octave.grid_size = _grid_size;
+		octave.grid_width = m_width / _grid_size + 1 + 1;	// first +1 is for completeness, second +1 is for ( _width % _grid_size != 0 )
+		octave.grid_height = m_height / _grid_size + 1 + 1;
+
+		// improved method from Ken Perlin	// http://mrl.nyu.edu/~perlin/paper445.pdf
+		octave.fade.resize( _grid_size );
+		for( int i = 0; i < _grid_size; i++ )
+		{
+			float t = (float)i / _grid_size;
+			octave.fade[i] = t * t * t * ( t * ( t * 6 - 15 ) + 10 );
+		}
+
+		octave.grid_x.resize( m_width );
+		octave.col_p.resize( m_width );
+		octave.col_q.resize( m_width );
+		octave.col_r.resize( m_width );
+		octave.col_s.resize( m_width );
+		for( int i = 0; i < m_width; i++ )
+		{
+			int local_x = i % _grid_size;
+			float weight_x = octave.fade[ local_x ];
+
+			octave.grid_x[i] = i / _grid_size;
+			octave.col_p[i] = ( 1 - weight_x ) * local_x;
+			octave.col_q[i] = 1 - weight_x;
+			octave.col_r[i] = weight_x * ( local_x - ( _grid_size - 1 ) );
+			octave.col_s[i] = weight_x;
+		}
+
+		octave.grad_x.resize( octave.grid_width * octave.grid_height );
+		octave.grad_y.resize( octave.grid_width * octave.grid_height );
+
+		return octave;
+	}
+
+	void _randomizeGradient( Octave &_octave )
+	{
+		for( unsigned int i = 0; i < _octave.grad_x.size(); i++ )
+		{
+			int degree = m_degree_dist( m_rng );
+			_octave.grad_x[i] = m_dir_cos[ degree ];
+			_octave.grad_y[i] = m_dir_sin[ degree ];
+		}
+	}
+
+	// make the last grid column & row the same as the first ones, so the noise wraps around
+	void _wrapGradient( Octave &_octave )
+	{
+		int period_x = m_width / _octave.grid_size;
+		int period_y = m_height / _octave.grid_size;
+
+		for( int j = 0; j < _octave.grid_height; j++ )
+		{
+			for( int i = 0; i < _octave.grid_width; i++ )
+			{
+				int src = i % period_x + ( j % period_y ) * _octave.grid_width;
+				_octave.grad_x[ i + j * _octave.grid_width ] = _octave.grad_x[ src ];
+				_octave.grad_y[ i + j * _octave.grid_width ] = _octave.grad_y[ src ];
+			}
+		}
+	}
+
+	// expand the gradients of grid row _gy to per column coefficients c0, c1, c2 & c3 in _coeff
+	void _prepareGridRow( const Octave &_octave, int _gy, float _weight, float *_coeff )
+	{
+		const float *grad_x0 = &_octave.grad_x[ _gy * _octave.grid_width ];
+		const float *grad_y0 = &_octave.grad_y[ _gy * _octave.grid_width ];
+		const float *grad_x1 = grad_x0 + _octave.grid_width;
+		const float *grad_y1 = grad_y0 + _octave.grid_width;
+		float last = _octave.grid_size - 1;
+
+		for( int i = 0; i < m_width; i++ )
+		{
+			int gx = _octave.grid_x[i];
+			float p = _octave.col_p[i];
+			float q = _octave.col_q[i];
+			float r = _octave.col_r[i];
+			float s = _octave.col_s[i];
+
+			// upper-left, upper-right, lower-left, lower-right
+			float g00_x = grad_x0[ gx ], g10_x = grad_x0[ gx + 1 ], g01_x = grad_x1[ gx ], g11_x = grad_x1[ gx + 1 ];
+			float g00_y = grad_y0[ gx ], g10_y = grad_y0[ gx + 1 ], g01_y = grad_y1[ gx ], g11_y = grad_y1[ gx + 1 ];
+
+			_coeff[i] = _weight * ( p * g00_x + r * g10_x );
+			_coeff[ i + m_width ] = _weight * ( p * ( g01_x - g00_x ) + r * ( g11_x - g10_x ) - last * ( q * g01_y + s * g11_y ) );
+			_coeff[ i + 2 * m_width ] = _weight * ( q * g00_y + s * g10_y );
+			_coeff[ i + 3 * m_width ] = _weight * ( q * ( g01_y - g00_y ) + s * ( g11_y - g10_y ) );
+		}
+	}
+
+	void _rowKernel(	float *_row,
+						const float *_c0, const float *_c1, const float *_c2, const float *_c3,
+						float _wy, float _ly, bool _accumulate )
+	{
+		int i = 0;
+#ifdef PERLIN_NOISE_X86
+		if( m_use_avx )
+		{
+			i = _rowKernelAVX( _row, _c0, _c1, _c2, _c3, _wy, _ly, _accumulate );
+		}
+		else
+		{
+			i = _rowKernelSSE( _row, _c0, _c1, _c2, _c3, _wy, _ly, _accumulate );
+		}
+#endif
+		for( ; i < m_width; i++ )
+		{
+			float value = _c0[i] + _wy * _c1[i] + _ly * ( _c2[i] + _wy * _c3[i] );
+			_row[i] = _accumulate ? _row[i] + value : value;
+		}
+	}
+
+#ifdef PERLIN_NOISE_X86
+	// return number of columns processed
+	int _rowKernelSSE(	float *_row,
+						const float *_c0, const float *_c1, const float *_c2, const float *_c3,
+						float _wy, float _ly, bool _accumulate )
+	{
+		__m128 wy = _mm_set1_ps( _wy );
+		__m128 ly = _mm_set1_ps( _ly );
+
+		int i = 0;
+		for( ; i + 4 <= m_width; i += 4 )
+		{
+			__m128 value = _mm_add_ps(	_mm_add_ps( _mm_loadu_ps( _c0 + i ), _mm_mul_ps( wy, _mm_loadu_ps( _c1 + i ) ) ),
+										_mm_mul_ps( ly, _mm_add_ps( _mm_loadu_ps( _c2 + i ), _mm_mul_ps( wy, _mm_loadu_ps( _c3 + i ) ) ) ) );
+			if( _accumulate )
+			{
+				value = _mm_add_ps( _mm_loadu_ps( _row + i ), value );
+			}
+			_mm_storeu_ps( _row + i, value );
+		}
+		return i;
+	}
+
+	__attribute__(( target( "avx" ) ))
+	int _rowKernelAVX(	float *_row,
+						const float *_c0, const float *_c1, const float *_c2, const float *_c3,
+						float _wy, float _ly, bool _accumulate )
+	{
+		__m256 wy = _mm256_set1_ps( _wy );
+		__m256 ly = _mm256_set1_ps( _ly );
+
+		int i = 0;
+		for( ; i + 8 <= m_width; i += 8 )
+		{
+			__m256 value = _mm256_add_ps(	_mm256_add_ps( _mm256_loadu_ps( _c0 + i ), _mm256_mul_ps( wy, _mm256_loadu_ps( _c1 + i ) ) ),
+											_mm256_mul_ps( ly, _mm256_add_ps( _mm256_loadu_ps( _c2 + i ), _mm256_mul_ps( wy, _mm256_loadu_ps( _c3 + i ) ) ) ) );
+			if( _accumulate )
+			{
+				value = _mm256_add_ps( _mm256_loadu_ps( _row + i ), value );
+			}
+			_mm256_storeu_ps( _row + i, value );
+		}
+		return i;
+	}
+#endif
+
+public:
+
+private:
+	static const int TILE_ROWS = 32;
+
+	// noise resolution
+	int m_width;
+	int m_height;
+	// split rows into tiles ( NULL for single thread )
+	WorkerPool *m_pool;
+	// per instance random generator, never re-seeded by generate()
+	mt19937 m_rng;
+	uniform_int_distribution< int > m_degree_dist;
+	// cos & sin of every gradient direction
+	vector< float > m_dir_cos;
+	vector< float > m_dir_sin;
+	// lookup tables of every grid size used so far
+	vector< Octave > m_octaves;
+	// octaves of the current generate()
+	vector< Octave* > m_active_octaves;
+	// c0 ~ c3 of every octave, one block per tile
+	vector< float > m_coeff;
+	// cpu supports AVX, otherwise SSE
+	bool m_use_avx = false;
+};
+
+#endif /* PERLIN_NOISE_ENGINE_H_ */
@@ -0,0 +1,277 @@
+/*
+ * RenderTargetLayout.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef RENDER_TARGET_LAYOUT_H_
+#define RENDER_TARGET_LAYOUT_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#include <vector>
+
+using namespace std;
+
+// pixel format of the depth render target
+enum DepthFormat
+{
+	// ( depth, 1 - label, 1 - label, depth ), needed by the MRT pass
+	DEPTH_FORMAT_RGBA32F = 0,
+	// depth only, 1 float per pixel
+	DEPTH_FORMAT_R32F
+};
+
+// pixel format of the rayconf render target
+enum RayConfFormat
+{
+	// ( ray.xyz, confidence ) in camera space
+	RAYCONF_FORMAT_XYZC32F = 0,
+	// confidence only, 1 float per pixel, xyz is reconstructed from depth
+	RAYCONF_FORMAT_C32F,
+	// confidence only, 1 half float per pixel, xyz is reconstructed from depth
+	RAYCONF_FORMAT_C16F
+};
+
+// Layout of the depth & rayconf buffers read back from the render targets, and how post processing reads them.
+// depth is ( | z | - near ) / ( far - near ) in channel 0, 1 where the IR projector can't reach & for the background.
+// rayconf is ( x, y, z, confidence ) in meters, ( 0, 0, 0, -1 ) where the IR projector can't reach & white for the background.
+// Without xyz in the rayconf buffer, points are reconstructed on the rays of pixel centers ( see DepthStreamCodec ),
+//   x = ( u - cx ) / fx * d, y = -( v - cy ) / fy * d, z = -d, d = near + depth * ( far - near ).
+class RenderTargetLayout
+{
+public:
+	RenderTargetLayout(	DepthFormat		_depth_format = DEPTH_FORMAT_RGBA32F,
+						RayConfFormat	_rayconf_format = RAYCONF_FORMAT_XYZC32F )
+		: m_depth_format( _depth_format ),
+		  m_rayconf_format( _rayconf_format ),
+		  m_depth_channels( _depth_format == DEPTH_FORMAT_RGBA32F ? 4 : 1 ),
+		  m_near( 0 ),
+		  m_depth_range( 1 )
+	{
+	}
+	~RenderTargetLayout()
+	{
+	}
+
+	// intrinsics of pixel centers & clip distances of the camera, only needed if xyz is reconstructed
+	void setCamera(	int		_width,
+					int		_height,
+					float	_fx,
+					float	_fy,
+					float	_cx,
+					float	_cy,
+					float	_near,
+					float	_far )
+	{
+		m_ray_x.resize( _width );
+		for( int u = 0; u < _width; u++ )
+		{
+			m_ray_x[u] = ( u - _cx ) / _fx;
+		}
+		m_ray_y.resize( _height );
+		for( int v = 0; v < _height; v++ )
+		{
+			m_ray_y[v] = -( v - _cy ) / _fy;
+		}
+		m_near = _near;
+		m_depth_range = _far - _near;
+	}
+
+	DepthFormat getDepthFormat() const
+	{
+		return m_depth_format;
+	}
+
+	RayConfFormat getRayConfFormat() const
+	{
+		return m_rayconf_format;
+	}
+
+	// floats per pixel of the depth buffer
+	int depthChannels() const
+	{
+		return m_depth_channels;
+	}
+
+	// bytes per pixel of the depth & rayconf buffers
+	int depthPixelBytes() const
+	{
+		return m_depth_channels * sizeof( float );
+	}
+
+	int rayconfPixelBytes() const
+	{
+		switch( m_rayconf_format )
+		{
+		case RAYCONF_FORMAT_C32F:
+			return sizeof( float );
+		case RAYCONF_FORMAT_C16F:
+			return sizeof( uint16_t );
+		default:
+			return 4 * sizeof( float );
+		}
+	}
+
+	bool reconstructsXYZ() const
+	{
+		return m_rayconf_format != RAYCONF_FORMAT_XYZC32F;
+	}
+
+	// normalized depth of pixel _idx
+	float depth( const float *_depth, int _idx ) const
+	{
+		return _depth[ m_depth_channels * _idx ];
+	}
+
+	// confidence of pixel _idx, -1 where the IR projector can't reach
+	float confidence( const float *_rayconf, int _idx ) const
+	{
+		switch( m_rayconf_format )
+		{
+		case RAYCONF_FORMAT_C32F:
+			return _rayconf[ _idx ];
+		case RAYCONF_FORMAT_C16F:
+			return halfToFloat( ( (const uint16_t*)_rayconf )[ _idx ] );
+		default:
+			return _rayconf[ 4 * _idx + 3 ];
+		}
+	}
+
+	// the IR projector reaches pixel _idx & it isn't background, rayconf[3] != -1 && rayconf[2] < 0 of the full layout
+	bool hasPoint( const float *_depth, const float *_rayconf, int _idx ) const
+	{
+		if( confidence( _rayconf, _idx ) == -1 )
+		{
+			return false;
+		}
+		return reconstructsXYZ() ? depth( _depth, _idx ) < 1 : _rayconf[ 4 * _idx + 2 ] < 0;
+	}
+
+	// camera space position of pixel _idx in meters
+	void point( const float *_depth, const float *_rayconf, int _idx, float *_xyz ) const
+	{
+		if( !reconstructsXYZ() )
+		{
+			_xyz[0] = _rayconf[ 4 * _idx + 0 ];
+			_xyz[1] = _rayconf[ 4 * _idx + 1 ];
+			_xyz[2] = _rayconf[ 4 * _idx + 2 ];
+			return;
+		}
+
+		pointFromDepth( depth( _depth, _idx ), _idx, _xyz );
+	}
+
+	// camera space position of pixel _idx in meters from it's normalized depth, on the ray of the pixel center
+	void pointFromDepth( float _depth, int _idx, float *_xyz ) const
+	{
+		int width = m_ray_x.size();
+		float d = m_near + _depth * m_depth_range;
+		_xyz[0] = m_ray_x[ _idx % width ] * d;
+		_xyz[1] = m_ray_y[ _idx / width ] * d;
+		_xyz[2] = -d;
+	}
+
+	// IEEE 754 half ( PF_FLOAT16_R ) to float
+	static float halfToFloat( uint16_t _half )
+	{
+		uint32_t sign = ( _half & 0x8000u ) << 16;
+		uint32_t exponent = ( _half >> 10 ) & 0x1f;
+		uint32_t mantissa = _half & 0x3ff;
+
+		uint32_t bits;
+		if( exponent == 0x1f )
+		{
+			// inf & nan
+			bits = sign | 0x7f800000u | ( mantissa << 13 );
+		}
+		else if( exponent != 0 )
+		{
+			bits = sign | ( ( exponent + 112 ) << 23 ) | ( mantissa << 13 );
+		}
+		else if( mantissa == 0 )
+		{
+			bits = sign;
+		}
+		else
+		{
+			// subnormal half is a normal float
+			exponent = 113;
+			while( !( mantissa & 0x400 ) )
+			{
+				mantissa <<= 1;
+				exponent--;
+			}
+			bits = sign | ( exponent << 23 ) | ( ( mantissa & 0x3ff ) << 13 );
+		}
+
+		float value;
+		memcpy( &value, &bits, sizeof( value ) );
+		return value;
+	}
+
+	// float to IEEE 754 half, round to nearest even ( what the render target stores )
+	static uint16_t floatToHalf( float _value )
+	{
+		uint32_t bits;
+		memcpy( &bits, &_value, sizeof( bits ) );
+
+		uint16_t sign = ( bits >> 16 ) & 0x8000;
+		int32_t exponent = ( ( bits >> 23 ) & 0xff ) - 112;
+		uint32_t mantissa = bits & 0x7fffff;
+
+		if( ( ( bits >> 23 ) & 0xff ) == 0xff )
+		{
+			return sign | 0x7c00 | ( mantissa ? 0x200 : 0 );
+		}
+		if( exponent >= 0x1f )
+		{
+			return sign | 0x7c00;
+		}
+		if( exponent <= 0 )
+		{
+			if( exponent < -10 )
+			{
+				return sign;
+			}
+			// subnormal half
+			mantissa |= 0x800000;
+			int shift = 14 - exponent;
+			uint32_t half_mantissa = mantissa >> shift;
+			uint32_t rest = mantissa & ( ( 1u << shift ) - 1 );
+			uint32_t halfway = 1u << ( shift - 1 );
+			if( rest > halfway || ( rest == halfway && ( half_mantissa & 1 ) ) )
+			{
+				half_mantissa++;
+			}
+			return sign | half_mantissa;
+		}
+
+		uint32_t half = ( exponent << 10 ) | ( mantissa >> 13 );
+		uint32_t rest = mantissa & 0x1fff;
+		if( rest > 0x1000 || ( rest == 0x1000 && ( half & 1 ) ) )
+		{
+			// may carry into the exponent, up to inf
+			half++;
+		}
+		return sign | half;
+	}
+
+public:
+
+private:
+	DepthFormat m_depth_format;
+	RayConfFormat m_rayconf_format;
+	// floats per pixel of the depth buffer
+	int m_depth_channels;
+
+	// ( u - cx ) / fx of every column & -( v - cy ) / fy of every row
+	vector< float > m_ray_x;
+	vector< float > m_ray_y;
+	// near clip distance & far - near, depth is normalized with them
+	float m_near;
+	float m_depth_range;
+};
+
+#endif /* RENDER_TARGET_LAYOUT_H_ */
@@ -1,8 +1,13 @@
+#include <stdint.h>
+
+#include <unordered_map>
+
 #include <Ogre.h>
 
 #include <gazebo/rendering/rendering.hh>
 
-#include "ShadowSettings.h"
+#include "EntityProxyCache.h"
+#include "CaptureStateGuard.h"
 
 using namespace gazebo;
 using namespace std;
@@ -13,15 +18,18 @@ public:
 	SegmentRTListener( 	rendering::ScenePtr 	_scene,
 						Ogre::SceneManager		*_scene_mgr,
 						Ogre::RenderTexture 	*_render_texture,
-						unsigned char 			*_segment_buffer )
+						unsigned char 			*_segment_buffer,
+						EntityProxyCache		*_entity_cache,
+						CaptureStateGuard		*_capture_state,
+						SegmentEncoding			_encoding = SEGMENT_ENCODING_GREY )
 		: m_scene( _scene ),
 		  m_scene_mgr( _scene_mgr ),
 		  m_render_texture( _render_texture ),
 		  m_segment_buffer( _segment_buffer ),
-		  m_shadow_settings(),
-		  m_turned_off_lights(),
-		  m_turned_off_mobj(),
-		  m_cloned_entity()
+		  m_entity_cache( _entity_cache ),
+		  m_capture_state( _capture_state ),
+		  m_encoding( _encoding ),
+		  m_material_version( (unsigned long)-1 )
 	{
 
 	}
@@ -31,6 +39,8 @@ public:
 
 	void preRenderTargetUpdate( const Ogre::RenderTargetEvent& evt )
 	{
+		// segment materials are self illuminated, they render the same with the lights of depth pass, so nothing is set again
+		m_capture_state->apply( CaptureStateGuard::PROFILE_DEPTH );
 		// set materials for all objects
 		_toggleMaterials( true );
 	}
@@ -43,6 +53,12 @@ public:
 		_toggleMaterials( false );
 	}
 
+	// frame buffer of the next update, W * H * segmentBytes() bytes
+	void setBuffer( unsigned char *_segment_buffer )
+	{
+		m_segment_buffer = _segment_buffer;
+	}
+
 private:
 	void _textureToPixmap()
 	{
@@ -52,10 +68,12 @@ private:
 		unsigned int width = m_render_texture->getWidth();
 		unsigned int height = m_render_texture->getHeight();
 
+		// grey levels are equal in every channel, only red is read back
+		// ids are packed in R, G, B & A, read back as they are ( little endian class id << 24 | instance id )
 		Ogre::PixelBox pixelBox(	width,
 									height,
 									1,
-									Ogre::PF_BYTE_RGB,
+									m_encoding == SEGMENT_ENCODING_ID ? Ogre::PF_BYTE_RGBA : Ogre::PF_R8,
 									m_segment_buffer );
 
 		m_render_texture->copyContentsToMemory( pixelBox, Ogre::RenderTarget::FB_AUTO );
@@ -65,181 +83,86 @@ private:
 	{
 		if( _in_pre )
 		{
-			// **************** //
-			// count all models //
-			// **************** //
-			vector< string > model_names;
-
-			unsigned int num_visual = m_scene->GetVisualCount();
-			// go through every visual in rendering::Scene
-			for( unsigned int i = 1; i < num_visual+10; i++ )	// skip the first one, or crash		// +10 is due to bug in GetVisualCount(), it return less value than actual value.
+			// materials only change with the models & proxies of the scene
+			if( m_entity_cache->getVersion() != m_material_version )
 			{
-				rendering::VisualPtr cur_visual = m_scene->GetVisual( i );
-				if( cur_visual )
-				{
-					// get only model names
-					string model_name = cur_visual->GetName();
-					size_t found_pos = model_name.rfind( "::" );
-					if( found_pos != string::npos )
-					{
-						continue;
-					}
-
-					if( find( model_names.begin(), model_names.end(), model_name ) == model_names.end() )
-					{
-						model_names.push_back( model_name );
-					}
-					else	// should not happen
-					{
-						cout << "ERROR : u have two same visual name!" << endl;
-					}
-				}
+				_updateMaterials();
 			}
-			// ****************************** //
-			// create material for each model //
-			// ****************************** //
 
-			// materials for every models, the order is the same with correspondence model
-			vector< Ogre::MaterialPtr > model_materials;
+			// show segment proxies instead of all objects
+			m_entity_cache->showProxies( EntityProxyCache::PASS_SEGMENT );
+		}
+		else
+		{
+			// hide proxies and show original visuals
+			m_entity_cache->hideProxies();
+		}
+	}
 
-			// get material manager
-			Ogre::MaterialManager& material_manager = Ogre::MaterialManager::getSingleton();
+	void _updateMaterials()
+	{
+		vector< uint32_t > model_ids;
+		vector< string > model_names = m_entity_cache->countSceneModels( &model_ids );
 
-			for( unsigned int i = 0; i < model_names.size(); i++ )
-			{
-				std::stringstream ss;
-				ss << i;
+		// ******************************************************** //
+		// material of each model, created the first time it's seen //
+		// ******************************************************** //
+		Ogre::MaterialManager& material_manager = Ogre::MaterialManager::getSingleton();
 
-				Ogre::MaterialPtr material = material_manager.create( 	"segment_material_" + ss.str(),
+		m_model_materials.resize( model_names.size() );
+		for( unsigned int i = 0; i < model_names.size(); i++ )
+		{
+			unordered_map< string, Ogre::MaterialPtr >::iterator iter = m_materials.find( model_names[i] );
+			if( iter == m_materials.end() )
+			{
+				Ogre::MaterialPtr material = material_manager.create( 	"segment_material_" + model_names[i],
 																		Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME );
-
 				Ogre::Pass* pass = material->getTechnique( 0 )->getPass( 0 );
-
-				float color = ( i + 1.0f ) / model_names.size();
-
-				// Emissive / self illumination is the color 'produced' by the object.
-				pass->setSelfIllumination( Ogre::ColourValue( color, color, color ) );
 				// diffuse color is the traditionnal color of the lit object.
 				pass->setDiffuse( Ogre::ColourValue( 0.0f, 0.0f, 0.0f, 0.0f ) );
 				// ambient colour is linked to ambient lighting.
 				pass->setAmbient( Ogre::ColourValue( 0.0f, 0.0f, 0.0f, 0.0f ) );
 
-				model_materials.push_back( material );
-			}
-
-			// ***************************** //
-			// clone entity and set material //
-			// ***************************** //
-			m_turned_off_mobj.clear();
-			m_cloned_entity.clear();
-
-			// this vector contains scene node that cloned Entity is going to attached to
-			vector< Ogre::SceneNode* > cloned_scene_node;
-
-			num_visual = m_scene->GetVisualCount();
-			// go through every visual in rendering::Scene
-			for( unsigned int i = 1; i < num_visual+10; i++ )	// skip the first one, or crash		// +10 is due to bug in GetVisualCount(), it return less value than actual value.
-			{
-				rendering::VisualPtr cur_visual = m_scene->GetVisual( i );
-				if( cur_visual )
+				if( m_encoding == SEGMENT_ENCODING_ID )
 				{
-					// only visual with NO "_MATERIAL_" in it's Visual material name will pass through
-					string material_name = cur_visual->GetMaterialName();
-					size_t found_pos = material_name.rfind( "_MATERIAL_" );
-					if( found_pos != string::npos )
-					{
-						continue;
-					}
-
-					// clone the visual if it's visible
-					if( cur_visual->GetVisible() )
-					{
-						Ogre::SceneNode *scene_node = cur_visual->GetSceneNode();
-
-						// Apply material to all child scene nodes
-						for( unsigned int i = 0; i < scene_node->numChildren(); ++i )
-						{
-							Ogre::SceneNode *sn = (Ogre::SceneNode*)(scene_node->getChild(i));
-							for (int j = 0; j < sn->numAttachedObjects(); j++)
-							{
-								Ogre::MovableObject *mobj = sn->getAttachedObject( j );
-								Ogre::Entity *entity = dynamic_cast<Ogre::Entity*>( mobj );
-								Ogre::SimpleRenderable *sr = dynamic_cast<Ogre::SimpleRenderable*>( mobj );
-								if( mobj->getVisible() )
-								{
-									if( entity )
-									{
-										// clone only model visualize object ( those dosen't have "__COLLISION_VISUAL__" in it's entity name
-										string entity_name = entity->getName();
-										size_t found_pos = entity_name.rfind( "__COLLISION_VISUAL__" );
-										if( found_pos == string::npos )
-										{
-											Ogre::Entity *cloned_entity = entity->clone( "CLONED_ENTITY_" + entity->getName() );
-											m_cloned_entity.push_back( cloned_entity );
-											cloned_scene_node.push_back( entity->getParentSceneNode() );
-
-											// set it's material
-											int pos = entity_name.find( "::" );
-
-											vector< string >::iterator found_pos = find( 	model_names.begin(),
-																							model_names.end(),
-																							entity_name.substr( 7, pos - 7 ) );
-
-											if( found_pos != model_names.end() )
-											{
-												int idx = found_pos - model_names.begin();
-												cloned_entity->setMaterial( model_materials[ idx ] );
-												cloned_entity->setCastShadows( false );
-											}
-											else
-											{
-												cout << "ERROR: weird result." << endl;
-												cout << "not found model name : " << entity_name.substr( 7, pos - 7 ) << endl;
-												exit( -1 );
-											}
-										}
-										entity->setVisible( false );
-										m_turned_off_mobj.push_back( mobj );
-
-									}
-									else if( sr )	// Ogre::SimpleRenderable
-									{
-										sr->setVisible( false );
-										m_turned_off_mobj.push_back( mobj );
-									}
-									else	// not sure
-									{
-										cerr << "Something didn't handled in DepthRTListener!" << endl;
-									}
-								}
-							}
-						}
-					}
+					// every byte of the id must reach the render texture as it is
+					pass->setFog( true, Ogre::FOG_NONE );
+					pass->setSceneBlending( Ogre::SBT_REPLACE );
+					// the id never changes, byte k / 255 is written back as k
+					uint32_t id = model_ids[i];
+					pass->setSelfIllumination( Ogre::ColourValue(	( id & 0xff ) / 255.0f,
+																	( ( id >> 8 ) & 0xff ) / 255.0f,
+																	( ( id >> 16 ) & 0xff ) / 255.0f ) );
+					// alpha of the fragment is the alpha of diffuse
+					pass->setDiffuse( Ogre::ColourValue( 0.0f, 0.0f, 0.0f, ( id >> 24 ) / 255.0f ) );
 				}
+
+				iter = m_materials.insert( make_pair( model_names[i], material ) ).first;
 			}
-			// attach cloned Entity to it's SceneNode	( cloned entity are not attach to SceneNode, thus not visible
-			unsigned int i = 0;
-			for( vector< Ogre::Entity* >::iterator iter = m_cloned_entity.begin(); iter != m_cloned_entity.end(); iter++, i++ )
+
+			if( m_encoding == SEGMENT_ENCODING_GREY )
 			{
-				cloned_scene_node[i]->attachObject( (*iter) );
+				// the label depends on the number of models, ( i + 1 ) / number of models
+				float color = ( i + 1.0f ) / model_names.size();
+				// Emissive / self illumination is the color 'produced' by the object.
+				iter->second->getTechnique( 0 )->getPass( 0 )->setSelfIllumination( Ogre::ColourValue( color, color, color ) );
 			}
+
+			m_model_materials[i] = iter->second;
 		}
-		else
+
+		// ******************************* //
+		// set material of segment proxies //
+		// ******************************* //
+		int unknown = m_entity_cache->setModelMaterials( EntityProxyCache::PASS_SEGMENT, m_model_materials );
+		if( unknown > 0 )
 		{
-			// turn on original visual
-			for( vector< Ogre::MovableObject* >::iterator iter = m_turned_off_mobj.begin(); iter != m_turned_off_mobj.end(); iter++ )
-			{
-				( *iter )->setVisible( true );
-			}
-			// delete cloned visual
-			for( vector< Ogre::Entity* >::iterator iter = m_cloned_entity.begin(); iter != m_cloned_entity.end(); iter++ )
-			{
-				(*iter)->getParentSceneNode()->detachObject( (*iter) );
-				m_scene_mgr->destroyEntity( (*iter) );
-			}
-			m_cloned_entity.clear();
+			cerr << "SegmentRTListener : " << unknown << " proxies don't belong to any model, they are not labeled" << endl;
 		}
+
+		m_material_version = m_entity_cache->getVersion();
 	}
+
 public:
 
 private:
@@ -251,12 +174,16 @@ private:
 	Ogre::RenderTexture *m_render_texture;
 	// this buffer contain the corresponding RenderTexture's content
 	unsigned char *m_segment_buffer;
-	// the instance contain gazebo's shadow settings
-	ShadowSettings m_shadow_settings;
-	// this vector contain lights being turned off by this class
-	vector<Ogre::Light *> m_turned_off_lights;
-	// this vector contain MovableObject being hidden by depth RT listener
-	vector< Ogre::MovableObject * > m_turned_off_mobj;
-	// this vcetor contain Entity being cloned for depth simulator
-	vector< Ogre::Entity * > m_cloned_entity;
+	// proxies of every model entity, shared with other listeners
+	EntityProxyCache *m_entity_cache;
+	// shadow & light settings of the capture, shared with other listeners
+	CaptureStateGuard *m_capture_state;
+	// grey levels or ids
+	SegmentEncoding m_encoding;
+	// segment material of every model seen so far, keyed by model name
+	unordered_map< string, Ogre::MaterialPtr > m_materials;
+	// materials in the order of countSceneModels()
+	vector< Ogre::MaterialPtr > m_model_materials;
+	// EntityProxyCache::getVersion() when the materials were set
+	unsigned long m_material_version;
 };
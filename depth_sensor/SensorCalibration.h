@@ -0,0 +1,405 @@
+/*
+ * SensorCalibration.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef SENSOR_CALIBRATION_H_
+#define SENSOR_CALIBRATION_H_
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// ********************************************************************** //
+// layout of a sensor calibration file, mapped read-only & used in place  //
+// ********************************************************************** //
+// [ SensorCalibrationHeader ][ SensorCalibrationTable x num_tables ][ data ][ data ] ...
+// Every table is a row major height x width x channels array of one SensorCalibrationType, 64 bytes aligned.
+// Tables of the same name are resolution variants of one calibration, e.g. the noise magnitude measured at
+// source_width x source_height & resized for the common sensor resolutions, so the sensor never resamples at start.
+// directory_checksum covers the table directory, every table has the checksum of its data.
+
+static const uint32_t SENSOR_CALIBRATION_MAGIC = 0x4c435a47;	// "GZCL"
+static const uint32_t SENSOR_CALIBRATION_VERSION = 1;
+static const uint64_t SENSOR_CALIBRATION_ALIGN = 64;
+
+enum SensorCalibrationType
+{
+	SENSOR_CALIBRATION_FLOAT32 = 0,
+	SENSOR_CALIBRATION_UINT8 = 1,
+	SENSOR_CALIBRATION_UINT16 = 2
+};
+
+struct SensorCalibrationHeader
+{
+	uint32_t magic;
+	uint32_t version;
+	uint32_t num_tables;
+	uint32_t reserved0;
+	// size of the whole file
+	uint64_t file_bytes;
+	uint64_t directory_checksum;
+	uint32_t reserved[8];
+};
+
+struct SensorCalibrationTable
+{
+	char name[32];
+	// SensorCalibrationType
+	uint32_t type;
+	uint32_t channels;
+	uint32_t width;
+	uint32_t height;
+	// resolution the calibration was measured at
+	uint32_t source_width;
+	uint32_t source_height;
+	// from the start of the file
+	uint64_t offset;
+	uint64_t bytes;
+	uint64_t checksum;
+};
+
+inline uint64_t sensorCalibrationAlign( uint64_t _value )
+{
+	return ( _value + SENSOR_CALIBRATION_ALIGN - 1 ) / SENSOR_CALIBRATION_ALIGN * SENSOR_CALIBRATION_ALIGN;
+}
+
+inline uint32_t sensorCalibrationTypeSize( uint32_t _type )
+{
+	switch( _type )
+	{
+	case SENSOR_CALIBRATION_FLOAT32:	return 4;
+	case SENSOR_CALIBRATION_UINT8:		return 1;
+	case SENSOR_CALIBRATION_UINT16:		return 2;
+	default:							return 0;
+	}
+}
+
+// 64 bit FNV-1a over 8 byte words, then the remaining bytes
+inline uint64_t sensorCalibrationChecksum( const void *_data, uint64_t _bytes )
+{
+	const unsigned char *data = (const unsigned char*)_data;
+	uint64_t hash = 14695981039346656037ULL;
+	uint64_t i = 0;
+	for( ; i + 8 <= _bytes; i += 8 )
+	{
+		uint64_t word;
+		memcpy( &word, data + i, 8 );
+		hash = ( hash ^ word ) * 1099511628211ULL;
+	}
+	for( ; i < _bytes; i++ )
+	{
+		hash = ( hash ^ data[i] ) * 1099511628211ULL;
+	}
+	return hash;
+}
+
+// Collects tables in memory & writes a calibration file.
+class SensorCalibrationWriter
+{
+public:
+	SensorCalibrationWriter()
+	{
+	}
+	~SensorCalibrationWriter()
+	{
+	}
+
+	// _data holds height * width * channels values of _type, copied
+	bool addTable(	const string	&_name,
+					uint32_t		_type,
+					uint32_t		_channels,
+					uint32_t		_width,
+					uint32_t		_height,
+					uint32_t		_source_width,
+					uint32_t		_source_height,
+					const void		*_data )
+	{
+		SensorCalibrationTable table;
+		memset( &table, 0, sizeof( table ) );
+		if( _name.size() >= sizeof( table.name ) || sensorCalibrationTypeSize( _type ) == 0 )
+		{
+			cerr << "SensorCalibrationWriter : bad table " << _name << endl;
+			return false;
+		}
+		strncpy( table.name, _name.c_str(), sizeof( table.name ) - 1 );
+		table.type = _type;
+		table.channels = _channels;
+		table.width = _width;
+		table.height = _height;
+		table.source_width = _source_width;
+		table.source_height = _source_height;
+		table.bytes = (uint64_t)_width * _height * _channels * sensorCalibrationTypeSize( _type );
+		table.checksum = sensorCalibrationChecksum( _data, table.bytes );
+
+		m_tables.push_back( table );
+		m_data.push_back( vector< unsigned char >( (const unsigned char*)_data, (const unsigned char*)_data + table.bytes ) );
+		return true;
+	}
+
+	// written to a temporary file & renamed, a mapped old file stays valid
+	bool write( const string &_path )
+	{
+		SensorCalibrationHeader header;
+		memset( &header, 0, sizeof( header ) );
+		header.magic = SENSOR_CALIBRATION_MAGIC;
+		header.version = SENSOR_CALIBRATION_VERSION;
+		header.num_tables = m_tables.size();
+
+		uint64_t offset = sensorCalibrationAlign( sizeof( header ) + m_tables.size() * sizeof( SensorCalibrationTable ) );
+		for( unsigned int i = 0; i < m_tables.size(); i++ )
+		{
+			m_tables[i].offset = offset;
+			offset = sensorCalibrationAlign( offset + m_tables[i].bytes );
+		}
+		header.file_bytes = offset;
+		header.directory_checksum = m_tables.empty() ? 0 : sensorCalibrationChecksum( &m_tables[0], m_tables.size() * sizeof( SensorCalibrationTable ) );
+
+		string temp_path = _path + ".tmp";
+		{
+			ofstream file( temp_path.c_str(), ios::out | ios::binary | ios::trunc );
+			file.write( (const char*)&header, sizeof( header ) );
+			if( !m_tables.empty() )
+			{
+				file.write( (const char*)&m_tables[0], m_tables.size() * sizeof( SensorCalibrationTable ) );
+			}
+			for( unsigned int i = 0; i < m_tables.size(); i++ )
+			{
+				_pad( file, m_tables[i].offset );
+				file.write( (const char*)&m_data[i][0], m_tables[i].bytes );
+			}
+			_pad( file, header.file_bytes );
+			if( !file )
+			{
+				cerr << "SensorCalibrationWriter : write " << temp_path << " failed" << endl;
+				remove( temp_path.c_str() );
+				return false;
+			}
+		}
+		if( rename( temp_path.c_str(), _path.c_str() ) != 0 )
+		{
+			cerr << "SensorCalibrationWriter : rename to " << _path << " failed, " << strerror( errno ) << endl;
+			return false;
+		}
+		return true;
+	}
+
+private:
+	// zeros up to _offset
+	static void _pad( ofstream &_file, uint64_t _offset )
+	{
+		static const char zeros[ SENSOR_CALIBRATION_ALIGN ] = { 0 };
+		uint64_t position = _file.tellp();
+		if( _offset > position )
+		{
+			_file.write( zeros, _offset - position );
+		}
+	}
+
+public:
+
+private:
+	vector< SensorCalibrationTable > m_tables;
+	vector< vector< unsigned char > > m_data;
+};
+
+// Maps a calibration file read-only, tables are used in place without copying or parsing.
+// Every checksum is verified by open().
+class SensorCalibrationReader
+{
+public:
+	SensorCalibrationReader()
+		: m_data( NULL ),
+		  m_size( 0 ),
+		  m_tables( NULL ),
+		  m_num_tables( 0 )
+	{
+	}
+	~SensorCalibrationReader()
+	{
+		close();
+	}
+
+	bool open( const string &_path )
+	{
+		close();
+
+		int fd = ::open( _path.c_str(), O_RDONLY );
+		if( fd < 0 )
+		{
+			cerr << "SensorCalibrationReader : open " << _path << " failed, " << strerror( errno ) << endl;
+			return false;
+		}
+		struct stat st;
+		fstat( fd, &st );
+		if( (uint64_t)st.st_size < sizeof( SensorCalibrationHeader ) )
+		{
+			::close( fd );
+			cerr << "SensorCalibrationReader : " << _path << " is too small" << endl;
+			return false;
+		}
+		void *memory = mmap( NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0 );
+		::close( fd );
+		if( memory == MAP_FAILED )
+		{
+			cerr << "SensorCalibrationReader : mmap " << _path << " failed, " << strerror( errno ) << endl;
+			return false;
+		}
+		m_data = (const unsigned char*)memory;
+		m_size = st.st_size;
+
+		string error = _validate();
+		if( !error.empty() )
+		{
+			cerr << "SensorCalibrationReader : " << _path << " " << error << endl;
+			close();
+			return false;
+		}
+		return true;
+	}
+
+	void close()
+	{
+		if( m_data )
+		{
+			munmap( (void*)m_data, m_size );
+			m_data = NULL;
+			m_size = 0;
+		}
+		m_tables = NULL;
+		m_num_tables = 0;
+	}
+
+	bool isOpen() const
+	{
+		return m_data != NULL;
+	}
+
+	int getNumTables() const
+	{
+		return m_num_tables;
+	}
+
+	const SensorCalibrationTable &getTable( int _idx ) const
+	{
+		return m_tables[ _idx ];
+	}
+
+	// data of a table, valid until close()
+	const void *getData( const SensorCalibrationTable &_table ) const
+	{
+		return m_data + _table.offset;
+	}
+
+	// variant of _name at _width x _height, NULL if there is none
+	const SensorCalibrationTable *find( const string &_name, uint32_t _width, uint32_t _height ) const
+	{
+		for( uint32_t i = 0; i < m_num_tables; i++ )
+		{
+			const SensorCalibrationTable &table = m_tables[i];
+			if( _isNamed( table, _name ) && table.width == _width && table.height == _height )
+			{
+				return &table;
+			}
+		}
+		return NULL;
+	}
+
+	// variant of _name to resample from : the one at its source resolution, or else the largest
+	const SensorCalibrationTable *findSource( const string &_name ) const
+	{
+		const SensorCalibrationTable *source = NULL;
+		for( uint32_t i = 0; i < m_num_tables; i++ )
+		{
+			const SensorCalibrationTable &table = m_tables[i];
+			if( !_isNamed( table, _name ) )
+			{
+				continue;
+			}
+			if( table.width == table.source_width && table.height == table.source_height )
+			{
+				return &table;
+			}
+			if( !source || (uint64_t)table.width * table.height > (uint64_t)source->width * source->height )
+			{
+				source = &table;
+			}
+		}
+		return source;
+	}
+
+private:
+	// empty string if the file is valid
+	string _validate()
+	{
+		SensorCalibrationHeader header;
+		memcpy( &header, m_data, sizeof( header ) );
+		if( header.magic != SENSOR_CALIBRATION_MAGIC )
+		{
+			return "is not a sensor calibration file";
+		}
+		if( header.version != SENSOR_CALIBRATION_VERSION )
+		{
+			return "has unsupported version " + to_string( header.version );
+		}
+		uint64_t directory_bytes = (uint64_t)header.num_tables * sizeof( SensorCalibrationTable );
+		if( header.file_bytes != m_size || sizeof( header ) + directory_bytes > m_size )
+		{
+			return "is truncated";
+		}
+
+		const SensorCalibrationTable *tables = (const SensorCalibrationTable*)( m_data + sizeof( header ) );
+		if( header.num_tables > 0 && sensorCalibrationChecksum( tables, directory_bytes ) != header.directory_checksum )
+		{
+			return "has a broken table directory";
+		}
+		for( uint32_t i = 0; i < header.num_tables; i++ )
+		{
+			const SensorCalibrationTable &table = tables[i];
+			string name( table.name, strnlen( table.name, sizeof( table.name ) ) );
+			if(	table.bytes != (uint64_t)table.width * table.height * table.channels * sensorCalibrationTypeSize( table.type ) ||
+				table.offset % SENSOR_CALIBRATION_ALIGN != 0 ||
+				table.offset + table.bytes > m_size )
+			{
+				return "has a bad table " + name;
+			}
+			if( sensorCalibrationChecksum( m_data + table.offset, table.bytes ) != table.checksum )
+			{
+				return "has a checksum mismatch in table " + name;
+			}
+		}
+
+		m_tables = tables;
+		m_num_tables = header.num_tables;
+		return "";
+	}
+
+	static bool _isNamed( const SensorCalibrationTable &_table, const string &_name )
+	{
+		return strnlen( _table.name, sizeof( _table.name ) ) == _name.size() && memcmp( _table.name, _name.c_str(), _name.size() ) == 0;
+	}
+
+public:
+
+private:
+	const unsigned char *m_data;
+	uint64_t m_size;
+	// directory inside the mapping
+	const SensorCalibrationTable *m_tables;
+	uint32_t m_num_tables;
+};
+
+#endif /* SENSOR_CALIBRATION_H_ */
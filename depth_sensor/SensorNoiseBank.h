@@ -0,0 +1,332 @@
+/*
+ * SensorNoiseBank.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef SENSOR_NOISE_BANK_H_
+#define SENSOR_NOISE_BANK_H_
+
+#include <math.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include <condition_variable>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <opencv2/core/core.hpp>
+
+#include "WorkerPool.h"
+
+using namespace std;
+
+// Sensor noise of the depth sensor : real inverse DFT of a measured magnitude spectrum with a random phase.
+// K realizations are generated once ( split over a WorkerPool ) and cached in a file keyed by resolution & the checksum
+// of the magnitude, so a restart only reads them back. Frames rotate through the realizations with next(),
+// an optional refresh thread replaces the oldest one with a new realization at idle priority.
+// Realizations are reference counted cv::Mat, a frame keeps its realization even if the refresh replaces it.
+class SensorNoiseBank
+{
+public:
+	// _magnitude : CV_32F spectrum of sensor resolution, noise is scaled by _gain
+	// _seed : realization i uses _seed + i, random if negative
+	// _cache_dir : realizations are read from / written to a file in it, empty for no cache
+	SensorNoiseBank(	const cv::Mat	&_magnitude,
+						float			_gain,
+						uint64_t		_magnitude_hash,
+						int				_num_realizations,
+						int				_seed,
+						const string	&_cache_dir,
+						WorkerPool		*_pool = NULL )
+		: m_magnitude( _magnitude ),
+		  m_gain( _gain ),
+		  m_next( 0 ),
+		  m_oldest( 0 ),
+		  m_cached( 0 ),
+		  m_refreshed( 0 ),
+		  m_stop( false )
+	{
+		int num_realizations = max( 1, _num_realizations );
+		unsigned int seed = _seed >= 0 ? _seed : random_device()();
+		m_realizations.resize( num_realizations );
+
+		if( !_cache_dir.empty() )
+		{
+			ostringstream ss;
+			ss << _cache_dir << "/sensor_noise_" << m_magnitude.cols << "x" << m_magnitude.rows << "_" << hex << _magnitude_hash;
+			// a fixed seed must give the same noise, random realizations are shared by every random run
+			if( _seed >= 0 )
+			{
+				ss << "_seed" << dec << _seed;
+			}
+			ss << ".bin";
+			m_cache_path = ss.str();
+			m_cached = _readCache( _magnitude_hash );
+		}
+
+		// realizations missing from the cache, every one is independent
+		auto generate = [&]( int _i0, int _i1 )
+		{
+			for( int i = _i0; i < _i1; i++ )
+			{
+				mt19937 rng( seed + i );
+				m_realizations[i] = _generate( rng );
+			}
+		};
+		if( _pool )
+		{
+			_pool->parallelFor( m_cached, num_realizations, 1, generate );
+		}
+		else
+		{
+			generate( m_cached, num_realizations );
+		}
+
+		if( !m_cache_path.empty() && m_cached < num_realizations )
+		{
+			mkdir( _cache_dir.c_str(), 0755 );
+			if( !_writeCache( _magnitude_hash ) )
+			{
+				cerr << "[SensorNoiseBank] failed to write " << m_cache_path << endl;
+			}
+		}
+
+		// refresh realizations continue the seed sequence
+		m_rng.seed( seed + num_realizations );
+	}
+	~SensorNoiseBank()
+	{
+		if( m_thread.joinable() )
+		{
+			{
+				lock_guard< mutex > lock( m_mutex );
+				m_stop = true;
+			}
+			m_stop_cv.notify_all();
+			m_thread.join();
+		}
+	}
+
+	// replace the oldest realization every _period seconds on a thread of idle priority
+	void startRefresh( double _period )
+	{
+		if( _period > 0 && !m_thread.joinable() )
+		{
+			m_thread = thread( &SensorNoiseBank::_refreshLoop, this, _period );
+		}
+	}
+
+	// realization of the next frame, W * H CV_32F
+	cv::Mat next()
+	{
+		lock_guard< mutex > lock( m_mutex );
+		cv::Mat noise = m_realizations[ m_next ];
+		m_next = ( m_next + 1 ) % m_realizations.size();
+		return noise;
+	}
+
+	int getNumRealizations() const
+	{
+		return m_realizations.size();
+	}
+
+	// realizations read from the cache file
+	int getCached() const
+	{
+		return m_cached;
+	}
+
+	const string &getCachePath() const
+	{
+		return m_cache_path;
+	}
+
+	// realizations replaced by the refresh thread
+	unsigned long getRefreshed()
+	{
+		lock_guard< mutex > lock( m_mutex );
+		return m_refreshed;
+	}
+
+private:
+	struct CacheHeader
+	{
+		char magic[8];
+		uint32_t version;
+		uint32_t width;
+		uint32_t height;
+		uint32_t count;
+		uint64_t magnitude_hash;
+		float gain;
+		uint32_t reserved;
+	};
+
+	static const char *_cacheMagic()
+	{
+		return "GZNOISE1";
+	}
+
+	// ************************************************************* //
+	// random phase of every non zero frequency & real inverse DFT   //
+	// ************************************************************* //
+	cv::Mat _generate( mt19937 &_rng ) const
+	{
+		uniform_int_distribution< int > phase_step( 0, 35999 );
+
+		cv::Mat phase( m_magnitude.rows, m_magnitude.cols, CV_32F );
+		for( int j = 0; j < phase.rows; j++ )
+		{
+			const float *magnitude = m_magnitude.ptr< float >( j );
+			float *row = phase.ptr< float >( j );
+			for( int i = 0; i < phase.cols; i++ )
+			{
+				// 0.01 degree steps in -180 ~ 180
+				row[i] = magnitude[i] != 0 ? ( phase_step( _rng ) / 100.0 - 180.0 ) * M_PI / 180 : 0;
+			}
+		}
+
+		// magnitude ^ phase => real part & imaginary part
+		cv::Mat parts[2];
+		cv::polarToCart( m_magnitude, phase, parts[0], parts[1] );
+		cv::Mat complex;
+		cv::merge( parts, 2, complex );
+
+		cv::Mat noise;
+		cv::dft( complex, noise, cv::DFT_INVERSE | cv::DFT_REAL_OUTPUT | cv::DFT_SCALE );
+		noise.convertTo( noise, CV_32F, m_gain );
+		return noise;
+	}
+
+	// return number of realizations read
+	int _readCache( uint64_t _magnitude_hash )
+	{
+		ifstream file( m_cache_path.c_str(), ios::in | ios::binary );
+		CacheHeader header;
+		if( !file || !file.read( (char*)&header, sizeof( header ) ) )
+		{
+			return 0;
+		}
+		if(	memcmp( header.magic, _cacheMagic(), sizeof( header.magic ) ) != 0 ||
+			header.version != CACHE_VERSION ||
+			(int)header.width != m_magnitude.cols ||
+			(int)header.height != m_magnitude.rows ||
+			header.magnitude_hash != _magnitude_hash ||
+			header.gain != m_gain )
+		{
+			cerr << "[SensorNoiseBank] " << m_cache_path << " doesn't match, realizations are generated again" << endl;
+			return 0;
+		}
+
+		int count = min( (int)header.count, (int)m_realizations.size() );
+		for( int i = 0; i < count; i++ )
+		{
+			cv::Mat noise( m_magnitude.rows, m_magnitude.cols, CV_32F );
+			if( !file.read( (char*)noise.data, noise.total() * sizeof( float ) ) )
+			{
+				return i;
+			}
+			m_realizations[i] = noise;
+		}
+		return count;
+	}
+
+	// write to a temporary file & rename, a reader never sees a partial cache
+	bool _writeCache( uint64_t _magnitude_hash ) const
+	{
+		CacheHeader header;
+		memset( &header, 0, sizeof( header ) );
+		memcpy( header.magic, _cacheMagic(), sizeof( header.magic ) );
+		header.version = CACHE_VERSION;
+		header.width = m_magnitude.cols;
+		header.height = m_magnitude.rows;
+		header.count = m_realizations.size();
+		header.magnitude_hash = _magnitude_hash;
+		header.gain = m_gain;
+
+		string temp_path = m_cache_path + ".tmp";
+		{
+			ofstream file( temp_path.c_str(), ios::out | ios::binary | ios::trunc );
+			file.write( (const char*)&header, sizeof( header ) );
+			for( unsigned int i = 0; i < m_realizations.size(); i++ )
+			{
+				file.write( (const char*)m_realizations[i].data, m_realizations[i].total() * sizeof( float ) );
+			}
+			if( !file )
+			{
+				remove( temp_path.c_str() );
+				return false;
+			}
+		}
+		return rename( temp_path.c_str(), m_cache_path.c_str() ) == 0;
+	}
+
+	void _refreshLoop( double _period )
+	{
+		// only runs when no other thread wants the cpu
+		sched_param param;
+		param.sched_priority = 0;
+		if( pthread_setschedparam( pthread_self(), SCHED_IDLE, &param ) != 0 )
+		{
+			cerr << "[SensorNoiseBank] failed to set idle priority of refresh thread" << endl;
+		}
+
+		while( true )
+		{
+			{
+				unique_lock< mutex > lock( m_mutex );
+				if( m_stop_cv.wait_for( lock, chrono::duration< double >( _period ), [this]{ return m_stop; } ) )
+				{
+					return;
+				}
+			}
+
+			// m_rng is only used by this thread after construction
+			cv::Mat noise = _generate( m_rng );
+
+			lock_guard< mutex > lock( m_mutex );
+			m_realizations[ m_oldest ] = noise;
+			m_oldest = ( m_oldest + 1 ) % m_realizations.size();
+			m_refreshed++;
+		}
+	}
+
+public:
+
+private:
+	static const uint32_t CACHE_VERSION = 1;
+
+	// spectrum of sensor resolution
+	cv::Mat m_magnitude;
+	float m_gain;
+	// cache file, empty if not cached
+	string m_cache_path;
+
+	// guards everything below
+	mutex m_mutex;
+	vector< cv::Mat > m_realizations;
+	// realization of the next frame
+	int m_next;
+	// realization replaced by the next refresh
+	int m_oldest;
+	int m_cached;
+	unsigned long m_refreshed;
+
+	// refresh thread
+	thread m_thread;
+	condition_variable m_stop_cv;
+	bool m_stop;
+	mt19937 m_rng;
+};
+
+#endif /* SENSOR_NOISE_BANK_H_ */
@@ -0,0 +1,232 @@
+/*
+ * SharedMemoryRing.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef SHARED_MEMORY_RING_H_
+#define SHARED_MEMORY_RING_H_
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+
+#include <atomic>
+#include <iostream>
+#include <new>
+#include <string>
+
+using namespace std;
+
+// ****************************************************************************** //
+// layout of the ring in POSIX shared memory, shared by the writer & every reader //
+// ****************************************************************************** //
+// [ SharedMemoryRingHeader ][ slot 0 ][ slot 1 ] ... every slot is slot_bytes long :
+// [ SharedMemorySlotHeader ][ width * height points, 16 bytes each : float x, y, z, uint32 label ][ width * height * 3 bytes rgb ]
+// A slot is protected by a seqlock : its sequence is odd while being written,
+// readers check the sequence before & after reading to know if the slot was overwritten meanwhile.
+
+static const uint32_t SHARED_MEMORY_RING_MAGIC = 0x43505a47;	// "GZPC"
+static const uint32_t SHARED_MEMORY_RING_VERSION = 1;
+
+struct SharedMemoryRingHeader
+{
+	uint32_t magic;
+	uint32_t version;
+	uint32_t num_slots;
+	uint32_t width;
+	uint32_t height;
+	uint32_t point_step;
+	uint64_t slot_bytes;
+	// offset of points & rgb from the start of a slot
+	uint64_t points_offset;
+	uint64_t rgb_offset;
+	// number of the last committed frame, 0 if none
+	atomic< uint64_t > last_frame;
+	// increased on every commit, readers sleep on it with futex
+	atomic< uint32_t > futex_word;
+} __attribute__( ( aligned( 64 ) ) );
+
+struct SharedMemorySlotHeader
+{
+	// even : stable, odd : being written
+	atomic< uint64_t > sequence;
+	// frame number stored in the slot
+	uint64_t frame;
+	uint32_t width;
+	uint32_t height;
+	uint32_t has_label;
+	uint32_t has_rgb;
+} __attribute__( ( aligned( 64 ) ) );
+
+// futex on a word in shared memory, works across processes
+inline long sharedMemoryFutex( atomic< uint32_t > *_word, int _op, uint32_t _value, const struct timespec *_timeout )
+{
+	static_assert( sizeof( atomic< uint32_t > ) == sizeof( uint32_t ), "futex needs a plain 32 bit word" );
+	return syscall( SYS_futex, (uint32_t*)_word, _op, _value, _timeout, NULL, 0 );
+}
+
+// Creates the ring and writes frames into it, one writer per ring.
+// The shared memory object is removed when the writer is destroyed, readers keep their mapping until they close it.
+class SharedMemoryRingWriter
+{
+public:
+	// _name : POSIX shared memory name, without the leading '/'
+	SharedMemoryRingWriter(	const string	&_name,
+							int				_width,
+							int				_height,
+							int				_num_slots )
+		: m_name( "/" + _name ),
+		  m_bytes( 0 ),
+		  m_memory( NULL ),
+		  m_header( NULL ),
+		  m_next_slot( 0 )
+	{
+		uint64_t points_offset = sizeof( SharedMemorySlotHeader );
+		uint64_t rgb_offset = points_offset + (uint64_t)_width * _height * POINT_STEP;
+		// keep every slot cache line aligned
+		uint64_t slot_bytes = ( rgb_offset + (uint64_t)_width * _height * 3 + 63 ) / 64 * 64;
+		m_bytes = sizeof( SharedMemoryRingHeader ) + slot_bytes * _num_slots;
+
+		// a stale ring of a crashed run is replaced
+		shm_unlink( m_name.c_str() );
+		int fd = shm_open( m_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0666 );
+		if( fd < 0 )
+		{
+			cerr << "SharedMemoryRingWriter : shm_open " << m_name << " failed, " << strerror( errno ) << endl;
+			return;
+		}
+		if( ftruncate( fd, m_bytes ) != 0 )
+		{
+			cerr << "SharedMemoryRingWriter : ftruncate " << m_bytes << " bytes failed, " << strerror( errno ) << endl;
+			close( fd );
+			shm_unlink( m_name.c_str() );
+			return;
+		}
+
+		void *memory = mmap( NULL, m_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+		close( fd );
+		if( memory == MAP_FAILED )
+		{
+			cerr << "SharedMemoryRingWriter : mmap failed, " << strerror( errno ) << endl;
+			shm_unlink( m_name.c_str() );
+			return;
+		}
+		m_memory = (unsigned char*)memory;
+
+		// ftruncate filled everything with 0, every slot sequence is even
+		m_header = new( m_memory ) SharedMemoryRingHeader();
+		m_header->num_slots = _num_slots;
+		m_header->width = _width;
+		m_header->height = _height;
+		m_header->point_step = POINT_STEP;
+		m_header->slot_bytes = slot_bytes;
+		m_header->points_offset = points_offset;
+		m_header->rgb_offset = rgb_offset;
+		m_header->last_frame = 0;
+		m_header->futex_word = 0;
+		for( int i = 0; i < _num_slots; i++ )
+		{
+			new( _slotHeader( i ) ) SharedMemorySlotHeader();
+		}
+
+		// readers check magic last
+		m_header->version = SHARED_MEMORY_RING_VERSION;
+		atomic_thread_fence( memory_order_release );
+		m_header->magic = SHARED_MEMORY_RING_MAGIC;
+	}
+	~SharedMemoryRingWriter()
+	{
+		if( m_memory )
+		{
+			munmap( m_memory, m_bytes );
+			shm_unlink( m_name.c_str() );
+		}
+	}
+
+	bool isValid() const
+	{
+		return m_memory != NULL;
+	}
+
+	uint32_t getNumSlots() const
+	{
+		return m_header->num_slots;
+	}
+
+	// *************************************************************** //
+	// beginFrame(), fill points & rgb of the slot, then commitFrame() //
+	// *************************************************************** //
+	// mark the next slot as being written and return its index
+	int beginFrame()
+	{
+		int slot = m_next_slot;
+		m_next_slot = ( m_next_slot + 1 ) % m_header->num_slots;
+
+		SharedMemorySlotHeader *header = _slotHeader( slot );
+		header->sequence.store( header->sequence.load( memory_order_relaxed ) + 1, memory_order_relaxed );
+		// data written after this must not become visible before the odd sequence
+		atomic_thread_fence( memory_order_release );
+		return slot;
+	}
+
+	// 16 bytes per point : float x, y, z, uint32 label
+	unsigned char *getPoints( int _slot )
+	{
+		return (unsigned char*)_slotHeader( _slot ) + m_header->points_offset;
+	}
+
+	// 3 bytes per pixel
+	unsigned char *getRGB( int _slot )
+	{
+		return (unsigned char*)_slotHeader( _slot ) + m_header->rgb_offset;
+	}
+
+	// publish the slot as the next frame, wake up waiting readers, return the frame number
+	uint64_t commitFrame( int _slot, bool _has_label, bool _has_rgb )
+	{
+		uint64_t frame = m_header->last_frame.load( memory_order_relaxed ) + 1;
+
+		SharedMemorySlotHeader *header = _slotHeader( _slot );
+		header->frame = frame;
+		header->width = m_header->width;
+		header->height = m_header->height;
+		header->has_label = _has_label;
+		header->has_rgb = _has_rgb;
+		header->sequence.store( header->sequence.load( memory_order_relaxed ) + 1, memory_order_release );
+
+		m_header->last_frame.store( frame, memory_order_release );
+		m_header->futex_word.fetch_add( 1, memory_order_release );
+		sharedMemoryFutex( &m_header->futex_word, FUTEX_WAKE, INT_MAX, NULL );
+		return frame;
+	}
+
+private:
+	SharedMemorySlotHeader *_slotHeader( int _slot )
+	{
+		return (SharedMemorySlotHeader*)( m_memory + sizeof( SharedMemoryRingHeader ) + _slot * m_header->slot_bytes );
+	}
+
+public:
+
+private:
+	static const uint32_t POINT_STEP = 16;
+
+	// shared memory name with leading '/'
+	string m_name;
+	// mapped size
+	size_t m_bytes;
+	unsigned char *m_memory;
+	SharedMemoryRingHeader *m_header;
+	// slot written by the next beginFrame()
+	int m_next_slot;
+};
+
+#endif /* SHARED_MEMORY_RING_H_ */
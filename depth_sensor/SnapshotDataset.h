@@ -0,0 +1,632 @@
+/*
+ * SnapshotDataset.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef SNAPSHOT_DATASET_H_
+#define SNAPSHOT_DATASET_H_
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// ********************************************************************* //
+// layout of a snapshot dataset file, one record per only_snapshot frame //
+// ********************************************************************* //
+// [ SnapshotDatasetHeader ][ record ][ record ] ... [ SnapshotIndexEntry x num_records ][ SnapshotDatasetFooter ]
+// Every record starts on a page boundary : [ SnapshotRecordHeader ][ sections ], every section is 64 bytes aligned :
+//   rgb   : width * height * 3 bytes, RGB
+//   cloud : width * height float x, y, z in millimeter ( CLOUD_XYZ ) or one DepthStreamCodec stream ( CLOUD_DEPTH_STREAM )
+//   label : width * height * label_bytes, same value as the segment buffer
+//   pose  : num_poses SnapshotPose, ground truth of every model in the scene
+// Records are only appended. The index & footer are rewritten behind the last record,
+// a file without a valid footer ( crashed run ) is recovered by walking the record headers.
+
+static const uint32_t SNAPSHOT_DATASET_MAGIC = 0x53445a47;	// "GZDS"
+static const uint32_t SNAPSHOT_RECORD_MAGIC = 0x43525a47;		// "GZRC"
+static const uint32_t SNAPSHOT_FOOTER_MAGIC = 0x58495a47;		// "GZIX"
+static const uint32_t SNAPSHOT_DATASET_VERSION = 1;
+static const uint64_t SNAPSHOT_RECORD_ALIGN = 4096;
+static const uint64_t SNAPSHOT_SECTION_ALIGN = 64;
+
+enum SnapshotCloudFormat
+{
+	SNAPSHOT_CLOUD_FORMAT_NONE = 0,
+	SNAPSHOT_CLOUD_FORMAT_XYZ = 1,
+	SNAPSHOT_CLOUD_FORMAT_DEPTH_STREAM = 2
+};
+
+enum SnapshotSection
+{
+	SNAPSHOT_SECTION_RGB = 0,
+	SNAPSHOT_SECTION_CLOUD,
+	SNAPSHOT_SECTION_LABEL,
+	SNAPSHOT_SECTION_POSE,
+	NUM_SNAPSHOT_SECTIONS
+};
+
+struct SnapshotDatasetHeader
+{
+	uint32_t magic;
+	uint32_t version;
+	uint32_t width;
+	uint32_t height;
+	// SnapshotCloudFormat of every record
+	uint32_t cloud_format;
+	// 1 ( grey level ) or 4 ( little endian class id << 24 | instance id ), 0 in older files means 1
+	uint32_t label_bytes;
+	uint32_t reserved[10];
+};
+
+struct SnapshotRecordHeader
+{
+	uint32_t magic;
+	uint32_t num_poses;
+	// frame number, same as m_save_file_number of rgb_N.png
+	uint64_t frame;
+	// simulation time of the capture
+	double sim_time;
+	// bytes from the start of this header to the next record
+	uint64_t record_bytes;
+	// offset from the start of this header & size of every section, 0 bytes if missing
+	uint64_t section_offset[ NUM_SNAPSHOT_SECTIONS ];
+	uint64_t section_bytes[ NUM_SNAPSHOT_SECTIONS ];
+};
+
+// world pose of one model, position in meter, orientation as quaternion w, x, y, z
+struct SnapshotPose
+{
+	char model_name[64];
+	// value of the model in the label section
+	uint32_t label;
+	uint32_t reserved;
+	double position[3];
+	double orientation[4];
+};
+
+struct SnapshotIndexEntry
+{
+	uint64_t frame;
+	uint64_t offset;
+	uint64_t bytes;
+};
+
+struct SnapshotDatasetFooter
+{
+	uint32_t magic;
+	uint32_t version;
+	uint64_t index_offset;
+	uint64_t num_records;
+	uint64_t reserved;
+};
+
+inline uint64_t snapshotAlign( uint64_t _value, uint64_t _align )
+{
+	return ( _value + _align - 1 ) / _align * _align;
+}
+
+// index of the records in _data ( _size bytes ), from the footer or by walking the record headers
+// return false if _data is not a snapshot dataset
+inline bool readSnapshotIndex(	const unsigned char				*_data,
+								uint64_t						_size,
+								vector< SnapshotIndexEntry >	&_index,
+								bool							&_recovered )
+{
+	_index.clear();
+	_recovered = false;
+
+	SnapshotDatasetHeader header;
+	if( _size < sizeof( header ) )
+	{
+		return false;
+	}
+	memcpy( &header, _data, sizeof( header ) );
+	if( header.magic != SNAPSHOT_DATASET_MAGIC || header.version != SNAPSHOT_DATASET_VERSION )
+	{
+		return false;
+	}
+
+	// ****** //
+	// footer //
+	// ****** //
+	if( _size >= SNAPSHOT_RECORD_ALIGN + sizeof( SnapshotDatasetFooter ) )
+	{
+		SnapshotDatasetFooter footer;
+		memcpy( &footer, _data + _size - sizeof( footer ), sizeof( footer ) );
+		if(	footer.magic == SNAPSHOT_FOOTER_MAGIC &&
+			footer.version == SNAPSHOT_DATASET_VERSION &&
+			footer.index_offset + footer.num_records * sizeof( SnapshotIndexEntry ) + sizeof( footer ) == _size )
+		{
+			_index.resize( footer.num_records );
+			if( footer.num_records > 0 )
+			{
+				memcpy( &_index[0], _data + footer.index_offset, footer.num_records * sizeof( SnapshotIndexEntry ) );
+			}
+
+			bool valid = true;
+			for( unsigned int i = 0; i < _index.size() && valid; i++ )
+			{
+				valid = _index[i].offset + _index[i].bytes <= footer.index_offset;
+			}
+			if( valid )
+			{
+				return true;
+			}
+			_index.clear();
+		}
+	}
+
+	// ******************************************************** //
+	// no valid footer : every complete record before the crash //
+	// ******************************************************** //
+	_recovered = true;
+	uint64_t offset = SNAPSHOT_RECORD_ALIGN;
+	while( offset + sizeof( SnapshotRecordHeader ) <= _size )
+	{
+		SnapshotRecordHeader record;
+		memcpy( &record, _data + offset, sizeof( record ) );
+		if(	record.magic != SNAPSHOT_RECORD_MAGIC ||
+			record.record_bytes < sizeof( record ) ||
+			record.record_bytes % SNAPSHOT_RECORD_ALIGN != 0 ||
+			offset + record.record_bytes > _size )
+		{
+			break;
+		}
+
+		SnapshotIndexEntry entry = { record.frame, offset, record.record_bytes };
+		_index.push_back( entry );
+		offset += record.record_bytes;
+	}
+	return true;
+}
+
+// Appends records to a dataset file, a dataset of the same resolution, cloud format & label bytes is resumed.
+// append() may be called from several threads, records are written in the order of the calls.
+class SnapshotDatasetWriter
+{
+public:
+	struct Record
+	{
+		uint64_t frame;
+		double sim_time;
+		// NULL / 0 bytes for a missing section
+		const void *section[ NUM_SNAPSHOT_SECTIONS ];
+		uint64_t section_bytes[ NUM_SNAPSHOT_SECTIONS ];
+		uint32_t num_poses;
+	};
+
+public:
+	// _index_interval : index & footer are rewritten every _index_interval records, and when closing
+	SnapshotDatasetWriter(	const string	&_path,
+							int				_width,
+							int				_height,
+							uint32_t		_cloud_format,
+							uint32_t		_label_bytes = 1,
+							int				_index_interval = 100 )
+		: m_path( _path ),
+		  m_fd( -1 ),
+		  m_index_interval( _index_interval ),
+		  m_end( SNAPSHOT_RECORD_ALIGN ),
+		  m_unindexed( 0 ),
+		  m_recovered( false )
+	{
+		m_fd = open( _path.c_str(), O_RDWR | O_CREAT, 0666 );
+		if( m_fd < 0 )
+		{
+			cerr << "SnapshotDatasetWriter : open " << _path << " failed, " << strerror( errno ) << endl;
+			return;
+		}
+
+		struct stat st;
+		fstat( m_fd, &st );
+		if( st.st_size == 0 )
+		{
+			SnapshotDatasetHeader header;
+			memset( &header, 0, sizeof( header ) );
+			header.magic = SNAPSHOT_DATASET_MAGIC;
+			header.version = SNAPSHOT_DATASET_VERSION;
+			header.width = _width;
+			header.height = _height;
+			header.cloud_format = _cloud_format;
+			header.label_bytes = _label_bytes;
+			if( pwrite( m_fd, &header, sizeof( header ), 0 ) != sizeof( header ) )
+			{
+				cerr << "SnapshotDatasetWriter : write " << _path << " failed, " << strerror( errno ) << endl;
+				_fail();
+				return;
+			}
+			_writeIndex();
+			return;
+		}
+
+		// ****** //
+		// resume //
+		// ****** //
+		void *memory = mmap( NULL, st.st_size, PROT_READ, MAP_SHARED, m_fd, 0 );
+		if( memory == MAP_FAILED )
+		{
+			cerr << "SnapshotDatasetWriter : mmap " << _path << " failed, " << strerror( errno ) << endl;
+			_fail();
+			return;
+		}
+
+		SnapshotDatasetHeader header;
+		bool valid = readSnapshotIndex( (const unsigned char*)memory, st.st_size, m_index, m_recovered );
+		memcpy( &header, memory, min( (size_t)st.st_size, sizeof( header ) ) );
+		munmap( memory, st.st_size );
+
+		if( !valid )
+		{
+			cerr << "SnapshotDatasetWriter : " << _path << " is not a snapshot dataset" << endl;
+			_fail();
+			return;
+		}
+		uint32_t label_bytes = header.label_bytes ? header.label_bytes : 1;
+		if( (int)header.width != _width || (int)header.height != _height || header.cloud_format != _cloud_format || label_bytes != _label_bytes )
+		{
+			cerr << "SnapshotDatasetWriter : " << _path << " has " << header.width << " x " << header.height
+				 << " cloud format " << header.cloud_format << " label bytes " << label_bytes << ", can't append "
+				 << _width << " x " << _height << " cloud format " << _cloud_format << " label bytes " << _label_bytes << endl;
+			_fail();
+			return;
+		}
+
+		if( !m_index.empty() )
+		{
+			m_end = m_index.back().offset + m_index.back().bytes;
+		}
+		if( m_recovered )
+		{
+			cerr << "SnapshotDatasetWriter : " << _path << " had no valid index, recovered " << m_index.size() << " records" << endl;
+		}
+		// drop the old index, it is written again behind the next records
+		_writeIndex();
+	}
+	~SnapshotDatasetWriter()
+	{
+		_close();
+	}
+
+	bool isValid() const
+	{
+		return m_fd >= 0;
+	}
+
+	// records in the file
+	int getNumRecords()
+	{
+		lock_guard< mutex > lock( m_mutex );
+		return m_index.size();
+	}
+
+	// frame behind the last frame of the file, the first frame of a resumed run,
+	// records may skip frames ( dropped snapshots ) so it can be more than getNumRecords()
+	uint64_t getNextFrame()
+	{
+		lock_guard< mutex > lock( m_mutex );
+		uint64_t next = 0;
+		for( unsigned int i = 0; i < m_index.size(); i++ )
+		{
+			next = max( next, m_index[i].frame + 1 );
+		}
+		return next;
+	}
+
+	// true if the last run didn't close the file
+	bool isRecovered() const
+	{
+		return m_recovered;
+	}
+
+	// write _record behind the last one, return false on I/O error
+	bool append( const Record &_record )
+	{
+		SnapshotRecordHeader header;
+		memset( &header, 0, sizeof( header ) );
+		header.magic = SNAPSHOT_RECORD_MAGIC;
+		header.num_poses = _record.num_poses;
+		header.frame = _record.frame;
+		header.sim_time = _record.sim_time;
+
+		uint64_t offset = snapshotAlign( sizeof( header ), SNAPSHOT_SECTION_ALIGN );
+		for( int s = 0; s < NUM_SNAPSHOT_SECTIONS; s++ )
+		{
+			if( !_record.section[s] || _record.section_bytes[s] == 0 )
+			{
+				continue;
+			}
+			header.section_offset[s] = offset;
+			header.section_bytes[s] = _record.section_bytes[s];
+			offset = snapshotAlign( offset + _record.section_bytes[s], SNAPSHOT_SECTION_ALIGN );
+		}
+		header.record_bytes = snapshotAlign( offset, SNAPSHOT_RECORD_ALIGN );
+
+		lock_guard< mutex > lock( m_mutex );
+		if( m_fd < 0 )
+		{
+			return false;
+		}
+
+		// header is written last, so a half written record is not recovered
+		bool success = true;
+		for( int s = 0; s < NUM_SNAPSHOT_SECTIONS && success; s++ )
+		{
+			if( header.section_bytes[s] > 0 )
+			{
+				success = _writeAll( _record.section[s], header.section_bytes[s], m_end + header.section_offset[s] );
+			}
+		}
+		// the file size covers the padding of the last section
+		success = success && ftruncate( m_fd, m_end + header.record_bytes ) == 0;
+		success = success && _writeAll( &header, sizeof( header ), m_end );
+		if( !success )
+		{
+			cerr << "SnapshotDatasetWriter : write frame " << _record.frame << " failed, " << strerror( errno ) << endl;
+			return false;
+		}
+
+		SnapshotIndexEntry entry = { _record.frame, m_end, header.record_bytes };
+		m_index.push_back( entry );
+		m_end += header.record_bytes;
+
+		if( ++m_unindexed >= m_index_interval )
+		{
+			_writeIndex();
+		}
+		return true;
+	}
+
+	// write index & footer now
+	void sync()
+	{
+		lock_guard< mutex > lock( m_mutex );
+		if( m_fd >= 0 )
+		{
+			_writeIndex();
+		}
+	}
+
+private:
+	bool _writeAll( const void *_data, uint64_t _bytes, uint64_t _offset )
+	{
+		const unsigned char *data = (const unsigned char*)_data;
+		while( _bytes > 0 )
+		{
+			ssize_t written = pwrite( m_fd, data, _bytes, _offset );
+			if( written <= 0 )
+			{
+				return false;
+			}
+			data += written;
+			_bytes -= written;
+			_offset += written;
+		}
+		return true;
+	}
+
+	// index & footer behind the last record, the file ends with the footer
+	void _writeIndex()
+	{
+		SnapshotDatasetFooter footer;
+		memset( &footer, 0, sizeof( footer ) );
+		footer.magic = SNAPSHOT_FOOTER_MAGIC;
+		footer.version = SNAPSHOT_DATASET_VERSION;
+		footer.index_offset = m_end;
+		footer.num_records = m_index.size();
+
+		uint64_t index_bytes = m_index.size() * sizeof( SnapshotIndexEntry );
+		if(	( index_bytes > 0 && !_writeAll( &m_index[0], index_bytes, m_end ) ) ||
+			!_writeAll( &footer, sizeof( footer ), m_end + index_bytes ) ||
+			ftruncate( m_fd, m_end + index_bytes + sizeof( footer ) ) != 0 )
+		{
+			cerr << "SnapshotDatasetWriter : write index of " << m_path << " failed, " << strerror( errno ) << endl;
+		}
+		m_unindexed = 0;
+	}
+
+	// the file is left as it is
+	void _fail()
+	{
+		close( m_fd );
+		m_fd = -1;
+	}
+
+	void _close()
+	{
+		if( m_fd >= 0 )
+		{
+			_writeIndex();
+			close( m_fd );
+			m_fd = -1;
+		}
+	}
+
+public:
+
+private:
+	string m_path;
+	int m_fd;
+	// records between two index writes
+	int m_index_interval;
+
+	// guards everything below & the file
+	mutex m_mutex;
+	vector< SnapshotIndexEntry > m_index;
+	// end of the last record
+	uint64_t m_end;
+	// records appended since the last index write
+	int m_unindexed;
+	// index was rebuilt from record headers
+	bool m_recovered;
+};
+
+// Maps a dataset file read-only, records are read in place without copying or parsing.
+class SnapshotDatasetReader
+{
+public:
+	// pointers into the mapping, NULL for a missing section
+	struct Record
+	{
+		uint64_t frame;
+		double sim_time;
+		const unsigned char *rgb;
+		const void *cloud;
+		uint64_t cloud_bytes;
+		const unsigned char *label;
+		const SnapshotPose *poses;
+		uint32_t num_poses;
+	};
+
+public:
+	SnapshotDatasetReader()
+		: m_data( NULL ),
+		  m_size( 0 ),
+		  m_recovered( false )
+	{
+		memset( &m_header, 0, sizeof( m_header ) );
+	}
+	~SnapshotDatasetReader()
+	{
+		close();
+	}
+
+	bool open( const string &_path )
+	{
+		close();
+
+		int fd = ::open( _path.c_str(), O_RDONLY );
+		if( fd < 0 )
+		{
+			cerr << "SnapshotDatasetReader : open " << _path << " failed, " << strerror( errno ) << endl;
+			return false;
+		}
+		struct stat st;
+		fstat( fd, &st );
+		if( st.st_size == 0 )
+		{
+			::close( fd );
+			cerr << "SnapshotDatasetReader : " << _path << " is empty" << endl;
+			return false;
+		}
+		void *memory = mmap( NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0 );
+		::close( fd );
+		if( memory == MAP_FAILED )
+		{
+			cerr << "SnapshotDatasetReader : mmap " << _path << " failed, " << strerror( errno ) << endl;
+			return false;
+		}
+		m_data = (const unsigned char*)memory;
+		m_size = st.st_size;
+
+		if( !readSnapshotIndex( m_data, m_size, m_index, m_recovered ) )
+		{
+			cerr << "SnapshotDatasetReader : " << _path << " is not a snapshot dataset" << endl;
+			close();
+			return false;
+		}
+		memcpy( &m_header, m_data, sizeof( m_header ) );
+		return true;
+	}
+
+	void close()
+	{
+		if( m_data )
+		{
+			munmap( (void*)m_data, m_size );
+			m_data = NULL;
+			m_size = 0;
+		}
+		m_index.clear();
+	}
+
+	const SnapshotDatasetHeader &getHeader() const
+	{
+		return m_header;
+	}
+
+	// bytes of every label in the label section
+	uint32_t getLabelBytes() const
+	{
+		return m_header.label_bytes ? m_header.label_bytes : 1;
+	}
+
+	int getNumRecords() const
+	{
+		return m_index.size();
+	}
+
+	// true if the file had no valid footer
+	bool isRecovered() const
+	{
+		return m_recovered;
+	}
+
+	// record at position _idx of the file, false if it is out of range or broken
+	bool getRecord( int _idx, Record &_record ) const
+	{
+		if( _idx < 0 || _idx >= (int)m_index.size() )
+		{
+			return false;
+		}
+		const SnapshotIndexEntry &entry = m_index[ _idx ];
+		const SnapshotRecordHeader *header = (const SnapshotRecordHeader*)( m_data + entry.offset );
+		if( header->magic != SNAPSHOT_RECORD_MAGIC )
+		{
+			return false;
+		}
+		for( int s = 0; s < NUM_SNAPSHOT_SECTIONS; s++ )
+		{
+			if( header->section_offset[s] + header->section_bytes[s] > entry.bytes )
+			{
+				return false;
+			}
+		}
+
+		const unsigned char *record = m_data + entry.offset;
+		_record.frame = header->frame;
+		_record.sim_time = header->sim_time;
+		_record.rgb = header->section_bytes[ SNAPSHOT_SECTION_RGB ] ? record + header->section_offset[ SNAPSHOT_SECTION_RGB ] : NULL;
+		_record.cloud = header->section_bytes[ SNAPSHOT_SECTION_CLOUD ] ? record + header->section_offset[ SNAPSHOT_SECTION_CLOUD ] : NULL;
+		_record.cloud_bytes = header->section_bytes[ SNAPSHOT_SECTION_CLOUD ];
+		_record.label = header->section_bytes[ SNAPSHOT_SECTION_LABEL ] ? record + header->section_offset[ SNAPSHOT_SECTION_LABEL ] : NULL;
+		_record.poses = header->section_bytes[ SNAPSHOT_SECTION_POSE ] ? (const SnapshotPose*)( record + header->section_offset[ SNAPSHOT_SECTION_POSE ] ) : NULL;
+		_record.num_poses = _record.poses ? min( (uint64_t)header->num_poses, header->section_bytes[ SNAPSHOT_SECTION_POSE ] / sizeof( SnapshotPose ) ) : 0;
+		return true;
+	}
+
+	// position of the record of _frame, -1 if there is none
+	int findFrame( uint64_t _frame ) const
+	{
+		for( unsigned int i = 0; i < m_index.size(); i++ )
+		{
+			if( m_index[i].frame == _frame )
+			{
+				return i;
+			}
+		}
+		return -1;
+	}
+
+public:
+
+private:
+	const unsigned char *m_data;
+	uint64_t m_size;
+	SnapshotDatasetHeader m_header;
+	vector< SnapshotIndexEntry > m_index;
+	bool m_recovered;
+};
+
+#endif /* SNAPSHOT_DATASET_H_ */
@@ -0,0 +1,178 @@
+/*
+ * StreamMonitor.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef STREAM_MONITOR_H_
+#define STREAM_MONITOR_H_
+
+#include <mutex>
+#include <sstream>
+#include <string>
+
+#include <gazebo/common/Time.hh>
+
+#include "FrameRing.h"
+
+using namespace std;
+
+// Achieved rate, per stage latency & drops of <capture_trigger> stream.
+// The sensor thread counts captured & dropped frames, the pipeline thread adds every processed frame,
+// processed() summarizes the frames of the last _period seconds of wall time, so the log gets one line per period.
+// latency is the wall time from the start of the capture until the frame is published.
+class StreamMonitor
+{
+public:
+	StreamMonitor( double _period = 1.0 )
+		: m_period( _period ),
+		  m_total_captured( 0 ),
+		  m_total_dropped( 0 ),
+		  m_period_start( -1 ),
+		  m_sim_start( 0 )
+	{
+		_resetPeriod();
+	}
+	~StreamMonitor()
+	{
+	}
+
+	// sensor thread, _slot went to the pipeline, degraded if outputs were left out for backpressure
+	void captured( const FrameSlot &_slot )
+	{
+		lock_guard< mutex > lock( m_mutex );
+		_startClock( _slot.start_time, _slot.sim_time );
+		m_captured++;
+		m_total_captured++;
+		if( _slot.degrade > 0 )
+		{
+			m_degraded++;
+		}
+	}
+
+	// sensor thread, a frame was dropped at _sim_time because post processing is behind
+	void dropped( double _sim_time )
+	{
+		lock_guard< mutex > lock( m_mutex );
+		_startClock( gazebo::common::Time::GetWallTime().Double(), _sim_time );
+		m_dropped++;
+		m_total_dropped++;
+	}
+
+	// pipeline thread, after _slot is published
+	// return true with the summary in _summary once a period is over
+	bool processed( const FrameSlot &_slot, string &_summary )
+	{
+		lock_guard< mutex > lock( m_mutex );
+		double now = gazebo::common::Time::GetWallTime().Double();
+
+		_startClock( _slot.start_time, _slot.sim_time );
+
+		double latency = now - _slot.start_time;
+		m_processed++;
+		m_latency += latency;
+		m_max_latency = max( m_max_latency, latency );
+		for( int i = 0; i < FrameStages::NUM_STAGES; i++ )
+		{
+			if( !_slot.stages.isSkipped( i ) )
+			{
+				m_stage_seconds[i] += _slot.stages.seconds[i];
+				m_stage_frames[i]++;
+			}
+		}
+
+		double elapsed = now - m_period_start;
+		if( elapsed < m_period )
+		{
+			return false;
+		}
+
+		// frames per wall & sim second, they differ when the real time factor isn't 1
+		double sim_elapsed = _slot.sim_time - m_sim_start;
+		ostringstream ss;
+		ss << m_processed / elapsed << " fps";
+		if( sim_elapsed > 0 )
+		{
+			ss << " ( " << m_processed / sim_elapsed << " per sim second )";
+		}
+		ss << ", captured " << m_captured
+		   << ", dropped " << m_dropped
+		   << ", degraded " << m_degraded
+		   << ", total captured " << m_total_captured << " dropped " << m_total_dropped
+		   << ", latency mean " << m_latency / m_processed * 1000 << " ms max " << m_max_latency * 1000 << " ms";
+		for( int i = 0; i < FrameStages::NUM_STAGES; i++ )
+		{
+			if( m_stage_frames[i] > 0 )
+			{
+				ss << ", " << FrameStages::getName( i ) << " " << m_stage_seconds[i] / m_stage_frames[i] * 1000 << " ms";
+			}
+		}
+		_summary = ss.str();
+
+		_startPeriod( now, _slot.sim_time );
+		return true;
+	}
+
+private:
+	// the first captured or dropped frame starts the first period, without clearing its counters, m_mutex must be locked
+	void _startClock( double _now, double _sim_time )
+	{
+		if( m_period_start < 0 )
+		{
+			m_period_start = _now;
+			m_sim_start = _sim_time;
+		}
+	}
+
+	// m_mutex must be locked
+	void _startPeriod( double _now, double _sim_time )
+	{
+		m_period_start = _now;
+		m_sim_start = _sim_time;
+		_resetPeriod();
+	}
+
+	void _resetPeriod()
+	{
+		m_captured = 0;
+		m_dropped = 0;
+		m_degraded = 0;
+		m_processed = 0;
+		m_latency = 0;
+		m_max_latency = 0;
+		for( int i = 0; i < FrameStages::NUM_STAGES; i++ )
+		{
+			m_stage_seconds[i] = 0;
+			m_stage_frames[i] = 0;
+		}
+	}
+
+public:
+
+private:
+	// seconds of wall time per summary
+	double m_period;
+	// guards every counter, the sensor & pipeline threads both count
+	mutex m_mutex;
+
+	// since the plugin was loaded
+	unsigned long m_total_captured;
+	unsigned long m_total_dropped;
+
+	// wall & sim time the period started, m_period_start < 0 before the first captured or dropped frame
+	double m_period_start;
+	double m_sim_start;
+	// frames of the period
+	unsigned long m_captured;
+	unsigned long m_dropped;
+	unsigned long m_degraded;
+	unsigned long m_processed;
+	// capture start until published, sum & max of the period
+	double m_latency;
+	double m_max_latency;
+	// seconds & frames of every stage that wasn't skipped
+	double m_stage_seconds[ FrameStages::NUM_STAGES ];
+	unsigned long m_stage_frames[ FrameStages::NUM_STAGES ];
+};
+
+#endif /* STREAM_MONITOR_H_ */
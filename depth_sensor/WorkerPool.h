@@ -0,0 +1,250 @@
+/*
+ * WorkerPool.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef WORKER_POOL_H_
+#define WORKER_POOL_H_
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// Threads created once and kept for the plugin's lifetime, so per frame work doesn't pay for thread creation.
+// parallelFor() splits a row range into tiles, the calling thread works on tiles too and returns when all are done.
+class WorkerPool
+{
+public:
+	// _num_workers threads besides the calling thread, pinned to _cpus if not empty
+	WorkerPool(	unsigned int		_num_workers,
+				const vector< int >	&_cpus = vector< int >() )
+		: m_cpus( _cpus ),
+		  m_generation( 0 ),
+		  m_stop( false ),
+		  m_active_workers( 0 ),
+		  m_func( NULL ),
+		  m_invoke( NULL ),
+		  m_num_tiles( 0 ),
+		  m_tile_rows( 1 ),
+		  m_begin( 0 ),
+		  m_end( 0 ),
+		  m_next_tile( 0 ),
+		  m_done_tiles( 0 )
+	{
+		for( unsigned int i = 0; i < _num_workers; i++ )
+		{
+			m_workers.push_back( thread( &WorkerPool::_workerLoop, this ) );
+		}
+	}
+	~WorkerPool()
+	{
+		{
+			lock_guard< mutex > lock( m_mutex );
+			m_stop = true;
+		}
+		m_start_cv.notify_all();
+
+		for( unsigned int i = 0; i < m_workers.size(); i++ )
+		{
+			m_workers[i].join();
+		}
+	}
+
+	// workers + calling thread
+	unsigned int getNumThreads() const
+	{
+		return m_workers.size() + 1;
+	}
+
+	// call _func( first row, last row + 1 ) for every tile of _tile_rows rows in [ _begin, _end ), blocks until every tile is done
+	// _func is any callable taken by reference, so lambdas aren't copied into a std::function ( which may allocate )
+	template< typename Func >
+	void parallelFor( int _begin, int _end, int _tile_rows, const Func &_func )
+	{
+		int num_tiles = ( _end - _begin + _tile_rows - 1 ) / _tile_rows;
+
+		// nothing to share, or called from inside a tile
+		if( m_workers.empty() || num_tiles <= 1 || _isWorkerThread() )
+		{
+			for( int y0 = _begin; y0 < _end; y0 += _tile_rows )
+			{
+				_func( y0, min( y0 + _tile_rows, _end ) );
+			}
+			return;
+		}
+
+		// one job at a time
+		lock_guard< mutex > job_lock( m_job_mutex );
+		{
+			// workers woken late by the last job may still be looking for tiles
+			unique_lock< mutex > lock( m_mutex );
+			m_done_cv.wait( lock, [this]{ return m_active_workers == 0; } );
+
+			m_func = &_func;
+			m_invoke = &_invokeTile< Func >;
+			m_begin = _begin;
+			m_end = _end;
+			m_tile_rows = _tile_rows;
+			m_num_tiles = num_tiles;
+			m_next_tile = 0;
+			m_done_tiles = 0;
+			m_generation++;
+		}
+		m_start_cv.notify_all();
+
+		// tiles calling parallelFor() again run it by themselves
+		_isWorkerThread() = true;
+		int num_done = _runTiles();
+		_isWorkerThread() = false;
+
+		// wait for tiles taken by workers
+		unique_lock< mutex > lock( m_mutex );
+		m_done_tiles += num_done;
+		m_done_cv.wait( lock, [this]{ return m_done_tiles == m_num_tiles && m_active_workers == 0; } );
+	}
+
+	// every online cpu except _excluded_cpu
+	static vector< int > cpusExcept( int _excluded_cpu )
+	{
+		vector< int > cpus;
+		cpu_set_t cpu_set;
+		CPU_ZERO( &cpu_set );
+		if( sched_getaffinity( 0, sizeof( cpu_set ), &cpu_set ) == 0 )
+		{
+			for( int cpu = 0; cpu < CPU_SETSIZE; cpu++ )
+			{
+				if( CPU_ISSET( cpu, &cpu_set ) && cpu != _excluded_cpu )
+				{
+					cpus.push_back( cpu );
+				}
+			}
+		}
+		return cpus;
+	}
+
+	// pin the calling thread to _cpus, return false if failed
+	static bool pinCurrentThread( const vector< int > &_cpus )
+	{
+		if( _cpus.empty() )
+		{
+			return false;
+		}
+
+		cpu_set_t cpu_set;
+		CPU_ZERO( &cpu_set );
+		for( unsigned int i = 0; i < _cpus.size(); i++ )
+		{
+			CPU_SET( _cpus[i], &cpu_set );
+		}
+		return pthread_setaffinity_np( pthread_self(), sizeof( cpu_set ), &cpu_set ) == 0;
+	}
+
+private:
+	void _workerLoop()
+	{
+		_isWorkerThread() = true;
+
+		if( !m_cpus.empty() && !pinCurrentThread( m_cpus ) )
+		{
+			cerr << "WorkerPool : failed to pin worker thread" << endl;
+		}
+
+		unsigned long generation = 0;
+		while( true )
+		{
+			{
+				unique_lock< mutex > lock( m_mutex );
+				m_start_cv.wait( lock, [&]{ return m_stop || m_generation != generation; } );
+				if( m_stop )
+				{
+					return;
+				}
+				generation = m_generation;
+				m_active_workers++;
+			}
+
+			int num_done = _runTiles();
+
+			{
+				lock_guard< mutex > lock( m_mutex );
+				m_done_tiles += num_done;
+				m_active_workers--;
+			}
+			m_done_cv.notify_all();
+		}
+	}
+
+	// take tiles until none is left, return number of tiles done
+	int _runTiles()
+	{
+		int num_done = 0;
+		while( true )
+		{
+			int tile = m_next_tile++;
+			if( tile >= m_num_tiles )
+			{
+				break;
+			}
+
+			int y0 = m_begin + tile * m_tile_rows;
+			m_invoke( m_func, y0, min( y0 + m_tile_rows, m_end ) );
+			num_done++;
+		}
+		return num_done;
+	}
+
+	// calls the callable of the current job, m_func points to a Func
+	template< typename Func >
+	static void _invokeTile( const void *_func, int _y0, int _y1 )
+	{
+		( *static_cast< const Func* >( _func ) )( _y0, _y1 );
+	}
+
+	static bool &_isWorkerThread()
+	{
+		static thread_local bool is_worker = false;
+		return is_worker;
+	}
+
+public:
+
+private:
+	vector< thread > m_workers;
+	// cpus workers are pinned to ( empty for no pinning )
+	vector< int > m_cpus;
+
+	// guards everything below except m_next_tile
+	mutex m_mutex;
+	// serializes parallelFor() called from different threads
+	mutex m_job_mutex;
+	condition_variable m_start_cv;
+	condition_variable m_done_cv;
+	// increased for every job, workers wake up when it changes
+	unsigned long m_generation;
+	bool m_stop;
+	// workers between waking up and finishing their tiles
+	int m_active_workers;
+
+	// current job
+	// callable of parallelFor() & the thunk calling it
+	const void *m_func;
+	void ( *m_invoke )( const void*, int, int );
+	int m_num_tiles;
+	int m_tile_rows;
+	int m_begin;
+	int m_end;
+	atomic< int > m_next_tile;
+	int m_done_tiles;
+};
+
+#endif /* WORKER_POOL_H_ */
@@ -16,27 +16,38 @@
 #include <pcl/io/pcd_io.h>
 #include <pcl/point_types.h>
 #include <pcl/io/ply_io.h>
-#include <pcl/filters/fast_bilateral_omp.h>
 
 #include <opencv2/core/core.hpp>
 #include <opencv2/imgproc/imgproc.hpp>
 #include <opencv2/highgui/highgui.hpp>
 
-#include <boost/archive/binary_oarchive.hpp>
-#include <boost/archive/binary_iarchive.hpp>
+#include <boost/algorithm/string/trim.hpp>
 
 #include <gazebo/msgs/request.pb.h>
+#include <gazebo/msgs/image.pb.h>
 #include <gazebo/gazebo.hh>
 #include <gazebo/sensors/sensors.hh>
 
 #include "/home/kevin/research/gazebo/msgs/include/point_cloud.pb.h"
-
-#include "perlin_noise.h"
-#include "cvmat_serialization.h"
+#include "/home/kevin/research/gazebo/msgs/include/packed_point_cloud.pb.h"
+#include "/home/kevin/research/gazebo/msgs/include/shm_frame.pb.h"
+#include "/home/kevin/research/gazebo/msgs/include/compressed_depth.pb.h"
+
+#include "PerlinNoiseEngine.h"
+#include "NoiseFieldBank.h"
+#include "SensorNoiseBank.h"
+#include "SensorCalibration.h"
+#include "OcclusionEdgeEroder.h"
+#include "DepthPostProcessKernel.h"
+#include "DepthBilateralFilter.h"
 
 #define COUT_PREFIX "\033[1;32m" << "[DepthSensorPlugin] " << "\033[0m"
 #define CERR_PREFIX "\033[1;31m" << "[DepthSensorPlugin]" << "\033[0m"
 
+// grid sizes of the perlin noises of every frame
+static const int PERLIN_GRID_40[] = { 40 };
+static const int PERLIN_GRID_5_10_20[] = { 5, 10, 20 };
+
 
 using namespace std;
 using namespace gazebo;
@@ -44,13 +55,68 @@ using namespace gazebo;
 DepthSensorPlugin::DepthSensorPlugin()
 	: m_scene_mgr( NULL ),
 	  m_ogre_camera( NULL ),
+	  m_capture_state( NULL ),
+	  m_entity_cache( NULL ),
 	  SENSOR_IR_PROJECTOR_NAME_PREFIX( "Sensor_IR_Projector_" ),
 	  m_rgb_rt_listener( NULL ),
 	  m_depth_rt_listener( NULL ),
 	  m_rayconf_rt_listener( NULL ),
+	  m_mask_pass( NULL ),
+	  m_frame_ring( NULL ),
+	  m_worker_pool( NULL ),
+	  m_physics_thread_pinned( false ),
+	  m_sensor_thread_pinned( false ),
+	  m_edge_eroder( NULL ),
+	  m_post_process_kernel( NULL ),
+	  m_bilateral_filter( NULL ),
+	  m_depth_codec( NULL ),
+	  m_sensor_noise( NULL ),
+	  m_calibration( NULL ),
+	  m_perlin_engine( NULL ),
+	  m_noise_bank( NULL ),
+	  m_cloud_queue( NULL ),
+	  m_shm_ring( NULL ),
+	  m_snapshot_writer( NULL ),
+	  m_snapshot_dataset( NULL ),
 	  m_take_picture( false ),
+	  m_sequence( 0 ),
+	  m_stream_degrade( 0 ),
+	  m_stream_on_time( 0 ),
+	  m_stream_monitor( NULL ),
 	  m_segment_rt_listener( NULL ),
-	  m_use_ideal_segmentation( true )
+	  m_mrt( NULL ),
+	  m_mrt_listener( NULL ),
+	  m_use_ideal_segmentation( true ),
+	  m_outputs( OUTPUT_CLOUD ),
+	  m_capture_mode( CAPTURE_SEQUENTIAL ),
+	  m_segment_encoding( SEGMENT_ENCODING_GREY ),
+	  m_depth_format( DEPTH_FORMAT_RGBA32F ),
+	  m_rayconf_format( RAYCONF_FORMAT_XYZC32F ),
+	  m_noise_seed( -1 ),
+	  m_noise_bank_mb( 64 ),
+	  m_noise_realizations( 8 ),
+	  m_noise_refresh_period( 2.0 ),
+	  m_noise_cache_dir( "noise_cache" ),
+	  m_calibration_file( "sensor_calibration.gzcal" ),
+	  m_post_process_mode( POST_PROCESS_FUSED ),
+	  m_mask_pass_mode( MASK_PASS_CPU ),
+	  m_worker_threads( 0 ),
+	  m_worker_affinity( AFFINITY_NONE ),
+	  m_physics_cpu( 0 ),
+	  m_cloud_message( CLOUD_MESSAGE_LEGACY ),
+	  m_shm_name( "gazebo_depth_sensor" ),
+	  m_shm_slots( 4 ),
+	  m_depth_step_mm( 0.1f ),
+	  m_snapshot_cloud( SNAPSHOT_CLOUD_NONE ),
+	  m_snapshot_writer_threads( 2 ),
+	  m_snapshot_queue_size( 8 ),
+	  m_snapshot_queue_policy( AsyncSnapshotWriter::POLICY_BLOCK ),
+	  m_snapshot_format( SNAPSHOT_FORMAT_FILES ),
+	  m_snapshot_dataset_path( "only_snapshot/snapshot.gzds" ),
+	  m_publish_queue_depth( 2 ),
+	  m_frame_slots( 2 ),
+	  m_capture_trigger( CAPTURE_TRIGGER_REQUEST ),
+	  m_stream_backpressure( BACKPRESSURE_DROP )
 	// TODO initialize class variable
 {
 }
@@ -60,10 +126,11 @@ DepthSensorPlugin::~DepthSensorPlugin()
 	// don't know if this is necessary
 	this->m_camera_sensor->DisconnectUpdated( this->m_update_connection );
 
-	// free container
-	m_turned_off_lights.clear();
-	m_turned_off_mobj.clear();
-	m_cloned_entity.clear();
+	// frames still in the pipeline use everything below
+	if( m_frame_ring )
+	{
+		m_frame_ring->flush();
+	}
 
 	// free render texture
 	m_rgb_rt->removeAllListeners();
@@ -72,11 +139,46 @@ DepthSensorPlugin::~DepthSensorPlugin()
 
 	m_segment_rt->removeAllListeners();
 
-	// free frame buffer
-	delete []m_rgb_buffer;
-	delete []m_depth_buffer;
-	delete []m_rayconf_buffer;
-	delete []m_segment_buffer;
+	// private scene manager, material & textures of the mask pass
+	delete m_mask_pass;
+
+	if( m_mrt )
+	{
+		m_mrt->removeAllListeners();
+		Ogre::Root::getSingleton().getRenderSystem()->destroyRenderTarget( m_mrt->getName() );
+	}
+
+	// destroy cached proxies
+	delete m_entity_cache;
+	// restores gazebo's settings if a capture didn't end
+	delete m_capture_state;
+
+	delete m_perlin_engine;
+	delete m_noise_bank;
+	// stops the refresh thread
+	delete m_sensor_noise;
+	// unmaps the noise magnitude, after the noise bank
+	delete m_calibration;
+	delete m_edge_eroder;
+	delete m_post_process_kernel;
+	delete m_bilateral_filter;
+	delete m_depth_codec;
+
+	delete m_cloud_queue;
+	// removes the shared memory object, readers keep their mapping
+	delete m_shm_ring;
+
+	// writes every queued snapshot file first
+	delete m_snapshot_writer;
+	// index & footer are written when closing
+	delete m_snapshot_dataset;
+
+	// frame buffers, after the snapshot jobs holding them
+	delete m_frame_ring;
+	delete m_stream_monitor;
+
+	// after everything using it
+	delete m_worker_pool;
 }
 
 void DepthSensorPlugin::Load( sensors::SensorPtr _sensor, sdf::ElementPtr _sdf )
@@ -126,6 +228,19 @@ void DepthSensorPlugin::Load( sensors::SensorPtr _sensor, sdf::ElementPtr _sdf )
 	std::cout << "\n" << std::endl;
 	std::cout << "Setting up depth sensor..." << std::endl;
 
+	this->_loadParameters( _sdf );
+	this->_setupWorkerPool();
+	m_snapshot_writer = new AsyncSnapshotWriter( m_snapshot_writer_threads, m_snapshot_queue_size, m_snapshot_queue_policy );
+	m_stream_monitor = new StreamMonitor();
+	// render targets write into its slots, so it's created before them
+	m_frame_ring = new FrameRing(	m_camera->GetImageWidth(),
+									m_camera->GetImageHeight(),
+									m_frame_slots,
+									std::bind( &DepthSensorPlugin::_processFrame, this, std::placeholders::_1 ),
+									m_worker_cpus,
+									m_rt_layout.depthPixelBytes(),
+									m_rt_layout.rayconfPixelBytes(),
+									m_mask_pass_mode == MASK_PASS_GPU );
 	this->_loadPlugins();
 	//std::cout << "\tFinish _loadPlugins()" << std::endl;
 	this->_addResources();
@@ -140,6 +255,10 @@ void DepthSensorPlugin::Load( sensors::SensorPtr _sensor, sdf::ElementPtr _sdf )
 	// ************************ //
 	this->_setupIdealSegmentation();
 	//std::cout << "\tFinish _setupIdealSegmentation()" << std::endl;
+	if( m_capture_mode == CAPTURE_MRT )
+	{
+		this->_setupMultiRenderTarget();
+	}
 	std::cout << "Depth sensor completed!" << std::endl;
 	std::cout << "\n" << std::endl;
 
@@ -150,7 +269,35 @@ void DepthSensorPlugin::Load( sensors::SensorPtr _sensor, sdf::ElementPtr _sdf )
 	// Initialize the node with the world name
 	m_node_ptr->Init( m_camera_sensor->GetWorldName() );
 
-	if( m_use_ideal_segmentation )
+	if( m_cloud_message == CLOUD_MESSAGE_SHM )
+	{
+		m_shm_ring = new SharedMemoryRingWriter( m_shm_name, m_camera->GetImageWidth(), m_camera->GetImageHeight(), m_shm_slots );
+		if( m_shm_ring->isValid() )
+		{
+			cout << "\tshared memory ring : /" << m_shm_name << ", " << m_shm_slots << " slots" << endl;
+		}
+		else
+		{
+			cerr << CERR_PREFIX << "shared memory ring not available, use packed" << endl;
+			delete m_shm_ring;
+			m_shm_ring = NULL;
+			m_cloud_message = CLOUD_MESSAGE_PACKED;
+		}
+	}
+
+	if( m_cloud_message == CLOUD_MESSAGE_SHM )
+	{
+		m_publisher_ptr = m_node_ptr->Advertise< pcl::msgs::SharedMemoryFrame >("~/depth_sensor/point_cloud");
+	}
+	else if( m_cloud_message == CLOUD_MESSAGE_PACKED )
+	{
+		m_publisher_ptr = m_node_ptr->Advertise< pcl::msgs::PackedPointCloud >("~/depth_sensor/point_cloud");
+	}
+	else if( m_cloud_message == CLOUD_MESSAGE_COMPRESSED )
+	{
+		m_publisher_ptr = m_node_ptr->Advertise< pcl::msgs::CompressedDepthCloud >("~/depth_sensor/point_cloud");
+	}
+	else if( m_use_ideal_segmentation )
 	{
 		m_publisher_ptr = m_node_ptr->Advertise< pcl::msgs::PointCloudXYZL >("~/depth_sensor/point_cloud");
 	}
@@ -158,7 +305,14 @@ void DepthSensorPlugin::Load( sensors::SensorPtr _sensor, sdf::ElementPtr _sdf )
 	{
 		m_publisher_ptr = m_node_ptr->Advertise< pcl::msgs::PointCloud >("~/depth_sensor/point_cloud");
 	}
+	m_cloud_queue = new PublicationQueue( m_publisher_ptr, m_publish_queue_depth );
 	m_rethrow_publisher_ptr = m_node_ptr->Advertise< gazebo::msgs::Request >("~/depth_sensor/rethrow_event");
+	m_snapshot_event_publisher_ptr = m_node_ptr->Advertise< gazebo::msgs::Request >("~/depth_sensor/snapshot_event");
+
+	// one topic per output, their passes are only rendered while somebody subscribes ( see _outputDemand() )
+	m_labels_publisher_ptr = m_node_ptr->Advertise< gazebo::msgs::Image >("~/depth_sensor/labels");
+	m_rgb_publisher_ptr = m_node_ptr->Advertise< gazebo::msgs::Image >("~/depth_sensor/rgb");
+	m_confidence_publisher_ptr = m_node_ptr->Advertise< gazebo::msgs::Image >("~/depth_sensor/confidence");
 
 	// listen to take picture request from evaluation platform
 	m_subscriber_ptr = m_node_ptr->Subscribe( "~/evaluation_platform/take_picture_request", &DepthSensorPlugin::_takePicture, this );
@@ -168,61 +322,148 @@ void DepthSensorPlugin::Load( sensors::SensorPtr _sensor, sdf::ElementPtr _sdf )
 // Calls whenever DepthSensorPlugin is updated //
 void DepthSensorPlugin::_onUpdatedCallback()
 {
+	// sensor thread works on tiles with the workers, keep it off the physics cpu too
+	if( !m_sensor_thread_pinned && m_worker_affinity == AFFINITY_ISOLATE_PHYSICS )
+	{
+		m_sensor_thread_pinned = true;
+		if( !WorkerPool::pinCurrentThread( m_worker_cpus ) )
+		{
+			cerr << CERR_PREFIX << "failed to pin sensor thread" << endl;
+		}
+	}
+
+	// point clouds published before the estimator subscribed
+	if( m_cloud_queue && m_cloud_queue->flush() > 0 )
+	{
+		cout << COUT_PREFIX << "delivered queued point clouds, " << m_cloud_queue->getSummary() << endl;
+	}
+
+	// stream : every sensor update at <update_rate> is a frame, only_snapshot runs still go by request
+	bool stream = m_capture_trigger == CAPTURE_TRIGGER_STREAM && !m_snapshot;
+
 	// action only receiving request
-	if( m_take_picture )
+	if( m_take_picture || stream )
 	{
-		cout << "Sensor start time : " << common::Time::GetWallTimeAsISOString() << endl;
+		// every snapshot of this run is taken
+		if( m_snapshot && m_save_count > m_total_snapshot )
+		{
+			m_take_picture = false;
+			return;
+		}
 
-		// TODO : TEMP START
+		// a stream reports once per second in _processFrame() instead
+		if( !stream )
+		{
+			cout << "Sensor start time : " << common::Time::GetWallTimeAsISOString() << endl;
+		}
+
+		// start of the capture ( FrameSlot::start_time )
 		double time = common::Time::GetWallTime().Double();
-		// TEMP END
 
-		// ********************************* //
-		// update our render target manually //
-		// ********************************* //
+		// frames dropped by backpressure keep their sequence number
+		uint64_t sequence = m_sequence++;
 
-		// hide the grid first if it is visible
-		rendering::ScenePtr scene = m_camera_sensor->GetCamera()->GetScene();
-		unsigned int grid_count = scene->GetGridCount();
-		std::vector<uint32_t> visible_grid_id;
-		for( unsigned int i = 0; i < grid_count; i++ )
+		FrameSlot *slot;
+		if( stream )
 		{
-			if( scene->GetGrid( i )->GetSceneNode()->getAttachedObject( 0 )->getVisible() )	// should have only one attachment on this scenenode
+			slot = _acquireStreamSlot();
+			if( !slot )
 			{
-				visible_grid_id.push_back( i );
-				scene->GetGrid( i )->Enable( false );
+				m_stream_monitor->dropped( m_scene->GetSimTime().Double() );
+				m_take_picture = false;
+				return;
 			}
 		}
-
-		// update the render target
-		m_rgb_rt->update( true );
-		m_depth_rt->update( true );
-		m_rayconf_rt->update( true );
-
-		if( m_use_ideal_segmentation )
+		else
 		{
-			m_segment_rt->update( true );
+			// waits only if every slot is still post processed or written
+			slot = m_frame_ring->acquire();
 		}
+		slot->start_time = time;
+		slot->sequence = sequence;
+		slot->stream = stream;
+		slot->degrade = stream ? m_stream_degrade : 0;
+		// only the passes of outputs somebody needs are rendered
+		slot->outputs = _outputDemand( slot->stream, slot->degrade );
+		slot->stages.reset();
+		_bindFrameSlot( *slot );
+
+		bool cloud = slot->outputs & OUTPUT_CLOUD;
+		bool labels = slot->outputs & OUTPUT_LABELS;
+		bool confidence = slot->outputs & OUTPUT_CONFIDENCE;
 
-		// unhide the Grid if it's visible before
-		for( unsigned int i = 0; i < visible_grid_id.size(); i++ )
+		// ********************************* //
+		// update our render target manually //
+		// ********************************* //
+		if( cloud || labels || confidence )
 		{
-			scene->GetGrid( visible_grid_id[i] )->Enable( true );
-		}
+			// save gazebo's settings & hide the grid, every pass applies its profile of m_capture_state
+			m_capture_state->begin();
 
-		// destroy vector
-		visible_grid_id.clear();
+			// clone proxies for newly added models, drop removed ones
+			m_entity_cache->update();
 
-		// **************** //
-		// save sensor data //
-		// **************** //
-		this->_saveSensorData();
+			// update the render target
+			double pass_time = common::Time::GetWallTime().Double();
+			if( cloud )
+			{
+				m_rgb_rt->update( true );
+				slot->stages.stop( FrameStages::STAGE_RGB, pass_time );
+			}
 
-		// TODO : TEMP START
-		cout << "Sensor simulation time : " << common::Time::GetWallTime().Double() - time << endl;
-		// TEMP END
+			if( m_capture_mode == CAPTURE_MRT )
+			{
+				// depth, rayconf & label in one pass
+				pass_time = common::Time::GetWallTime().Double();
+				m_mrt->update( true );
+				slot->stages.stop( FrameStages::STAGE_MRT, pass_time );
+			}
+			else
+			{
+				if( cloud )
+				{
+					pass_time = common::Time::GetWallTime().Double();
+					m_depth_rt->update( true );
+					slot->stages.stop( FrameStages::STAGE_DEPTH, pass_time );
+				}
+				if( cloud || confidence )
+				{
+					pass_time = common::Time::GetWallTime().Double();
+					m_rayconf_rt->update( true );
+					slot->stages.stop( FrameStages::STAGE_RAYCONF, pass_time );
+				}
+				if( labels )
+				{
+					pass_time = common::Time::GetWallTime().Double();
+					m_segment_rt->update( true );
+					slot->stages.stop( FrameStages::STAGE_SEGMENT, pass_time );
+				}
+			}
 
-		cout << "Sensor finish time : " << common::Time::GetWallTimeAsISOString() << endl;
+			// restore gazebo's settings & unhide the grid if it's visible before
+			m_capture_state->end();
+		}
+
+		// saturation & confidence masks of this frame, its noise goes with the slot to post process & verification
+		if( m_mask_pass && cloud )
+		{
+			double mask_time = common::Time::GetWallTime().Double();
+			_generatePerlinNoise( PERLIN_GRID_40, 1, slot->noise_40 );
+			_generatePerlinNoise( PERLIN_GRID_5_10_20, 3, slot->conf_noise );
+			m_mask_pass->setNoise( slot->noise_40, slot->conf_noise );
+			m_mask_pass->update();
+			slot->stages.stop( FrameStages::STAGE_MASK, mask_time );
+		}
+
+		// ************************************************ //
+		// save sensor data, post processed by m_frame_ring //
+		// ************************************************ //
+		this->_captureSceneState( *slot );
+		if( stream )
+		{
+			m_stream_monitor->captured( *slot );
+		}
+		m_frame_ring->submit( slot );
 
 		// reset m_take_picture
 		m_take_picture = false;
@@ -258,91 +499,531 @@ void DepthSensorPlugin::_takePicture( ConstMsgsRequestPtr &_msgs )
 	m_take_picture = true;
 }
 
-void DepthSensorPlugin::_loadPlugins()
+void DepthSensorPlugin::_loadParameters( sdf::ElementPtr _sdf )
 {
-	std::string required_plugin = "Cg Program Manager";
+	// every parameter is optional, default values are set in constructor
+	if( _sdf->HasElement( "capture_mode" ) )
+	{
+		std::string capture_mode = boost::algorithm::trim_copy( _sdf->Get< std::string >( "capture_mode" ) );
+		if( capture_mode == "mrt" )
+		{
+			m_capture_mode = CAPTURE_MRT;
+		}
+		else if( capture_mode == "sequential" )
+		{
+			m_capture_mode = CAPTURE_SEQUENTIAL;
+		}
+		else
+		{
+			cerr << CERR_PREFIX << "unknown capture_mode : " << capture_mode << ", use sequential" << endl;
+		}
+	}
+	std::cout << "\tcapture mode : " << ( m_capture_mode == CAPTURE_MRT ? "mrt" : "sequential" ) << std::endl;
 
-	// Check if the required plugins are installed and ready for use
-	// If not: load the plugin
-	std::cout << "\tloading : " << required_plugin << std::endl;
-	//Ogre::Root::PluginInstanceList ip = Ogre::Root::getSingletonPtr()->getInstalledPlugins();
+	if( _sdf->HasElement( "segment_encoding" ) )
+	{
+		std::string segment_encoding = boost::algorithm::trim_copy( _sdf->Get< std::string >( "segment_encoding" ) );
+		if( segment_encoding == "id" )
+		{
+			m_segment_encoding = SEGMENT_ENCODING_ID;
+		}
+		else if( segment_encoding == "grey" )
+		{
+			m_segment_encoding = SEGMENT_ENCODING_GREY;
+		}
+		else
+		{
+			cerr << CERR_PREFIX << "unknown segment_encoding : " << segment_encoding << ", use grey" << endl;
+		}
+	}
+	std::cout << "\tsegment encoding : " << ( m_segment_encoding == SEGMENT_ENCODING_ID ? "id" : "grey" ) << std::endl;
 
-	// try to find the required plugin in the current installed plugins
-	bool found = false;
+	if( _sdf->HasElement( "depth_format" ) )
+	{
+		std::string depth_format = boost::algorithm::trim_copy( _sdf->Get< std::string >( "depth_format" ) );
+		if( depth_format == "r32f" )
+		{
+			m_depth_format = DEPTH_FORMAT_R32F;
+		}
+		else if( depth_format == "rgba32f" )
+		{
+			m_depth_format = DEPTH_FORMAT_RGBA32F;
+		}
+		else
+		{
+			cerr << CERR_PREFIX << "unknown depth_format : " << depth_format << ", use rgba32f" << endl;
+		}
+	}
+	if( _sdf->HasElement( "rayconf_format" ) )
+	{
+		std::string rayconf_format = boost::algorithm::trim_copy( _sdf->Get< std::string >( "rayconf_format" ) );
+		if( rayconf_format == "c32f" )
+		{
+			m_rayconf_format = RAYCONF_FORMAT_C32F;
+		}
+		else if( rayconf_format == "c16f" )
+		{
+			m_rayconf_format = RAYCONF_FORMAT_C16F;
+		}
+		else if( rayconf_format == "xyzc32f" )
+		{
+			m_rayconf_format = RAYCONF_FORMAT_XYZC32F;
+		}
+		else
+		{
+			cerr << CERR_PREFIX << "unknown rayconf_format : " << rayconf_format << ", use xyzc32f" << endl;
+		}
+	}
+	// MRT pass writes labels into depth & binds surfaces of the same format
+	if( m_capture_mode == CAPTURE_MRT && ( m_depth_format != DEPTH_FORMAT_RGBA32F || m_rayconf_format != RAYCONF_FORMAT_XYZC32F ) )
+	{
+		cerr << CERR_PREFIX << "mrt capture_mode needs rgba32f depth_format & xyzc32f rayconf_format, use them" << endl;
+		m_depth_format = DEPTH_FORMAT_RGBA32F;
+		m_rayconf_format = RAYCONF_FORMAT_XYZC32F;
+	}
+	m_rt_layout = RenderTargetLayout( m_depth_format, m_rayconf_format );
+	std::cout << "\tdepth format : " << ( m_depth_format == DEPTH_FORMAT_R32F ? "r32f" : "rgba32f" )
+			  << ", rayconf format : " << ( m_rayconf_format == RAYCONF_FORMAT_C32F ? "c32f" :
+											m_rayconf_format == RAYCONF_FORMAT_C16F ? "c16f" : "xyzc32f" )
+			  << ( m_rt_layout.reconstructsXYZ() ? ", xyz from depth" : "" ) << std::endl;
 
-	//for( Ogre::Root::PluginInstanceList::iterator k = ip.begin(); k != ip.end(); k++ )
-	//{
-	//	std::cout << ' ' << (*k) ;
-	//	std::cout << "\n" << std::endl;
-	//	if( (*k)->getName() == required_plugin )
-	//	{
-	//		found = true;
-	//		std::cout << "\t\tFOUND" << std::endl;
-			//std::cout << required_plugin << std::endl;
+	if( _sdf->HasElement( "noise_seed" ) )
+	{
+		m_noise_seed = _sdf->Get< int >( "noise_seed" );
+	}
+	if( m_noise_seed >= 0 )
+	{
+		std::cout << "\tnoise seed : " << m_noise_seed << std::endl;
+	}
 
-	//		break;
-	//	}
-	//}
-	// load the required_plugin
+	if( _sdf->HasElement( "noise_bank_mb" ) )
+	{
+		m_noise_bank_mb = _sdf->Get< int >( "noise_bank_mb" );
+	}
+	std::cout << "\tnoise bank : " << m_noise_bank_mb << " MB" << std::endl;
 
-	if( !found )
+	if( _sdf->HasElement( "noise_realizations" ) )
 	{
-		// load Plugin_CgProgramManager ( this loading plugin method is from gazebo/RenderEngine.cc )
-		std::list<std::string> ogrePaths = common::SystemPaths::Instance()->GetOgrePaths();
-		/*
-		//std::list<std::string> ogrePaths = "/usr/local/lib/OGRE";
-		for( std::list<std::string>::iterator iter = ogrePaths.begin(); iter != ogrePaths.end(); iter++ )
-		{
-			//*iter = '/usr/local/lib/OGRE';
-			std::cout << ' ' << *iter ;
+		m_noise_realizations = max( 1, _sdf->Get< int >( "noise_realizations" ) );
+	}
+	std::cout << "\tsensor noise realizations : " << m_noise_realizations << std::endl;
 
-			std::string path(*iter);
-			DIR *dir = opendir(path.c_str());
+	if( _sdf->HasElement( "noise_refresh_period" ) )
+	{
+		m_noise_refresh_period = _sdf->Get< double >( "noise_refresh_period" );
+	}
+	std::cout << "\tsensor noise refresh period : " << m_noise_refresh_period << " sec" << std::endl;
 
-			//std::cout << path.c_str() << std::endl;
+	if( _sdf->HasElement( "noise_cache_dir" ) )
+	{
+		m_noise_cache_dir = boost::algorithm::trim_copy( _sdf->Get< std::string >( "noise_cache_dir" ) );
+	}
+	std::cout << "\tsensor noise cache : " << ( m_noise_cache_dir.empty() ? "none" : m_noise_cache_dir ) << std::endl;
 
-			if( dir == NULL )
+	if( _sdf->HasElement( "calibration_file" ) )
+	{
+		m_calibration_file = boost::algorithm::trim_copy( _sdf->Get< std::string >( "calibration_file" ) );
+	}
+	std::cout << "\tcalibration file : " << m_calibration_file << std::endl;
+
+	if( _sdf->HasElement( "post_process" ) )
+	{
+		std::string post_process = boost::algorithm::trim_copy( _sdf->Get< std::string >( "post_process" ) );
+		if( post_process == "fused" )
+		{
+			m_post_process_mode = POST_PROCESS_FUSED;
+		}
+		else if( post_process == "reference" )
+		{
+			m_post_process_mode = POST_PROCESS_REFERENCE;
+		}
+		else if( post_process == "verify" )
+		{
+			m_post_process_mode = POST_PROCESS_VERIFY;
+		}
+		else
+		{
+			cerr << CERR_PREFIX << "unknown post_process : " << post_process << ", use fused" << endl;
+		}
+	}
+	std::cout << "\tpost process : " << ( m_post_process_mode == POST_PROCESS_FUSED ? "fused" :
+										 m_post_process_mode == POST_PROCESS_REFERENCE ? "reference" : "verify" ) << std::endl;
+
+	if( _sdf->HasElement( "outputs" ) )
+	{
+		std::istringstream outputs( _sdf->Get< std::string >( "outputs" ) );
+		std::string output;
+		m_outputs = 0;
+		while( outputs >> output )
+		{
+			if( output == "cloud" )
 			{
-				std::cout << "\t\tNOT FOUND" << std::endl;
-				continue;
+				m_outputs |= OUTPUT_CLOUD;
 			}
-			closedir( dir );
-			std::cout << "\t\t" << path << std::endl;
+			else if( output == "labels" )
+			{
+				m_outputs |= OUTPUT_LABELS;
+			}
+			else if( output == "rgb" )
+			{
+				m_outputs |= OUTPUT_RGB;
+			}
+			else if( output == "confidence" )
+			{
+				m_outputs |= OUTPUT_CONFIDENCE;
+			}
+			else if( output == "rgb_png" )
+			{
+				m_outputs |= OUTPUT_RGB_PNG;
+			}
+			else if( output != "none" )
+			{
+				cerr << CERR_PREFIX << "unknown output : " << output << ", ignored" << endl;
+			}
+		}
+	}
+	std::cout << "\toutputs :" << ( m_outputs & OUTPUT_CLOUD ? " cloud" : "" )
+			  << ( m_outputs & OUTPUT_LABELS ? " labels" : "" )
+			  << ( m_outputs & OUTPUT_RGB ? " rgb" : "" )
+			  << ( m_outputs & OUTPUT_CONFIDENCE ? " confidence" : "" )
+			  << ( m_outputs & OUTPUT_RGB_PNG ? " rgb_png" : "" )
+			  << ( m_outputs == 0 ? " none" : "" ) << ", topics add theirs on demand" << std::endl;
+
+	if( _sdf->HasElement( "mask_pass" ) )
+	{
+		std::string mask_pass = boost::algorithm::trim_copy( _sdf->Get< std::string >( "mask_pass" ) );
+		if( mask_pass == "gpu" )
+		{
+			m_mask_pass_mode = MASK_PASS_GPU;
+		}
+		else if( mask_pass == "cpu" )
+		{
+			m_mask_pass_mode = MASK_PASS_CPU;
+		}
+		else
+		{
+			cerr << CERR_PREFIX << "unknown mask_pass : " << mask_pass << ", use cpu" << endl;
+		}
+	}
+	// reference post process is the step by step cpu implementation
+	if( m_mask_pass_mode == MASK_PASS_GPU && m_post_process_mode == POST_PROCESS_REFERENCE )
+	{
+		cerr << CERR_PREFIX << "reference post_process needs cpu mask_pass, use it" << endl;
+		m_mask_pass_mode = MASK_PASS_CPU;
+	}
+	std::cout << "\tmask pass : " << ( m_mask_pass_mode == MASK_PASS_GPU ? "gpu" : "cpu" ) << std::endl;
 
-			std::string prefix = "";
-			std::string extension = ".so";
+	if( _sdf->HasElement( "worker_threads" ) )
+	{
+		m_worker_threads = _sdf->Get< int >( "worker_threads" );
+	}
 
-			Ogre::Root::getSingletonPtr()->loadPlugin( path + "/" + prefix + "Plugin_CgProgramManager" + extension );
-			std::cout << "\t\tFOUND: " << required_plugin << std::endl;
+	if( _sdf->HasElement( "worker_affinity" ) )
+	{
+		std::string worker_affinity = boost::algorithm::trim_copy( _sdf->Get< std::string >( "worker_affinity" ) );
+		if( worker_affinity == "isolate_physics" )
+		{
+			m_worker_affinity = AFFINITY_ISOLATE_PHYSICS;
 		}
-		*/
-		Ogre::Root::getSingletonPtr()->loadPlugin("/usr/local/ogre-1-9/lib/OGRE/Plugin_CgProgramManager.so");
+		else if( worker_affinity == "none" )
+		{
+			m_worker_affinity = AFFINITY_NONE;
+		}
+		else
+		{
+			cerr << CERR_PREFIX << "unknown worker_affinity : " << worker_affinity << ", use none" << endl;
+		}
+	}
 
+	if( _sdf->HasElement( "physics_cpu" ) )
+	{
+		m_physics_cpu = _sdf->Get< int >( "physics_cpu" );
 	}
-}
 
-void DepthSensorPlugin::_addResources()
-{
-	// std::cout << "\tIn _addResources()" << std::endl;
+	if( _sdf->HasElement( "cloud_message" ) )
+	{
+		std::string cloud_message = boost::algorithm::trim_copy( _sdf->Get< std::string >( "cloud_message" ) );
+		if( cloud_message == "packed" )
+		{
+			m_cloud_message = CLOUD_MESSAGE_PACKED;
+		}
+		else if( cloud_message == "legacy" )
+		{
+			m_cloud_message = CLOUD_MESSAGE_LEGACY;
+		}
+		else if( cloud_message == "shm" )
+		{
+			m_cloud_message = CLOUD_MESSAGE_SHM;
+		}
+		else if( cloud_message == "compressed" )
+		{
+			m_cloud_message = CLOUD_MESSAGE_COMPRESSED;
+		}
+		else
+		{
+			cerr << CERR_PREFIX << "unknown cloud_message : " << cloud_message << ", use legacy" << endl;
+		}
+	}
+	std::cout << "\tcloud message : " << ( m_cloud_message == CLOUD_MESSAGE_PACKED ? "packed" :
+										  m_cloud_message == CLOUD_MESSAGE_LEGACY ? "legacy" :
+										  m_cloud_message == CLOUD_MESSAGE_SHM ? "shm" : "compressed" ) << std::endl;
 
-	// check if the resourceGroup already exist
-	Ogre::ResourceGroupManager *resource_group_mgr = Ogre::ResourceGroupManager::getSingletonPtr();
+	if( _sdf->HasElement( "shm_name" ) )
+	{
+		m_shm_name = boost::algorithm::trim_copy( _sdf->Get< std::string >( "shm_name" ) );
+	}
+	if( _sdf->HasElement( "shm_slots" ) )
+	{
+		m_shm_slots = max( 2, _sdf->Get< int >( "shm_slots" ) );
+	}
 
-	if( resource_group_mgr->resourceGroupExists( "DEPTH_SHADOWMAP_RESOURCE_GROUP" ) )
+	if( _sdf->HasElement( "depth_step_mm" ) )
 	{
-		return;
+		m_depth_step_mm = _sdf->Get< float >( "depth_step_mm" );
 	}
-	// std::cout << "\t\tresourceGroup does not exist! Setting up..." << std::endl;
-	std::cout << "\tadding resources" << std::endl;
-	// setup resource for shadow map if it's not already exist
-	resource_group_mgr->createResourceGroup( "DEPTH_SHADOWMAP_RESOURCE_GROUP" );
-	// std::cout << "\t\tcreated: DEPTH_SHADOWMAP_RESOURCE_GROUP" << std::endl;
+	if( _sdf->HasElement( "publish_queue_depth" ) )
+	{
+		m_publish_queue_depth = max( 1, _sdf->Get< int >( "publish_queue_depth" ) );
+	}
+	if( _sdf->HasElement( "frame_slots" ) )
+	{
+		m_frame_slots = max( 1, _sdf->Get< int >( "frame_slots" ) );
+	}
+	std::cout << "\tframe slots : " << m_frame_slots << ( m_frame_slots > 1 ? ", pipelined" : ", post process on sensor thread" ) << std::endl;
 
-	resource_group_mgr->addResourceLocation( "/home/kevin/research/gazebo/resource/depth_shadowmap_resource",
-											 "FileSystem",
-											 "DEPTH_SHADOWMAP_RESOURCE_GROUP",
-											 false );
-	// std::cout << "\t\tlocation added" << std::endl;
+	if( _sdf->HasElement( "capture_trigger" ) )
+	{
+		std::string capture_trigger = boost::algorithm::trim_copy( _sdf->Get< std::string >( "capture_trigger" ) );
+		if( capture_trigger == "stream" )
+		{
+			m_capture_trigger = CAPTURE_TRIGGER_STREAM;
+		}
+		else if( capture_trigger != "request" )
+		{
+			cerr << CERR_PREFIX << "unknown capture_trigger : " << capture_trigger << ", use request" << endl;
+		}
+	}
+	if( _sdf->HasElement( "stream_backpressure" ) )
+	{
+		std::string backpressure = boost::algorithm::trim_copy( _sdf->Get< std::string >( "stream_backpressure" ) );
+		if( backpressure == "block" )
+		{
+			m_stream_backpressure = BACKPRESSURE_BLOCK;
+		}
+		else if( backpressure == "degrade" )
+		{
+			m_stream_backpressure = BACKPRESSURE_DEGRADE;
+		}
+		else if( backpressure != "drop" )
+		{
+			cerr << CERR_PREFIX << "unknown stream_backpressure : " << backpressure << ", use drop" << endl;
+		}
+	}
+	std::cout << "\tcapture trigger : " << ( m_capture_trigger == CAPTURE_TRIGGER_STREAM ? "stream" : "request" );
+	if( m_capture_trigger == CAPTURE_TRIGGER_STREAM )
+	{
+		std::cout << " at " << m_camera_sensor->GetUpdateRate() << " Hz, backpressure "
+				  << ( m_stream_backpressure == BACKPRESSURE_BLOCK ? "block" :
+					   m_stream_backpressure == BACKPRESSURE_DEGRADE ? "degrade" : "drop" );
+	}
+	std::cout << std::endl;
+
+	if( _sdf->HasElement( "snapshot_cloud" ) )
+	{
+		std::string snapshot_cloud = boost::algorithm::trim_copy( _sdf->Get< std::string >( "snapshot_cloud" ) );
+		if( snapshot_cloud == "compressed" )
+		{
+			m_snapshot_cloud = SNAPSHOT_CLOUD_COMPRESSED;
+		}
+		else if( snapshot_cloud == "pcd" )
+		{
+			m_snapshot_cloud = SNAPSHOT_CLOUD_PCD;
+		}
+		else if( snapshot_cloud != "none" )
+		{
+			cerr << CERR_PREFIX << "unknown snapshot_cloud : " << snapshot_cloud << ", use none" << endl;
+		}
+	}
+
+	if( _sdf->HasElement( "snapshot_writer_threads" ) )
+	{
+		m_snapshot_writer_threads = max( 0, _sdf->Get< int >( "snapshot_writer_threads" ) );
+	}
+	if( _sdf->HasElement( "snapshot_queue_size" ) )
+	{
+		m_snapshot_queue_size = max( 1, _sdf->Get< int >( "snapshot_queue_size" ) );
+	}
+	if( _sdf->HasElement( "snapshot_queue_policy" ) )
+	{
+		std::string policy = boost::algorithm::trim_copy( _sdf->Get< std::string >( "snapshot_queue_policy" ) );
+		if( policy == "drop" )
+		{
+			m_snapshot_queue_policy = AsyncSnapshotWriter::POLICY_DROP;
+		}
+		else if( policy == "block" )
+		{
+			m_snapshot_queue_policy = AsyncSnapshotWriter::POLICY_BLOCK;
+		}
+		else
+		{
+			cerr << CERR_PREFIX << "unknown snapshot_queue_policy : " << policy << ", use block" << endl;
+		}
+	}
+	if( _sdf->HasElement( "snapshot_format" ) )
+	{
+		std::string snapshot_format = boost::algorithm::trim_copy( _sdf->Get< std::string >( "snapshot_format" ) );
+		if( snapshot_format == "dataset" )
+		{
+			m_snapshot_format = SNAPSHOT_FORMAT_DATASET;
+		}
+		else if( snapshot_format != "files" )
+		{
+			cerr << CERR_PREFIX << "unknown snapshot_format : " << snapshot_format << ", use files" << endl;
+		}
+	}
+	if( _sdf->HasElement( "snapshot_dataset" ) )
+	{
+		m_snapshot_dataset_path = boost::algorithm::trim_copy( _sdf->Get< std::string >( "snapshot_dataset" ) );
+	}
+	if( m_snapshot_format == SNAPSHOT_FORMAT_DATASET )
+	{
+		std::cout << "\tsnapshot format : dataset " << m_snapshot_dataset_path << std::endl;
+	}
+	std::cout << "\tsnapshot writer : " << m_snapshot_writer_threads << " threads, queue " << m_snapshot_queue_size
+			  << ( m_snapshot_queue_policy == AsyncSnapshotWriter::POLICY_DROP ? " ( drop )" : " ( block )" ) << std::endl;
+}
+
+void DepthSensorPlugin::_setupWorkerPool()
+{
+	if( m_worker_affinity == AFFINITY_ISOLATE_PHYSICS )
+	{
+		m_worker_cpus = WorkerPool::cpusExcept( m_physics_cpu );
+		if( m_worker_cpus.empty() )
+		{
+			cerr << CERR_PREFIX << "no cpu left besides physics_cpu " << m_physics_cpu << ", use none" << endl;
+			m_worker_affinity = AFFINITY_NONE;
+		}
+	}
+
+	// auto : one thread per cpu, the sensor thread works on tiles too
+	int num_workers = m_worker_threads;
+	if( num_workers <= 0 )
+	{
+		int num_cpus = m_worker_affinity == AFFINITY_ISOLATE_PHYSICS ? m_worker_cpus.size() : std::thread::hardware_concurrency();
+		num_workers = max( 0, num_cpus - 1 );
+	}
+
+	m_worker_pool = new WorkerPool( num_workers, m_worker_cpus );
+
+	if( m_worker_affinity == AFFINITY_ISOLATE_PHYSICS )
+	{
+		// physics runs in its own thread, pin it from inside the first world update
+		m_world_update_connection = event::Events::ConnectWorldUpdateBegin( std::bind( &DepthSensorPlugin::_onWorldUpdateBegin, this ) );
+	}
+
+	std::cout << "\tworker threads : " << m_worker_pool->getNumThreads()
+			  << ( m_worker_affinity == AFFINITY_ISOLATE_PHYSICS ? ", physics on cpu " + std::to_string( m_physics_cpu ) : "" ) << std::endl;
+}
+
+void DepthSensorPlugin::_onWorldUpdateBegin()
+{
+	if( m_physics_thread_pinned )
+	{
+		return;
+	}
+	m_physics_thread_pinned = true;
+
+	if( !WorkerPool::pinCurrentThread( vector< int >( 1, m_physics_cpu ) ) )
+	{
+		cerr << CERR_PREFIX << "failed to pin physics thread to cpu " << m_physics_cpu << endl;
+	}
+}
+
+void DepthSensorPlugin::_loadPlugins()
+{
+	std::string required_plugin = "Cg Program Manager";
+
+	// Check if the required plugins are installed and ready for use
+	// If not: load the plugin
+	std::cout << "\tloading : " << required_plugin << std::endl;
+	//Ogre::Root::PluginInstanceList ip = Ogre::Root::getSingletonPtr()->getInstalledPlugins();
+
+	// try to find the required plugin in the current installed plugins
+	bool found = false;
+
+	//for( Ogre::Root::PluginInstanceList::iterator k = ip.begin(); k != ip.end(); k++ )
+	//{
+	//	std::cout << ' ' << (*k) ;
+	//	std::cout << "\n" << std::endl;
+	//	if( (*k)->getName() == required_plugin )
+	//	{
+	//		found = true;
+	//		std::cout << "\t\tFOUND" << std::endl;
+			//std::cout << required_plugin << std::endl;
+
+	//		break;
+	//	}
+	//}
+	// load the required_plugin
+
+	if( !found )
+	{
+		// load Plugin_CgProgramManager ( this loading plugin method is from gazebo/RenderEngine.cc )
+		std::list<std::string> ogrePaths = common::SystemPaths::Instance()->GetOgrePaths();
+		/*
+		//std::list<std::string> ogrePaths = "/usr/local/lib/OGRE";
+		for( std::list<std::string>::iterator iter = ogrePaths.begin(); iter != ogrePaths.end(); iter++ )
+		{
+			//*iter = '/usr/local/lib/OGRE';
+			std::cout << ' ' << *iter ;
+
+			std::string path(*iter);
+			DIR *dir = opendir(path.c_str());
+
+			//std::cout << path.c_str() << std::endl;
+
+			if( dir == NULL )
+			{
+				std::cout << "\t\tNOT FOUND" << std::endl;
+				continue;
+			}
+			closedir( dir );
+			std::cout << "\t\t" << path << std::endl;
+
+			std::string prefix = "";
+			std::string extension = ".so";
+
+			Ogre::Root::getSingletonPtr()->loadPlugin( path + "/" + prefix + "Plugin_CgProgramManager" + extension );
+			std::cout << "\t\tFOUND: " << required_plugin << std::endl;
+		}
+		*/
+		Ogre::Root::getSingletonPtr()->loadPlugin("/usr/local/ogre-1-9/lib/OGRE/Plugin_CgProgramManager.so");
+
+	}
+}
+
+void DepthSensorPlugin::_addResources()
+{
+	// std::cout << "\tIn _addResources()" << std::endl;
+
+	// check if the resourceGroup already exist
+	Ogre::ResourceGroupManager *resource_group_mgr = Ogre::ResourceGroupManager::getSingletonPtr();
+
+	if( resource_group_mgr->resourceGroupExists( "DEPTH_SHADOWMAP_RESOURCE_GROUP" ) )
+	{
+		return;
+	}
+	// std::cout << "\t\tresourceGroup does not exist! Setting up..." << std::endl;
+	std::cout << "\tadding resources" << std::endl;
+	// setup resource for shadow map if it's not already exist
+	resource_group_mgr->createResourceGroup( "DEPTH_SHADOWMAP_RESOURCE_GROUP" );
+	// std::cout << "\t\tcreated: DEPTH_SHADOWMAP_RESOURCE_GROUP" << std::endl;
+
+	resource_group_mgr->addResourceLocation( "/home/kevin/research/gazebo/resource/depth_shadowmap_resource",
+											 "FileSystem",
+											 "DEPTH_SHADOWMAP_RESOURCE_GROUP",
+											 false );
+	// std::cout << "\t\tlocation added" << std::endl;
 
 	resource_group_mgr->initialiseResourceGroup( "DEPTH_SHADOWMAP_RESOURCE_GROUP" );
 	// std::cout << "\t\tinitialized" << std::endl;
@@ -398,6 +1079,27 @@ void DepthSensorPlugin::_setupDepthSensor()
 	// A light attached to a SceneNode is assumed to have a base position of (0,0,0) and a direction of (0,0,1)
 	sensor_cam_projector_node->yaw( Ogre::Degree( 90.0f ) );
 
+	// shadow & light settings of every pass, gazebo's settings are restored once per capture
+	m_capture_state = new CaptureStateGuard( m_scene, m_camera_sensor->GetCamera(), m_scene_mgr, spotlight, &m_base_dist );
+
+
+	// proxies shared by depth, rayconf and segment render texture listener
+	m_entity_cache = new EntityProxyCache( m_scene, m_scene_mgr );
+	if( m_capture_mode == CAPTURE_MRT )
+	{
+		m_entity_cache->enablePass( EntityProxyCache::PASS_MRT, true );
+	}
+	else
+	{
+		m_entity_cache->enablePass( EntityProxyCache::PASS_DEPTH, true );
+		m_entity_cache->enablePass( EntityProxyCache::PASS_RAYCONF, true );
+		m_entity_cache->enablePass( EntityProxyCache::PASS_SEGMENT, m_use_ideal_segmentation );
+	}
+	// single channel rayconf render target only keeps confidence
+	if( m_rt_layout.reconstructsXYZ() )
+	{
+		m_entity_cache->setPassMaterial( EntityProxyCache::PASS_RAYCONF, "Ogre/DepthShadowmap_Conf/BasicTemplateMaterial" );
+	}
 
 	// ****** render to texture START (Depth) *** //
 	Ogre::TexturePtr rtt_texture;
@@ -407,30 +1109,24 @@ void DepthSensorPlugin::_setupDepthSensor()
 																		cam_w,
 																		cam_h,
 																		0,
-																		Ogre::PF_FLOAT32_RGBA,
+																		m_rt_layout.getDepthFormat() == DEPTH_FORMAT_R32F ? Ogre::PF_FLOAT32_R : Ogre::PF_FLOAT32_RGBA,
 																		Ogre::TU_RENDERTARGET);
 
+	m_depth_texture = rtt_texture;
 	m_depth_rt = rtt_texture->getBuffer()->getRenderTarget();
 	m_depth_rt -> addViewport( m_ogre_camera );
 	m_depth_rt -> getViewport(0)->setClearEveryFrame( true );
 	m_depth_rt -> getViewport(0)->setBackgroundColour( Ogre::ColourValue::White );
 	m_depth_rt -> getViewport(0)->setOverlaysEnabled( false );
 
-	// allocate memory for rgb frame buffer
-	m_depth_buffer = new float[ cam_w * cam_h * 4 ];
-
-	// create rgb render target listener
+	// create rgb render target listener, it writes into the slot of every capture
 	m_depth_rt_listener = new DepthRTListener( 	m_scene,
 												m_camera_sensor->GetCamera(),
 												m_scene_mgr,
 												m_depth_rt,
-												m_depth_buffer,
-												&m_shadow_settings,
-												&m_turned_off_lights,
-												&m_turned_off_mobj,
-												&m_cloned_entity,
-												&m_base_dist,
-												SENSOR_IR_PROJECTOR_NAME_PREFIX );
+												m_frame_ring->getSlot( 0 )->depth,
+												m_capture_state,
+												m_entity_cache );
 
 	m_depth_rt -> addListener( m_depth_rt_listener );
 
@@ -443,29 +1139,24 @@ void DepthSensorPlugin::_setupDepthSensor()
 																		cam_w,
 																		cam_h,
 																		0,
-																		Ogre::PF_FLOAT32_RGBA,
+																		m_rt_layout.getRayConfFormat() == RAYCONF_FORMAT_C32F ? Ogre::PF_FLOAT32_R :
+																		m_rt_layout.getRayConfFormat() == RAYCONF_FORMAT_C16F ? Ogre::PF_FLOAT16_R : Ogre::PF_FLOAT32_RGBA,
 																		Ogre::TU_RENDERTARGET);
+	m_rayconf_texture = rtt_texture;
 	m_rayconf_rt = rtt_texture->getBuffer()->getRenderTarget();
 	m_rayconf_rt -> addViewport( m_ogre_camera );
 	m_rayconf_rt -> getViewport(0)->setClearEveryFrame( true );
 	m_rayconf_rt -> getViewport(0)->setBackgroundColour( Ogre::ColourValue::White );
 	m_rayconf_rt -> getViewport(0)->setOverlaysEnabled( false );
 
-	// allocate memory for rgb frame buffer
-	m_rayconf_buffer = new float[ cam_w * cam_h * 4 ];
-
-	// create rgb render target listener
+	// create rgb render target listener, it writes into the slot of every capture
 	m_rayconf_rt_listener = new RayConfRTListener( 	m_scene,
 													m_camera_sensor->GetCamera(),
 													m_scene_mgr,
 													m_rayconf_rt,
-													m_rayconf_buffer,
-													&m_shadow_settings,
-													&m_turned_off_lights,
-													&m_turned_off_mobj,
-													&m_cloned_entity,
-													&m_base_dist,
-													SENSOR_IR_PROJECTOR_NAME_PREFIX );
+													m_frame_ring->getSlot( 0 )->rayconf,
+													m_capture_state,
+													m_entity_cache );
 
 	m_rayconf_rt -> addListener( m_rayconf_rt_listener );
 
@@ -482,6 +1173,7 @@ void DepthSensorPlugin::_setupDepthSensor()
 																		0,
 																		Ogre::PF_BYTE_RGB,
 																		Ogre::TU_RENDERTARGET );
+	m_rgb_texture = rtt_texture;
 	m_rgb_rt = rtt_texture->getBuffer()->getRenderTarget();
 
 	// setup render texture
@@ -491,20 +1183,54 @@ void DepthSensorPlugin::_setupDepthSensor()
 	m_rgb_rt -> getViewport(0)->setBackgroundColour( Ogre::ColourValue( 0, 0, 0, 1 ) );
 	m_rgb_rt -> getViewport(0)->setOverlaysEnabled( false );
 
-	// allocate memory for rgb frame buffer
-	m_rgb_buffer = new unsigned char[ cam_w * cam_h * 3 ];
-
-	// create rgb render target listener
+	// create rgb render target listener, it writes into the slot of every capture
 	m_rgb_rt_listener = new RGBRTListener(	m_scene,
 											m_camera_sensor->GetCamera(),
 											m_scene_mgr,
 											m_rgb_rt,
-											m_rgb_buffer,
-											&m_base_dist,
-											spotlight );
+											m_frame_ring->getSlot( 0 )->rgb,
+											m_capture_state );
 
 	m_rgb_rt -> addListener( m_rgb_rt_listener );
 
+	// occlusion edge erosion of sensor resolution
+	m_edge_eroder = new OcclusionEdgeEroder( cam_w, cam_h, m_worker_pool );
+	// fused post process of sensor resolution
+	m_post_process_kernel = new DepthPostProcessKernel( cam_w, cam_h, m_worker_pool, &m_rt_layout );
+	// smoothing of the point cloud, sigma_s 2.5 pixels & sigma_r 5 mm
+	m_bilateral_filter = new DepthBilateralFilter( cam_w, cam_h, 2.5f, 5.f, m_worker_pool );
+
+	// intrinsics of pixel centers from the projection matrix, rayconf positions lie exactly on these rays
+	Ogre::Matrix4 proj = m_ogre_camera->getProjectionMatrix();
+	DepthStreamCodec::Intrinsics intrinsics;
+	intrinsics.fx = proj[0][0] * cam_w / 2;
+	intrinsics.fy = proj[1][1] * cam_h / 2;
+	intrinsics.cx = ( 1 + proj[0][2] ) * cam_w / 2 - 0.5f;
+	intrinsics.cy = ( 1 - proj[1][2] ) * cam_h / 2 - 0.5f;
+	m_depth_codec = new DepthStreamCodec( cam_w, cam_h, intrinsics, m_depth_step_mm );
+
+	// same rays for points reconstructed from depth, depth is normalized by the clip distances in the depth shader
+	m_rt_layout.setCamera(	cam_w,
+							cam_h,
+							intrinsics.fx,
+							intrinsics.fy,
+							intrinsics.cx,
+							intrinsics.cy,
+							m_ogre_camera->getNearClipDistance(),
+							m_ogre_camera->getFarClipDistance() );
+
+	// ********************************************* //
+	// masks of depth, rayconf & rgb on the gpu side //
+	// ********************************************* //
+	if( m_mask_pass_mode == MASK_PASS_GPU )
+	{
+		m_mask_pass = new DepthMaskPass(	camera_name,
+											m_depth_texture,
+											m_rayconf_texture,
+											m_rgb_texture,
+											m_rt_layout,
+											m_frame_ring->getSlot( 0 )->mask );
+	}
 }
 
 void DepthSensorPlugin::_prepareSensorNoise()
@@ -515,59 +1241,132 @@ void DepthSensorPlugin::_prepareSensorNoise()
 	// prepare noise //
 	// ************* //
 
-	// read noise magnitude from file
-	cv::Mat noise_mag;
-
-	std::cout << "\treading mag.bin to set up noise" << std::endl;
-	std::ifstream ifs( "mag.bin", std::ios::in | std::ios::binary );
+	// noise magnitude from the calibration file, mapped in place if it has a variant of sensor resolution
+	int width = m_camera->GetImageWidth();
+	int height = m_camera->GetImageHeight();
+	std::string calibration_path = common::find_file( m_calibration_file );
+	std::cout << "\treading " << ( calibration_path.empty() ? m_calibration_file : calibration_path ) << " to set up noise" << std::endl;
 
+	const SensorCalibrationTable *table = NULL;
+	cv::Mat noise_mag;
+	m_calibration = new SensorCalibrationReader();
+	if( !calibration_path.empty() && m_calibration->open( calibration_path ) )
 	{
-		boost::archive::binary_iarchive ia( ifs );
-
-		ia >> noise_mag;
-	}
-
-	ifs.close();
-
-	// resize noise to current sensor resolution
-	float scale = (float)noise_mag.cols * noise_mag.rows / ( m_camera->GetImageWidth() * m_camera->GetImageHeight() );
-	cout << "\t\tscale: " << scale << endl;
-	cout << "\t\tsqrt scale: " << sqrt( scale ) << endl;
-	cv::resize( noise_mag, noise_mag, cv::Size( m_camera->GetImageWidth(), m_camera->GetImageHeight() ) );
-
-	// generate random phase
-	cv::Mat noise_phase( noise_mag.rows, noise_mag.cols, noise_mag.type() );
+		// variant of sensor resolution, or the one to resize from
+		table = m_calibration->find( "noise_magnitude", width, height );
+		if( !table )
+		{
+			table = m_calibration->findSource( "noise_magnitude" );
+		}
+		if( table && ( table->type != SENSOR_CALIBRATION_FLOAT32 || table->channels != 1 ) )
+		{
+			cerr << CERR_PREFIX << "noise magnitude in " << calibration_path << " is not single channel float" << endl;
+			table = NULL;
+		}
 
-	for( int j = 0; j < noise_phase.rows; j++ )
-	{
-		for( int i = 0; i< noise_phase.cols; i++ )
+		if( table )
 		{
-			if( noise_mag.at<float>( j, i ) != 0 )
+			cv::Mat magnitude( table->height, table->width, CV_32F, (void*)m_calibration->getData( *table ) );
+			if( magnitude.cols == width && magnitude.rows == height )
 			{
-				int rand_num = rand() % 36000;
-				float degree = rand_num / 100.0 - 180.0;
-
-				noise_phase.at<float>( j, i ) = degree * M_PI / 180;
+				noise_mag = magnitude;
 			}
 			else
 			{
-				noise_phase.at<float>( j, i ) = 0;
+				// add this resolution with sensor_calibration_tool to skip resizing
+				cerr << CERR_PREFIX << "no noise magnitude of " << width << " x " << height << ", resized from "
+					 << magnitude.cols << " x " << magnitude.rows << endl;
+				cv::resize( magnitude, noise_mag, cv::Size( width, height ) );
 			}
 		}
 	}
+	if( !table )
+	{
+		cerr << CERR_PREFIX << "no noise magnitude in " << m_calibration_file << ", sensor noise is disabled" << endl;
+		m_noise = cv::Mat::zeros( height, width, CV_32F );
+	}
+	else
+	{
+		// realizations of random phase, inverse DFT scaled by the resizing of the measured magnitude,
+		// read back from the cache if this magnitude was used at this resolution before
+		double noise_time = common::Time::GetWallTime().Double();
+		float scale = (float)table->source_width * table->source_height / ( width * height );
+		m_sensor_noise = new SensorNoiseBank(	noise_mag,
+												1 / sqrt( scale ),
+												table->checksum,
+												m_noise_realizations,
+												m_noise_seed,
+												m_noise_cache_dir,
+												m_worker_pool );
+		cout << "\tsensor noise : " << m_sensor_noise->getNumRealizations() << " realizations, "
+			 << m_sensor_noise->getCached() << " from cache, " << common::Time::GetWallTime().Double() - noise_time << " sec" << endl;
+
+		// with a fixed seed every run must see the same realizations
+		if( m_noise_seed < 0 )
+		{
+			m_sensor_noise->startRefresh( m_noise_refresh_period );
+		}
+	}
+
+	// perlin noise of sensor resolution, lookup tables are built on first use
+	if( m_noise_seed >= 0 )
+	{
+		m_perlin_engine = new PerlinNoiseEngine( m_camera->GetImageWidth(), m_camera->GetImageHeight(), m_noise_seed, m_worker_pool );
+	}
+	else
+	{
+		m_perlin_engine = new PerlinNoiseEngine( m_camera->GetImageWidth(), m_camera->GetImageHeight(), random_device()(), m_worker_pool );
+	}
+
+	// tileable perlin noise sampled every frame, instead of generating new noise
+	if( m_noise_bank_mb > 0 )
+	{
+		double time = common::Time::GetWallTime().Double();
+
+		vector< int > grid_sizes = { 5, 10, 20, 40 };
+		size_t budget = (size_t)m_noise_bank_mb * 1024 * 1024;
+		if( m_noise_seed >= 0 )
+		{
+			m_noise_bank = new NoiseFieldBank( grid_sizes, m_camera->GetImageWidth(), m_camera->GetImageHeight(), budget, m_noise_seed, m_worker_pool );
+		}
+		else
+		{
+			m_noise_bank = new NoiseFieldBank( grid_sizes, m_camera->GetImageWidth(), m_camera->GetImageHeight(), budget, random_device()(), m_worker_pool );
+		}
+
+		if( m_noise_bank->isValid() )
+		{
+			cout << "\tnoise bank : " << m_noise_bank->getFieldWidth() << " x " << m_noise_bank->getFieldHeight()
+				 << ", " << m_noise_bank->getBytes() / 1024 / 1024 << " MB, " << common::Time::GetWallTime().Double() - time << " sec" << endl;
+		}
+		else
+		{
+			// fall back to generating perlin noise every frame
+			delete m_noise_bank;
+			m_noise_bank = NULL;
+		}
+	}
+}
 
-	Mat complex;
-	// change magnitude ^ phase => Real part & Imaginary part
-	Mat real_part, img_part;
-	polarToCart( noise_mag, noise_phase, real_part, img_part );
-	Mat complex_temp_r[]={ real_part, img_part };
-	merge( complex_temp_r, 2, complex );
+void DepthSensorPlugin::_generatePerlinNoise( const int *_grid_sizes, int _num_octaves, float *_noise )
+{
+	// random offsets of the bank & the engine aren't thread safe
+	std::lock_guard< std::mutex > lock( m_noise_mutex );
 
-	// generate sensor noise from frequency domain
-	dft( complex, m_noise, DFT_INVERSE | DFT_REAL_OUTPUT | DFT_SCALE  );
+	bool in_bank = m_noise_bank != NULL;
+	for( int i = 0; i < _num_octaves && in_bank; i++ )
+	{
+		in_bank = m_noise_bank->hasGridSize( _grid_sizes[i] );
+	}
 
-	// scale the noise dude to resizing noise_mag
-	m_noise.convertTo( m_noise, m_noise.type(), 1 / sqrt(scale) );
+	if( in_bank )
+	{
+		m_noise_bank->sample( _grid_sizes, _num_octaves, _noise );
+	}
+	else
+	{
+		m_perlin_engine->generate( _grid_sizes, _num_octaves, _noise );
+	}
 }
 
 void DepthSensorPlugin::_check_file_number()
@@ -592,52 +1391,614 @@ void DepthSensorPlugin::_check_file_number()
 	}
 }
 
-void DepthSensorPlugin::_saveSensorData()
+unsigned int DepthSensorPlugin::_outputDemand( bool _stream, int _degrade )
 {
-	if((m_snapshot)&&(m_save_count>m_total_snapshot))
+	// outputs of every frame
+	unsigned int outputs = m_outputs;
+
+	// topics somebody subscribes to
+	if( m_publisher_ptr->HasConnections() )
 	{
-		return;
+		outputs |= OUTPUT_CLOUD;
+	}
+	if( m_labels_publisher_ptr->HasConnections() )
+	{
+		outputs |= OUTPUT_LABELS;
+	}
+	if( m_rgb_publisher_ptr->HasConnections() )
+	{
+		outputs |= OUTPUT_RGB;
+	}
+	if( m_confidence_publisher_ptr->HasConnections() )
+	{
+		outputs |= OUTPUT_CONFIDENCE;
 	}
-	// **************** //
-	// save sensor data //
-	// **************** //
 
- 	// get sensor info
-	int width = m_rgb_rt->getWidth();
-	int height = m_rgb_rt->getHeight();
+	// a png encode & write per frame on the sensor thread can't keep up with <update_rate>, the rgb topic can
+	if( _stream )
+	{
+		outputs &= ~OUTPUT_RGB_PNG;
+	}
 
-	// ******** //
-	// save RGB //
-	// ******** //
+	// a stream behind its rate keeps only the cloud, unless the cloud message needs more
+	if( _degrade > 0 && ( outputs & OUTPUT_CLOUD ) )
+	{
+		outputs = OUTPUT_CLOUD;
+	}
 
-	// save rgb picture from gazebo's sensor
-	if(m_snapshot)
+	if( m_snapshot )
 	{
-		// check the total files in the directory (ONLY ONCE!!!)
-		if(m_current_file_number == 0) { _check_file_number(); }
-		boost::filesystem::create_directory( "only_snapshot/rgb" );
-		std::cout << COUT_PREFIX << "Snapshot progress = " << m_save_count << " / " << m_total_snapshot << std::endl;
-		ss.clear();
-		ss.str( "" );
-		// get the path for saving
+		// the point cloud isn't published in only_snapshot mode, the snapshot writer needs it ( & labels ) or not
+		outputs &= ~( OUTPUT_CLOUD | OUTPUT_RGB_PNG );
+		if( m_snapshot_format == SNAPSHOT_FORMAT_DATASET || m_snapshot_cloud != SNAPSHOT_CLOUD_NONE )
+		{
+			outputs |= OUTPUT_CLOUD | OUTPUT_LABELS;
+		}
+	}
+	else if( ( outputs & OUTPUT_CLOUD ) && m_cloud_message == CLOUD_MESSAGE_LEGACY )
+	{
+		// pcl::msgs::PointCloudXYZL always carries labels
+		outputs |= OUTPUT_LABELS;
+	}
+
+	// no segment pass without ideal segmentation
+	if( !m_use_ideal_segmentation )
+	{
+		outputs &= ~OUTPUT_LABELS;
+	}
+	return outputs;
+}
+
+FrameSlot *DepthSensorPlugin::_acquireStreamSlot()
+{
+	if( m_stream_backpressure == BACKPRESSURE_BLOCK )
+	{
+		return m_frame_ring->acquire();
+	}
+
+	// post processing is behind while every slot is still post processed or published
+	FrameSlot *slot = m_frame_ring->tryAcquire();
+	if( !slot )
+	{
+		if( m_stream_backpressure == BACKPRESSURE_DEGRADE )
+		{
+			m_stream_degrade = min( m_stream_degrade + 1, 2 );
+			m_stream_on_time = 0;
+		}
+		return NULL;
+	}
+
+	// one level back after a second of frames without drop
+	if( m_stream_degrade > 0 && ++m_stream_on_time >= max( 1.0, m_camera_sensor->GetUpdateRate() ) )
+	{
+		m_stream_degrade--;
+		m_stream_on_time = 0;
+	}
+	return slot;
+}
+
+void DepthSensorPlugin::_bindFrameSlot( FrameSlot &_slot )
+{
+	// the mask pass samples depth, rayconf & rgb on the gpu, they are only read back to verify it ( & rgb for shm frames )
+	bool readback = !m_mask_pass || m_post_process_mode == POST_PROCESS_VERIFY;
+
+	m_rgb_rt_listener->setBuffer( readback || m_cloud_message == CLOUD_MESSAGE_SHM ? _slot.rgb : NULL );
+	m_depth_rt_listener->setBuffer( readback ? _slot.depth : NULL );
+	m_rayconf_rt_listener->setBuffer( readback || ( _slot.outputs & OUTPUT_CONFIDENCE ) ? _slot.rayconf : NULL );
+	m_segment_rt_listener->setBuffer( _slot.segment );
+	if( m_mrt_listener )
+	{
+		m_mrt_listener->setBuffers( _slot.depth, _slot.rayconf, _slot.segment );
+	}
+	if( m_mask_pass )
+	{
+		m_mask_pass->setBuffer( _slot.mask );
+	}
+}
+
+void DepthSensorPlugin::_captureSceneState( FrameSlot &_slot )
+{
+	_slot.sim_time = m_scene->GetSimTime().Double();
+	_slot.snapshot = m_snapshot;
+
+	// camera image of the rgb topic, snapshots copy it below
+	if( !m_snapshot && ( _slot.outputs & OUTPUT_RGB ) )
+	{
+		memcpy( _slot.camera_rgb, m_camera->GetImageData(), m_camera->GetImageWidth() * m_camera->GetImageHeight() * 3 );
+	}
+
+	// save rgb picture from gazebo's sensor
+	if( !m_snapshot )
+	{
+		if( _slot.outputs & OUTPUT_RGB_PNG )
+		{
+			this->m_camera_sensor->SaveFrame( "rgb_sensor.png" );
+		}
+		return;
+	}
+
+	// check the total files in the directory (ONLY ONCE!!!)
+	if( !m_file_number_checked )
+	{
+		if( m_snapshot_format == SNAPSHOT_FORMAT_DATASET )
+		{
+			_openSnapshotDataset();
+		}
+		else
+		{
+			_check_file_number();
+		}
+		m_file_number_checked = true;
+	}
+	std::cout << COUT_PREFIX << "Snapshot progress = " << m_save_count << " / " << m_total_snapshot << std::endl;
+	_slot.save_count = m_save_count;
+	_slot.save_file_number = m_save_count + m_current_file_number;
+
+	// same image as CameraSensor::SaveFrame()
+	memcpy( _slot.camera_rgb, m_camera->GetImageData(), m_camera->GetImageWidth() * m_camera->GetImageHeight() * 3 );
+
+	// ground truth of every model, labels follow the order of SegmentRTListener
+	_slot.poses.clear();
+	if( m_snapshot_format == SNAPSHOT_FORMAT_DATASET )
+	{
+		vector< uint32_t > model_ids;
+		vector< string > model_names = m_entity_cache->countSceneModels( &model_ids );
+		for( unsigned int i = 0; i < model_names.size(); i++ )
+		{
+			rendering::VisualPtr visual = m_scene->GetVisual( model_names[i] );
+			if( !visual )
+			{
+				continue;
+			}
+			math::Pose world_pose = visual->GetWorldPose();
+
+			SnapshotPose pose;
+			memset( &pose, 0, sizeof( pose ) );
+			strncpy( pose.model_name, model_names[i].c_str(), sizeof( pose.model_name ) - 1 );
+			if( m_segment_encoding == SEGMENT_ENCODING_ID )
+			{
+				pose.label = model_ids[i];
+			}
+			else
+			{
+				pose.label = (uint32_t)( ( i + 1.0f ) / model_names.size() * 255 + 0.5f );
+			}
+			pose.position[0] = world_pose.pos.x;
+			pose.position[1] = world_pose.pos.y;
+			pose.position[2] = world_pose.pos.z;
+			pose.orientation[0] = world_pose.rot.w;
+			pose.orientation[1] = world_pose.rot.x;
+			pose.orientation[2] = world_pose.rot.y;
+			pose.orientation[3] = world_pose.rot.z;
+			_slot.poses.push_back( pose );
+		}
+	}
+
+	// everything of the scene is in the slot, objects are rethrown while it is post processed
+	msgs::Request rethrow_event;
+	rethrow_event.set_id( 2 );
+	rethrow_event.set_request( "rethrow_in_evaluation_platform" );
+	rethrow_event.set_data(std::to_string(m_save_count));
+	m_rethrow_publisher_ptr->Publish(rethrow_event);
+	m_save_count++;
+}
+
+void DepthSensorPlugin::_processFrame( FrameSlot &_slot )
+{
+	this->_saveSensorData( _slot );
+
+	// a stream reports once per second instead of every frame
+	if( _slot.stream )
+	{
+		std::string summary;
+		if( m_stream_monitor->processed( _slot, summary ) )
+		{
+			cout << COUT_PREFIX << "stream : " << summary << endl;
+		}
+		return;
+	}
+
+	// every stage of this frame, passes & steps its outputs didn't need are skipped
+	std::ostringstream stages;
+	for( int i = 0; i < FrameStages::NUM_STAGES; i++ )
+	{
+		stages << ( i > 0 ? ", " : "" ) << FrameStages::getName( i ) << " ";
+		if( _slot.stages.isSkipped( i ) )
+		{
+			stages << "skipped";
+		}
+		else
+		{
+			stages << _slot.stages.seconds[i] * 1000 << " ms";
+		}
+	}
+	// capture start until published, what the stream summary reports as latency
+	stages << ", total " << ( common::Time::GetWallTime().Double() - _slot.start_time ) * 1000 << " ms";
+	cout << "Sensor stages : " << stages.str() << endl;
+
+	cout << "Sensor finish time : " << common::Time::GetWallTimeAsISOString() << endl;
+}
+
+void DepthSensorPlugin::_saveSensorData( FrameSlot &_slot )
+{
+	// **************** //
+	// save sensor data //
+	// **************** //
+
+ 	// get sensor info
+	int width = m_rgb_rt->getWidth();
+	int height = m_rgb_rt->getHeight();
+
+	// ******** //
+	// save RGB //
+	// ******** //
+
+	// the dataset record is written with the point cloud
+	if( _slot.snapshot && m_snapshot_format == SNAPSHOT_FORMAT_FILES )
+	{
+		boost::filesystem::create_directory( "only_snapshot/rgb" );
+		ss.clear();
+		ss.str( "" );
+		// get the path for saving
 		save_string.clear();
-		m_save_file_number = m_save_count + m_current_file_number;
-		ss << "only_snapshot/rgb/rgb_" << m_save_file_number << ".png";
+		ss << "only_snapshot/rgb/rgb_" << _slot.save_file_number << ".png";
 		save_string = ss.str();
-		this->m_camera_sensor->SaveFrame( save_string );
+		_saveSnapshotRGB( _slot, save_string );
 		std::cout << "save rgb = " << save_string << endl;
 	}
+
+	// TODO: TEMP START test rgb render texture
+	// QImage rgb_image( _slot.rgb, width, height, QImage::Format_RGB888 );
+	// rgb_image.save( "saturate_map.png" );
+	// TEMP END
+
+
+
+	// ******************************************************************** //
+	// labels, camera image & confidence on their topics, without the cloud //
+	// ******************************************************************** //
+	double publish_time = common::Time::GetWallTime().Double();
+	_publishImages( _slot );
+	_slot.stages.stop( FrameStages::STAGE_PUBLISH, publish_time );
+
+	// nothing else is rendered for a frame without the cloud
+	if( !( _slot.outputs & OUTPUT_CLOUD ) )
+	{
+		if( _slot.snapshot && _slot.save_count >= m_total_snapshot )
+		{
+			_finishSnapshotRun();
+		}
+		return;
+	}
+
+	this->_extractCloud( _slot );
+
+	// smoothed in place by _extractCloud()
+	pcl::PointCloud< pcl::PointXYZ > &blurred_cloud = *_slot.cloud;
+	publish_time = common::Time::GetWallTime().Double();
+
+	// if it is in only_snapshot mode, we don't need to do pose estimation
+	if( _slot.snapshot )
+	{
+		if( m_snapshot_format == SNAPSHOT_FORMAT_DATASET )
+		{
+			_saveSnapshotRecord( _slot );
+		}
+		else if( m_snapshot_cloud != SNAPSHOT_CLOUD_NONE )
+		{
+			bool compressed = m_snapshot_cloud == SNAPSHOT_CLOUD_COMPRESSED;
+			boost::filesystem::create_directory( compressed ? "only_snapshot/depth" : "only_snapshot/pcd" );
+			ss.clear();
+			ss.str( "" );
+			save_string.clear();
+			if( compressed )
+			{
+				ss << "only_snapshot/depth/depth_" << _slot.save_file_number << ".gzdz";
+			}
+			else
+			{
+				ss << "only_snapshot/pcd/pointcloud_" << _slot.save_file_number << ".pcd";
+			}
+			save_string = ss.str();
+			_saveSnapshotCloud( _slot, save_string );
+			std::cout << "save cloud = " << save_string << endl;
+		}
+
+		_slot.stages.stop( FrameStages::STAGE_PUBLISH, publish_time );
+
+		// the run ends with the last snapshot, rethrow_event was published by _captureSceneState()
+		if( _slot.save_count >= m_total_snapshot )
+		{
+			_finishSnapshotRun();
+		}
+		return;
+	}
+	// if it is in only_snapshot mode, we don't need to do pose estimation
+
+	// *************************************** //
+	// send sensor data through gazebo message //
+	// *************************************** //
+	if( m_cloud_message == CLOUD_MESSAGE_SHM )
+	{
+		_publishSharedMemoryFrame( _slot );
+	}
+	else if( m_cloud_message == CLOUD_MESSAGE_PACKED )
+	{
+		_publishPackedCloud( _slot );
+	}
+	else if( m_cloud_message == CLOUD_MESSAGE_COMPRESSED )
+	{
+		_publishCompressedCloud( _slot );
+	}
+	else if( m_use_ideal_segmentation )
+	{
+		// publish PointCloud
+		pcl::msgs::PointCloudXYZL msgs_pointcloudxyzl;
+		msgs_pointcloudxyzl.set_width( blurred_cloud.width );
+		msgs_pointcloudxyzl.set_height( blurred_cloud.height );
+		msgs_pointcloudxyzl.set_is_dense( blurred_cloud.is_dense );
+
+		// allocate every point first, then fill rows in parallel
+		msgs_pointcloudxyzl.mutable_points()->Reserve( width * height );
+		for( int idx = 0; idx < width * height; idx++ )
+		{
+			msgs_pointcloudxyzl.add_points();
+		}
+		m_worker_pool->parallelFor( 0, height, 16, [&]( int _y0, int _y1 )
+		{
+			for( int j = _y0; j < _y1; j++ )
+			{
+				for( int i = 0; i < width; i++ )
+				{
+					pcl::msgs::PointXYZL *point_xyzl = msgs_pointcloudxyzl.mutable_points( i + j * width );
+					point_xyzl->set_x( blurred_cloud( i, j ).x );
+					point_xyzl->set_y( blurred_cloud( i, j ).y );
+					point_xyzl->set_z( blurred_cloud( i, j ).z );
+					point_xyzl->set_label( segmentLabel( _slot.segment, m_segment_encoding, i + j * width ) );
+				}
+			}
+		} );
+		if( !_slot.stream )
+		{
+			cout << "Publishing PointCloud..." << endl;
+		}
+		_publishCloudMessage( msgs_pointcloudxyzl );
+	}
+	else // not use ideal segmentation
+	{
+		// publish PointCloud
+		pcl::msgs::PointCloud msgs_pointcloud;
+		msgs_pointcloud.set_width( blurred_cloud.width );
+		msgs_pointcloud.set_height( blurred_cloud.height );
+		msgs_pointcloud.set_is_dense( blurred_cloud.is_dense );
+
+		// allocate every point first, then fill rows in parallel
+		msgs_pointcloud.mutable_points()->Reserve( width * height );
+		for( int idx = 0; idx < width * height; idx++ )
+		{
+			msgs_pointcloud.add_points();
+		}
+		m_worker_pool->parallelFor( 0, height, 16, [&]( int _y0, int _y1 )
+		{
+			for( int j = _y0; j < _y1; j++ )
+			{
+				for( int i = 0; i < width; i++ )
+				{
+					pcl::msgs::PointXYZ *point_xyz = msgs_pointcloud.mutable_points( i + j * width );
+					point_xyz->set_x( blurred_cloud( i, j ).x );
+					point_xyz->set_y( blurred_cloud( i, j ).y );
+					point_xyz->set_z( blurred_cloud( i, j ).z );
+				}
+			}
+		} );
+		if( !_slot.stream )
+		{
+			cout << "Publishing PointCloud..." << endl;
+		}
+		_publishCloudMessage( msgs_pointcloud );
+	}
+	_slot.stages.stop( FrameStages::STAGE_PUBLISH, publish_time );
+
+	// TODO : TEMP START
+	//	cout << "send message : " << common::Time::GetWallTime().Double() - time << endl;
+	//	time = common::Time::GetWallTime().Double();
+	// TEMP END
+
+}
+
+void DepthSensorPlugin::_extractCloud( FrameSlot &_slot )
+{
+	FrameScratch &scratch = m_frame_ring->getScratch();
+
+	// ***************************************************** //
+	// perlin noise, same for fused & reference post process //
+	// ***************************************************** //
+	// the mask pass already applied noise 40 & confidence noise of the slot
+	if( !m_mask_pass )
+	{
+		_generatePerlinNoise( PERLIN_GRID_40, 1, scratch.noise_40 );	// amplitude about -10 ~ 10
+	}
+
+	_generatePerlinNoise( PERLIN_GRID_5_10_20, 3, scratch.edge_noise );
+
+	// sum of noise 5 ( -2.5 ~ 2.5 ), noise 10 ( -5 ~ 5 ) & noise 20 ( -10 ~ 10 )
+	if( !m_mask_pass )
+	{
+		_generatePerlinNoise( PERLIN_GRID_5_10_20, 3, scratch.conf_noise );
+	}
+
+	// *********************************************************** //
+	// depth validation, point cloud extraction & add sensor noise //
+	// *********************************************************** //
+	// realizations rotate frame by frame
+	if( m_sensor_noise )
+	{
+		m_noise = m_sensor_noise->next();
+	}
+
+	// organized width x height since the ring was created
+	pcl::PointCloud<pcl::PointXYZ> &cloud = *_slot.cloud;
+
+	double post_process_time = common::Time::GetWallTime().Double();
+
+	if( m_post_process_mode == POST_PROCESS_REFERENCE )
+	{
+		_postProcessReference( _slot, cloud );
+	}
+	else if( m_mask_pass )
+	{
+		_postProcessMasked( _slot, cloud );
+	}
+	else
+	{
+		_postProcessFused( _slot, cloud );
+	}
+
+	_slot.stages.stop( FrameStages::STAGE_POST_PROCESS, post_process_time );
+
+	// masks of the gpu must match the cpu fallback
+	if( m_post_process_mode == POST_PROCESS_VERIFY && m_mask_pass )
+	{
+		_verifyMaskPass( _slot );
+	}
+	// fused result must be bit-exact to reference
+	else if( m_post_process_mode == POST_PROCESS_VERIFY )
+	{
+		// keeps its capacity, only the first frame allocates
+		pcl::PointCloud<pcl::PointXYZ> &reference_cloud = scratch.reference_cloud;
+		reference_cloud = cloud;
+		_postProcessReference( _slot, reference_cloud );
+
+		int num_mismatch = 0;
+		for( unsigned int idx = 0; idx < cloud.size(); idx++ )
+		{
+			if( memcmp( cloud[ idx ].data, reference_cloud[ idx ].data, 3 * sizeof( float ) ) != 0 )
+			{
+				num_mismatch++;
+			}
+		}
+
+		if( num_mismatch == 0 )
+		{
+			cout << COUT_PREFIX << "fused post process is bit-exact to reference" << endl;
+		}
+		else
+		{
+			cerr << CERR_PREFIX << num_mismatch << " points of fused post process differ from reference!" << endl;
+		}
+	}
+
+	// TODO : If you want to save the point cloud, just uncomment this part
+	// ********************* //
+	// save Point Cloud Data //
+	// ********************* //
+	/*
+	boost::filesystem::create_directory( "only_snapshot/pcd" );
+	// save pcd file from gazebo's sensor
+	if(m_snapshot)
+	{
+		ss.clear();
+		ss.str( "" );
+		save_string.clear();
+		ss << "only_snapshot/pcd/pointcloud_" << _slot.save_file_number << ".pcd";
+		save_string = ss.str();
+		std::cout << "save pcd = " << save_string << endl;
+		pcl::io::savePCDFileBinary(save_string, cloud);
+	}
 	else
 	{
-		this->m_camera_sensor->SaveFrame( "rgb_sensor.png" );
+		pcl::io::savePCDFileBinary( "pointcloud.pcd", cloud );
+	}
+	 */
+
+	//pcl::io::savePCDFileBinary( "pointcloud_noise.pcd", cloud );
+
+	// TODO : TEMP START
+	//	cout << "add noise: " << common::Time::GetWallTime().Double() - time << endl;
+	//	time = common::Time::GetWallTime().Double();
+	// TEMP END
+
+	// ****************** //
+	// smooth point cloud //
+	// ****************** //
+
+	// get Gaussian kernel
+	/*const int kernel_size = 11;
+	const int k = ( kernel_size - 1 ) / 2;
+	const double sigma = 4;
+
+	cv::Mat gauss_kernel = gaussianMaskGenerator( kernel_size, sigma );
+	*/
+
+	// start blurring on z - direction, in place on the slot's cloud, invalid ( NaN ) points are left as they are
+	pcl::PointCloud< pcl::PointXYZ > &blurred_cloud = *_slot.cloud;
+
+	// bilateral grid of pcl::FastBilateralFilter, sigma_s 2.5 pixels & sigma_r 5 mm, skipped by the last backpressure level
+	if( _slot.degrade < 2 )
+	{
+		double filter_time = common::Time::GetWallTime().Double();
+		m_bilateral_filter->filter( &blurred_cloud.points[0].z, sizeof( pcl::PointXYZ ) / sizeof( float ) );
+		_slot.stages.stop( FrameStages::STAGE_FILTER, filter_time );
+	}
+
+	//	pcl::io::savePCDFileBinary( "pointcloud_noise_blur.pcd", blurred_cloud );
+
+	// TODO : TEMP START
+	//	cout << "blurring : " << common::Time::GetWallTime().Double() - time << endl;
+	//	time = common::Time::GetWallTime().Double();
+	// TEMP END
+
+
+	// TEMP END
+
+	/*for( int j = 0; j < height; j++ )
+	{
+		for( int i = 0; i < width; i++ )
+		{
+			if( !pcl::isFinite( cloud( i, j ) ) )
+			{
+				continue;
+			}
+
+			float norm_factor = 0.f;
+			float sum = 0.f;
+
+			for( int y = 0; y < kernel_size; y++ )
+			{
+				for( int x = 0; x < kernel_size; x++ )
+				{
+					if( ( i - k + x ) < 0 ||
+						( j - k + y ) < 0 ||
+						( i - k + x ) >= width ||
+						( j - k + y ) >= height ||
+						!pcl::isFinite( cloud( i - k + x, j - k + y ) ) ||
+						abs( cloud( i, j ).z - cloud( i - k +x, j - k + y ).z ) > 10 )
+					{
+						continue;
+					}
+
+					sum += cloud( i - k + x, j - k + y ).z * gauss_kernel.at<float>( y, x );
+					norm_factor += gauss_kernel.at<float>( y, x );
+				}
+			}
+
+			blurred_cloud.at( i, j ).z = sum / norm_factor;
+		}
 	}
 
-	// TODO: TEMP START test rgb render texture
-	// QImage rgb_image( m_rgb_buffer, width, height, QImage::Format_RGB888 );
-	// rgb_image.save( "saturate_map.png" );
-	// TEMP END
+	//pcl::io::savePCDFileBinary( "pointcloud_noise_blur.pcd", blurred_cloud );*/
+}
 
+void DepthSensorPlugin::_postProcessReference(	const FrameSlot						&_slot,
+												pcl::PointCloud< pcl::PointXYZ >	&_cloud )
+{
+	// get sensor info
+	int width = m_rgb_rt->getWidth();
+	int height = m_rgb_rt->getHeight();
 
+	FrameScratch &scratch = m_frame_ring->getScratch();
+	const float *noise_40 = scratch.noise_40;
+	const float *conf_noise = scratch.conf_noise;
 
 	// ****************** //
 	// extract depth data //
@@ -647,11 +2008,13 @@ void DepthSensorPlugin::_saveSensorData()
 	// double time = common::Time::GetWallTime().Double();
 	// TEMP END
 
-	unsigned char *temp_depth_buffer = new unsigned char[ width * height * 3 ];
-	// convert float 32 to unsigned char 8 bit;
+	// preallocated, reused every frame
+	unsigned char *temp_depth_buffer = scratch.depth_8u;
+	// convert float 32 to unsigned char 8 bit, 255 only for out of range;
 	for( unsigned int i = 0; i < m_depth_rt->getWidth() * m_depth_rt->getHeight(); i++ )
 	{
-		unsigned char data = (unsigned char)( m_depth_buffer[ 4 * i + 0] * 255 );
+		float depth = m_rt_layout.depth( _slot.depth, i );
+		unsigned char data = DepthMask::outOfRange( depth ) ? 255 : (unsigned char)( depth * 255 );
 		temp_depth_buffer[3*i] = data;
 		temp_depth_buffer[3*i + 1] = data;
 		temp_depth_buffer[3*i + 2] = data;
@@ -667,22 +2030,16 @@ void DepthSensorPlugin::_saveSensorData()
 	// ************************** //
 	// intensity saturation check //
 	// ************************** //
-	vector< float > noise_5_temp = perlinNoise( width, height, 5 );	// amplitude about -2.5~2.5
-	vector< float > noise_10_temp = perlinNoise( width, height, 10 );	// amplitude about -5 ~ 5
-	vector< float > noise_20_temp = perlinNoise( width, height, 20 );	// amplitude about -10 ~ 10
-	vector< float > noise_40_temp = perlinNoise( width, height, 40 );	// amplitude about -10 ~ 10
-
 	for( int j = 0; j < height; j++ )
 	{
 		for( int i = 0; i < width; i++ )
 		{
 			int idx = i + j * width;
 
-			//float thres = 180 + noise_5_temp[ idx ]*5 + noise_10_temp[ idx ]*4 + noise_20_temp[ idx ]*10 + noise_40_temp[ idx ] * 10;
-			float thres = 180 + noise_40_temp[ idx ] * 10;
+			float thres = 180 + noise_40[ idx ] * 10;
 			thres = thres > 0 ? thres : 1;
 
-			if( m_rgb_buffer[ 3 * idx ] > thres  )
+			if( _slot.rgb[ 3 * idx ] > thres  )
 			{
 				temp_depth_buffer[ 3 * idx ] = 255;
 				temp_depth_buffer[ 3 * idx + 1 ] = 255;
@@ -696,8 +2053,21 @@ void DepthSensorPlugin::_saveSensorData()
 	// ********************** //
 	// disturb occlusion edge //
 	// ********************** //
-	_disturbOcclusionEdge( temp_depth_buffer );
-	//_disturbOcclusionEdge( temp_depth_buffer );
+	unsigned char *invalid_mask = scratch.invalid_mask;
+	for( int idx = 0; idx < width * height; idx++ )
+	{
+		invalid_mask[ idx ] = temp_depth_buffer[ 3 * idx ] == 255;
+	}
+	_disturbOcclusionEdge( invalid_mask, scratch.edge_noise );
+	for( int idx = 0; idx < width * height; idx++ )
+	{
+		if( invalid_mask[ idx ] )
+		{
+			temp_depth_buffer[ 3 * idx ] = 255;
+			temp_depth_buffer[ 3 * idx + 1 ] = 255;
+			temp_depth_buffer[ 3 * idx + 2 ] = 255;
+		}
+	}
 	//	depth_image.save( "depth_disturb_occlusion.png" );
 
 	// TODO : TEMP START
@@ -708,19 +2078,15 @@ void DepthSensorPlugin::_saveSensorData()
 	// ************************** //
 	// confidence threshold check //
 	// ************************** //
-	vector< float > noise_5 = perlinNoise( width, height, 5 );	// amplitude about -2.5~2.5
-	vector< float > noise_10 = perlinNoise( width, height, 10 );	// amplitude about -5 ~ 5
-	vector< float > noise_20 = perlinNoise( width, height, 20 );	// amplitude about -10 ~ 10
-
 	for( int j = 0; j < height; j++ )
 	{
 		for( int i = 0; i < width; i++ )
 		{
 			int idx = i + j * width;
 			// disturb confidence threshold with pelin noise
-			float conf_thres = 75.f + noise_5[ idx ] + noise_10[ idx ] + noise_20[ idx ];
+			float conf_thres = 75.f + conf_noise[ idx ];
 
-			if( m_rayconf_buffer[ 4 * idx + 3 ] < cos( conf_thres * M_PI / 180.f ) )
+			if( m_rt_layout.confidence( _slot.rayconf, idx ) < cos( conf_thres * M_PI / 180.f ) )
 			{
 				temp_depth_buffer[ 3 * idx ] = 255;
 				temp_depth_buffer[ 3 * idx + 1 ] = 255;
@@ -740,51 +2106,48 @@ void DepthSensorPlugin::_saveSensorData()
 	// **************** //
 	// save point cloud //
 	// **************** //
-	pcl::PointCloud<pcl::PointXYZ> cloud;
-	cloud.width = width;
-	cloud.height = height;
-	cloud.is_dense = false;
-	cloud.points.resize( cloud.width * cloud.height );
-
 	// ideal data
-	/*for( unsigned int idx = 0 ; idx < cloud.size(); ++idx )
+	/*for( unsigned int idx = 0 ; idx < _cloud.size(); ++idx )
 	{
 
 		// check validatioin of data, in depth range & confidence != 0
-		if( m_rayconf_buffer[ 4 * idx + 3 ] != -1  && m_rayconf_buffer[ 4 * idx + 2 ] < 0 )
+		if( _slot.rayconf[ 4 * idx + 3 ] != -1  && _slot.rayconf[ 4 * idx + 2 ] < 0 )
 		{
-			cloud[idx].x = m_rayconf_buffer[ 4 * idx + 0 ];
-			cloud[idx].y = m_rayconf_buffer[ 4 * idx + 1 ];
-			cloud[idx].z = m_rayconf_buffer[ 4 * idx + 2 ];
+			_cloud[idx].x = _slot.rayconf[ 4 * idx + 0 ];
+			_cloud[idx].y = _slot.rayconf[ 4 * idx + 1 ];
+			_cloud[idx].z = _slot.rayconf[ 4 * idx + 2 ];
 		}
 		else
 		{
-			cloud[idx].x = std::numeric_limits<float>::quiet_NaN();
-			cloud[idx].y = std::numeric_limits<float>::quiet_NaN();
-			cloud[idx].z = std::numeric_limits<float>::quiet_NaN();
+			_cloud[idx].x = std::numeric_limits<float>::quiet_NaN();
+			_cloud[idx].y = std::numeric_limits<float>::quiet_NaN();
+			_cloud[idx].z = std::numeric_limits<float>::quiet_NaN();
 
 		}
 
 	}
 
-	pcl::io::savePCDFileBinary( "pointcloud_ideal.pcd", cloud );*/
+	pcl::io::savePCDFileBinary( "pointcloud_ideal.pcd", _cloud );*/
 
 	// point cloud with disturb edge, confidence threshold, and change to millimeter
-	for( unsigned int idx = 0 ; idx < cloud.size(); ++idx )
+	for( unsigned int idx = 0 ; idx < _cloud.size(); ++idx )
 	{
 
 		// check validatioin of data, in depth range & confidence != 0
-		if( m_rayconf_buffer[ 4 * idx + 3 ] != -1  && m_rayconf_buffer[ 4 * idx + 2 ] < 0 && temp_depth_buffer[ 3 * idx ] != 255 )
+		if( m_rt_layout.hasPoint( _slot.depth, _slot.rayconf, idx ) && temp_depth_buffer[ 3 * idx ] != 255 )
 		{
-			cloud[idx].x = m_rayconf_buffer[ 4 * idx + 0 ] * 1000;
-			cloud[idx].y = m_rayconf_buffer[ 4 * idx + 1 ] * 1000;
-			cloud[idx].z = m_rayconf_buffer[ 4 * idx + 2 ] * 1000;
+			// xyz of rayconf buffer, or reconstructed from depth
+			float xyz[3];
+			m_rt_layout.point( _slot.depth, _slot.rayconf, idx, xyz );
+			_cloud[idx].x = xyz[0] * 1000;
+			_cloud[idx].y = xyz[1] * 1000;
+			_cloud[idx].z = xyz[2] * 1000;
 		}
 		else
 		{
-			cloud[idx].x = std::numeric_limits<float>::quiet_NaN();
-			cloud[idx].y = std::numeric_limits<float>::quiet_NaN();
-			cloud[idx].z = std::numeric_limits<float>::quiet_NaN();
+			_cloud[idx].x = std::numeric_limits<float>::quiet_NaN();
+			_cloud[idx].y = std::numeric_limits<float>::quiet_NaN();
+			_cloud[idx].z = std::numeric_limits<float>::quiet_NaN();
 		}
 
 	}
@@ -796,301 +2159,511 @@ void DepthSensorPlugin::_saveSensorData()
 	// ******************************* //
 	// add sensor noise to point cloud //
 	// ******************************* //
-	for( unsigned int idx = 0 ; idx < cloud.size(); ++idx )
+	for( unsigned int idx = 0 ; idx < _cloud.size(); ++idx )
 	{
-		if( !pcl::isFinite( cloud[idx] ) )
+		if( !pcl::isFinite( _cloud[idx] ) )
 		{
 			continue;
 		}
 
-		cloud[idx].z += m_noise.at<float>( idx / width, idx % width ) * 3;
+		_cloud[idx].z += m_noise.at<float>( idx / width, idx % width ) * 3;
 	}
+}
 
-	// TODO : If you want to save the point cloud, just uncomment this part
-	// ********************* //
-	// save Point Cloud Data //
-	// ********************* //
-	/*
-	boost::filesystem::create_directory( "only_snapshot/pcd" );
-	// save pcd file from gazebo's sensor
-	if(m_snapshot)
+void DepthSensorPlugin::_postProcessFused(	const FrameSlot						&_slot,
+											pcl::PointCloud< pcl::PointXYZ >	&_cloud )
+{
+	FrameScratch &scratch = m_frame_ring->getScratch();
+
+	// depth out of range & intensity saturation
+	unsigned char *invalid_mask = scratch.invalid_mask;
+	m_post_process_kernel->invalidMask( _slot.depth, _slot.rgb, scratch.noise_40, invalid_mask );
+
+	// needs the whole mask, can't be fused
+	_disturbOcclusionEdge( invalid_mask, scratch.edge_noise );
+
+	// confidence threshold, point cloud & sensor noise
+	m_post_process_kernel->extractCloud(	_slot.depth,
+											_slot.rayconf,
+											invalid_mask,
+											scratch.conf_noise,
+											(float*)m_noise.data,
+											&_cloud.points[0] );
+}
+
+void DepthSensorPlugin::_postProcessMasked(	const FrameSlot						&_slot,
+											pcl::PointCloud< pcl::PointXYZ >	&_cloud )
+{
+	FrameScratch &scratch = m_frame_ring->getScratch();
+	int size = m_rgb_rt->getWidth() * m_rgb_rt->getHeight();
+
+	// depth out of range & intensity saturation of the mask pass
+	unsigned char *invalid_mask = scratch.invalid_mask;
+	for( int idx = 0; idx < size; idx++ )
 	{
-		ss.clear();
-		ss.str( "" );
-		save_string.clear();
-		m_save_file_number = m_save_count + m_current_file_number;
-		ss << "only_snapshot/pcd/pointcloud_" << m_save_file_number << ".pcd";
-		save_string = ss.str();
-		std::cout << "save pcd = " << save_string << endl;
-		pcl::io::savePCDFileBinary(save_string, cloud);
+		invalid_mask[ idx ] = ( DepthMask::flags( _slot.mask, idx ) & DepthMask::MASK_INVALID ) != 0;
 	}
-	else
+
+	// needs the whole mask, stays on the cpu
+	_disturbOcclusionEdge( invalid_mask, scratch.edge_noise );
+
+	// point cloud & sensor noise, confidence threshold is already in the flags
+	m_post_process_kernel->extractMaskedCloud(	_slot.mask,
+												invalid_mask,
+												(float*)m_noise.data,
+												&_cloud.points[0] );
+}
+
+void DepthSensorPlugin::_verifyMaskPass( const FrameSlot &_slot )
+{
+	FrameScratch &scratch = m_frame_ring->getScratch();
+	int size = m_rgb_rt->getWidth() * m_rgb_rt->getHeight();
+
+	m_post_process_kernel->maskFlags( _slot.depth, _slot.rayconf, _slot.rgb, _slot.noise_40, _slot.conf_noise, scratch.mask_flags );
+
+	// the gpu's cos may round the other way when confidence is right at the threshold
+	int num_mismatch = 0;
+	int num_borderline = 0;
+	for( int idx = 0; idx < size; idx++ )
 	{
-		pcl::io::savePCDFileBinary( "pointcloud.pcd", cloud );
-	}
-	 */
+		int flags = DepthMask::flags( _slot.mask, idx );
+		bool mismatch = flags != scratch.mask_flags[ idx ];
+		if( !mismatch && flags == 0 )
+		{
+			mismatch = DepthMask::depth( _slot.mask, idx ) != m_rt_layout.depth( _slot.depth, idx );
+		}
+		if( !mismatch )
+		{
+			continue;
+		}
 
-	//pcl::io::savePCDFileBinary( "pointcloud_noise.pcd", cloud );
+		num_mismatch++;
+		float conf_thres = cos( ( 75.f + _slot.conf_noise[ idx ] ) * M_PI / 180.f );
+		if(	( flags ^ scratch.mask_flags[ idx ] ) == DepthMask::MASK_REJECTED &&
+			fabs( m_rt_layout.confidence( _slot.rayconf, idx ) - conf_thres ) < 1e-5 )
+		{
+			num_borderline++;
+		}
+	}
 
-	// TODO : TEMP START
-	//	cout << "add noise: " << common::Time::GetWallTime().Double() - time << endl;
-	//	time = common::Time::GetWallTime().Double();
-	// TEMP END
+	if( num_mismatch == 0 )
+	{
+		cout << COUT_PREFIX << "gpu mask pass matches cpu fallback" << endl;
+	}
+	else if( num_mismatch == num_borderline )
+	{
+		cout << COUT_PREFIX << num_mismatch << " pixels of gpu mask pass differ from cpu fallback, all at the confidence threshold" << endl;
+	}
+	else
+	{
+		cerr << CERR_PREFIX << num_mismatch << " pixels of gpu mask pass differ from cpu fallback ( "
+			 << num_borderline << " at the confidence threshold )!" << endl;
+	}
+}
 
-	// ****************** //
-	// smooth point cloud //
-	// ****************** //
+void DepthSensorPlugin::_publishImages( const FrameSlot &_slot )
+{
+	int width = m_rgb_rt->getWidth();
+	int height = m_rgb_rt->getHeight();
 
-	// get Gaussian kernel
-	/*const int kernel_size = 11;
-	const int k = ( kernel_size - 1 ) / 2;
-	const double sigma = 4;
+	// grey levels ( L_INT8 ), or ids as little endian uint32 ( RGBA_INT8 )
+	if( ( _slot.outputs & OUTPUT_LABELS ) && m_labels_publisher_ptr->HasConnections() )
+	{
+		int label_bytes = segmentBytes( m_segment_encoding );
+		gazebo::msgs::Image msgs_labels;
+		msgs_labels.set_width( width );
+		msgs_labels.set_height( height );
+		msgs_labels.set_pixel_format( label_bytes == 1 ? common::Image::L_INT8 : common::Image::RGBA_INT8 );
+		msgs_labels.set_step( width * label_bytes );
+		msgs_labels.set_data( _slot.segment, width * height * label_bytes );
+		m_labels_publisher_ptr->Publish( msgs_labels );
+	}
 
-	cv::Mat gauss_kernel = gaussianMaskGenerator( kernel_size, sigma );
-	*/
+	// gazebo camera image, copied by _captureSceneState()
+	if( ( _slot.outputs & OUTPUT_RGB ) && m_rgb_publisher_ptr->HasConnections() )
+	{
+		gazebo::msgs::Image msgs_rgb;
+		msgs_rgb.set_width( width );
+		msgs_rgb.set_height( height );
+		msgs_rgb.set_pixel_format( common::Image::RGB_INT8 );
+		msgs_rgb.set_step( width * 3 );
+		msgs_rgb.set_data( _slot.camera_rgb, width * height * 3 );
+		m_rgb_publisher_ptr->Publish( msgs_rgb );
+	}
 
-	// start blurring on z - direction
-	pcl::PointCloud< pcl::PointXYZ > blurred_cloud;
+	// cos of the IR projector's incident angle, -1 where it can't reach
+	if( ( _slot.outputs & OUTPUT_CONFIDENCE ) && m_confidence_publisher_ptr->HasConnections() )
+	{
+		gazebo::msgs::Image msgs_confidence;
+		msgs_confidence.set_width( width );
+		msgs_confidence.set_height( height );
+		msgs_confidence.set_pixel_format( common::Image::R_FLOAT32 );
+		msgs_confidence.set_step( width * sizeof( float ) );
+
+		std::string *data = msgs_confidence.mutable_data();
+		data->resize( width * height * sizeof( float ) );
+		float *confidence = (float*)&( *data )[0];
+		for( int idx = 0; idx < width * height; idx++ )
+		{
+			confidence[ idx ] = m_rt_layout.confidence( _slot.rayconf, idx );
+		}
+		m_confidence_publisher_ptr->Publish( msgs_confidence );
+	}
+}
 
-	// Useing Fast Bilateral Filter
-	pcl::FastBilateralFilterOMP< pcl::PointXYZ > fast_bilateral_filter;
-	fast_bilateral_filter.setSigmaS( 2.5 );
-	fast_bilateral_filter.setSigmaR( 5 );
-	fast_bilateral_filter.setInputCloud( cloud.makeShared() );
-	fast_bilateral_filter.filter( blurred_cloud );
+void DepthSensorPlugin::_publishPackedCloud( const FrameSlot &_slot )
+{
+	// pcl::PointXYZ is x, y, z & 4 bytes of padding, the label goes into the padding
+	static_assert( sizeof( pcl::PointXYZ ) == 16, "pcl::PointXYZ is expected to be 16 bytes" );
 
-	//	pcl::io::savePCDFileBinary( "pointcloud_noise_blur.pcd", blurred_cloud );
+	const pcl::PointCloud< pcl::PointXYZ > &cloud = *_slot.cloud;
 
-	// TODO : TEMP START
-	//	cout << "blurring : " << common::Time::GetWallTime().Double() - time << endl;
-	//	time = common::Time::GetWallTime().Double();
-	// TEMP END
+	pcl::msgs::PackedPointCloud msgs_packed;
+	msgs_packed.set_width( cloud.width );
+	msgs_packed.set_height( cloud.height );
+	msgs_packed.set_is_dense( cloud.is_dense );
+	msgs_packed.set_point_step( sizeof( pcl::PointXYZ ) );
+	msgs_packed.set_sequence( _slot.sequence );
+	msgs_packed.set_sim_time( _slot.sim_time );
 
+	const char *field_names[] = { "x", "y", "z" };
+	for( int i = 0; i < 3; i++ )
+	{
+		pcl::msgs::PackedPointCloud::Field *field = msgs_packed.add_fields();
+		field->set_name( field_names[i] );
+		field->set_offset( i * sizeof( float ) );
+		field->set_datatype( pcl::msgs::PackedPointCloud::Field::FLOAT32 );
+	}
 
-	// TEMP END
+	// one copy of the whole cloud
+	std::string *data = msgs_packed.mutable_data();
+	data->resize( cloud.points.size() * sizeof( pcl::PointXYZ ) );
+	memcpy( &( *data )[0], &cloud.points[0], data->size() );
 
-	/*for( int j = 0; j < height; j++ )
+	if( _slot.outputs & OUTPUT_LABELS )
 	{
-		for( int i = 0; i < width; i++ )
+		pcl::msgs::PackedPointCloud::Field *field = msgs_packed.add_fields();
+		field->set_name( "label" );
+		field->set_offset( 3 * sizeof( float ) );
+		field->set_datatype( pcl::msgs::PackedPointCloud::Field::UINT32 );
+
+		int width = cloud.width;
+		unsigned char *points = (unsigned char*)&( *data )[0];
+		m_worker_pool->parallelFor( 0, cloud.height, 16, [&]( int _y0, int _y1 )
 		{
-			if( !pcl::isFinite( cloud( i, j ) ) )
+			for( int idx = _y0 * width; idx < _y1 * width; idx++ )
 			{
-				continue;
+				uint32_t label = segmentLabel( _slot.segment, m_segment_encoding, idx );
+				memcpy( points + idx * sizeof( pcl::PointXYZ ) + 3 * sizeof( float ), &label, sizeof( label ) );
 			}
+		} );
+	}
 
-			float norm_factor = 0.f;
-			float sum = 0.f;
+	if( !_slot.stream )
+	{
+		cout << "Publishing PointCloud..." << endl;
+	}
+	_publishCloudMessage( msgs_packed );
+}
 
-			for( int y = 0; y < kernel_size; y++ )
-			{
-				for( int x = 0; x < kernel_size; x++ )
-				{
-					if( ( i - k + x ) < 0 ||
-						( j - k + y ) < 0 ||
-						( i - k + x ) >= width ||
-						( j - k + y ) >= height ||
-						!pcl::isFinite( cloud( i - k + x, j - k + y ) ) ||
-						abs( cloud( i, j ).z - cloud( i - k +x, j - k + y ).z ) > 10 )
-					{
-						continue;
-					}
+void DepthSensorPlugin::_publishSharedMemoryFrame( const FrameSlot &_slot )
+{
+	const pcl::PointCloud< pcl::PointXYZ > &cloud = *_slot.cloud;
 
-					sum += cloud( i - k + x, j - k + y ).z * gauss_kernel.at<float>( y, x );
-					norm_factor += gauss_kernel.at<float>( y, x );
-				}
-			}
+	// same 16 bytes per point as PackedPointCloud, written straight into the slot
+	int slot = m_shm_ring->beginFrame();
+	unsigned char *points = m_shm_ring->getPoints( slot );
+	memcpy( points, &cloud.points[0], cloud.points.size() * sizeof( pcl::PointXYZ ) );
+	memcpy( m_shm_ring->getRGB( slot ), _slot.rgb, cloud.points.size() * 3 );
 
-			blurred_cloud.at( i, j ).z = sum / norm_factor;
-		}
+	if( _slot.outputs & OUTPUT_LABELS )
+	{
+		int width = cloud.width;
+		m_worker_pool->parallelFor( 0, cloud.height, 16, [&]( int _y0, int _y1 )
+		{
+			for( int idx = _y0 * width; idx < _y1 * width; idx++ )
+			{
+				uint32_t label = segmentLabel( _slot.segment, m_segment_encoding, idx );
+				memcpy( points + idx * sizeof( pcl::PointXYZ ) + 3 * sizeof( float ), &label, sizeof( label ) );
+			}
+		} );
 	}
 
-	//pcl::io::savePCDFileBinary( "pointcloud_noise_blur.pcd", blurred_cloud );*/
+	uint64_t frame = m_shm_ring->commitFrame( slot, ( _slot.outputs & OUTPUT_LABELS ) != 0, true );
 
-	// if it is in only_snapshot mode, we don't need to do pose estimation
-	if(m_snapshot)
+	pcl::msgs::SharedMemoryFrame msgs_frame;
+	msgs_frame.set_shm_name( m_shm_name );
+	msgs_frame.set_frame( frame );
+	msgs_frame.set_slot( slot );
+	msgs_frame.set_width( cloud.width );
+	msgs_frame.set_height( cloud.height );
+	msgs_frame.set_sequence( _slot.sequence );
+	msgs_frame.set_sim_time( _slot.sim_time );
+
+	if( !_slot.stream )
 	{
-		msgs::Request rethrow_event;
-		rethrow_event.set_id( 2 );
-		rethrow_event.set_request( "rethrow_in_evaluation_platform" );
-		rethrow_event.set_data(std::to_string(m_save_count));
-		m_rethrow_publisher_ptr->Publish(rethrow_event);
-		m_save_count++;
-		return;
+		cout << "Publishing frame " << frame << " in slot " << slot << "..." << endl;
 	}
-	// if it is in only_snapshot mode, we don't need to do pose estimation
+	_publishCloudMessage( msgs_frame );
+}
 
-	// *************************************** //
-	// send sensor data through gazebo message //
-	// *************************************** //
-	while( !m_publisher_ptr->HasConnections() )
+void DepthSensorPlugin::_publishCompressedCloud( const FrameSlot &_slot )
+{
+	pcl::msgs::CompressedDepthCloud msgs_compressed;
+	msgs_compressed.set_width( _slot.cloud->width );
+	msgs_compressed.set_height( _slot.cloud->height );
+	msgs_compressed.set_sequence( _slot.sequence );
+	msgs_compressed.set_sim_time( _slot.sim_time );
+	_encodeDepthStream( _slot, *msgs_compressed.mutable_data() );
+
+	if( !_slot.stream )
+	{
+		cout << "Publishing PointCloud... ( compressed " << msgs_compressed.data().size() / 1024 << " KB )" << endl;
+	}
+	_publishCloudMessage( msgs_compressed );
+}
+
+void DepthSensorPlugin::_publishCloudMessage( const google::protobuf::Message &_msgs )
+{
+	if( !m_cloud_queue->publish( _msgs ) )
 	{
-		cout << "[DepthSensorPlugin] Waiting for connection..." << endl;
-		gazebo::common::Time::MSleep( 500 );
+		cout << COUT_PREFIX << "no subscriber yet, point cloud queued, " << m_cloud_queue->getSummary() << endl;
 	}
+}
 
-	if( m_publisher_ptr->HasConnections() )
+void DepthSensorPlugin::_encodeDepthStream( const FrameSlot &_slot, std::string &_stream )
+{
+	// grey levels, or whole class << 24 | instance ids
+	int label_bytes = segmentBytes( m_segment_encoding );
+	m_depth_codec->encode(	&_slot.cloud->points[0],
+							sizeof( pcl::PointXYZ ),
+							( _slot.outputs & OUTPUT_LABELS ) ? _slot.segment : NULL,
+							label_bytes,
+							_stream,
+							label_bytes );
+}
+
+void DepthSensorPlugin::_saveSnapshotRGB( FrameSlot &_slot, const std::string &_path )
+{
+	// camera image copied by _captureSceneState(), the slot isn't reused before the job is done
+	int width = m_camera->GetImageWidth();
+	int height = m_camera->GetImageHeight();
+	std::shared_ptr< FrameSlot > slot = m_frame_ring->share( &_slot );
+
+	bool queued = m_snapshot_writer->submit( [ slot, width, height, _path ]()
 	{
-		if( m_use_ideal_segmentation )
-		{
-			// publish PointCloud
-			pcl::msgs::PointCloudXYZL msgs_pointcloudxyzl;
-			msgs_pointcloudxyzl.set_width( blurred_cloud.width );
-			msgs_pointcloudxyzl.set_height( blurred_cloud.height );
-			msgs_pointcloudxyzl.set_is_dense( blurred_cloud.is_dense );
-			for( int j = 0; j < height; j++ )
-			{
-				for( int i = 0; i < width; i++ )
-				{
-					pcl::msgs::PointXYZL point_xyzl;
-					point_xyzl.set_x( blurred_cloud( i, j ).x );
-					point_xyzl.set_y( blurred_cloud( i, j ).y );
-					point_xyzl.set_z( blurred_cloud( i, j ).z );
-					point_xyzl.set_label( m_segment_buffer[ ( i + j * width ) * 3 ] );
+		cv::Mat rgb( height, width, CV_8UC3, slot->camera_rgb );
+		cv::Mat bgr;
+		cv::cvtColor( rgb, bgr, CV_RGB2BGR );
+		return cv::imwrite( _path, bgr );
+	} );
+	if( !queued )
+	{
+		cerr << CERR_PREFIX << "snapshot queue is full, drop " << _path << endl;
+	}
+}
 
-					msgs_pointcloudxyzl.add_points()->CopyFrom( point_xyzl );
-				}
-			}
-			cout << "Publishing PointCloud..." << endl;
-			m_publisher_ptr->Publish( msgs_pointcloudxyzl );
-		}
-		else // not use ideal segmentation
+void DepthSensorPlugin::_saveSnapshotCloud( FrameSlot &_slot, const std::string &_path )
+{
+	// blurred cloud & segment buffer are read from the slot, held until the job is done
+	std::shared_ptr< FrameSlot > slot = m_frame_ring->share( &_slot );
+
+	bool queued;
+	if( m_snapshot_cloud == SNAPSHOT_CLOUD_PCD )
+	{
+		queued = m_snapshot_writer->submit( [ slot, _path ]()
 		{
-			// publish PointCloud
-			pcl::msgs::PointCloud msgs_pointcloud;
-			msgs_pointcloud.set_width( blurred_cloud.width );
-			msgs_pointcloud.set_height( blurred_cloud.height );
-			msgs_pointcloud.set_is_dense( blurred_cloud.is_dense );
-			for( int j = 0; j < height; j++ )
-			{
-				for( int i = 0; i < width; i++ )
-				{
-					pcl::msgs::PointXYZ point_xyz;
-					point_xyz.set_x( blurred_cloud( i, j ).x );
-					point_xyz.set_y( blurred_cloud( i, j ).y );
-					point_xyz.set_z( blurred_cloud( i, j ).z );
-					msgs_pointcloud.add_points()->CopyFrom( point_xyz );
-				}
-			}
-			cout << "Publishing PointCloud..." << endl;
-			m_publisher_ptr->Publish( msgs_pointcloud );
-		}
+			return pcl::io::savePCDFileBinary( _path, *slot->cloud ) == 0;
+		} );
 	}
 	else
 	{
-		cout << "Has no connections !..." << endl;
-	}
+		// encoded by the writer thread with its own codec
+		bool labels = _slot.outputs & OUTPUT_LABELS;
+		int label_bytes = segmentBytes( m_segment_encoding );
+		DepthStreamCodec::Intrinsics intrinsics = m_depth_codec->getIntrinsics();
+		float depth_step = m_depth_codec->getMinDepthStep();
 
-	// TODO : TEMP START
-	//	cout << "send message : " << common::Time::GetWallTime().Double() - time << endl;
-	//	time = common::Time::GetWallTime().Double();
-	// TEMP END
+		queued = m_snapshot_writer->submit( [ slot, labels, label_bytes, intrinsics, depth_step, _path ]()
+		{
+			const pcl::PointCloud< pcl::PointXYZ > &cloud = *slot->cloud;
+			DepthStreamCodec codec( cloud.width, cloud.height, intrinsics, depth_step );
+			std::string stream;
+			codec.encode( &cloud.points[0], sizeof( pcl::PointXYZ ), labels ? slot->segment : NULL, label_bytes, stream, label_bytes );
+
+			std::ofstream file( _path.c_str(), std::ios::binary );
+			file.write( stream.data(), stream.size() );
+			return (bool)file;
+		} );
+	}
 
-	// free memory
-	delete [] temp_depth_buffer;
+	if( !queued )
+	{
+		cerr << CERR_PREFIX << "snapshot queue is full, drop " << _path << endl;
+	}
 }
 
-void DepthSensorPlugin::_disturbOcclusionEdge( unsigned char *_depth_buffer )
+void DepthSensorPlugin::_openSnapshotDataset()
 {
-	// get sensor info
-	int width = m_rgb_rt->getWidth();
-	int height = m_rgb_rt->getHeight();
+	boost::filesystem::path path( m_snapshot_dataset_path );
+	if( path.has_parent_path() )
+	{
+		boost::filesystem::create_directories( path.parent_path() );
+	}
 
-	// get a copy of depth buffer
-	unsigned char *temp_buffer = new unsigned char[ width * height * 3 ];
-	memcpy( temp_buffer, _depth_buffer, width * height * 3 * sizeof( unsigned char ) );
+	uint32_t cloud_format = SNAPSHOT_CLOUD_FORMAT_NONE;
+	if( m_snapshot_cloud == SNAPSHOT_CLOUD_PCD )
+	{
+		cloud_format = SNAPSHOT_CLOUD_FORMAT_XYZ;
+	}
+	else if( m_snapshot_cloud == SNAPSHOT_CLOUD_COMPRESSED )
+	{
+		cloud_format = SNAPSHOT_CLOUD_FORMAT_DEPTH_STREAM;
+	}
 
-	// generate pelin noise
-	vector< float > noise_5 = perlinNoise( width, height, 5 );	// amplitude about -2.5~2.5
-	vector< float > noise_10 = perlinNoise( width, height, 10 );	// amplitude about -5 ~ 5
-	vector< float > noise_20 = perlinNoise( width, height, 20 );	// amplitude about -10 ~ 10
+	m_snapshot_dataset = new SnapshotDatasetWriter(	m_snapshot_dataset_path,
+													m_camera->GetImageWidth(),
+													m_camera->GetImageHeight(),
+													cloud_format,
+													segmentBytes( m_segment_encoding ) );
+	if( !m_snapshot_dataset->isValid() )
+	{
+		cerr << CERR_PREFIX << "can't write " << m_snapshot_dataset_path << ", snapshots are not saved" << endl;
+		delete m_snapshot_dataset;
+		m_snapshot_dataset = NULL;
+		return;
+	}
 
-	vector< float > noise( width * height );
+	// resume behind the last frame, frame numbers continue like rgb_N.png and stay unique across dropped frames
+	m_current_file_number = m_snapshot_dataset->getNextFrame();
+	std::cout << "it has : " << m_snapshot_dataset->getNumRecords() << " records in " << m_snapshot_dataset_path
+			  << ", next frame " << m_current_file_number << std::endl;
+}
 
-	for( int j = 0; j < height; j++ )
+void DepthSensorPlugin::_saveSnapshotRecord( FrameSlot &_slot )
+{
+	if( !m_snapshot_dataset )
 	{
-		for( int i = 0; i < width; i++ )
-		{
-			noise[ i + j * width ] =	noise_5[ i + j * width ] +
-										noise_10[ i + j * width] +
-										noise_20[ i + j * width];
-		}
+		return;
 	}
 
-	cv::normalize( noise, noise, -10, 10, cv::NORM_MINMAX );
+	// camera image, clouds, segment buffer & poses are read from the slot, held until the record is appended
+	std::shared_ptr< FrameSlot > slot = m_frame_ring->share( &_slot );
+	bool labels = _slot.outputs & OUTPUT_LABELS;
+	int label_bytes = segmentBytes( m_segment_encoding );
 
-	// generate elements(diamond shape ) for each size
-	int max_size = 20;
-	vector< vector< math::Vector2i > > elements;
-	for( int cur_size = 0; cur_size <= max_size; cur_size++ )
-	{
-		vector< math::Vector2i > cur_elements;
+	SnapshotDatasetWriter *dataset = m_snapshot_dataset;
+	SnapshotCloud cloud_format = m_snapshot_cloud;
+	DepthStreamCodec::Intrinsics intrinsics = m_depth_codec->getIntrinsics();
+	float depth_step = m_depth_codec->getMinDepthStep();
+	uint64_t frame = _slot.save_file_number;
 
-		for( int x = cur_size; x > 0; x-- )
+	bool queued = m_snapshot_writer->submit( [ = ]()
+	{
+		const pcl::PointCloud< pcl::PointXYZ > &cloud = *slot->cloud;
+		int size = cloud.points.size();
+
+		SnapshotDatasetWriter::Record record;
+		memset( &record, 0, sizeof( record ) );
+		record.frame = frame;
+		record.sim_time = slot->sim_time;
+		record.section[ SNAPSHOT_SECTION_RGB ] = slot->camera_rgb;
+		record.section_bytes[ SNAPSHOT_SECTION_RGB ] = size * 3;
+		if( labels )
 		{
-			cur_elements.push_back( math::Vector2i( x, 0 ) );
-			cur_elements.push_back( math::Vector2i( -x, 0 ) );
+			// the segment buffer as it is
+			record.section[ SNAPSHOT_SECTION_LABEL ] = slot->segment;
+			record.section_bytes[ SNAPSHOT_SECTION_LABEL ] = size * label_bytes;
 		}
-
-		for( int y = 1; y <= cur_size; y++ )
+		if( !slot->poses.empty() )
 		{
-			cur_elements.push_back( math::Vector2i( 0, y ) );
-			cur_elements.push_back( math::Vector2i( 0, -y ) );
+			record.section[ SNAPSHOT_SECTION_POSE ] = &slot->poses[0];
+			record.section_bytes[ SNAPSHOT_SECTION_POSE ] = slot->poses.size() * sizeof( SnapshotPose );
+			record.num_poses = slot->poses.size();
 		}
 
-		for( int y = 1; y < cur_size; y++ )
+		// float x, y, z without the padding of pcl::PointXYZ, or the compressed stream
+		vector< float > xyz;
+		string stream;
+		if( cloud_format == SNAPSHOT_CLOUD_PCD )
 		{
-			for( int x = cur_size - y; x > 0; x-- )
+			xyz.resize( size * 3 );
+			for( int i = 0; i < size; i++ )
 			{
-				cur_elements.push_back( math::Vector2i( x, y ) );
-				cur_elements.push_back( math::Vector2i( -x, y ) );
-				cur_elements.push_back( math::Vector2i( x, -y ) );
-				cur_elements.push_back( math::Vector2i( -x, -y ) );
+				xyz[ i * 3 ] = cloud.points[i].x;
+				xyz[ i * 3 + 1 ] = cloud.points[i].y;
+				xyz[ i * 3 + 2 ] = cloud.points[i].z;
 			}
+			record.section[ SNAPSHOT_SECTION_CLOUD ] = &xyz[0];
+			record.section_bytes[ SNAPSHOT_SECTION_CLOUD ] = xyz.size() * sizeof( float );
+		}
+		else if( cloud_format == SNAPSHOT_CLOUD_COMPRESSED )
+		{
+			DepthStreamCodec codec( cloud.width, cloud.height, intrinsics, depth_step );
+			codec.encode( &cloud.points[0], sizeof( pcl::PointXYZ ), labels ? slot->segment : NULL, label_bytes, stream, label_bytes );
+			record.section[ SNAPSHOT_SECTION_CLOUD ] = stream.data();
+			record.section_bytes[ SNAPSHOT_SECTION_CLOUD ] = stream.size();
 		}
 
-		elements.push_back( cur_elements );
+		return dataset->append( record );
+	} );
+	if( !queued )
+	{
+		cerr << CERR_PREFIX << "snapshot queue is full, drop frame " << frame << endl;
 	}
+	std::cout << "save record = " << m_snapshot_dataset_path << " frame " << frame << endl;
+}
 
-	// erosion
-	for( int j = 1; j < height - 1; j++ )
+void DepthSensorPlugin::_finishSnapshotRun()
+{
+	double time = common::Time::GetWallTime().Double();
+	m_snapshot_writer->flush();
+	if( m_snapshot_dataset )
 	{
-		for( int i = 1; i < width - 1; i++ )
-		{
-			int erosion_size = abs( (int)noise[ i + j * width] );
+		// the dataset is readable without recovery from now on
+		m_snapshot_dataset->sync();
+	}
 
-			// check if is NaN point && do erosion if noise >= 1 ( erosion size )
-			if(	temp_buffer[ 3 * ( i + j * width ) ] == 255 &&
-				erosion_size >= 1 &&
-				(	temp_buffer[ 3 * ( i - 1+ j * width ) ] != 255 ||
-					temp_buffer[ 3 * ( i + 1+ j * width ) ] != 255 ||
-					temp_buffer[ 3 * ( i + ( j - 1 ) * width ) ] != 255 ||
-					temp_buffer[ 3 * ( i + ( j + 1 ) * width ) ] != 255 ) )
-			{
-				// TODO : use template element to do erosion
-				const vector< math::Vector2i > &cur_element = elements[ erosion_size ];
+	std::ostringstream result;
+	result << "written " << m_snapshot_writer->getWritten()
+		   << " failed " << m_snapshot_writer->getFailed()
+		   << " dropped " << m_snapshot_writer->getDropped();
+	cout << COUT_PREFIX << "snapshot files flushed in " << common::Time::GetWallTime().Double() - time << " sec, " << result.str() << endl;
+
+	msgs::Request flush_event;
+	flush_event.set_id( 3 );
+	flush_event.set_request( "snapshot_flushed" );
+	flush_event.set_data( result.str() );
+	m_snapshot_event_publisher_ptr->Publish( flush_event );
+}
 
-				for( uint idx = 0; idx < cur_element.size(); idx++ )
-				{
-					int target_x = i + cur_element[ idx ].x;
-					int target_y = j + cur_element[ idx ].y;
-					if( target_x < width &&
-						target_x >= 0 &&
-						target_y < height &&
-						target_y >= 0 )
-					{
-						_depth_buffer[ 3 * ( target_x + target_y * width ) ] = 255;
-						_depth_buffer[ 3 * ( target_x + target_y * width ) + 1 ] = 255;
-						_depth_buffer[ 3 * ( target_x + target_y * width ) + 2 ] = 255;
-					}
+void DepthSensorPlugin::_disturbOcclusionEdge( unsigned char *_invalid_mask, const float *_noise )
+{
+	// get sensor info
+	int width = m_rgb_rt->getWidth();
+	int height = m_rgb_rt->getHeight();
+	FrameScratch &scratch = m_frame_ring->getScratch();
 
-				}
+	// pelin noise ( sum of noise 5, 10 & 20 ) to -10 ~ 10, normalized into the scratch buffer
+	float *noise = scratch.edge_noise_normalized;
+	cv::Mat noise_mat( 1, width * height, CV_32FC1, noise );
+	cv::normalize( cv::Mat( 1, width * height, CV_32FC1, (void*)_noise ), noise_mat, -10, 10, cv::NORM_MINMAX );
 
-			}
-		}
+	// erosion size of every pixel
+	unsigned char *erosion_size = scratch.erosion_size;
+	for( int idx = 0; idx < width * height; idx++ )
+	{
+		erosion_size[ idx ] = abs( (int)noise[ idx ] );
 	}
 
-	// free memory
-	delete [] temp_buffer;
+	// erosion, same as stamping a diamond of erosion size on every NaN point next to a valid point
+	unsigned char *eroded_mask = scratch.eroded_mask;
+	m_edge_eroder->erode( _invalid_mask, erosion_size, eroded_mask );
+
+	for( int idx = 0; idx < width * height; idx++ )
+	{
+		_invalid_mask[ idx ] = _invalid_mask[ idx ] || eroded_mask[ idx ];
+	}
 }
 
 // _mask_size must be odd number and positive
@@ -1145,27 +2718,61 @@ void DepthSensorPlugin::_setupIdealSegmentation()
 																		cam_w,
 																		cam_h,
 																		0,
-																		Ogre::PF_BYTE_RGB,
+																		m_segment_encoding == SEGMENT_ENCODING_ID ? Ogre::PF_BYTE_RGBA : Ogre::PF_BYTE_RGB,
 																		Ogre::TU_RENDERTARGET );
 	m_segment_rt = rtt_texture->getBuffer()->getRenderTarget();
 
 	// setup render texture
 	m_segment_rt -> addViewport( m_ogre_camera );
 	m_segment_rt -> getViewport( 0 )->setClearEveryFrame( true );
-	// background set to ( 0, 0, 0 ), means no object at that pixel
-	m_segment_rt -> getViewport( 0 )->setBackgroundColour( Ogre::ColourValue( 0, 0, 0 ) );
+	// background set to ( 0, 0, 0, 0 ), means no object at that pixel
+	m_segment_rt -> getViewport( 0 )->setBackgroundColour( Ogre::ColourValue( 0, 0, 0, 0 ) );
 	m_segment_rt -> getViewport( 0 )->setOverlaysEnabled( false );
 
-	// allocate memory for rgb frame buffer
-	m_segment_buffer = new unsigned char[ cam_w * cam_h * 3 ];
-
-	// create rgb render target listener
-	m_segment_rt_listener = new SegmentRTListener( m_scene, m_scene_mgr, m_segment_rt, m_segment_buffer );
+	// create rgb render target listener, it writes into the slot of every capture
+	m_segment_rt_listener = new SegmentRTListener(	m_scene,
+													m_scene_mgr,
+													m_segment_rt,
+													m_frame_ring->getSlot( 0 )->segment,
+													m_entity_cache,
+													m_capture_state,
+													m_segment_encoding );
 
 	m_segment_rt -> addListener( m_segment_rt_listener );
 }
 
-void DepthSensorPlugin::_getIdealSegmentation()
+void DepthSensorPlugin::_setupMultiRenderTarget()
+{
+	std::string camera_name = m_camera->GetName();
+
+	// ************************************************** //
+	// bind depth & rayconf textures to one render target //
+	// ************************************************** //
+	m_mrt = Ogre::Root::getSingleton().getRenderSystem()->createMultiRenderTarget( "MRT_DEPTH_RAYCONF_" + camera_name );
+	m_mrt->bindSurface( 0, m_depth_texture->getBuffer()->getRenderTarget() );
+	m_mrt->bindSurface( 1, m_rayconf_texture->getBuffer()->getRenderTarget() );
+	m_mrt->setAutoUpdated( false );
+
+	// white background, same as depth & rayconf render texture ( label decoded as 0 )
+	m_mrt -> addViewport( m_ogre_camera );
+	m_mrt -> getViewport(0)->setClearEveryFrame( true );
+	m_mrt -> getViewport(0)->setBackgroundColour( Ogre::ColourValue::White );
+	m_mrt -> getViewport(0)->setOverlaysEnabled( false );
+
+	// reuse depth & rayconf frame buffer, label is decoded into segment frame buffer
+	m_mrt_listener = new DepthMRTListener(	m_entity_cache,
+											m_depth_texture,
+											m_rayconf_texture,
+											m_frame_ring->getSlot( 0 )->depth,
+											m_frame_ring->getSlot( 0 )->rayconf,
+											m_use_ideal_segmentation ? m_frame_ring->getSlot( 0 )->segment : NULL,
+											m_capture_state,
+											m_segment_encoding );
+
+	m_mrt -> addListener( m_mrt_listener );
+}
+
+void DepthSensorPlugin::_getIdealSegmentation( const FrameSlot &_slot )
 {
 	int width = m_camera->GetImageWidth();
 	int height = m_camera->GetImageHeight();
@@ -1173,7 +2780,8 @@ void DepthSensorPlugin::_getIdealSegmentation()
 	// save image;
 	common::Image img;
 	cout << "SetFromData" << endl;
-	img.SetFromData( m_segment_buffer, width, height, common::Image::RGB_INT8 );
+	// ids are saved as they are, instance id in R, G, B & class id in alpha
+	img.SetFromData( _slot.segment, width, height, m_segment_encoding == SEGMENT_ENCODING_ID ? common::Image::RGBA_INT8 : common::Image::L_INT8 );
 	cout << "saving image" << endl;
 	img.SavePNG( "test.png" );
 }
@@ -19,12 +19,34 @@
 
 #include <opencv2/core/core.hpp>
 
-#include "ShadowSettings.h"
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+
+#include "WorkerPool.h"
+#include "FrameRing.h"
+#include "StreamMonitor.h"
+#include "RenderTargetLayout.h"
+#include "SharedMemoryRing.h"
+#include "DepthStreamCodec.h"
+#include "AsyncSnapshotWriter.h"
+#include "SnapshotDataset.h"
+#include "/home/kevin/research/gazebo/msgs/include/publication_queue.h"
+#include "PerlinNoiseEngine.h"
+#include "NoiseFieldBank.h"
+#include "SensorNoiseBank.h"
+#include "SensorCalibration.h"
+#include "OcclusionEdgeEroder.h"
+#include "DepthPostProcessKernel.h"
+#include "DepthBilateralFilter.h"
+#include "EntityProxyCache.h"
+#include "CaptureStateGuard.h"
+#include "DepthMaskPass.h"
 
 #include "RGBRTListener.h"
 #include "DepthRTListener.h"
 #include "RayConfRTListener.h"
 #include "SegmentRTListener.h"
+#include "DepthMRTListener.h"
 
 using namespace gazebo;
 
@@ -47,6 +69,9 @@ private:
 	/// \brief Callback that recieves the camera's update signal.
 	virtual void _onUpdatedCallback();
 
+	// callback of world update, pins the physics thread once in isolate_physics mode
+	void _onWorldUpdateBegin();
+
 	void _onlySnapshot( ConstMsgsRequestPtr &_msgs );
 
 	void _takePicture( ConstMsgsRequestPtr &_msgs );
@@ -56,6 +81,12 @@ private:
 	// callback that recieves the preRender event
 	//virtual void _preRenderCallback();
 
+	// load parameters from <plugin> element of sensor SDF
+	void _loadParameters( sdf::ElementPtr _sdf );
+
+	// create worker pool for row tiles of post processing
+	void _setupWorkerPool();
+
 	// load cg plugin
 	void _loadPlugins();
 	// add resources for depth shadow map
@@ -67,14 +98,85 @@ private:
 	// check the number of files in a directory
 	void _check_file_number();
 
-	// save sensor data
-	void _saveSensorData();
+	// FrameOutput bits of the next frame, from <outputs>, the subscribers of every topic & the snapshot writer
+	// a _stream frame never writes rgb_sensor.png, only the cloud is left if _degrade > 0
+	unsigned int _outputDemand( bool _stream, int _degrade );
+
+	// slot for the next stream frame by <stream_backpressure>, NULL if it's dropped, adjusts m_stream_degrade
+	FrameSlot *_acquireStreamSlot();
+
+	// point every render target listener at the buffers of _slot
+	void _bindFrameSlot( FrameSlot &_slot );
+
+	// scene state of a captured frame, on the sensor thread before the scene changes : snapshot numbering, camera image, poses
+	void _captureSceneState( FrameSlot &_slot );
+
+	// process callback of m_frame_ring, _saveSensorData() & timing
+	void _processFrame( FrameSlot &_slot );
+
+	// post process, save & publish a captured frame, on the pipeline thread of m_frame_ring
+	void _saveSensorData( FrameSlot &_slot );
+
+	// perlin noise, depth validation, point cloud extraction & bilateral filter into the cloud of _slot
+	void _extractCloud( FrameSlot &_slot );
 
 	// prepare sensor noise
 	void _prepareSensorNoise();
 
-	// disturb occlusion edge
-	void _disturbOcclusionEdge( unsigned char *_depth_buffer );
+	// sum of perlin noise of _num_octaves grid sizes, sampled from noise bank if possible
+	void _generatePerlinNoise( const int *_grid_sizes, int _num_octaves, float *_noise );
+
+	// depth validation & point cloud extraction from the buffers of _slot, one full image pass per step
+	// perlin noise is taken from the scratch buffers of m_frame_ring
+	void _postProcessReference(	const FrameSlot						&_slot,
+								pcl::PointCloud< pcl::PointXYZ >	&_cloud );
+
+	// same as _postProcessReference() with fused per pixel steps
+	void _postProcessFused(	const FrameSlot						&_slot,
+							pcl::PointCloud< pcl::PointXYZ >	&_cloud );
+
+	// point cloud extraction from the depth / flags buffer of the mask pass, only the occlusion edge is disturbed on the cpu
+	void _postProcessMasked(	const FrameSlot						&_slot,
+								pcl::PointCloud< pcl::PointXYZ >	&_cloud );
+
+	// compare the flags of the mask pass with the cpu fallback ( DepthPostProcessKernel::maskFlags() ) on the same noise
+	void _verifyMaskPass( const FrameSlot &_slot );
+
+	// publish labels, camera image & confidence of _slot on their topics, if the frame has them & somebody subscribes
+	void _publishImages( const FrameSlot &_slot );
+
+	// publish blurred cloud ( & labels ) of _slot as one pcl::msgs::PackedPointCloud payload
+	void _publishPackedCloud( const FrameSlot &_slot );
+
+	// write blurred cloud, labels & rgb of _slot into the shared memory ring, publish only its pcl::msgs::SharedMemoryFrame
+	void _publishSharedMemoryFrame( const FrameSlot &_slot );
+
+	// publish blurred cloud ( & labels ) of _slot as pcl::msgs::CompressedDepthCloud
+	void _publishCompressedCloud( const FrameSlot &_slot );
+
+	// hand _msgs to m_cloud_queue, it waits there if nobody subscribes to the point cloud yet
+	void _publishCloudMessage( const google::protobuf::Message &_msgs );
+
+	// compressed depth stream of blurred cloud ( & labels ) of _slot into _stream
+	void _encodeDepthStream( const FrameSlot &_slot, std::string &_stream );
+
+	// queue png encoding of the camera image of _slot to m_snapshot_writer, the job holds the slot
+	void _saveSnapshotRGB( FrameSlot &_slot, const std::string &_path );
+
+	// queue writing blurred cloud ( & labels ) of _slot to m_snapshot_writer in <snapshot_cloud> format, the job holds the slot
+	void _saveSnapshotCloud( FrameSlot &_slot, const std::string &_path );
+
+	// open ( or resume ) the <snapshot_dataset> file, the next frame number comes from its index
+	void _openSnapshotDataset();
+
+	// queue appending camera image, blurred cloud, labels & ground truth poses of _slot as one record of m_snapshot_dataset
+	void _saveSnapshotRecord( FrameSlot &_slot );
+
+	// wait for every queued snapshot file & publish snapshot_flushed
+	void _finishSnapshotRun();
+
+	// disturb occlusion edge, _invalid_mask is 1 byte per pixel
+	void _disturbOcclusionEdge( unsigned char *_invalid_mask, const float *_noise );
 
 	// gaussian mask generator for blurring process
 	cv::Mat gaussianMaskGenerator( int _mask_size, float _sigma );
@@ -84,7 +186,10 @@ private:
 	void _setupIdealSegmentation();
 
 	// get ideal segmenation
-	void _getIdealSegmentation();
+	void _getIdealSegmentation( const FrameSlot &_slot );
+
+	// setup MultiRenderTarget writing depth, rayconf & label in one pass
+	void _setupMultiRenderTarget();
 
 public:
 private:
@@ -104,19 +209,18 @@ private:
 	// Connection that maintains a link between the render event and DepthSensorPlugin::render() callback
 	//event::ConnectionPtr m_render_connection;
 
+	// Connection to world update begin, only in isolate_physics mode
+	event::ConnectionPtr m_world_update_connection;
+
 	// Ogre SceneManager
 	Ogre::SceneManager *m_scene_mgr;
 	// Ogre Camera
 	Ogre::Camera *m_ogre_camera;
 
-	// instance to save gazebo's shadow settings
-	ShadowSettings m_shadow_settings;
-	// this vector contain lights being turned off by this class
-	vector<Ogre::Light *>	m_turned_off_lights;
-	// this vector contain MovableObject being hidden by depth RT listener
-	vector< Ogre::MovableObject * > m_turned_off_mobj;
-	// this vcetor contain MovableObject being cloned for depth simulator
-	vector< Ogre::Entity * > m_cloned_entity;
+	// gazebo's shadow, light & grid settings, saved & restored once per capture
+	CaptureStateGuard *m_capture_state;
+	// proxies of every model entity for depth, rayconf & segment passes ( live as long as the scene )
+	EntityProxyCache *m_entity_cache;
 
 
 
@@ -127,28 +231,60 @@ private:
 	const std::string SENSOR_IR_PROJECTOR_NAME_PREFIX;
 
 	// RGB render texture
+	Ogre::TexturePtr m_rgb_texture;
 	Ogre::RenderTexture *m_rgb_rt;
 	// RGB render texture listener
 	RGBRTListener *m_rgb_rt_listener;
-	// rgb frame buffer
-	unsigned char *m_rgb_buffer;
 
 	// depth render texture
+	Ogre::TexturePtr m_depth_texture;
 	Ogre::RenderTexture *m_depth_rt;
 	// depth render texture listener
 	DepthRTListener *m_depth_rt_listener;
-	// depth frame buffer
-	float *m_depth_buffer;
 
 	// rayconf render texture
+	Ogre::TexturePtr m_rayconf_texture;
 	Ogre::RenderTexture *m_rayconf_rt;
 	// rayconf render texture listener
 	RayConfRTListener *m_rayconf_rt_listener;
-	// rayconf frame buffer
-	float *m_rayconf_buffer;
 
-	// sensor noise
+	// saturation & confidence masks on the gpu, only its buffer is read back ( NULL if <mask_pass> cpu )
+	DepthMaskPass *m_mask_pass;
+
+	// frame buffers of every render target, frame k + 1 is rendered while frame k is post processed
+	FrameRing *m_frame_ring;
+	// formats of depth & rayconf render targets, how post processing reads their buffers
+	RenderTargetLayout m_rt_layout;
+
+	// persistent threads sharing row tiles of noise, masking, erosion, point cloud & message packing
+	WorkerPool *m_worker_pool;
+	// cpus of worker pool in isolate_physics mode ( empty if not pinned )
+	vector< int > m_worker_cpus;
+	// physics thread & sensor thread are pinned only once
+	bool m_physics_thread_pinned;
+	bool m_sensor_thread_pinned;
+
+	// linear time erosion for _disturbOcclusionEdge()
+	OcclusionEdgeEroder *m_edge_eroder;
+	// fused per pixel steps of _saveSensorData()
+	DepthPostProcessKernel *m_post_process_kernel;
+	// in place bilateral filter of the point cloud
+	DepthBilateralFilter *m_bilateral_filter;
+	// quantized depth stream for compressed messages & snapshots
+	DepthStreamCodec *m_depth_codec;
+
+	// sensor noise of the frame being post processed
 	cv::Mat m_noise;
+	// realizations of sensor noise, m_noise rotates through them ( NULL without noise magnitude )
+	SensorNoiseBank *m_sensor_noise;
+	// mapped calibration file, the noise magnitude is used in place
+	SensorCalibrationReader *m_calibration;
+	// perlin noise generator for saturation, confidence & occlusion edge disturbance
+	PerlinNoiseEngine *m_perlin_engine;
+	// tileable perlin noise fields sampled at random offsets ( NULL if disabled )
+	NoiseFieldBank *m_noise_bank;
+	// noise of the mask pass is drawn on the sensor thread, the rest on the pipeline thread
+	std::mutex m_noise_mutex;
 
 	// transport::Node
 	transport::NodePtr m_node_ptr;
@@ -156,6 +292,17 @@ private:
 	// transport::Publisher for transferring PointCloud of this Sensor
 	transport::PublisherPtr m_publisher_ptr;
 
+	// queue of m_publisher_ptr, the sensor thread never waits for a subscriber
+	PublicationQueue *m_cloud_queue;
+
+	// ring of frames for consumers on the same host ( NULL if not in shm mode )
+	SharedMemoryRingWriter *m_shm_ring;
+
+	// transport::Publisher of gazebo::msgs::Image for "~/depth_sensor/labels", "~/depth_sensor/rgb" & "~/depth_sensor/confidence"
+	transport::PublisherPtr m_labels_publisher_ptr;
+	transport::PublisherPtr m_rgb_publisher_ptr;
+	transport::PublisherPtr m_confidence_publisher_ptr;
+
 	// transport::Publisher for re-throwing objects in evaluation platform
 	transport::PublisherPtr m_rethrow_publisher_ptr;
 
@@ -165,9 +312,26 @@ private:
 	// Subscribe for "~/evaluation_platform/only_snapshot"
 	transport::SubscriberPtr m_snapshot_subscriber_ptr;
 
+	// transport::Publisher for "~/depth_sensor/snapshot_event" ( snapshot_flushed )
+	transport::PublisherPtr m_snapshot_event_publisher_ptr;
+
+	// background png / pcd / depth stream writer of only_snapshot mode
+	AsyncSnapshotWriter *m_snapshot_writer;
+
+	// container of <snapshot_format> dataset, opened with the first snapshot
+	SnapshotDatasetWriter *m_snapshot_dataset;
+
 
 	// take picture switch
 	bool m_take_picture;
+	// sequence number of the next capture
+	uint64_t m_sequence;
+	// backpressure level of <stream_backpressure> degrade, 0 : every output, 1 : only the cloud, 2 : also without bilateral filter
+	int m_stream_degrade;
+	// stream frames captured since the last drop, the level goes down after one second of them
+	int m_stream_on_time;
+	// fps, latency & drops of stream mode
+	StreamMonitor *m_stream_monitor;
 	// snapshot_switch
 	bool m_snapshot = false;
 
@@ -176,9 +340,10 @@ private:
 	int m_total_snapshot;
 	std::ostringstream ss;
 	std::string save_string;
-	int m_save_file_number;
 	// for checking file number
 	int m_current_file_number = 0;
+	// directory is only scanned once
+	bool m_file_number_checked = false;
 
 	float m_msgs[19] = {0};
 
@@ -189,13 +354,140 @@ private:
 	Ogre::RenderTexture *m_segment_rt;
 	// rayconf render texture listener
 	SegmentRTListener *m_segment_rt_listener;
-	// rayconf frame buffer
-	unsigned char *m_segment_buffer;
+
+	// ************************** //
+	// for multiple render target //
+	// ************************** //
+	// depth & rayconf textures bound as one render target
+	Ogre::MultiRenderTarget *m_mrt;
+	// MultiRenderTarget listener
+	DepthMRTListener *m_mrt_listener;
 
 	// ********** //
 	// parameters //
 	// ********** //
 	bool m_use_ideal_segmentation;
+
+	// <outputs> FrameOutput bits of every frame, topics add theirs while somebody subscribes
+	unsigned int m_outputs;
+
+	enum CaptureMode
+	{
+		CAPTURE_SEQUENTIAL,		// rgb, depth, rayconf & segment are rendered one by one
+		CAPTURE_MRT				// rgb, then depth + rayconf + label in one MultiRenderTarget pass
+	};
+	// <capture_mode> sequential / mrt
+	CaptureMode m_capture_mode;
+	// <segment_encoding> grey / id, labels of the segment buffer ( see ModelLabelTable.h )
+	SegmentEncoding m_segment_encoding;
+	// <depth_format> rgba32f / r32f, depth render target ( see RenderTargetLayout.h )
+	DepthFormat m_depth_format;
+	// <rayconf_format> xyzc32f / c32f / c16f, rayconf render target, xyz is reconstructed from depth without xyz
+	RayConfFormat m_rayconf_format;
+	// <noise_seed> seed of perlin noise, random if negative
+	int m_noise_seed;
+	// <noise_bank_mb> memory budget of noise bank, 0 to generate perlin noise every frame
+	int m_noise_bank_mb;
+	// <noise_realizations> realizations of sensor noise, frames rotate through them
+	int m_noise_realizations;
+	// <noise_refresh_period> seconds between new realizations replacing the oldest one, 0 to keep them ( random noise_seed only )
+	double m_noise_refresh_period;
+	// <noise_cache_dir> realizations are cached here by resolution & magnitude checksum, empty for no cache
+	std::string m_noise_cache_dir;
+	// <calibration_file> sensor calibration tables ( see sensor_calibration ), model:// & resource paths are searched
+	std::string m_calibration_file;
+
+	enum PostProcessMode
+	{
+		POST_PROCESS_FUSED,			// DepthPostProcessKernel
+		POST_PROCESS_REFERENCE,		// one full image pass per step
+		POST_PROCESS_VERIFY			// fused, then compare with reference every frame
+	};
+	// <post_process> fused / reference / verify
+	PostProcessMode m_post_process_mode;
+
+	enum MaskPassMode
+	{
+		MASK_PASS_CPU,		// depth, rayconf & rgb are read back & masked by post process
+		MASK_PASS_GPU		// DepthMaskPass, only its depth / flags buffer is read back
+	};
+	// <mask_pass> cpu / gpu
+	MaskPassMode m_mask_pass_mode;
+
+	// <worker_threads> threads of worker pool besides the sensor thread, 0 for auto
+	int m_worker_threads;
+
+	enum WorkerAffinity
+	{
+		AFFINITY_NONE,				// let the os schedule every thread
+		AFFINITY_ISOLATE_PHYSICS	// physics thread on <physics_cpu>, workers & sensor thread on the others
+	};
+	// <worker_affinity> none / isolate_physics
+	WorkerAffinity m_worker_affinity;
+	// <physics_cpu> cpu reserved for the physics thread
+	int m_physics_cpu;
+
+	enum CloudMessage
+	{
+		CLOUD_MESSAGE_PACKED,		// pcl::msgs::PackedPointCloud, one bytes payload
+		CLOUD_MESSAGE_LEGACY,		// pcl::msgs::PointCloud( XYZL ), one sub-message per point
+		CLOUD_MESSAGE_SHM,			// frames in shared memory ring, pcl::msgs::SharedMemoryFrame on topic
+		CLOUD_MESSAGE_COMPRESSED	// pcl::msgs::CompressedDepthCloud, quantized depth & intrinsics
+	};
+	// <cloud_message> packed / legacy / shm / compressed
+	CloudMessage m_cloud_message;
+	// <shm_name> name of shared memory ring
+	std::string m_shm_name;
+	// <shm_slots> number of frames in shared memory ring
+	int m_shm_slots;
+	// <depth_step_mm> finest quantization step of compressed depth
+	float m_depth_step_mm;
+
+	enum SnapshotCloud
+	{
+		SNAPSHOT_CLOUD_NONE,		// only rgb
+		SNAPSHOT_CLOUD_PCD,			// binary pcd
+		SNAPSHOT_CLOUD_COMPRESSED	// DepthStreamCodec stream
+	};
+	// <snapshot_cloud> none / pcd / compressed, point cloud saved in only_snapshot mode
+	SnapshotCloud m_snapshot_cloud;
+	// <snapshot_writer_threads> threads encoding snapshot files, 0 to write on the sensor thread
+	int m_snapshot_writer_threads;
+	// <snapshot_queue_size> snapshot files waiting to be written
+	int m_snapshot_queue_size;
+	// <snapshot_queue_policy> block / drop when the queue is full
+	AsyncSnapshotWriter::Policy m_snapshot_queue_policy;
+
+	enum SnapshotFormat
+	{
+		SNAPSHOT_FORMAT_FILES,		// only_snapshot/rgb/rgb_N.png ( & pcd / depth ) per frame
+		SNAPSHOT_FORMAT_DATASET		// one record per frame in <snapshot_dataset>
+	};
+	// <snapshot_format> files / dataset
+	SnapshotFormat m_snapshot_format;
+	// <snapshot_dataset> path of the dataset file
+	std::string m_snapshot_dataset_path;
+	// <publish_queue_depth> point clouds kept while nobody subscribes
+	int m_publish_queue_depth;
+	// <frame_slots> frames in m_frame_ring, 1 to post process on the sensor thread
+	int m_frame_slots;
+
+	enum CaptureTrigger
+	{
+		CAPTURE_TRIGGER_REQUEST,	// one frame per take_picture_request
+		CAPTURE_TRIGGER_STREAM		// one frame per sensor update at <update_rate>, except in only_snapshot mode
+	};
+	// <capture_trigger> request / stream
+	CaptureTrigger m_capture_trigger;
+
+	enum StreamBackpressure
+	{
+		BACKPRESSURE_BLOCK,		// wait for a free slot, the sensor update is delayed
+		BACKPRESSURE_DROP,		// drop the frame while every slot is post processed or published
+		BACKPRESSURE_DEGRADE	// drop, then leave out outputs & the bilateral filter until post processing keeps up
+	};
+	// <stream_backpressure> block / drop / degrade, when post processing falls behind the stream
+	StreamBackpressure m_stream_backpressure;
 };
 
 // Register this plugin with the simulator
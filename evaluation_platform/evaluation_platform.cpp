@@ -70,6 +70,11 @@ void EvaluationPlatform::Load(physics::WorldPtr _world, sdf::ElementPtr /*_sdf*/
 
 	m_snapshot_publisher_ptr = m_node_ptr->Advertise< gazebo::msgs::Request >( "~/evaluation_platform/only_snapshot" );
 
+	m_take_picture_queue.reset( new PublicationQueue( m_publisher_ptr, m_publish_queue_depth ) );
+	m_resimulate_queue.reset( new PublicationQueue( m_resimulate_publisher_ptr, m_publish_queue_depth ) );
+	m_snapshot_queue.reset( new PublicationQueue( m_snapshot_publisher_ptr, m_publish_queue_depth ) );
+	this->m_publication_connection = event::Events::ConnectWorldUpdateBegin( boost::bind( &EvaluationPlatform::_flushPublications, this, _1 ) );
+
 	// ************************************ //
 	// setup connection with pose estimator //
 	// ************************************ //
@@ -87,6 +92,19 @@ void EvaluationPlatform::Load(physics::WorldPtr _world, sdf::ElementPtr /*_sdf*/
 	cout << COUT_PREFIX << "Seed : " << gazebo::math::Rand::GetSeed() << endl;
 }
 
+void EvaluationPlatform::_flushPublications( const common::UpdateInfo & /*_info*/ )
+{
+	// checked every world update, flush() returns at once when nothing is queued
+	boost::shared_ptr< PublicationQueue > queues[] = { m_take_picture_queue, m_resimulate_queue, m_snapshot_queue };
+	for( unsigned int i = 0; i < sizeof( queues ) / sizeof( queues[0] ); i++ )
+	{
+		if( queues[i] && queues[i]->flush() > 0 )
+		{
+			cout << COUT_PREFIX << "delivered queued requests, " << queues[i]->getSummary() << endl;
+		}
+	}
+}
+
 void EvaluationPlatform::_onUpdate( const common::UpdateInfo & /*_info*/ )
 {
 	// steady counter
@@ -217,13 +235,11 @@ void EvaluationPlatform::_onUpdate( const common::UpdateInfo & /*_info*/ )
 			take_pic_request.set_id( 0 );
 			take_pic_request.set_request( "take_one_picture" );
 
-			while( !m_publisher_ptr->HasConnections() )
+			cout << COUT_PREFIX << "Take one shot request." << endl;
+			if( !m_take_picture_queue->publish( take_pic_request ) )
 			{
-				cout << COUT_PREFIX << "\033[1;31m" << "have no depth sensor connected!" << "\033[0m" << endl;
-				gazebo::common::Time::MSleep( 10 );
+				cout << COUT_PREFIX << "\033[1;31m" << "have no depth sensor connected! request queued" << "\033[0m" << endl;
 			}
-			cout << COUT_PREFIX << "Take one shot request." << endl;
-			m_publisher_ptr->Publish( take_pic_request );
 
 			// for only snapshot mode //
 			if(m_snapshot_mode==1)
@@ -247,7 +263,7 @@ void EvaluationPlatform::_onUpdate( const common::UpdateInfo & /*_info*/ )
 				//std::cout << "total messges : " << ss.str() << std::endl;
 				only_snapshot.set_request( "onlysnapshot_mode" );
 				only_snapshot.set_data(ss.str());
-				m_snapshot_publisher_ptr->Publish( only_snapshot );
+				m_snapshot_queue->publish( only_snapshot );
 			}
 
 			// ****************************************************** //
@@ -680,13 +696,11 @@ void EvaluationPlatform::_receiveResult( ConstMsgsPoseEstimationResultPtr &_msg
 			resimulate_request.set_id( 0 );
 			resimulate_request.set_request( "resimulate" );
 
-			while( !m_resimulate_publisher_ptr->HasConnections() )
+			cout << COUT_PREFIX << "Resimulate request..." << endl;
+			if( !m_resimulate_queue->publish( resimulate_request ) )
 			{
-				cout << COUT_PREFIX << "\033[1;31m" << "no connection to resimulate request!" << "\033[0m" << endl;
-				gazebo::common::Time::MSleep( 10 );
+				cout << COUT_PREFIX << "\033[1;31m" << "no connection to resimulate request! request queued" << "\033[0m" << endl;
 			}
-			cout << COUT_PREFIX << "Resimulate request..." << endl;
-			m_resimulate_publisher_ptr->Publish( resimulate_request );
 
 
 			// fake all models are estimated, so the simulation will restart
@@ -1337,6 +1351,7 @@ void EvaluationPlatform::_initParameters( const std::string &_filename )
 
         // read attributes parameters
         m_resimulate_after_fail = pt.get< bool >( "evaluation_platform.attribute.resimulate_after_fail", false );
+        m_publish_queue_depth = pt.get< int >( "evaluation_platform.attribute.publish_queue_depth", 4 );
 
         // ************************ //
         // read snapshot parameters //
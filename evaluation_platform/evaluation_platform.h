@@ -13,6 +13,7 @@
 #include <gazebo/gazebo.hh>
 
 #include "/home/kevin/research/gazebo/msgs/include/pose_estimation_result.pb.h"
+#include "/home/kevin/research/gazebo/msgs/include/publication_queue.h"
 
 #include "evaluation_criteria.h"
 
@@ -31,6 +32,8 @@ public:
 
 private:
 	void _onUpdate( const common::UpdateInfo & /*_info*/ );
+	// publish requests queued while their topic had no subscriber, connected for the whole run
+	void _flushPublications( const common::UpdateInfo & /*_info*/ );
 	// callback function of algorithm's result
 	void _receiveResult( ConstMsgsPoseEstimationResultPtr &_msg );
 
@@ -60,6 +63,9 @@ private:
     // Pointer to the update event connection
     event::ConnectionPtr m_update_connection;
 
+    // connection of _flushPublications, never disconnected
+    event::ConnectionPtr m_publication_connection;
+
     // contain the name of every target models
     std::vector< std::string > m_models_name;
 
@@ -90,6 +96,11 @@ private:
 	// transport::Publisher for only snapshot
 	transport::PublisherPtr m_snapshot_publisher_ptr;
 
+	// queues of m_publisher_ptr, m_resimulate_publisher_ptr & m_snapshot_publisher_ptr, update threads never wait for subscribers
+	boost::shared_ptr< PublicationQueue > m_take_picture_queue;
+	boost::shared_ptr< PublicationQueue > m_resimulate_queue;
+	boost::shared_ptr< PublicationQueue > m_snapshot_queue;
+
 	// transport::Subscriber to subscribe pose estimation result message
 	transport::SubscriberPtr m_subscriber_ptr;
 
@@ -103,6 +114,8 @@ private:
 	// parameters - evaluation attributes //
 	// ********************************** //
 	bool m_resimulate_after_fail;
+	// requests kept per topic while nobody subscribes
+	int m_publish_queue_depth;
 
 	// ****************************************************** //
 	// parameters - evaluation attributes for multiple models //
@@ -13,6 +13,7 @@
 #include <gazebo/gazebo.hh>
 
 #include "/home/kevin/research/gazebo/msgs/include/pose_estimation_result.pb.h"
+#include "/home/kevin/research/gazebo/msgs/include/publication_queue.h"
 
 #include "evaluation_criteria.h"
 
@@ -33,6 +34,8 @@ public:
 private:
 	void DummyUpdate( const common::UpdateInfo & /*_info*/ );
 	void _onUpdate( const common::UpdateInfo & /*_info*/ );
+	// publish requests queued while their topic had no subscriber, connected for the whole run
+	void _flushPublications( const common::UpdateInfo & /*_info*/ );
 	// callback function of algorithm's result
 	void _receiveResult( ConstMsgsPoseEstimationResultPtr &_msg );
 
@@ -59,6 +62,9 @@ private:
     // Pointer to the update event connection
     event::ConnectionPtr m_update_connection;
 
+    // connection of _flushPublications, never disconnected
+    event::ConnectionPtr m_publication_connection;
+
     // contain the name of evey target models
     std::vector< std::string > m_models_name;
 
@@ -83,6 +89,10 @@ private:
 	// transport::Publisher for evaluation result
 	transport::PublisherPtr m_evaluation_result_publisher_ptr;
 
+	// queues of m_publisher_ptr & m_resimulate_publisher_ptr, update threads never wait for subscribers
+	boost::shared_ptr< PublicationQueue > m_take_picture_queue;
+	boost::shared_ptr< PublicationQueue > m_resimulate_queue;
+
 	// transport::Subscriber to subscribe pose estimation result message
 	transport::SubscriberPtr m_subscriber_ptr;
 
@@ -93,6 +103,8 @@ private:
 	// parameters - evaluation attributes //
 	// ********************************** //
 	bool m_resimulate_after_fail;
+	// requests kept per topic while nobody subscribes
+	int m_publish_queue_depth;
 
 	// ****************************************************** //
 	// parameters - evaluation attributes for multiple models //
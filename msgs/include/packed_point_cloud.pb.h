@@ -0,0 +1,727 @@
+// Generated by the protocol buffer compiler.  DO NOT EDIT!
+// source: packed_point_cloud.proto
+
+#ifndef PROTOBUF_packed_5fpoint_5fcloud_2eproto__INCLUDED
+#define PROTOBUF_packed_5fpoint_5fcloud_2eproto__INCLUDED
+
+#include <string>
+
+#include <google/protobuf/stubs/common.h>
+
+#if GOOGLE_PROTOBUF_VERSION < 2005000
+#error This file was generated by a newer version of protoc which is
+#error incompatible with your Protocol Buffer headers.  Please update
+#error your headers.
+#endif
+#if 2005000 < GOOGLE_PROTOBUF_MIN_PROTOC_VERSION
+#error This file was generated by an older version of protoc which is
+#error incompatible with your Protocol Buffer headers.  Please
+#error regenerate this file with a newer version of protoc.
+#endif
+
+#include <google/protobuf/generated_message_util.h>
+#include <google/protobuf/message.h>
+#include <google/protobuf/repeated_field.h>
+#include <google/protobuf/extension_set.h>
+#include <google/protobuf/generated_enum_reflection.h>
+#include <google/protobuf/unknown_field_set.h>
+// @@protoc_insertion_point(includes)
+
+namespace pcl {
+namespace msgs {
+
+// Internal implementation detail -- do not call these.
+void  protobuf_AddDesc_packed_5fpoint_5fcloud_2eproto();
+void protobuf_AssignDesc_packed_5fpoint_5fcloud_2eproto();
+void protobuf_ShutdownFile_packed_5fpoint_5fcloud_2eproto();
+
+class PackedPointCloud;
+class PackedPointCloud_Field;
+
+enum PackedPointCloud_Field_DataType {
+  PackedPointCloud_Field_DataType_FLOAT32 = 1,
+  PackedPointCloud_Field_DataType_UINT32 = 2
+};
+bool PackedPointCloud_Field_DataType_IsValid(int value);
+const PackedPointCloud_Field_DataType PackedPointCloud_Field_DataType_DataType_MIN = PackedPointCloud_Field_DataType_FLOAT32;
+const PackedPointCloud_Field_DataType PackedPointCloud_Field_DataType_DataType_MAX = PackedPointCloud_Field_DataType_UINT32;
+const int PackedPointCloud_Field_DataType_DataType_ARRAYSIZE = PackedPointCloud_Field_DataType_DataType_MAX + 1;
+
+const ::google::protobuf::EnumDescriptor* PackedPointCloud_Field_DataType_descriptor();
+inline const ::std::string& PackedPointCloud_Field_DataType_Name(PackedPointCloud_Field_DataType value) {
+  return ::google::protobuf::internal::NameOfEnum(
+    PackedPointCloud_Field_DataType_descriptor(), value);
+}
+inline bool PackedPointCloud_Field_DataType_Parse(
+    const ::std::string& name, PackedPointCloud_Field_DataType* value) {
+  return ::google::protobuf::internal::ParseNamedEnum<PackedPointCloud_Field_DataType>(
+    PackedPointCloud_Field_DataType_descriptor(), name, value);
+}
+// ===================================================================
+
+class PackedPointCloud_Field : public ::google::protobuf::Message {
+ public:
+  PackedPointCloud_Field();
+  virtual ~PackedPointCloud_Field();
+
+  PackedPointCloud_Field(const PackedPointCloud_Field& from);
+
+  inline PackedPointCloud_Field& operator=(const PackedPointCloud_Field& from) {
+    CopyFrom(from);
+    return *this;
+  }
+
+  inline const ::google::protobuf::UnknownFieldSet& unknown_fields() const {
+    return _unknown_fields_;
+  }
+
+  inline ::google::protobuf::UnknownFieldSet* mutable_unknown_fields() {
+    return &_unknown_fields_;
+  }
+
+  static const ::google::protobuf::Descriptor* descriptor();
+  static const PackedPointCloud_Field& default_instance();
+
+  void Swap(PackedPointCloud_Field* other);
+
+  // implements Message ----------------------------------------------
+
+  PackedPointCloud_Field* New() const;
+  void CopyFrom(const ::google::protobuf::Message& from);
+  void MergeFrom(const ::google::protobuf::Message& from);
+  void CopyFrom(const PackedPointCloud_Field& from);
+  void MergeFrom(const PackedPointCloud_Field& from);
+  void Clear();
+  bool IsInitialized() const;
+
+  int ByteSize() const;
+  bool MergePartialFromCodedStream(
+      ::google::protobuf::io::CodedInputStream* input);
+  void SerializeWithCachedSizes(
+      ::google::protobuf::io::CodedOutputStream* output) const;
+  ::google::protobuf::uint8* SerializeWithCachedSizesToArray(::google::protobuf::uint8* output) const;
+  int GetCachedSize() const { return _cached_size_; }
+  private:
+  void SharedCtor();
+  void SharedDtor();
+  void SetCachedSize(int size) const;
+  public:
+
+  ::google::protobuf::Metadata GetMetadata() const;
+
+  // nested types ----------------------------------------------------
+
+  typedef PackedPointCloud_Field_DataType DataType;
+  static const DataType FLOAT32 = PackedPointCloud_Field_DataType_FLOAT32;
+  static const DataType UINT32 = PackedPointCloud_Field_DataType_UINT32;
+  static inline bool DataType_IsValid(int value) {
+    return PackedPointCloud_Field_DataType_IsValid(value);
+  }
+  static const DataType DataType_MIN =
+    PackedPointCloud_Field_DataType_DataType_MIN;
+  static const DataType DataType_MAX =
+    PackedPointCloud_Field_DataType_DataType_MAX;
+  static const int DataType_ARRAYSIZE =
+    PackedPointCloud_Field_DataType_DataType_ARRAYSIZE;
+  static inline const ::google::protobuf::EnumDescriptor*
+  DataType_descriptor() {
+    return PackedPointCloud_Field_DataType_descriptor();
+  }
+  static inline const ::std::string& DataType_Name(DataType name) {
+    return PackedPointCloud_Field_DataType_Name(name);
+  }
+  static inline bool DataType_Parse(const ::std::string& name,
+      DataType* value) {
+    return PackedPointCloud_Field_DataType_Parse(name, value);
+  }
+
+  // accessors -------------------------------------------------------
+
+  // required string name = 1;
+  inline bool has_name() const;
+  inline void clear_name();
+  static const int kNameFieldNumber = 1;
+  inline const ::std::string& name() const;
+  inline void set_name(const ::std::string& value);
+  inline void set_name(const char* value);
+  inline void set_name(const char* value, size_t size);
+  inline ::std::string* mutable_name();
+  inline ::std::string* release_name();
+  inline void set_allocated_name(::std::string* name);
+
+  // required uint32 offset = 2;
+  inline bool has_offset() const;
+  inline void clear_offset();
+  static const int kOffsetFieldNumber = 2;
+  inline ::google::protobuf::uint32 offset() const;
+  inline void set_offset(::google::protobuf::uint32 value);
+
+  // required .pcl.msgs.PackedPointCloud.Field.DataType datatype = 3;
+  inline bool has_datatype() const;
+  inline void clear_datatype();
+  static const int kDatatypeFieldNumber = 3;
+  inline ::pcl::msgs::PackedPointCloud_Field_DataType datatype() const;
+  inline void set_datatype(::pcl::msgs::PackedPointCloud_Field_DataType value);
+
+  // @@protoc_insertion_point(class_scope:pcl.msgs.PackedPointCloud.Field)
+ private:
+  inline void set_has_name();
+  inline void clear_has_name();
+  inline void set_has_offset();
+  inline void clear_has_offset();
+  inline void set_has_datatype();
+  inline void clear_has_datatype();
+
+  ::google::protobuf::UnknownFieldSet _unknown_fields_;
+
+  ::std::string* name_;
+  ::google::protobuf::uint32 offset_;
+  int datatype_;
+
+  mutable int _cached_size_;
+  ::google::protobuf::uint32 _has_bits_[(3 + 31) / 32];
+
+  friend void  protobuf_AddDesc_packed_5fpoint_5fcloud_2eproto();
+  friend void protobuf_AssignDesc_packed_5fpoint_5fcloud_2eproto();
+  friend void protobuf_ShutdownFile_packed_5fpoint_5fcloud_2eproto();
+
+  void InitAsDefaultInstance();
+  static PackedPointCloud_Field* default_instance_;
+};
+// -------------------------------------------------------------------
+
+class PackedPointCloud : public ::google::protobuf::Message {
+ public:
+  PackedPointCloud();
+  virtual ~PackedPointCloud();
+
+  PackedPointCloud(const PackedPointCloud& from);
+
+  inline PackedPointCloud& operator=(const PackedPointCloud& from) {
+    CopyFrom(from);
+    return *this;
+  }
+
+  inline const ::google::protobuf::UnknownFieldSet& unknown_fields() const {
+    return _unknown_fields_;
+  }
+
+  inline ::google::protobuf::UnknownFieldSet* mutable_unknown_fields() {
+    return &_unknown_fields_;
+  }
+
+  static const ::google::protobuf::Descriptor* descriptor();
+  static const PackedPointCloud& default_instance();
+
+  void Swap(PackedPointCloud* other);
+
+  // implements Message ----------------------------------------------
+
+  PackedPointCloud* New() const;
+  void CopyFrom(const ::google::protobuf::Message& from);
+  void MergeFrom(const ::google::protobuf::Message& from);
+  void CopyFrom(const PackedPointCloud& from);
+  void MergeFrom(const PackedPointCloud& from);
+  void Clear();
+  bool IsInitialized() const;
+
+  int ByteSize() const;
+  bool MergePartialFromCodedStream(
+      ::google::protobuf::io::CodedInputStream* input);
+  void SerializeWithCachedSizes(
+      ::google::protobuf::io::CodedOutputStream* output) const;
+  ::google::protobuf::uint8* SerializeWithCachedSizesToArray(::google::protobuf::uint8* output) const;
+  int GetCachedSize() const { return _cached_size_; }
+  private:
+  void SharedCtor();
+  void SharedDtor();
+  void SetCachedSize(int size) const;
+  public:
+
+  ::google::protobuf::Metadata GetMetadata() const;
+
+  // nested types ----------------------------------------------------
+
+  typedef PackedPointCloud_Field Field;
+
+  // accessors -------------------------------------------------------
+
+  // required uint32 width = 1;
+  inline bool has_width() const;
+  inline void clear_width();
+  static const int kWidthFieldNumber = 1;
+  inline ::google::protobuf::uint32 width() const;
+  inline void set_width(::google::protobuf::uint32 value);
+
+  // required uint32 height = 2;
+  inline bool has_height() const;
+  inline void clear_height();
+  static const int kHeightFieldNumber = 2;
+  inline ::google::protobuf::uint32 height() const;
+  inline void set_height(::google::protobuf::uint32 value);
+
+  // required bool is_dense = 3;
+  inline bool has_is_dense() const;
+  inline void clear_is_dense();
+  static const int kIsDenseFieldNumber = 3;
+  inline bool is_dense() const;
+  inline void set_is_dense(bool value);
+
+  // repeated .pcl.msgs.PackedPointCloud.Field fields = 4;
+  inline int fields_size() const;
+  inline void clear_fields();
+  static const int kFieldsFieldNumber = 4;
+  inline const ::pcl::msgs::PackedPointCloud_Field& fields(int index) const;
+  inline ::pcl::msgs::PackedPointCloud_Field* mutable_fields(int index);
+  inline ::pcl::msgs::PackedPointCloud_Field* add_fields();
+  inline const ::google::protobuf::RepeatedPtrField< ::pcl::msgs::PackedPointCloud_Field >&
+      fields() const;
+  inline ::google::protobuf::RepeatedPtrField< ::pcl::msgs::PackedPointCloud_Field >*
+      mutable_fields();
+
+  // required uint32 point_step = 5;
+  inline bool has_point_step() const;
+  inline void clear_point_step();
+  static const int kPointStepFieldNumber = 5;
+  inline ::google::protobuf::uint32 point_step() const;
+  inline void set_point_step(::google::protobuf::uint32 value);
+
+  // required bytes data = 6;
+  inline bool has_data() const;
+  inline void clear_data();
+  static const int kDataFieldNumber = 6;
+  inline const ::std::string& data() const;
+  inline void set_data(const ::std::string& value);
+  inline void set_data(const char* value);
+  inline void set_data(const void* value, size_t size);
+  inline ::std::string* mutable_data();
+  inline ::std::string* release_data();
+  inline void set_allocated_data(::std::string* data);
+
+  // optional uint64 sequence = 7;
+  inline bool has_sequence() const;
+  inline void clear_sequence();
+  static const int kSequenceFieldNumber = 7;
+  inline ::google::protobuf::uint64 sequence() const;
+  inline void set_sequence(::google::protobuf::uint64 value);
+
+  // optional double sim_time = 8;
+  inline bool has_sim_time() const;
+  inline void clear_sim_time();
+  static const int kSimTimeFieldNumber = 8;
+  inline double sim_time() const;
+  inline void set_sim_time(double value);
+
+  // @@protoc_insertion_point(class_scope:pcl.msgs.PackedPointCloud)
+ private:
+  inline void set_has_width();
+  inline void clear_has_width();
+  inline void set_has_height();
+  inline void clear_has_height();
+  inline void set_has_is_dense();
+  inline void clear_has_is_dense();
+  inline void set_has_point_step();
+  inline void clear_has_point_step();
+  inline void set_has_data();
+  inline void clear_has_data();
+  inline void set_has_sequence();
+  inline void clear_has_sequence();
+  inline void set_has_sim_time();
+  inline void clear_has_sim_time();
+
+  ::google::protobuf::UnknownFieldSet _unknown_fields_;
+
+  ::google::protobuf::uint32 width_;
+  ::google::protobuf::uint32 height_;
+  ::google::protobuf::RepeatedPtrField< ::pcl::msgs::PackedPointCloud_Field > fields_;
+  bool is_dense_;
+  ::google::protobuf::uint32 point_step_;
+  ::std::string* data_;
+  ::google::protobuf::uint64 sequence_;
+  double sim_time_;
+
+  mutable int _cached_size_;
+  ::google::protobuf::uint32 _has_bits_[(8 + 31) / 32];
+
+  friend void  protobuf_AddDesc_packed_5fpoint_5fcloud_2eproto();
+  friend void protobuf_AssignDesc_packed_5fpoint_5fcloud_2eproto();
+  friend void protobuf_ShutdownFile_packed_5fpoint_5fcloud_2eproto();
+
+  void InitAsDefaultInstance();
+  static PackedPointCloud* default_instance_;
+};
+// ===================================================================
+
+
+// ===================================================================
+
+// PackedPointCloud_Field
+
+// required string name = 1;
+inline bool PackedPointCloud_Field::has_name() const {
+  return (_has_bits_[0] & 0x00000001u) != 0;
+}
+inline void PackedPointCloud_Field::set_has_name() {
+  _has_bits_[0] |= 0x00000001u;
+}
+inline void PackedPointCloud_Field::clear_has_name() {
+  _has_bits_[0] &= ~0x00000001u;
+}
+inline void PackedPointCloud_Field::clear_name() {
+  if (name_ != &::google::protobuf::internal::kEmptyString) {
+    name_->clear();
+  }
+  clear_has_name();
+}
+inline const ::std::string& PackedPointCloud_Field::name() const {
+  return *name_;
+}
+inline void PackedPointCloud_Field::set_name(const ::std::string& value) {
+  set_has_name();
+  if (name_ == &::google::protobuf::internal::kEmptyString) {
+    name_ = new ::std::string;
+  }
+  name_->assign(value);
+}
+inline void PackedPointCloud_Field::set_name(const char* value) {
+  set_has_name();
+  if (name_ == &::google::protobuf::internal::kEmptyString) {
+    name_ = new ::std::string;
+  }
+  name_->assign(value);
+}
+inline void PackedPointCloud_Field::set_name(const char* value, size_t size) {
+  set_has_name();
+  if (name_ == &::google::protobuf::internal::kEmptyString) {
+    name_ = new ::std::string;
+  }
+  name_->assign(reinterpret_cast<const char*>(value), size);
+}
+inline ::std::string* PackedPointCloud_Field::mutable_name() {
+  set_has_name();
+  if (name_ == &::google::protobuf::internal::kEmptyString) {
+    name_ = new ::std::string;
+  }
+  return name_;
+}
+inline ::std::string* PackedPointCloud_Field::release_name() {
+  clear_has_name();
+  if (name_ == &::google::protobuf::internal::kEmptyString) {
+    return NULL;
+  } else {
+    ::std::string* temp = name_;
+    name_ = const_cast< ::std::string*>(&::google::protobuf::internal::kEmptyString);
+    return temp;
+  }
+}
+inline void PackedPointCloud_Field::set_allocated_name(::std::string* name) {
+  if (name_ != &::google::protobuf::internal::kEmptyString) {
+    delete name_;
+  }
+  if (name) {
+    set_has_name();
+    name_ = name;
+  } else {
+    clear_has_name();
+    name_ = const_cast< ::std::string*>(&::google::protobuf::internal::kEmptyString);
+  }
+}
+
+// required uint32 offset = 2;
+inline bool PackedPointCloud_Field::has_offset() const {
+  return (_has_bits_[0] & 0x00000002u) != 0;
+}
+inline void PackedPointCloud_Field::set_has_offset() {
+  _has_bits_[0] |= 0x00000002u;
+}
+inline void PackedPointCloud_Field::clear_has_offset() {
+  _has_bits_[0] &= ~0x00000002u;
+}
+inline void PackedPointCloud_Field::clear_offset() {
+  offset_ = 0u;
+  clear_has_offset();
+}
+inline ::google::protobuf::uint32 PackedPointCloud_Field::offset() const {
+  return offset_;
+}
+inline void PackedPointCloud_Field::set_offset(::google::protobuf::uint32 value) {
+  set_has_offset();
+  offset_ = value;
+}
+
+// required .pcl.msgs.PackedPointCloud.Field.DataType datatype = 3;
+inline bool PackedPointCloud_Field::has_datatype() const {
+  return (_has_bits_[0] & 0x00000004u) != 0;
+}
+inline void PackedPointCloud_Field::set_has_datatype() {
+  _has_bits_[0] |= 0x00000004u;
+}
+inline void PackedPointCloud_Field::clear_has_datatype() {
+  _has_bits_[0] &= ~0x00000004u;
+}
+inline void PackedPointCloud_Field::clear_datatype() {
+  datatype_ = 1;
+  clear_has_datatype();
+}
+inline ::pcl::msgs::PackedPointCloud_Field_DataType PackedPointCloud_Field::datatype() const {
+  return static_cast< ::pcl::msgs::PackedPointCloud_Field_DataType >(datatype_);
+}
+inline void PackedPointCloud_Field::set_datatype(::pcl::msgs::PackedPointCloud_Field_DataType value) {
+  assert(::pcl::msgs::PackedPointCloud_Field_DataType_IsValid(value));
+  set_has_datatype();
+  datatype_ = value;
+}
+
+// -------------------------------------------------------------------
+
+// PackedPointCloud
+
+// required uint32 width = 1;
+inline bool PackedPointCloud::has_width() const {
+  return (_has_bits_[0] & 0x00000001u) != 0;
+}
+inline void PackedPointCloud::set_has_width() {
+  _has_bits_[0] |= 0x00000001u;
+}
+inline void PackedPointCloud::clear_has_width() {
+  _has_bits_[0] &= ~0x00000001u;
+}
+inline void PackedPointCloud::clear_width() {
+  width_ = 0u;
+  clear_has_width();
+}
+inline ::google::protobuf::uint32 PackedPointCloud::width() const {
+  return width_;
+}
+inline void PackedPointCloud::set_width(::google::protobuf::uint32 value) {
+  set_has_width();
+  width_ = value;
+}
+
+// required uint32 height = 2;
+inline bool PackedPointCloud::has_height() const {
+  return (_has_bits_[0] & 0x00000002u) != 0;
+}
+inline void PackedPointCloud::set_has_height() {
+  _has_bits_[0] |= 0x00000002u;
+}
+inline void PackedPointCloud::clear_has_height() {
+  _has_bits_[0] &= ~0x00000002u;
+}
+inline void PackedPointCloud::clear_height() {
+  height_ = 0u;
+  clear_has_height();
+}
+inline ::google::protobuf::uint32 PackedPointCloud::height() const {
+  return height_;
+}
+inline void PackedPointCloud::set_height(::google::protobuf::uint32 value) {
+  set_has_height();
+  height_ = value;
+}
+
+// required bool is_dense = 3;
+inline bool PackedPointCloud::has_is_dense() const {
+  return (_has_bits_[0] & 0x00000004u) != 0;
+}
+inline void PackedPointCloud::set_has_is_dense() {
+  _has_bits_[0] |= 0x00000004u;
+}
+inline void PackedPointCloud::clear_has_is_dense() {
+  _has_bits_[0] &= ~0x00000004u;
+}
+inline void PackedPointCloud::clear_is_dense() {
+  is_dense_ = false;
+  clear_has_is_dense();
+}
+inline bool PackedPointCloud::is_dense() const {
+  return is_dense_;
+}
+inline void PackedPointCloud::set_is_dense(bool value) {
+  set_has_is_dense();
+  is_dense_ = value;
+}
+
+// repeated .pcl.msgs.PackedPointCloud.Field fields = 4;
+inline int PackedPointCloud::fields_size() const {
+  return fields_.size();
+}
+inline void PackedPointCloud::clear_fields() {
+  fields_.Clear();
+}
+inline const ::pcl::msgs::PackedPointCloud_Field& PackedPointCloud::fields(int index) const {
+  return fields_.Get(index);
+}
+inline ::pcl::msgs::PackedPointCloud_Field* PackedPointCloud::mutable_fields(int index) {
+  return fields_.Mutable(index);
+}
+inline ::pcl::msgs::PackedPointCloud_Field* PackedPointCloud::add_fields() {
+  return fields_.Add();
+}
+inline const ::google::protobuf::RepeatedPtrField< ::pcl::msgs::PackedPointCloud_Field >&
+PackedPointCloud::fields() const {
+  return fields_;
+}
+inline ::google::protobuf::RepeatedPtrField< ::pcl::msgs::PackedPointCloud_Field >*
+PackedPointCloud::mutable_fields() {
+  return &fields_;
+}
+
+// required uint32 point_step = 5;
+inline bool PackedPointCloud::has_point_step() const {
+  return (_has_bits_[0] & 0x00000010u) != 0;
+}
+inline void PackedPointCloud::set_has_point_step() {
+  _has_bits_[0] |= 0x00000010u;
+}
+inline void PackedPointCloud::clear_has_point_step() {
+  _has_bits_[0] &= ~0x00000010u;
+}
+inline void PackedPointCloud::clear_point_step() {
+  point_step_ = 0u;
+  clear_has_point_step();
+}
+inline ::google::protobuf::uint32 PackedPointCloud::point_step() const {
+  return point_step_;
+}
+inline void PackedPointCloud::set_point_step(::google::protobuf::uint32 value) {
+  set_has_point_step();
+  point_step_ = value;
+}
+
+// required bytes data = 6;
+inline bool PackedPointCloud::has_data() const {
+  return (_has_bits_[0] & 0x00000020u) != 0;
+}
+inline void PackedPointCloud::set_has_data() {
+  _has_bits_[0] |= 0x00000020u;
+}
+inline void PackedPointCloud::clear_has_data() {
+  _has_bits_[0] &= ~0x00000020u;
+}
+inline void PackedPointCloud::clear_data() {
+  if (data_ != &::google::protobuf::internal::kEmptyString) {
+    data_->clear();
+  }
+  clear_has_data();
+}
+inline const ::std::string& PackedPointCloud::data() const {
+  return *data_;
+}
+inline void PackedPointCloud::set_data(const ::std::string& value) {
+  set_has_data();
+  if (data_ == &::google::protobuf::internal::kEmptyString) {
+    data_ = new ::std::string;
+  }
+  data_->assign(value);
+}
+inline void PackedPointCloud::set_data(const char* value) {
+  set_has_data();
+  if (data_ == &::google::protobuf::internal::kEmptyString) {
+    data_ = new ::std::string;
+  }
+  data_->assign(value);
+}
+inline void PackedPointCloud::set_data(const void* value, size_t size) {
+  set_has_data();
+  if (data_ == &::google::protobuf::internal::kEmptyString) {
+    data_ = new ::std::string;
+  }
+  data_->assign(reinterpret_cast<const char*>(value), size);
+}
+inline ::std::string* PackedPointCloud::mutable_data() {
+  set_has_data();
+  if (data_ == &::google::protobuf::internal::kEmptyString) {
+    data_ = new ::std::string;
+  }
+  return data_;
+}
+inline ::std::string* PackedPointCloud::release_data() {
+  clear_has_data();
+  if (data_ == &::google::protobuf::internal::kEmptyString) {
+    return NULL;
+  } else {
+    ::std::string* temp = data_;
+    data_ = const_cast< ::std::string*>(&::google::protobuf::internal::kEmptyString);
+    return temp;
+  }
+}
+inline void PackedPointCloud::set_allocated_data(::std::string* data) {
+  if (data_ != &::google::protobuf::internal::kEmptyString) {
+    delete data_;
+  }
+  if (data) {
+    set_has_data();
+    data_ = data;
+  } else {
+    clear_has_data();
+    data_ = const_cast< ::std::string*>(&::google::protobuf::internal::kEmptyString);
+  }
+}
+
+// optional uint64 sequence = 7;
+inline bool PackedPointCloud::has_sequence() const {
+  return (_has_bits_[0] & 0x00000040u) != 0;
+}
+inline void PackedPointCloud::set_has_sequence() {
+  _has_bits_[0] |= 0x00000040u;
+}
+inline void PackedPointCloud::clear_has_sequence() {
+  _has_bits_[0] &= ~0x00000040u;
+}
+inline void PackedPointCloud::clear_sequence() {
+  sequence_ = GOOGLE_ULONGLONG(0);
+  clear_has_sequence();
+}
+inline ::google::protobuf::uint64 PackedPointCloud::sequence() const {
+  return sequence_;
+}
+inline void PackedPointCloud::set_sequence(::google::protobuf::uint64 value) {
+  set_has_sequence();
+  sequence_ = value;
+}
+
+// optional double sim_time = 8;
+inline bool PackedPointCloud::has_sim_time() const {
+  return (_has_bits_[0] & 0x00000080u) != 0;
+}
+inline void PackedPointCloud::set_has_sim_time() {
+  _has_bits_[0] |= 0x00000080u;
+}
+inline void PackedPointCloud::clear_has_sim_time() {
+  _has_bits_[0] &= ~0x00000080u;
+}
+inline void PackedPointCloud::clear_sim_time() {
+  sim_time_ = 0;
+  clear_has_sim_time();
+}
+inline double PackedPointCloud::sim_time() const {
+  return sim_time_;
+}
+inline void PackedPointCloud::set_sim_time(double value) {
+  set_has_sim_time();
+  sim_time_ = value;
+}
+
+
+// @@protoc_insertion_point(namespace_scope)
+
+}  // namespace msgs
+}  // namespace pcl
+
+#ifndef SWIG
+namespace google {
+namespace protobuf {
+
+template <>
+inline const EnumDescriptor* GetEnumDescriptor< ::pcl::msgs::PackedPointCloud_Field_DataType>() {
+  return ::pcl::msgs::PackedPointCloud_Field_DataType_descriptor();
+}
+
+}  // namespace google
+}  // namespace protobuf
+#endif  // SWIG
+
+// @@protoc_insertion_point(global_scope)
+
+#endif  // PROTOBUF_packed_5fpoint_5fcloud_2eproto__INCLUDED
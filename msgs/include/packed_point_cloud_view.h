@@ -0,0 +1,160 @@
+/*
+ * packed_point_cloud_view.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef PACKED_POINT_CLOUD_VIEW_H_
+#define PACKED_POINT_CLOUD_VIEW_H_
+
+#include <stdint.h>
+#include <string.h>
+#include <string>
+
+#include "packed_point_cloud.pb.h"
+
+namespace pcl
+{
+namespace msgs
+{
+
+// layout written by the depth sensor, same as pcl::PointXYZ with the label in its padding
+struct PackedPointXYZL
+{
+	float x;
+	float y;
+	float z;
+	uint32_t label;
+};
+
+// Reads a PackedPointCloud in place, points are never copied out of the message.
+// The view is only valid as long as the message is alive and not modified.
+class PackedPointCloudView
+{
+public:
+	explicit PackedPointCloudView( const PackedPointCloud &_msgs )
+		: m_data( (const unsigned char*)_msgs.data().data() ),
+		  m_width( _msgs.width() ),
+		  m_height( _msgs.height() ),
+		  m_point_step( _msgs.point_step() ),
+		  m_x_offset( -1 ),
+		  m_y_offset( -1 ),
+		  m_z_offset( -1 ),
+		  m_label_offset( -1 )
+	{
+		for( int i = 0; i < _msgs.fields_size(); i++ )
+		{
+			const PackedPointCloud::Field &field = _msgs.fields( i );
+			if( field.offset() + 4 > m_point_step )
+			{
+				continue;
+			}
+
+			bool is_float = field.datatype() == PackedPointCloud::Field::FLOAT32;
+			if( is_float && field.name() == "x" )
+			{
+				m_x_offset = field.offset();
+			}
+			else if( is_float && field.name() == "y" )
+			{
+				m_y_offset = field.offset();
+			}
+			else if( is_float && field.name() == "z" )
+			{
+				m_z_offset = field.offset();
+			}
+			else if( field.datatype() == PackedPointCloud::Field::UINT32 && field.name() == "label" )
+			{
+				m_label_offset = field.offset();
+			}
+		}
+
+		m_valid =	m_x_offset >= 0 && m_y_offset >= 0 && m_z_offset >= 0 &&
+					_msgs.data().size() == (size_t)m_width * m_height * m_point_step;
+	}
+
+	// false if x, y, z are missing or the payload size doesn't match width * height * point_step
+	bool isValid() const
+	{
+		return m_valid;
+	}
+
+	bool hasLabel() const
+	{
+		return m_label_offset >= 0;
+	}
+
+	uint32_t getWidth() const
+	{
+		return m_width;
+	}
+
+	uint32_t getHeight() const
+	{
+		return m_height;
+	}
+
+	size_t size() const
+	{
+		return (size_t)m_width * m_height;
+	}
+
+	// field access by point index ( _col + _row * width )
+	float getX( size_t _idx ) const
+	{
+		return _read< float >( _idx, m_x_offset );
+	}
+	float getY( size_t _idx ) const
+	{
+		return _read< float >( _idx, m_y_offset );
+	}
+	float getZ( size_t _idx ) const
+	{
+		return _read< float >( _idx, m_z_offset );
+	}
+	// 0 if the cloud has no label
+	uint32_t getLabel( size_t _idx ) const
+	{
+		return m_label_offset >= 0 ? _read< uint32_t >( _idx, m_label_offset ) : 0;
+	}
+
+	// direct pointer if the layout is exactly PackedPointXYZL, NULL otherwise
+	const PackedPointXYZL *getPointsXYZL() const
+	{
+		bool same_layout =	m_valid &&
+							m_point_step == sizeof( PackedPointXYZL ) &&
+							m_x_offset == 0 && m_y_offset == 4 && m_z_offset == 8 && m_label_offset == 12 &&
+							(uintptr_t)m_data % alignof( PackedPointXYZL ) == 0;
+		return same_layout ? (const PackedPointXYZL*)m_data : NULL;
+	}
+
+private:
+	template< typename T >
+	T _read( size_t _idx, int _offset ) const
+	{
+		// memcpy is a plain load, but safe for any alignment
+		T value;
+		memcpy( &value, m_data + _idx * m_point_step + _offset, sizeof( T ) );
+		return value;
+	}
+
+public:
+
+private:
+	// payload of the message
+	const unsigned char *m_data;
+	uint32_t m_width;
+	uint32_t m_height;
+	uint32_t m_point_step;
+	// byte offset of every field in a point, -1 if missing
+	int m_x_offset;
+	int m_y_offset;
+	int m_z_offset;
+	int m_label_offset;
+	bool m_valid;
+};
+
+}
+}
+
+#endif /* PACKED_POINT_CLOUD_VIEW_H_ */
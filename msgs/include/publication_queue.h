@@ -0,0 +1,185 @@
+/*
+ * publication_queue.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef PUBLICATION_QUEUE_H_
+#define PUBLICATION_QUEUE_H_
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <sstream>
+#include <string>
+
+#include <boost/shared_ptr.hpp>
+#include <google/protobuf/message.h>
+#include <gazebo/common/Time.hh>
+#include <gazebo/transport/transport.hh>
+
+// Publishes on a gazebo topic without waiting for subscribers, so no update thread is ever blocked.
+// Without subscribers the last max_depth messages are kept ( the oldest is dropped ),
+// flush() sends them in order as soon as the topic has a subscriber. Call flush() from an update callback.
+// publish() & flush() may be called from different threads.
+class PublicationQueue
+{
+public:
+	PublicationQueue(	gazebo::transport::PublisherPtr	_publisher,
+						int								_max_depth )
+		: m_publisher( _publisher ),
+		  m_max_depth( _max_depth > 0 ? _max_depth : 1 ),
+		  m_published( 0 ),
+		  m_delayed( 0 ),
+		  m_dropped( 0 ),
+		  m_total_wait_time( 0 ),
+		  m_max_wait_time( 0 )
+	{
+	}
+	~PublicationQueue()
+	{
+	}
+
+	// publish _msgs now if the topic has subscribers & nothing is waiting, otherwise queue a copy
+	// return true if it was published now
+	bool publish( const google::protobuf::Message &_msgs )
+	{
+		std::lock_guard< std::mutex > lock( m_mutex );
+		_flush();
+		if( m_queue.empty() && m_publisher->HasConnections() )
+		{
+			m_publisher->Publish( _msgs );
+			m_published++;
+			return true;
+		}
+
+		if( (int)m_queue.size() >= m_max_depth )
+		{
+			m_queue.pop_front();
+			m_dropped++;
+		}
+		Entry entry;
+		entry.msgs.reset( _msgs.New() );
+		entry.msgs->CopyFrom( _msgs );
+		entry.queued_time = gazebo::common::Time::GetWallTime();
+		m_queue.push_back( entry );
+		return false;
+	}
+
+	// publish every queued message if the topic has subscribers, return the number published
+	int flush()
+	{
+		std::lock_guard< std::mutex > lock( m_mutex );
+		return _flush();
+	}
+
+	std::string getTopic() const
+	{
+		return m_publisher->GetTopic();
+	}
+
+	// ******* //
+	// metrics //
+	// ******* //
+	// messages waiting for a subscriber
+	int getQueueDepth()
+	{
+		std::lock_guard< std::mutex > lock( m_mutex );
+		return m_queue.size();
+	}
+
+	// messages handed to the publisher, directly or after waiting
+	unsigned long getPublished()
+	{
+		std::lock_guard< std::mutex > lock( m_mutex );
+		return m_published;
+	}
+
+	// messages pushed out of a full queue
+	unsigned long getDropped()
+	{
+		std::lock_guard< std::mutex > lock( m_mutex );
+		return m_dropped;
+	}
+
+	// seconds queued messages waited for a subscriber, 0 if none had to wait
+	double getMeanWaitTime()
+	{
+		std::lock_guard< std::mutex > lock( m_mutex );
+		return m_delayed > 0 ? m_total_wait_time / m_delayed : 0;
+	}
+
+	double getMaxWaitTime()
+	{
+		std::lock_guard< std::mutex > lock( m_mutex );
+		return m_max_wait_time;
+	}
+
+	// one line of every metric, for logging
+	std::string getSummary()
+	{
+		std::lock_guard< std::mutex > lock( m_mutex );
+		std::ostringstream ss;
+		ss << m_publisher->GetTopic()
+		   << " : depth " << m_queue.size() << " / " << m_max_depth
+		   << ", published " << m_published
+		   << ", dropped " << m_dropped
+		   << ", wait mean " << ( m_delayed > 0 ? m_total_wait_time / m_delayed : 0 )
+		   << " s max " << m_max_wait_time << " s";
+		return ss.str();
+	}
+
+private:
+	// m_mutex must be locked
+	int _flush()
+	{
+		if( m_queue.empty() || !m_publisher->HasConnections() )
+		{
+			return 0;
+		}
+
+		gazebo::common::Time now = gazebo::common::Time::GetWallTime();
+		int count = m_queue.size();
+		while( !m_queue.empty() )
+		{
+			Entry &entry = m_queue.front();
+			m_publisher->Publish( *entry.msgs );
+
+			double wait_time = ( now - entry.queued_time ).Double();
+			m_total_wait_time += wait_time;
+			m_max_wait_time = std::max( m_max_wait_time, wait_time );
+			m_delayed++;
+			m_published++;
+			m_queue.pop_front();
+		}
+		return count;
+	}
+
+public:
+
+private:
+	struct Entry
+	{
+		boost::shared_ptr< google::protobuf::Message > msgs;
+		// wall time of publish()
+		gazebo::common::Time queued_time;
+	};
+
+	gazebo::transport::PublisherPtr m_publisher;
+	// messages kept without subscribers
+	int m_max_depth;
+
+	// guards everything below
+	std::mutex m_mutex;
+	std::deque< Entry > m_queue;
+
+	// metrics
+	unsigned long m_published;
+	// published after waiting in the queue
+	unsigned long m_delayed;
+	unsigned long m_dropped;
+	double m_total_wait_time;
+	double m_max_wait_time;
+};
+
+#endif /* PUBLICATION_QUEUE_H_ */
@@ -0,0 +1,484 @@
+// Generated by the protocol buffer compiler.  DO NOT EDIT!
+// source: compressed_depth.proto
+
+#define INTERNAL_SUPPRESS_PROTOBUF_FIELD_DEPRECATION
+#include "compressed_depth.pb.h"
+
+#include <algorithm>
+
+#include <google/protobuf/stubs/common.h>
+#include <google/protobuf/stubs/once.h>
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/wire_format_lite_inl.h>
+#include <google/protobuf/descriptor.h>
+#include <google/protobuf/generated_message_reflection.h>
+#include <google/protobuf/reflection_ops.h>
+#include <google/protobuf/wire_format.h>
+// @@protoc_insertion_point(includes)
+
+namespace pcl {
+namespace msgs {
+
+namespace {
+
+const ::google::protobuf::Descriptor* CompressedDepthCloud_descriptor_ = NULL;
+const ::google::protobuf::internal::GeneratedMessageReflection*
+  CompressedDepthCloud_reflection_ = NULL;
+
+}  // namespace
+
+
+void protobuf_AssignDesc_compressed_5fdepth_2eproto() {
+  protobuf_AddDesc_compressed_5fdepth_2eproto();
+  const ::google::protobuf::FileDescriptor* file =
+    ::google::protobuf::DescriptorPool::generated_pool()->FindFileByName(
+      "compressed_depth.proto");
+  GOOGLE_CHECK(file != NULL);
+  CompressedDepthCloud_descriptor_ = file->message_type(0);
+  static const int CompressedDepthCloud_offsets_[5] = {
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(CompressedDepthCloud, width_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(CompressedDepthCloud, height_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(CompressedDepthCloud, data_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(CompressedDepthCloud, sequence_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(CompressedDepthCloud, sim_time_),
+  };
+  CompressedDepthCloud_reflection_ =
+    new ::google::protobuf::internal::GeneratedMessageReflection(
+      CompressedDepthCloud_descriptor_,
+      CompressedDepthCloud::default_instance_,
+      CompressedDepthCloud_offsets_,
+      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(CompressedDepthCloud, _has_bits_[0]),
+      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(CompressedDepthCloud, _unknown_fields_),
+      -1,
+      ::google::protobuf::DescriptorPool::generated_pool(),
+      ::google::protobuf::MessageFactory::generated_factory(),
+      sizeof(CompressedDepthCloud));
+}
+
+namespace {
+
+GOOGLE_PROTOBUF_DECLARE_ONCE(protobuf_AssignDescriptors_once_);
+inline void protobuf_AssignDescriptorsOnce() {
+  ::google::protobuf::GoogleOnceInit(&protobuf_AssignDescriptors_once_,
+                 &protobuf_AssignDesc_compressed_5fdepth_2eproto);
+}
+
+void protobuf_RegisterTypes(const ::std::string&) {
+  protobuf_AssignDescriptorsOnce();
+  ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
+    CompressedDepthCloud_descriptor_, &CompressedDepthCloud::default_instance());
+}
+
+}  // namespace
+
+void protobuf_ShutdownFile_compressed_5fdepth_2eproto() {
+  delete CompressedDepthCloud::default_instance_;
+  delete CompressedDepthCloud_reflection_;
+}
+
+void protobuf_AddDesc_compressed_5fdepth_2eproto() {
+  static bool already_here = false;
+  if (already_here) return;
+  already_here = true;
+  GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+  ::google::protobuf::DescriptorPool::InternalAddGeneratedFile(
+    "\n\026compressed_depth.proto\022\010pcl.msgs\"g\n\024Co"
+    "mpressedDepthCloud\022\r\n\005width\030\001 \002(\r\022\016\n\006hei"
+    "ght\030\002 \002(\r\022\014\n\004data\030\003 \002(\014\022\020\n\010sequence\030\004 \001("
+    "\004\022\020\n\010sim_time\030\005 \001(\001", 139);
+  ::google::protobuf::MessageFactory::InternalRegisterGeneratedFile(
+    "compressed_depth.proto", &protobuf_RegisterTypes);
+  CompressedDepthCloud::default_instance_ = new CompressedDepthCloud();
+  CompressedDepthCloud::default_instance_->InitAsDefaultInstance();
+  ::google::protobuf::internal::OnShutdown(&protobuf_ShutdownFile_compressed_5fdepth_2eproto);
+}
+
+// Force AddDescriptors() to be called at static initialization time.
+struct StaticDescriptorInitializer_compressed_5fdepth_2eproto {
+  StaticDescriptorInitializer_compressed_5fdepth_2eproto() {
+    protobuf_AddDesc_compressed_5fdepth_2eproto();
+  }
+} static_descriptor_initializer_compressed_5fdepth_2eproto_;
+
+// ===================================================================
+
+#ifndef _MSC_VER
+const int CompressedDepthCloud::kWidthFieldNumber;
+const int CompressedDepthCloud::kHeightFieldNumber;
+const int CompressedDepthCloud::kDataFieldNumber;
+const int CompressedDepthCloud::kSequenceFieldNumber;
+const int CompressedDepthCloud::kSimTimeFieldNumber;
+#endif  // !_MSC_VER
+
+CompressedDepthCloud::CompressedDepthCloud()
+  : ::google::protobuf::Message() {
+  SharedCtor();
+}
+
+void CompressedDepthCloud::InitAsDefaultInstance() {
+}
+
+CompressedDepthCloud::CompressedDepthCloud(const CompressedDepthCloud& from)
+  : ::google::protobuf::Message() {
+  SharedCtor();
+  MergeFrom(from);
+}
+
+void CompressedDepthCloud::SharedCtor() {
+  _cached_size_ = 0;
+  width_ = 0u;
+  height_ = 0u;
+  data_ = const_cast< ::std::string*>(&::google::protobuf::internal::kEmptyString);
+  sequence_ = GOOGLE_ULONGLONG(0);
+  sim_time_ = 0;
+  ::memset(_has_bits_, 0, sizeof(_has_bits_));
+}
+
+CompressedDepthCloud::~CompressedDepthCloud() {
+  SharedDtor();
+}
+
+void CompressedDepthCloud::SharedDtor() {
+  if (data_ != &::google::protobuf::internal::kEmptyString) {
+    delete data_;
+  }
+  if (this != default_instance_) {
+  }
+}
+
+void CompressedDepthCloud::SetCachedSize(int size) const {
+  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
+  _cached_size_ = size;
+  GOOGLE_SAFE_CONCURRENT_WRITES_END();
+}
+const ::google::protobuf::Descriptor* CompressedDepthCloud::descriptor() {
+  protobuf_AssignDescriptorsOnce();
+  return CompressedDepthCloud_descriptor_;
+}
+
+const CompressedDepthCloud& CompressedDepthCloud::default_instance() {
+  if (default_instance_ == NULL) protobuf_AddDesc_compressed_5fdepth_2eproto();
+  return *default_instance_;
+}
+
+CompressedDepthCloud* CompressedDepthCloud::default_instance_ = NULL;
+
+CompressedDepthCloud* CompressedDepthCloud::New() const {
+  return new CompressedDepthCloud;
+}
+
+void CompressedDepthCloud::Clear() {
+  if (_has_bits_[0 / 32] & (0xffu << (0 % 32))) {
+    width_ = 0u;
+    height_ = 0u;
+    if (has_data()) {
+      if (data_ != &::google::protobuf::internal::kEmptyString) {
+        data_->clear();
+      }
+    }
+    sequence_ = GOOGLE_ULONGLONG(0);
+    sim_time_ = 0;
+  }
+  ::memset(_has_bits_, 0, sizeof(_has_bits_));
+  mutable_unknown_fields()->Clear();
+}
+
+bool CompressedDepthCloud::MergePartialFromCodedStream(
+    ::google::protobuf::io::CodedInputStream* input) {
+#define DO_(EXPRESSION) if (!(EXPRESSION)) return false
+  ::google::protobuf::uint32 tag;
+  while ((tag = input->ReadTag()) != 0) {
+    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+      // required uint32 width = 1;
+      case 1: {
+        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
+            ::google::protobuf::internal::WireFormatLite::WIRETYPE_VARINT) {
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   ::google::protobuf::uint32, ::google::protobuf::internal::WireFormatLite::TYPE_UINT32>(
+                 input, &width_)));
+          set_has_width();
+        } else {
+          goto handle_uninterpreted;
+        }
+        if (input->ExpectTag(16)) goto parse_height;
+        break;
+      }
+
+      // required uint32 height = 2;
+      case 2: {
+        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
+            ::google::protobuf::internal::WireFormatLite::WIRETYPE_VARINT) {
+         parse_height:
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   ::google::protobuf::uint32, ::google::protobuf::internal::WireFormatLite::TYPE_UINT32>(
+                 input, &height_)));
+          set_has_height();
+        } else {
+          goto handle_uninterpreted;
+        }
+        if (input->ExpectTag(26)) goto parse_data;
+        break;
+      }
+
+      // required bytes data = 3;
+      case 3: {
+        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
+            ::google::protobuf::internal::WireFormatLite::WIRETYPE_LENGTH_DELIMITED) {
+         parse_data:
+          DO_(::google::protobuf::internal::WireFormatLite::ReadBytes(
+                input, this->mutable_data()));
+        } else {
+          goto handle_uninterpreted;
+        }
+        if (input->ExpectTag(32)) goto parse_sequence;
+        break;
+      }
+
+      // optional uint64 sequence = 4;
+      case 4: {
+        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
+            ::google::protobuf::internal::WireFormatLite::WIRETYPE_VARINT) {
+         parse_sequence:
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   ::google::protobuf::uint64, ::google::protobuf::internal::WireFormatLite::TYPE_UINT64>(
+                 input, &sequence_)));
+          set_has_sequence();
+        } else {
+          goto handle_uninterpreted;
+        }
+        if (input->ExpectTag(41)) goto parse_sim_time;
+        break;
+      }
+
+      // optional double sim_time = 5;
+      case 5: {
+        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
+            ::google::protobuf::internal::WireFormatLite::WIRETYPE_FIXED64) {
+         parse_sim_time:
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   double, ::google::protobuf::internal::WireFormatLite::TYPE_DOUBLE>(
+                 input, &sim_time_)));
+          set_has_sim_time();
+        } else {
+          goto handle_uninterpreted;
+        }
+        if (input->ExpectAtEnd()) return true;
+        break;
+      }
+
+      default: {
+      handle_uninterpreted:
+        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
+            ::google::protobuf::internal::WireFormatLite::WIRETYPE_END_GROUP) {
+          return true;
+        }
+        DO_(::google::protobuf::internal::WireFormat::SkipField(
+              input, tag, mutable_unknown_fields()));
+        break;
+      }
+    }
+  }
+  return true;
+#undef DO_
+}
+
+void CompressedDepthCloud::SerializeWithCachedSizes(
+    ::google::protobuf::io::CodedOutputStream* output) const {
+  // required uint32 width = 1;
+  if (has_width()) {
+    ::google::protobuf::internal::WireFormatLite::WriteUInt32(1, this->width(), output);
+  }
+
+  // required uint32 height = 2;
+  if (has_height()) {
+    ::google::protobuf::internal::WireFormatLite::WriteUInt32(2, this->height(), output);
+  }
+
+  // required bytes data = 3;
+  if (has_data()) {
+    ::google::protobuf::internal::WireFormatLite::WriteBytes(
+      3, this->data(), output);
+  }
+
+  // optional uint64 sequence = 4;
+  if (has_sequence()) {
+    ::google::protobuf::internal::WireFormatLite::WriteUInt64(4, this->sequence(), output);
+  }
+
+  // optional double sim_time = 5;
+  if (has_sim_time()) {
+    ::google::protobuf::internal::WireFormatLite::WriteDouble(5, this->sim_time(), output);
+  }
+
+  if (!unknown_fields().empty()) {
+    ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
+        unknown_fields(), output);
+  }
+}
+
+::google::protobuf::uint8* CompressedDepthCloud::SerializeWithCachedSizesToArray(
+    ::google::protobuf::uint8* target) const {
+  // required uint32 width = 1;
+  if (has_width()) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteUInt32ToArray(1, this->width(), target);
+  }
+
+  // required uint32 height = 2;
+  if (has_height()) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteUInt32ToArray(2, this->height(), target);
+  }
+
+  // required bytes data = 3;
+  if (has_data()) {
+    target =
+      ::google::protobuf::internal::WireFormatLite::WriteBytesToArray(
+        3, this->data(), target);
+  }
+
+  // optional uint64 sequence = 4;
+  if (has_sequence()) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteUInt64ToArray(4, this->sequence(), target);
+  }
+
+  // optional double sim_time = 5;
+  if (has_sim_time()) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteDoubleToArray(5, this->sim_time(), target);
+  }
+
+  if (!unknown_fields().empty()) {
+    target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
+        unknown_fields(), target);
+  }
+  return target;
+}
+
+int CompressedDepthCloud::ByteSize() const {
+  int total_size = 0;
+
+  if (_has_bits_[0 / 32] & (0xffu << (0 % 32))) {
+    // required uint32 width = 1;
+    if (has_width()) {
+      total_size += 1 +
+        ::google::protobuf::internal::WireFormatLite::UInt32Size(
+          this->width());
+    }
+
+    // required uint32 height = 2;
+    if (has_height()) {
+      total_size += 1 +
+        ::google::protobuf::internal::WireFormatLite::UInt32Size(
+          this->height());
+    }
+
+    // required bytes data = 3;
+    if (has_data()) {
+      total_size += 1 +
+        ::google::protobuf::internal::WireFormatLite::BytesSize(
+          this->data());
+    }
+
+    // optional uint64 sequence = 4;
+    if (has_sequence()) {
+      total_size += 1 +
+        ::google::protobuf::internal::WireFormatLite::UInt64Size(
+          this->sequence());
+    }
+
+    // optional double sim_time = 5;
+    if (has_sim_time()) {
+      total_size += 1 + 8;
+    }
+
+  }
+  if (!unknown_fields().empty()) {
+    total_size +=
+      ::google::protobuf::internal::WireFormat::ComputeUnknownFieldsSize(
+        unknown_fields());
+  }
+  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
+  _cached_size_ = total_size;
+  GOOGLE_SAFE_CONCURRENT_WRITES_END();
+  return total_size;
+}
+
+void CompressedDepthCloud::MergeFrom(const ::google::protobuf::Message& from) {
+  GOOGLE_CHECK_NE(&from, this);
+  const CompressedDepthCloud* source =
+    ::google::protobuf::internal::dynamic_cast_if_available<const CompressedDepthCloud*>(
+      &from);
+  if (source == NULL) {
+    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
+  } else {
+    MergeFrom(*source);
+  }
+}
+
+void CompressedDepthCloud::MergeFrom(const CompressedDepthCloud& from) {
+  GOOGLE_CHECK_NE(&from, this);
+  if (from._has_bits_[0 / 32] & (0xffu << (0 % 32))) {
+    if (from.has_width()) {
+      set_width(from.width());
+    }
+    if (from.has_height()) {
+      set_height(from.height());
+    }
+    if (from.has_data()) {
+      set_data(from.data());
+    }
+    if (from.has_sequence()) {
+      set_sequence(from.sequence());
+    }
+    if (from.has_sim_time()) {
+      set_sim_time(from.sim_time());
+    }
+  }
+  mutable_unknown_fields()->MergeFrom(from.unknown_fields());
+}
+
+void CompressedDepthCloud::CopyFrom(const ::google::protobuf::Message& from) {
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+void CompressedDepthCloud::CopyFrom(const CompressedDepthCloud& from) {
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool CompressedDepthCloud::IsInitialized() const {
+  if ((_has_bits_[0] & 0x00000007) != 0x00000007) return false;
+
+  return true;
+}
+
+void CompressedDepthCloud::Swap(CompressedDepthCloud* other) {
+  if (other != this) {
+    std::swap(width_, other->width_);
+    std::swap(height_, other->height_);
+    std::swap(data_, other->data_);
+    std::swap(sequence_, other->sequence_);
+    std::swap(sim_time_, other->sim_time_);
+    std::swap(_has_bits_[0], other->_has_bits_[0]);
+    _unknown_fields_.Swap(&other->_unknown_fields_);
+    std::swap(_cached_size_, other->_cached_size_);
+  }
+}
+
+::google::protobuf::Metadata CompressedDepthCloud::GetMetadata() const {
+  protobuf_AssignDescriptorsOnce();
+  ::google::protobuf::Metadata metadata;
+  metadata.descriptor = CompressedDepthCloud_descriptor_;
+  metadata.reflection = CompressedDepthCloud_reflection_;
+  return metadata;
+}
+
+
+// @@protoc_insertion_point(namespace_scope)
+
+}  // namespace msgs
+}  // namespace pcl
+
+// @@protoc_insertion_point(global_scope)
@@ -0,0 +1,348 @@
+// Generated by the protocol buffer compiler.  DO NOT EDIT!
+// source: compressed_depth.proto
+
+#ifndef PROTOBUF_compressed_5fdepth_2eproto__INCLUDED
+#define PROTOBUF_compressed_5fdepth_2eproto__INCLUDED
+
+#include <string>
+
+#include <google/protobuf/stubs/common.h>
+
+#if GOOGLE_PROTOBUF_VERSION < 2005000
+#error This file was generated by a newer version of protoc which is
+#error incompatible with your Protocol Buffer headers.  Please update
+#error your headers.
+#endif
+#if 2005000 < GOOGLE_PROTOBUF_MIN_PROTOC_VERSION
+#error This file was generated by an older version of protoc which is
+#error incompatible with your Protocol Buffer headers.  Please
+#error regenerate this file with a newer version of protoc.
+#endif
+
+#include <google/protobuf/generated_message_util.h>
+#include <google/protobuf/message.h>
+#include <google/protobuf/repeated_field.h>
+#include <google/protobuf/extension_set.h>
+#include <google/protobuf/unknown_field_set.h>
+// @@protoc_insertion_point(includes)
+
+namespace pcl {
+namespace msgs {
+
+// Internal implementation detail -- do not call these.
+void  protobuf_AddDesc_compressed_5fdepth_2eproto();
+void protobuf_AssignDesc_compressed_5fdepth_2eproto();
+void protobuf_ShutdownFile_compressed_5fdepth_2eproto();
+
+class CompressedDepthCloud;
+
+// ===================================================================
+
+class CompressedDepthCloud : public ::google::protobuf::Message {
+ public:
+  CompressedDepthCloud();
+  virtual ~CompressedDepthCloud();
+
+  CompressedDepthCloud(const CompressedDepthCloud& from);
+
+  inline CompressedDepthCloud& operator=(const CompressedDepthCloud& from) {
+    CopyFrom(from);
+    return *this;
+  }
+
+  inline const ::google::protobuf::UnknownFieldSet& unknown_fields() const {
+    return _unknown_fields_;
+  }
+
+  inline ::google::protobuf::UnknownFieldSet* mutable_unknown_fields() {
+    return &_unknown_fields_;
+  }
+
+  static const ::google::protobuf::Descriptor* descriptor();
+  static const CompressedDepthCloud& default_instance();
+
+  void Swap(CompressedDepthCloud* other);
+
+  // implements Message ----------------------------------------------
+
+  CompressedDepthCloud* New() const;
+  void CopyFrom(const ::google::protobuf::Message& from);
+  void MergeFrom(const ::google::protobuf::Message& from);
+  void CopyFrom(const CompressedDepthCloud& from);
+  void MergeFrom(const CompressedDepthCloud& from);
+  void Clear();
+  bool IsInitialized() const;
+
+  int ByteSize() const;
+  bool MergePartialFromCodedStream(
+      ::google::protobuf::io::CodedInputStream* input);
+  void SerializeWithCachedSizes(
+      ::google::protobuf::io::CodedOutputStream* output) const;
+  ::google::protobuf::uint8* SerializeWithCachedSizesToArray(::google::protobuf::uint8* output) const;
+  int GetCachedSize() const { return _cached_size_; }
+  private:
+  void SharedCtor();
+  void SharedDtor();
+  void SetCachedSize(int size) const;
+  public:
+
+  ::google::protobuf::Metadata GetMetadata() const;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  // required uint32 width = 1;
+  inline bool has_width() const;
+  inline void clear_width();
+  static const int kWidthFieldNumber = 1;
+  inline ::google::protobuf::uint32 width() const;
+  inline void set_width(::google::protobuf::uint32 value);
+
+  // required uint32 height = 2;
+  inline bool has_height() const;
+  inline void clear_height();
+  static const int kHeightFieldNumber = 2;
+  inline ::google::protobuf::uint32 height() const;
+  inline void set_height(::google::protobuf::uint32 value);
+
+  // required bytes data = 3;
+  inline bool has_data() const;
+  inline void clear_data();
+  static const int kDataFieldNumber = 3;
+  inline const ::std::string& data() const;
+  inline void set_data(const ::std::string& value);
+  inline void set_data(const char* value);
+  inline void set_data(const void* value, size_t size);
+  inline ::std::string* mutable_data();
+  inline ::std::string* release_data();
+  inline void set_allocated_data(::std::string* data);
+
+  // optional uint64 sequence = 4;
+  inline bool has_sequence() const;
+  inline void clear_sequence();
+  static const int kSequenceFieldNumber = 4;
+  inline ::google::protobuf::uint64 sequence() const;
+  inline void set_sequence(::google::protobuf::uint64 value);
+
+  // optional double sim_time = 5;
+  inline bool has_sim_time() const;
+  inline void clear_sim_time();
+  static const int kSimTimeFieldNumber = 5;
+  inline double sim_time() const;
+  inline void set_sim_time(double value);
+
+  // @@protoc_insertion_point(class_scope:pcl.msgs.CompressedDepthCloud)
+ private:
+  inline void set_has_width();
+  inline void clear_has_width();
+  inline void set_has_height();
+  inline void clear_has_height();
+  inline void set_has_data();
+  inline void clear_has_data();
+  inline void set_has_sequence();
+  inline void clear_has_sequence();
+  inline void set_has_sim_time();
+  inline void clear_has_sim_time();
+
+  ::google::protobuf::UnknownFieldSet _unknown_fields_;
+
+  ::google::protobuf::uint32 width_;
+  ::google::protobuf::uint32 height_;
+  ::std::string* data_;
+  ::google::protobuf::uint64 sequence_;
+  double sim_time_;
+
+  mutable int _cached_size_;
+  ::google::protobuf::uint32 _has_bits_[(5 + 31) / 32];
+
+  friend void  protobuf_AddDesc_compressed_5fdepth_2eproto();
+  friend void protobuf_AssignDesc_compressed_5fdepth_2eproto();
+  friend void protobuf_ShutdownFile_compressed_5fdepth_2eproto();
+
+  void InitAsDefaultInstance();
+  static CompressedDepthCloud* default_instance_;
+};
+// ===================================================================
+
+
+// ===================================================================
+
+// CompressedDepthCloud
+
+// required uint32 width = 1;
+inline bool CompressedDepthCloud::has_width() const {
+  return (_has_bits_[0] & 0x00000001u) != 0;
+}
+inline void CompressedDepthCloud::set_has_width() {
+  _has_bits_[0] |= 0x00000001u;
+}
+inline void CompressedDepthCloud::clear_has_width() {
+  _has_bits_[0] &= ~0x00000001u;
+}
+inline void CompressedDepthCloud::clear_width() {
+  width_ = 0u;
+  clear_has_width();
+}
+inline ::google::protobuf::uint32 CompressedDepthCloud::width() const {
+  return width_;
+}
+inline void CompressedDepthCloud::set_width(::google::protobuf::uint32 value) {
+  set_has_width();
+  width_ = value;
+}
+
+// required uint32 height = 2;
+inline bool CompressedDepthCloud::has_height() const {
+  return (_has_bits_[0] & 0x00000002u) != 0;
+}
+inline void CompressedDepthCloud::set_has_height() {
+  _has_bits_[0] |= 0x00000002u;
+}
+inline void CompressedDepthCloud::clear_has_height() {
+  _has_bits_[0] &= ~0x00000002u;
+}
+inline void CompressedDepthCloud::clear_height() {
+  height_ = 0u;
+  clear_has_height();
+}
+inline ::google::protobuf::uint32 CompressedDepthCloud::height() const {
+  return height_;
+}
+inline void CompressedDepthCloud::set_height(::google::protobuf::uint32 value) {
+  set_has_height();
+  height_ = value;
+}
+
+// required bytes data = 3;
+inline bool CompressedDepthCloud::has_data() const {
+  return (_has_bits_[0] & 0x00000004u) != 0;
+}
+inline void CompressedDepthCloud::set_has_data() {
+  _has_bits_[0] |= 0x00000004u;
+}
+inline void CompressedDepthCloud::clear_has_data() {
+  _has_bits_[0] &= ~0x00000004u;
+}
+inline void CompressedDepthCloud::clear_data() {
+  if (data_ != &::google::protobuf::internal::kEmptyString) {
+    data_->clear();
+  }
+  clear_has_data();
+}
+inline const ::std::string& CompressedDepthCloud::data() const {
+  return *data_;
+}
+inline void CompressedDepthCloud::set_data(const ::std::string& value) {
+  set_has_data();
+  if (data_ == &::google::protobuf::internal::kEmptyString) {
+    data_ = new ::std::string;
+  }
+  data_->assign(value);
+}
+inline void CompressedDepthCloud::set_data(const char* value) {
+  set_has_data();
+  if (data_ == &::google::protobuf::internal::kEmptyString) {
+    data_ = new ::std::string;
+  }
+  data_->assign(value);
+}
+inline void CompressedDepthCloud::set_data(const void* value, size_t size) {
+  set_has_data();
+  if (data_ == &::google::protobuf::internal::kEmptyString) {
+    data_ = new ::std::string;
+  }
+  data_->assign(reinterpret_cast<const char*>(value), size);
+}
+inline ::std::string* CompressedDepthCloud::mutable_data() {
+  set_has_data();
+  if (data_ == &::google::protobuf::internal::kEmptyString) {
+    data_ = new ::std::string;
+  }
+  return data_;
+}
+inline ::std::string* CompressedDepthCloud::release_data() {
+  clear_has_data();
+  if (data_ == &::google::protobuf::internal::kEmptyString) {
+    return NULL;
+  } else {
+    ::std::string* temp = data_;
+    data_ = const_cast< ::std::string*>(&::google::protobuf::internal::kEmptyString);
+    return temp;
+  }
+}
+inline void CompressedDepthCloud::set_allocated_data(::std::string* data) {
+  if (data_ != &::google::protobuf::internal::kEmptyString) {
+    delete data_;
+  }
+  if (data) {
+    set_has_data();
+    data_ = data;
+  } else {
+    clear_has_data();
+    data_ = const_cast< ::std::string*>(&::google::protobuf::internal::kEmptyString);
+  }
+}
+
+// optional uint64 sequence = 4;
+inline bool CompressedDepthCloud::has_sequence() const {
+  return (_has_bits_[0] & 0x00000008u) != 0;
+}
+inline void CompressedDepthCloud::set_has_sequence() {
+  _has_bits_[0] |= 0x00000008u;
+}
+inline void CompressedDepthCloud::clear_has_sequence() {
+  _has_bits_[0] &= ~0x00000008u;
+}
+inline void CompressedDepthCloud::clear_sequence() {
+  sequence_ = GOOGLE_ULONGLONG(0);
+  clear_has_sequence();
+}
+inline ::google::protobuf::uint64 CompressedDepthCloud::sequence() const {
+  return sequence_;
+}
+inline void CompressedDepthCloud::set_sequence(::google::protobuf::uint64 value) {
+  set_has_sequence();
+  sequence_ = value;
+}
+
+// optional double sim_time = 5;
+inline bool CompressedDepthCloud::has_sim_time() const {
+  return (_has_bits_[0] & 0x00000010u) != 0;
+}
+inline void CompressedDepthCloud::set_has_sim_time() {
+  _has_bits_[0] |= 0x00000010u;
+}
+inline void CompressedDepthCloud::clear_has_sim_time() {
+  _has_bits_[0] &= ~0x00000010u;
+}
+inline void CompressedDepthCloud::clear_sim_time() {
+  sim_time_ = 0;
+  clear_has_sim_time();
+}
+inline double CompressedDepthCloud::sim_time() const {
+  return sim_time_;
+}
+inline void CompressedDepthCloud::set_sim_time(double value) {
+  set_has_sim_time();
+  sim_time_ = value;
+}
+
+
+// @@protoc_insertion_point(namespace_scope)
+
+}  // namespace msgs
+}  // namespace pcl
+
+#ifndef SWIG
+namespace google {
+namespace protobuf {
+
+
+}  // namespace google
+}  // namespace protobuf
+#endif  // SWIG
+
+// @@protoc_insertion_point(global_scope)
+
+#endif  // PROTOBUF_compressed_5fdepth_2eproto__INCLUDED
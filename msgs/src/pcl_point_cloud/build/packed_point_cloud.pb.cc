@@ -0,0 +1,975 @@
+// Generated by the protocol buffer compiler.  DO NOT EDIT!
+// source: packed_point_cloud.proto
+
+#define INTERNAL_SUPPRESS_PROTOBUF_FIELD_DEPRECATION
+#include "packed_point_cloud.pb.h"
+
+#include <algorithm>
+
+#include <google/protobuf/stubs/common.h>
+#include <google/protobuf/stubs/once.h>
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/wire_format_lite_inl.h>
+#include <google/protobuf/descriptor.h>
+#include <google/protobuf/generated_message_reflection.h>
+#include <google/protobuf/reflection_ops.h>
+#include <google/protobuf/wire_format.h>
+// @@protoc_insertion_point(includes)
+
+namespace pcl {
+namespace msgs {
+
+namespace {
+
+const ::google::protobuf::Descriptor* PackedPointCloud_descriptor_ = NULL;
+const ::google::protobuf::internal::GeneratedMessageReflection*
+  PackedPointCloud_reflection_ = NULL;
+const ::google::protobuf::Descriptor* PackedPointCloud_Field_descriptor_ = NULL;
+const ::google::protobuf::internal::GeneratedMessageReflection*
+  PackedPointCloud_Field_reflection_ = NULL;
+const ::google::protobuf::EnumDescriptor* PackedPointCloud_Field_DataType_descriptor_ = NULL;
+
+}  // namespace
+
+
+void protobuf_AssignDesc_packed_5fpoint_5fcloud_2eproto() {
+  protobuf_AddDesc_packed_5fpoint_5fcloud_2eproto();
+  const ::google::protobuf::FileDescriptor* file =
+    ::google::protobuf::DescriptorPool::generated_pool()->FindFileByName(
+      "packed_point_cloud.proto");
+  GOOGLE_CHECK(file != NULL);
+  PackedPointCloud_descriptor_ = file->message_type(0);
+  static const int PackedPointCloud_offsets_[8] = {
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PackedPointCloud, width_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PackedPointCloud, height_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PackedPointCloud, is_dense_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PackedPointCloud, fields_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PackedPointCloud, point_step_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PackedPointCloud, data_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PackedPointCloud, sequence_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PackedPointCloud, sim_time_),
+  };
+  PackedPointCloud_reflection_ =
+    new ::google::protobuf::internal::GeneratedMessageReflection(
+      PackedPointCloud_descriptor_,
+      PackedPointCloud::default_instance_,
+      PackedPointCloud_offsets_,
+      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PackedPointCloud, _has_bits_[0]),
+      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PackedPointCloud, _unknown_fields_),
+      -1,
+      ::google::protobuf::DescriptorPool::generated_pool(),
+      ::google::protobuf::MessageFactory::generated_factory(),
+      sizeof(PackedPointCloud));
+  PackedPointCloud_Field_descriptor_ = PackedPointCloud_descriptor_->nested_type(0);
+  static const int PackedPointCloud_Field_offsets_[3] = {
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PackedPointCloud_Field, name_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PackedPointCloud_Field, offset_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PackedPointCloud_Field, datatype_),
+  };
+  PackedPointCloud_Field_reflection_ =
+    new ::google::protobuf::internal::GeneratedMessageReflection(
+      PackedPointCloud_Field_descriptor_,
+      PackedPointCloud_Field::default_instance_,
+      PackedPointCloud_Field_offsets_,
+      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PackedPointCloud_Field, _has_bits_[0]),
+      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(PackedPointCloud_Field, _unknown_fields_),
+      -1,
+      ::google::protobuf::DescriptorPool::generated_pool(),
+      ::google::protobuf::MessageFactory::generated_factory(),
+      sizeof(PackedPointCloud_Field));
+  PackedPointCloud_Field_DataType_descriptor_ = PackedPointCloud_Field_descriptor_->enum_type(0);
+}
+
+namespace {
+
+GOOGLE_PROTOBUF_DECLARE_ONCE(protobuf_AssignDescriptors_once_);
+inline void protobuf_AssignDescriptorsOnce() {
+  ::google::protobuf::GoogleOnceInit(&protobuf_AssignDescriptors_once_,
+                 &protobuf_AssignDesc_packed_5fpoint_5fcloud_2eproto);
+}
+
+void protobuf_RegisterTypes(const ::std::string&) {
+  protobuf_AssignDescriptorsOnce();
+  ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
+    PackedPointCloud_descriptor_, &PackedPointCloud::default_instance());
+  ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
+    PackedPointCloud_Field_descriptor_, &PackedPointCloud_Field::default_instance());
+}
+
+}  // namespace
+
+void protobuf_ShutdownFile_packed_5fpoint_5fcloud_2eproto() {
+  delete PackedPointCloud::default_instance_;
+  delete PackedPointCloud_reflection_;
+  delete PackedPointCloud_Field::default_instance_;
+  delete PackedPointCloud_Field_reflection_;
+}
+
+void protobuf_AddDesc_packed_5fpoint_5fcloud_2eproto() {
+  static bool already_here = false;
+  if (already_here) return;
+  already_here = true;
+  GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+  ::google::protobuf::DescriptorPool::InternalAddGeneratedFile(
+    "\n\030packed_point_cloud.proto\022\010pcl.msgs\"\305\002\n"
+    "\020PackedPointCloud\022\r\n\005width\030\001 \002(\r\022\016\n\006heig"
+    "ht\030\002 \002(\r\022\020\n\010is_dense\030\003 \002(\010\0220\n\006fields\030\004 \003"
+    "(\0132 .pcl.msgs.PackedPointCloud.Field\022\022\n\n"
+    "point_step\030\005 \002(\r\022\014\n\004data\030\006 \002(\014\022\020\n\010sequen"
+    "ce\030\007 \001(\004\022\020\n\010sim_time\030\010 \001(\001\032\207\001\n\005Field\022\014\n\004"
+    "name\030\001 \002(\t\022\016\n\006offset\030\002 \002(\r\022;\n\010datatype\030\003"
+    " \002(\0162).pcl.msgs.PackedPointCloud.Field.D"
+    "ataType\"#\n\010DataType\022\013\n\007FLOAT32\020\001\022\n\n\006UINT"
+    "32\020\002", 364);
+  ::google::protobuf::MessageFactory::InternalRegisterGeneratedFile(
+    "packed_point_cloud.proto", &protobuf_RegisterTypes);
+  PackedPointCloud::default_instance_ = new PackedPointCloud();
+  PackedPointCloud_Field::default_instance_ = new PackedPointCloud_Field();
+  PackedPointCloud::default_instance_->InitAsDefaultInstance();
+  PackedPointCloud_Field::default_instance_->InitAsDefaultInstance();
+  ::google::protobuf::internal::OnShutdown(&protobuf_ShutdownFile_packed_5fpoint_5fcloud_2eproto);
+}
+
+// Force AddDescriptors() to be called at static initialization time.
+struct StaticDescriptorInitializer_packed_5fpoint_5fcloud_2eproto {
+  StaticDescriptorInitializer_packed_5fpoint_5fcloud_2eproto() {
+    protobuf_AddDesc_packed_5fpoint_5fcloud_2eproto();
+  }
+} static_descriptor_initializer_packed_5fpoint_5fcloud_2eproto_;
+
+// ===================================================================
+
+const ::google::protobuf::EnumDescriptor* PackedPointCloud_Field_DataType_descriptor() {
+  protobuf_AssignDescriptorsOnce();
+  return PackedPointCloud_Field_DataType_descriptor_;
+}
+bool PackedPointCloud_Field_DataType_IsValid(int value) {
+  switch(value) {
+    case 1:
+    case 2:
+      return true;
+    default:
+      return false;
+  }
+}
+
+#ifndef _MSC_VER
+const PackedPointCloud_Field_DataType PackedPointCloud_Field::FLOAT32;
+const PackedPointCloud_Field_DataType PackedPointCloud_Field::UINT32;
+const PackedPointCloud_Field_DataType PackedPointCloud_Field::DataType_MIN;
+const PackedPointCloud_Field_DataType PackedPointCloud_Field::DataType_MAX;
+const int PackedPointCloud_Field::DataType_ARRAYSIZE;
+#endif  // _MSC_VER
+#ifndef _MSC_VER
+const int PackedPointCloud_Field::kNameFieldNumber;
+const int PackedPointCloud_Field::kOffsetFieldNumber;
+const int PackedPointCloud_Field::kDatatypeFieldNumber;
+#endif  // !_MSC_VER
+
+PackedPointCloud_Field::PackedPointCloud_Field()
+  : ::google::protobuf::Message() {
+  SharedCtor();
+}
+
+void PackedPointCloud_Field::InitAsDefaultInstance() {
+}
+
+PackedPointCloud_Field::PackedPointCloud_Field(const PackedPointCloud_Field& from)
+  : ::google::protobuf::Message() {
+  SharedCtor();
+  MergeFrom(from);
+}
+
+void PackedPointCloud_Field::SharedCtor() {
+  _cached_size_ = 0;
+  name_ = const_cast< ::std::string*>(&::google::protobuf::internal::kEmptyString);
+  offset_ = 0u;
+  datatype_ = 1;
+  ::memset(_has_bits_, 0, sizeof(_has_bits_));
+}
+
+PackedPointCloud_Field::~PackedPointCloud_Field() {
+  SharedDtor();
+}
+
+void PackedPointCloud_Field::SharedDtor() {
+  if (name_ != &::google::protobuf::internal::kEmptyString) {
+    delete name_;
+  }
+  if (this != default_instance_) {
+  }
+}
+
+void PackedPointCloud_Field::SetCachedSize(int size) const {
+  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
+  _cached_size_ = size;
+  GOOGLE_SAFE_CONCURRENT_WRITES_END();
+}
+const ::google::protobuf::Descriptor* PackedPointCloud_Field::descriptor() {
+  protobuf_AssignDescriptorsOnce();
+  return PackedPointCloud_Field_descriptor_;
+}
+
+const PackedPointCloud_Field& PackedPointCloud_Field::default_instance() {
+  if (default_instance_ == NULL) protobuf_AddDesc_packed_5fpoint_5fcloud_2eproto();
+  return *default_instance_;
+}
+
+PackedPointCloud_Field* PackedPointCloud_Field::default_instance_ = NULL;
+
+PackedPointCloud_Field* PackedPointCloud_Field::New() const {
+  return new PackedPointCloud_Field;
+}
+
+void PackedPointCloud_Field::Clear() {
+  if (_has_bits_[0 / 32] & (0xffu << (0 % 32))) {
+    if (has_name()) {
+      if (name_ != &::google::protobuf::internal::kEmptyString) {
+        name_->clear();
+      }
+    }
+    offset_ = 0u;
+    datatype_ = 1;
+  }
+  ::memset(_has_bits_, 0, sizeof(_has_bits_));
+  mutable_unknown_fields()->Clear();
+}
+
+bool PackedPointCloud_Field::MergePartialFromCodedStream(
+    ::google::protobuf::io::CodedInputStream* input) {
+#define DO_(EXPRESSION) if (!(EXPRESSION)) return false
+  ::google::protobuf::uint32 tag;
+  while ((tag = input->ReadTag()) != 0) {
+    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+      // required string name = 1;
+      case 1: {
+        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
+            ::google::protobuf::internal::WireFormatLite::WIRETYPE_LENGTH_DELIMITED) {
+          DO_(::google::protobuf::internal::WireFormatLite::ReadString(
+                input, this->mutable_name()));
+          ::google::protobuf::internal::WireFormat::VerifyUTF8String(
+            this->name().data(), this->name().length(),
+            ::google::protobuf::internal::WireFormat::PARSE);
+        } else {
+          goto handle_uninterpreted;
+        }
+        if (input->ExpectTag(16)) goto parse_offset;
+        break;
+      }
+
+      // required uint32 offset = 2;
+      case 2: {
+        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
+            ::google::protobuf::internal::WireFormatLite::WIRETYPE_VARINT) {
+         parse_offset:
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   ::google::protobuf::uint32, ::google::protobuf::internal::WireFormatLite::TYPE_UINT32>(
+                 input, &offset_)));
+          set_has_offset();
+        } else {
+          goto handle_uninterpreted;
+        }
+        if (input->ExpectTag(24)) goto parse_datatype;
+        break;
+      }
+
+      // required .pcl.msgs.PackedPointCloud.Field.DataType datatype = 3;
+      case 3: {
+        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
+            ::google::protobuf::internal::WireFormatLite::WIRETYPE_VARINT) {
+         parse_datatype:
+          int value;
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   int, ::google::protobuf::internal::WireFormatLite::TYPE_ENUM>(
+                 input, &value)));
+          if (::pcl::msgs::PackedPointCloud_Field_DataType_IsValid(value)) {
+            set_datatype(static_cast< ::pcl::msgs::PackedPointCloud_Field_DataType >(value));
+          } else {
+            mutable_unknown_fields()->AddVarint(3, value);
+          }
+        } else {
+          goto handle_uninterpreted;
+        }
+        if (input->ExpectAtEnd()) return true;
+        break;
+      }
+
+      default: {
+      handle_uninterpreted:
+        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
+            ::google::protobuf::internal::WireFormatLite::WIRETYPE_END_GROUP) {
+          return true;
+        }
+        DO_(::google::protobuf::internal::WireFormat::SkipField(
+              input, tag, mutable_unknown_fields()));
+        break;
+      }
+    }
+  }
+  return true;
+#undef DO_
+}
+
+void PackedPointCloud_Field::SerializeWithCachedSizes(
+    ::google::protobuf::io::CodedOutputStream* output) const {
+  // required string name = 1;
+  if (has_name()) {
+    ::google::protobuf::internal::WireFormat::VerifyUTF8String(
+      this->name().data(), this->name().length(),
+      ::google::protobuf::internal::WireFormat::SERIALIZE);
+    ::google::protobuf::internal::WireFormatLite::WriteString(
+      1, this->name(), output);
+  }
+
+  // required uint32 offset = 2;
+  if (has_offset()) {
+    ::google::protobuf::internal::WireFormatLite::WriteUInt32(2, this->offset(), output);
+  }
+
+  // required .pcl.msgs.PackedPointCloud.Field.DataType datatype = 3;
+  if (has_datatype()) {
+    ::google::protobuf::internal::WireFormatLite::WriteEnum(
+      3, this->datatype(), output);
+  }
+
+  if (!unknown_fields().empty()) {
+    ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
+        unknown_fields(), output);
+  }
+}
+
+::google::protobuf::uint8* PackedPointCloud_Field::SerializeWithCachedSizesToArray(
+    ::google::protobuf::uint8* target) const {
+  // required string name = 1;
+  if (has_name()) {
+    ::google::protobuf::internal::WireFormat::VerifyUTF8String(
+      this->name().data(), this->name().length(),
+      ::google::protobuf::internal::WireFormat::SERIALIZE);
+    target =
+      ::google::protobuf::internal::WireFormatLite::WriteStringToArray(
+        1, this->name(), target);
+  }
+
+  // required uint32 offset = 2;
+  if (has_offset()) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteUInt32ToArray(2, this->offset(), target);
+  }
+
+  // required .pcl.msgs.PackedPointCloud.Field.DataType datatype = 3;
+  if (has_datatype()) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteEnumToArray(
+      3, this->datatype(), target);
+  }
+
+  if (!unknown_fields().empty()) {
+    target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
+        unknown_fields(), target);
+  }
+  return target;
+}
+
+int PackedPointCloud_Field::ByteSize() const {
+  int total_size = 0;
+
+  if (_has_bits_[0 / 32] & (0xffu << (0 % 32))) {
+    // required string name = 1;
+    if (has_name()) {
+      total_size += 1 +
+        ::google::protobuf::internal::WireFormatLite::StringSize(
+          this->name());
+    }
+
+    // required uint32 offset = 2;
+    if (has_offset()) {
+      total_size += 1 +
+        ::google::protobuf::internal::WireFormatLite::UInt32Size(
+          this->offset());
+    }
+
+    // required .pcl.msgs.PackedPointCloud.Field.DataType datatype = 3;
+    if (has_datatype()) {
+      total_size += 1 +
+        ::google::protobuf::internal::WireFormatLite::EnumSize(this->datatype());
+    }
+
+  }
+  if (!unknown_fields().empty()) {
+    total_size +=
+      ::google::protobuf::internal::WireFormat::ComputeUnknownFieldsSize(
+        unknown_fields());
+  }
+  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
+  _cached_size_ = total_size;
+  GOOGLE_SAFE_CONCURRENT_WRITES_END();
+  return total_size;
+}
+
+void PackedPointCloud_Field::MergeFrom(const ::google::protobuf::Message& from) {
+  GOOGLE_CHECK_NE(&from, this);
+  const PackedPointCloud_Field* source =
+    ::google::protobuf::internal::dynamic_cast_if_available<const PackedPointCloud_Field*>(
+      &from);
+  if (source == NULL) {
+    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
+  } else {
+    MergeFrom(*source);
+  }
+}
+
+void PackedPointCloud_Field::MergeFrom(const PackedPointCloud_Field& from) {
+  GOOGLE_CHECK_NE(&from, this);
+  if (from._has_bits_[0 / 32] & (0xffu << (0 % 32))) {
+    if (from.has_name()) {
+      set_name(from.name());
+    }
+    if (from.has_offset()) {
+      set_offset(from.offset());
+    }
+    if (from.has_datatype()) {
+      set_datatype(from.datatype());
+    }
+  }
+  mutable_unknown_fields()->MergeFrom(from.unknown_fields());
+}
+
+void PackedPointCloud_Field::CopyFrom(const ::google::protobuf::Message& from) {
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+void PackedPointCloud_Field::CopyFrom(const PackedPointCloud_Field& from) {
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool PackedPointCloud_Field::IsInitialized() const {
+  if ((_has_bits_[0] & 0x00000007) != 0x00000007) return false;
+
+  return true;
+}
+
+void PackedPointCloud_Field::Swap(PackedPointCloud_Field* other) {
+  if (other != this) {
+    std::swap(name_, other->name_);
+    std::swap(offset_, other->offset_);
+    std::swap(datatype_, other->datatype_);
+    std::swap(_has_bits_[0], other->_has_bits_[0]);
+    _unknown_fields_.Swap(&other->_unknown_fields_);
+    std::swap(_cached_size_, other->_cached_size_);
+  }
+}
+
+::google::protobuf::Metadata PackedPointCloud_Field::GetMetadata() const {
+  protobuf_AssignDescriptorsOnce();
+  ::google::protobuf::Metadata metadata;
+  metadata.descriptor = PackedPointCloud_Field_descriptor_;
+  metadata.reflection = PackedPointCloud_Field_reflection_;
+  return metadata;
+}
+
+
+// -------------------------------------------------------------------
+
+#ifndef _MSC_VER
+const int PackedPointCloud::kWidthFieldNumber;
+const int PackedPointCloud::kHeightFieldNumber;
+const int PackedPointCloud::kIsDenseFieldNumber;
+const int PackedPointCloud::kFieldsFieldNumber;
+const int PackedPointCloud::kPointStepFieldNumber;
+const int PackedPointCloud::kDataFieldNumber;
+const int PackedPointCloud::kSequenceFieldNumber;
+const int PackedPointCloud::kSimTimeFieldNumber;
+#endif  // !_MSC_VER
+
+PackedPointCloud::PackedPointCloud()
+  : ::google::protobuf::Message() {
+  SharedCtor();
+}
+
+void PackedPointCloud::InitAsDefaultInstance() {
+}
+
+PackedPointCloud::PackedPointCloud(const PackedPointCloud& from)
+  : ::google::protobuf::Message() {
+  SharedCtor();
+  MergeFrom(from);
+}
+
+void PackedPointCloud::SharedCtor() {
+  _cached_size_ = 0;
+  width_ = 0u;
+  height_ = 0u;
+  is_dense_ = false;
+  point_step_ = 0u;
+  data_ = const_cast< ::std::string*>(&::google::protobuf::internal::kEmptyString);
+  sequence_ = GOOGLE_ULONGLONG(0);
+  sim_time_ = 0;
+  ::memset(_has_bits_, 0, sizeof(_has_bits_));
+}
+
+PackedPointCloud::~PackedPointCloud() {
+  SharedDtor();
+}
+
+void PackedPointCloud::SharedDtor() {
+  if (data_ != &::google::protobuf::internal::kEmptyString) {
+    delete data_;
+  }
+  if (this != default_instance_) {
+  }
+}
+
+void PackedPointCloud::SetCachedSize(int size) const {
+  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
+  _cached_size_ = size;
+  GOOGLE_SAFE_CONCURRENT_WRITES_END();
+}
+const ::google::protobuf::Descriptor* PackedPointCloud::descriptor() {
+  protobuf_AssignDescriptorsOnce();
+  return PackedPointCloud_descriptor_;
+}
+
+const PackedPointCloud& PackedPointCloud::default_instance() {
+  if (default_instance_ == NULL) protobuf_AddDesc_packed_5fpoint_5fcloud_2eproto();
+  return *default_instance_;
+}
+
+PackedPointCloud* PackedPointCloud::default_instance_ = NULL;
+
+PackedPointCloud* PackedPointCloud::New() const {
+  return new PackedPointCloud;
+}
+
+void PackedPointCloud::Clear() {
+  if (_has_bits_[0 / 32] & (0xffu << (0 % 32))) {
+    width_ = 0u;
+    height_ = 0u;
+    is_dense_ = false;
+    point_step_ = 0u;
+    if (has_data()) {
+      if (data_ != &::google::protobuf::internal::kEmptyString) {
+        data_->clear();
+      }
+    }
+    sequence_ = GOOGLE_ULONGLONG(0);
+    sim_time_ = 0;
+  }
+  fields_.Clear();
+  ::memset(_has_bits_, 0, sizeof(_has_bits_));
+  mutable_unknown_fields()->Clear();
+}
+
+bool PackedPointCloud::MergePartialFromCodedStream(
+    ::google::protobuf::io::CodedInputStream* input) {
+#define DO_(EXPRESSION) if (!(EXPRESSION)) return false
+  ::google::protobuf::uint32 tag;
+  while ((tag = input->ReadTag()) != 0) {
+    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+      // required uint32 width = 1;
+      case 1: {
+        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
+            ::google::protobuf::internal::WireFormatLite::WIRETYPE_VARINT) {
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   ::google::protobuf::uint32, ::google::protobuf::internal::WireFormatLite::TYPE_UINT32>(
+                 input, &width_)));
+          set_has_width();
+        } else {
+          goto handle_uninterpreted;
+        }
+        if (input->ExpectTag(16)) goto parse_height;
+        break;
+      }
+
+      // required uint32 height = 2;
+      case 2: {
+        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
+            ::google::protobuf::internal::WireFormatLite::WIRETYPE_VARINT) {
+         parse_height:
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   ::google::protobuf::uint32, ::google::protobuf::internal::WireFormatLite::TYPE_UINT32>(
+                 input, &height_)));
+          set_has_height();
+        } else {
+          goto handle_uninterpreted;
+        }
+        if (input->ExpectTag(24)) goto parse_is_dense;
+        break;
+      }
+
+      // required bool is_dense = 3;
+      case 3: {
+        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
+            ::google::protobuf::internal::WireFormatLite::WIRETYPE_VARINT) {
+         parse_is_dense:
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   bool, ::google::protobuf::internal::WireFormatLite::TYPE_BOOL>(
+                 input, &is_dense_)));
+          set_has_is_dense();
+        } else {
+          goto handle_uninterpreted;
+        }
+        if (input->ExpectTag(34)) goto parse_fields;
+        break;
+      }
+
+      // repeated .pcl.msgs.PackedPointCloud.Field fields = 4;
+      case 4: {
+        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
+            ::google::protobuf::internal::WireFormatLite::WIRETYPE_LENGTH_DELIMITED) {
+         parse_fields:
+          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
+                input, add_fields()));
+        } else {
+          goto handle_uninterpreted;
+        }
+        if (input->ExpectTag(34)) goto parse_fields;
+        if (input->ExpectTag(40)) goto parse_point_step;
+        break;
+      }
+
+      // required uint32 point_step = 5;
+      case 5: {
+        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
+            ::google::protobuf::internal::WireFormatLite::WIRETYPE_VARINT) {
+         parse_point_step:
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   ::google::protobuf::uint32, ::google::protobuf::internal::WireFormatLite::TYPE_UINT32>(
+                 input, &point_step_)));
+          set_has_point_step();
+        } else {
+          goto handle_uninterpreted;
+        }
+        if (input->ExpectTag(50)) goto parse_data;
+        break;
+      }
+
+      // required bytes data = 6;
+      case 6: {
+        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
+            ::google::protobuf::internal::WireFormatLite::WIRETYPE_LENGTH_DELIMITED) {
+         parse_data:
+          DO_(::google::protobuf::internal::WireFormatLite::ReadBytes(
+                input, this->mutable_data()));
+        } else {
+          goto handle_uninterpreted;
+        }
+        if (input->ExpectTag(56)) goto parse_sequence;
+        break;
+      }
+
+      // optional uint64 sequence = 7;
+      case 7: {
+        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
+            ::google::protobuf::internal::WireFormatLite::WIRETYPE_VARINT) {
+         parse_sequence:
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   ::google::protobuf::uint64, ::google::protobuf::internal::WireFormatLite::TYPE_UINT64>(
+                 input, &sequence_)));
+          set_has_sequence();
+        } else {
+          goto handle_uninterpreted;
+        }
+        if (input->ExpectTag(65)) goto parse_sim_time;
+        break;
+      }
+
+      // optional double sim_time = 8;
+      case 8: {
+        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
+            ::google::protobuf::internal::WireFormatLite::WIRETYPE_FIXED64) {
+         parse_sim_time:
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   double, ::google::protobuf::internal::WireFormatLite::TYPE_DOUBLE>(
+                 input, &sim_time_)));
+          set_has_sim_time();
+        } else {
+          goto handle_uninterpreted;
+        }
+        if (input->ExpectAtEnd()) return true;
+        break;
+      }
+
+      default: {
+      handle_uninterpreted:
+        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
+            ::google::protobuf::internal::WireFormatLite::WIRETYPE_END_GROUP) {
+          return true;
+        }
+        DO_(::google::protobuf::internal::WireFormat::SkipField(
+              input, tag, mutable_unknown_fields()));
+        break;
+      }
+    }
+  }
+  return true;
+#undef DO_
+}
+
+void PackedPointCloud::SerializeWithCachedSizes(
+    ::google::protobuf::io::CodedOutputStream* output) const {
+  // required uint32 width = 1;
+  if (has_width()) {
+    ::google::protobuf::internal::WireFormatLite::WriteUInt32(1, this->width(), output);
+  }
+
+  // required uint32 height = 2;
+  if (has_height()) {
+    ::google::protobuf::internal::WireFormatLite::WriteUInt32(2, this->height(), output);
+  }
+
+  // required bool is_dense = 3;
+  if (has_is_dense()) {
+    ::google::protobuf::internal::WireFormatLite::WriteBool(3, this->is_dense(), output);
+  }
+
+  // repeated .pcl.msgs.PackedPointCloud.Field fields = 4;
+  for (int i = 0; i < this->fields_size(); i++) {
+    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
+      4, this->fields(i), output);
+  }
+
+  // required uint32 point_step = 5;
+  if (has_point_step()) {
+    ::google::protobuf::internal::WireFormatLite::WriteUInt32(5, this->point_step(), output);
+  }
+
+  // required bytes data = 6;
+  if (has_data()) {
+    ::google::protobuf::internal::WireFormatLite::WriteBytes(
+      6, this->data(), output);
+  }
+
+  // optional uint64 sequence = 7;
+  if (has_sequence()) {
+    ::google::protobuf::internal::WireFormatLite::WriteUInt64(7, this->sequence(), output);
+  }
+
+  // optional double sim_time = 8;
+  if (has_sim_time()) {
+    ::google::protobuf::internal::WireFormatLite::WriteDouble(8, this->sim_time(), output);
+  }
+
+  if (!unknown_fields().empty()) {
+    ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
+        unknown_fields(), output);
+  }
+}
+
+::google::protobuf::uint8* PackedPointCloud::SerializeWithCachedSizesToArray(
+    ::google::protobuf::uint8* target) const {
+  // required uint32 width = 1;
+  if (has_width()) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteUInt32ToArray(1, this->width(), target);
+  }
+
+  // required uint32 height = 2;
+  if (has_height()) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteUInt32ToArray(2, this->height(), target);
+  }
+
+  // required bool is_dense = 3;
+  if (has_is_dense()) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteBoolToArray(3, this->is_dense(), target);
+  }
+
+  // repeated .pcl.msgs.PackedPointCloud.Field fields = 4;
+  for (int i = 0; i < this->fields_size(); i++) {
+    target = ::google::protobuf::internal::WireFormatLite::
+      WriteMessageNoVirtualToArray(
+        4, this->fields(i), target);
+  }
+
+  // required uint32 point_step = 5;
+  if (has_point_step()) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteUInt32ToArray(5, this->point_step(), target);
+  }
+
+  // required bytes data = 6;
+  if (has_data()) {
+    target =
+      ::google::protobuf::internal::WireFormatLite::WriteBytesToArray(
+        6, this->data(), target);
+  }
+
+  // optional uint64 sequence = 7;
+  if (has_sequence()) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteUInt64ToArray(7, this->sequence(), target);
+  }
+
+  // optional double sim_time = 8;
+  if (has_sim_time()) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteDoubleToArray(8, this->sim_time(), target);
+  }
+
+  if (!unknown_fields().empty()) {
+    target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
+        unknown_fields(), target);
+  }
+  return target;
+}
+
+int PackedPointCloud::ByteSize() const {
+  int total_size = 0;
+
+  if (_has_bits_[0 / 32] & (0xffu << (0 % 32))) {
+    // required uint32 width = 1;
+    if (has_width()) {
+      total_size += 1 +
+        ::google::protobuf::internal::WireFormatLite::UInt32Size(
+          this->width());
+    }
+
+    // required uint32 height = 2;
+    if (has_height()) {
+      total_size += 1 +
+        ::google::protobuf::internal::WireFormatLite::UInt32Size(
+          this->height());
+    }
+
+    // required bool is_dense = 3;
+    if (has_is_dense()) {
+      total_size += 1 + 1;
+    }
+
+    // required uint32 point_step = 5;
+    if (has_point_step()) {
+      total_size += 1 +
+        ::google::protobuf::internal::WireFormatLite::UInt32Size(
+          this->point_step());
+    }
+
+    // required bytes data = 6;
+    if (has_data()) {
+      total_size += 1 +
+        ::google::protobuf::internal::WireFormatLite::BytesSize(
+          this->data());
+    }
+
+    // optional uint64 sequence = 7;
+    if (has_sequence()) {
+      total_size += 1 +
+        ::google::protobuf::internal::WireFormatLite::UInt64Size(
+          this->sequence());
+    }
+
+    // optional double sim_time = 8;
+    if (has_sim_time()) {
+      total_size += 1 + 8;
+    }
+
+  }
+  // repeated .pcl.msgs.PackedPointCloud.Field fields = 4;
+  total_size += 1 * this->fields_size();
+  for (int i = 0; i < this->fields_size(); i++) {
+    total_size +=
+      ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
+        this->fields(i));
+  }
+
+  if (!unknown_fields().empty()) {
+    total_size +=
+      ::google::protobuf::internal::WireFormat::ComputeUnknownFieldsSize(
+        unknown_fields());
+  }
+  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
+  _cached_size_ = total_size;
+  GOOGLE_SAFE_CONCURRENT_WRITES_END();
+  return total_size;
+}
+
+void PackedPointCloud::MergeFrom(const ::google::protobuf::Message& from) {
+  GOOGLE_CHECK_NE(&from, this);
+  const PackedPointCloud* source =
+    ::google::protobuf::internal::dynamic_cast_if_available<const PackedPointCloud*>(
+      &from);
+  if (source == NULL) {
+    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
+  } else {
+    MergeFrom(*source);
+  }
+}
+
+void PackedPointCloud::MergeFrom(const PackedPointCloud& from) {
+  GOOGLE_CHECK_NE(&from, this);
+  fields_.MergeFrom(from.fields_);
+  if (from._has_bits_[0 / 32] & (0xffu << (0 % 32))) {
+    if (from.has_width()) {
+      set_width(from.width());
+    }
+    if (from.has_height()) {
+      set_height(from.height());
+    }
+    if (from.has_is_dense()) {
+      set_is_dense(from.is_dense());
+    }
+    if (from.has_point_step()) {
+      set_point_step(from.point_step());
+    }
+    if (from.has_data()) {
+      set_data(from.data());
+    }
+    if (from.has_sequence()) {
+      set_sequence(from.sequence());
+    }
+    if (from.has_sim_time()) {
+      set_sim_time(from.sim_time());
+    }
+  }
+  mutable_unknown_fields()->MergeFrom(from.unknown_fields());
+}
+
+void PackedPointCloud::CopyFrom(const ::google::protobuf::Message& from) {
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+void PackedPointCloud::CopyFrom(const PackedPointCloud& from) {
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool PackedPointCloud::IsInitialized() const {
+  if ((_has_bits_[0] & 0x00000037) != 0x00000037) return false;
+
+  for (int i = 0; i < fields_size(); i++) {
+    if (!this->fields(i).IsInitialized()) return false;
+  }
+  return true;
+}
+
+void PackedPointCloud::Swap(PackedPointCloud* other) {
+  if (other != this) {
+    std::swap(width_, other->width_);
+    std::swap(height_, other->height_);
+    std::swap(is_dense_, other->is_dense_);
+    fields_.Swap(&other->fields_);
+    std::swap(point_step_, other->point_step_);
+    std::swap(data_, other->data_);
+    std::swap(sequence_, other->sequence_);
+    std::swap(sim_time_, other->sim_time_);
+    std::swap(_has_bits_[0], other->_has_bits_[0]);
+    _unknown_fields_.Swap(&other->_unknown_fields_);
+    std::swap(_cached_size_, other->_cached_size_);
+  }
+}
+
+::google::protobuf::Metadata PackedPointCloud::GetMetadata() const {
+  protobuf_AssignDescriptorsOnce();
+  ::google::protobuf::Metadata metadata;
+  metadata.descriptor = PackedPointCloud_descriptor_;
+  metadata.reflection = PackedPointCloud_reflection_;
+  return metadata;
+}
+
+
+// @@protoc_insertion_point(namespace_scope)
+
+}  // namespace msgs
+}  // namespace pcl
+
+// @@protoc_insertion_point(global_scope)
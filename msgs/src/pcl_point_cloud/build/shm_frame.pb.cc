@@ -0,0 +1,576 @@
+// Generated by the protocol buffer compiler.  DO NOT EDIT!
+// source: shm_frame.proto
+
+#define INTERNAL_SUPPRESS_PROTOBUF_FIELD_DEPRECATION
+#include "shm_frame.pb.h"
+
+#include <algorithm>
+
+#include <google/protobuf/stubs/common.h>
+#include <google/protobuf/stubs/once.h>
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/wire_format_lite_inl.h>
+#include <google/protobuf/descriptor.h>
+#include <google/protobuf/generated_message_reflection.h>
+#include <google/protobuf/reflection_ops.h>
+#include <google/protobuf/wire_format.h>
+// @@protoc_insertion_point(includes)
+
+namespace pcl {
+namespace msgs {
+
+namespace {
+
+const ::google::protobuf::Descriptor* SharedMemoryFrame_descriptor_ = NULL;
+const ::google::protobuf::internal::GeneratedMessageReflection*
+  SharedMemoryFrame_reflection_ = NULL;
+
+}  // namespace
+
+
+void protobuf_AssignDesc_shm_5fframe_2eproto() {
+  protobuf_AddDesc_shm_5fframe_2eproto();
+  const ::google::protobuf::FileDescriptor* file =
+    ::google::protobuf::DescriptorPool::generated_pool()->FindFileByName(
+      "shm_frame.proto");
+  GOOGLE_CHECK(file != NULL);
+  SharedMemoryFrame_descriptor_ = file->message_type(0);
+  static const int SharedMemoryFrame_offsets_[7] = {
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(SharedMemoryFrame, shm_name_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(SharedMemoryFrame, frame_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(SharedMemoryFrame, slot_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(SharedMemoryFrame, width_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(SharedMemoryFrame, height_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(SharedMemoryFrame, sequence_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(SharedMemoryFrame, sim_time_),
+  };
+  SharedMemoryFrame_reflection_ =
+    new ::google::protobuf::internal::GeneratedMessageReflection(
+      SharedMemoryFrame_descriptor_,
+      SharedMemoryFrame::default_instance_,
+      SharedMemoryFrame_offsets_,
+      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(SharedMemoryFrame, _has_bits_[0]),
+      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(SharedMemoryFrame, _unknown_fields_),
+      -1,
+      ::google::protobuf::DescriptorPool::generated_pool(),
+      ::google::protobuf::MessageFactory::generated_factory(),
+      sizeof(SharedMemoryFrame));
+}
+
+namespace {
+
+GOOGLE_PROTOBUF_DECLARE_ONCE(protobuf_AssignDescriptors_once_);
+inline void protobuf_AssignDescriptorsOnce() {
+  ::google::protobuf::GoogleOnceInit(&protobuf_AssignDescriptors_once_,
+                 &protobuf_AssignDesc_shm_5fframe_2eproto);
+}
+
+void protobuf_RegisterTypes(const ::std::string&) {
+  protobuf_AssignDescriptorsOnce();
+  ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
+    SharedMemoryFrame_descriptor_, &SharedMemoryFrame::default_instance());
+}
+
+}  // namespace
+
+void protobuf_ShutdownFile_shm_5fframe_2eproto() {
+  delete SharedMemoryFrame::default_instance_;
+  delete SharedMemoryFrame_reflection_;
+}
+
+void protobuf_AddDesc_shm_5fframe_2eproto() {
+  static bool already_here = false;
+  if (already_here) return;
+  already_here = true;
+  GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+  ::google::protobuf::DescriptorPool::InternalAddGeneratedFile(
+    "\n\017shm_frame.proto\022\010pcl.msgs\"\205\001\n\021SharedMe"
+    "moryFrame\022\020\n\010shm_name\030\001 \002(\t\022\r\n\005frame\030\002 \002"
+    "(\004\022\014\n\004slot\030\003 \002(\r\022\r\n\005width\030\004 \002(\r\022\016\n\006heigh"
+    "t\030\005 \002(\r\022\020\n\010sequence\030\006 \001(\004\022\020\n\010sim_time\030\007 "
+    "\001(\001", 163);
+  ::google::protobuf::MessageFactory::InternalRegisterGeneratedFile(
+    "shm_frame.proto", &protobuf_RegisterTypes);
+  SharedMemoryFrame::default_instance_ = new SharedMemoryFrame();
+  SharedMemoryFrame::default_instance_->InitAsDefaultInstance();
+  ::google::protobuf::internal::OnShutdown(&protobuf_ShutdownFile_shm_5fframe_2eproto);
+}
+
+// Force AddDescriptors() to be called at static initialization time.
+struct StaticDescriptorInitializer_shm_5fframe_2eproto {
+  StaticDescriptorInitializer_shm_5fframe_2eproto() {
+    protobuf_AddDesc_shm_5fframe_2eproto();
+  }
+} static_descriptor_initializer_shm_5fframe_2eproto_;
+
+// ===================================================================
+
+#ifndef _MSC_VER
+const int SharedMemoryFrame::kShmNameFieldNumber;
+const int SharedMemoryFrame::kFrameFieldNumber;
+const int SharedMemoryFrame::kSlotFieldNumber;
+const int SharedMemoryFrame::kWidthFieldNumber;
+const int SharedMemoryFrame::kHeightFieldNumber;
+const int SharedMemoryFrame::kSequenceFieldNumber;
+const int SharedMemoryFrame::kSimTimeFieldNumber;
+#endif  // !_MSC_VER
+
+SharedMemoryFrame::SharedMemoryFrame()
+  : ::google::protobuf::Message() {
+  SharedCtor();
+}
+
+void SharedMemoryFrame::InitAsDefaultInstance() {
+}
+
+SharedMemoryFrame::SharedMemoryFrame(const SharedMemoryFrame& from)
+  : ::google::protobuf::Message() {
+  SharedCtor();
+  MergeFrom(from);
+}
+
+void SharedMemoryFrame::SharedCtor() {
+  _cached_size_ = 0;
+  shm_name_ = const_cast< ::std::string*>(&::google::protobuf::internal::kEmptyString);
+  frame_ = GOOGLE_ULONGLONG(0);
+  slot_ = 0u;
+  width_ = 0u;
+  height_ = 0u;
+  sequence_ = GOOGLE_ULONGLONG(0);
+  sim_time_ = 0;
+  ::memset(_has_bits_, 0, sizeof(_has_bits_));
+}
+
+SharedMemoryFrame::~SharedMemoryFrame() {
+  SharedDtor();
+}
+
+void SharedMemoryFrame::SharedDtor() {
+  if (shm_name_ != &::google::protobuf::internal::kEmptyString) {
+    delete shm_name_;
+  }
+  if (this != default_instance_) {
+  }
+}
+
+void SharedMemoryFrame::SetCachedSize(int size) const {
+  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
+  _cached_size_ = size;
+  GOOGLE_SAFE_CONCURRENT_WRITES_END();
+}
+const ::google::protobuf::Descriptor* SharedMemoryFrame::descriptor() {
+  protobuf_AssignDescriptorsOnce();
+  return SharedMemoryFrame_descriptor_;
+}
+
+const SharedMemoryFrame& SharedMemoryFrame::default_instance() {
+  if (default_instance_ == NULL) protobuf_AddDesc_shm_5fframe_2eproto();
+  return *default_instance_;
+}
+
+SharedMemoryFrame* SharedMemoryFrame::default_instance_ = NULL;
+
+SharedMemoryFrame* SharedMemoryFrame::New() const {
+  return new SharedMemoryFrame;
+}
+
+void SharedMemoryFrame::Clear() {
+  if (_has_bits_[0 / 32] & (0xffu << (0 % 32))) {
+    if (has_shm_name()) {
+      if (shm_name_ != &::google::protobuf::internal::kEmptyString) {
+        shm_name_->clear();
+      }
+    }
+    frame_ = GOOGLE_ULONGLONG(0);
+    slot_ = 0u;
+    width_ = 0u;
+    height_ = 0u;
+    sequence_ = GOOGLE_ULONGLONG(0);
+    sim_time_ = 0;
+  }
+  ::memset(_has_bits_, 0, sizeof(_has_bits_));
+  mutable_unknown_fields()->Clear();
+}
+
+bool SharedMemoryFrame::MergePartialFromCodedStream(
+    ::google::protobuf::io::CodedInputStream* input) {
+#define DO_(EXPRESSION) if (!(EXPRESSION)) return false
+  ::google::protobuf::uint32 tag;
+  while ((tag = input->ReadTag()) != 0) {
+    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+      // required string shm_name = 1;
+      case 1: {
+        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
+            ::google::protobuf::internal::WireFormatLite::WIRETYPE_LENGTH_DELIMITED) {
+          DO_(::google::protobuf::internal::WireFormatLite::ReadString(
+                input, this->mutable_shm_name()));
+          ::google::protobuf::internal::WireFormat::VerifyUTF8String(
+            this->shm_name().data(), this->shm_name().length(),
+            ::google::protobuf::internal::WireFormat::PARSE);
+        } else {
+          goto handle_uninterpreted;
+        }
+        if (input->ExpectTag(16)) goto parse_frame;
+        break;
+      }
+
+      // required uint64 frame = 2;
+      case 2: {
+        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
+            ::google::protobuf::internal::WireFormatLite::WIRETYPE_VARINT) {
+         parse_frame:
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   ::google::protobuf::uint64, ::google::protobuf::internal::WireFormatLite::TYPE_UINT64>(
+                 input, &frame_)));
+          set_has_frame();
+        } else {
+          goto handle_uninterpreted;
+        }
+        if (input->ExpectTag(24)) goto parse_slot;
+        break;
+      }
+
+      // required uint32 slot = 3;
+      case 3: {
+        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
+            ::google::protobuf::internal::WireFormatLite::WIRETYPE_VARINT) {
+         parse_slot:
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   ::google::protobuf::uint32, ::google::protobuf::internal::WireFormatLite::TYPE_UINT32>(
+                 input, &slot_)));
+          set_has_slot();
+        } else {
+          goto handle_uninterpreted;
+        }
+        if (input->ExpectTag(32)) goto parse_width;
+        break;
+      }
+
+      // required uint32 width = 4;
+      case 4: {
+        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
+            ::google::protobuf::internal::WireFormatLite::WIRETYPE_VARINT) {
+         parse_width:
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   ::google::protobuf::uint32, ::google::protobuf::internal::WireFormatLite::TYPE_UINT32>(
+                 input, &width_)));
+          set_has_width();
+        } else {
+          goto handle_uninterpreted;
+        }
+        if (input->ExpectTag(40)) goto parse_height;
+        break;
+      }
+
+      // required uint32 height = 5;
+      case 5: {
+        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
+            ::google::protobuf::internal::WireFormatLite::WIRETYPE_VARINT) {
+         parse_height:
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   ::google::protobuf::uint32, ::google::protobuf::internal::WireFormatLite::TYPE_UINT32>(
+                 input, &height_)));
+          set_has_height();
+        } else {
+          goto handle_uninterpreted;
+        }
+        if (input->ExpectTag(48)) goto parse_sequence;
+        break;
+      }
+
+      // optional uint64 sequence = 6;
+      case 6: {
+        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
+            ::google::protobuf::internal::WireFormatLite::WIRETYPE_VARINT) {
+         parse_sequence:
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   ::google::protobuf::uint64, ::google::protobuf::internal::WireFormatLite::TYPE_UINT64>(
+                 input, &sequence_)));
+          set_has_sequence();
+        } else {
+          goto handle_uninterpreted;
+        }
+        if (input->ExpectTag(57)) goto parse_sim_time;
+        break;
+      }
+
+      // optional double sim_time = 7;
+      case 7: {
+        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
+            ::google::protobuf::internal::WireFormatLite::WIRETYPE_FIXED64) {
+         parse_sim_time:
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   double, ::google::protobuf::internal::WireFormatLite::TYPE_DOUBLE>(
+                 input, &sim_time_)));
+          set_has_sim_time();
+        } else {
+          goto handle_uninterpreted;
+        }
+        if (input->ExpectAtEnd()) return true;
+        break;
+      }
+
+      default: {
+      handle_uninterpreted:
+        if (::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
+            ::google::protobuf::internal::WireFormatLite::WIRETYPE_END_GROUP) {
+          return true;
+        }
+        DO_(::google::protobuf::internal::WireFormat::SkipField(
+              input, tag, mutable_unknown_fields()));
+        break;
+      }
+    }
+  }
+  return true;
+#undef DO_
+}
+
+void SharedMemoryFrame::SerializeWithCachedSizes(
+    ::google::protobuf::io::CodedOutputStream* output) const {
+  // required string shm_name = 1;
+  if (has_shm_name()) {
+    ::google::protobuf::internal::WireFormat::VerifyUTF8String(
+      this->shm_name().data(), this->shm_name().length(),
+      ::google::protobuf::internal::WireFormat::SERIALIZE);
+    ::google::protobuf::internal::WireFormatLite::WriteString(
+      1, this->shm_name(), output);
+  }
+
+  // required uint64 frame = 2;
+  if (has_frame()) {
+    ::google::protobuf::internal::WireFormatLite::WriteUInt64(2, this->frame(), output);
+  }
+
+  // required uint32 slot = 3;
+  if (has_slot()) {
+    ::google::protobuf::internal::WireFormatLite::WriteUInt32(3, this->slot(), output);
+  }
+
+  // required uint32 width = 4;
+  if (has_width()) {
+    ::google::protobuf::internal::WireFormatLite::WriteUInt32(4, this->width(), output);
+  }
+
+  // required uint32 height = 5;
+  if (has_height()) {
+    ::google::protobuf::internal::WireFormatLite::WriteUInt32(5, this->height(), output);
+  }
+
+  // optional uint64 sequence = 6;
+  if (has_sequence()) {
+    ::google::protobuf::internal::WireFormatLite::WriteUInt64(6, this->sequence(), output);
+  }
+
+  // optional double sim_time = 7;
+  if (has_sim_time()) {
+    ::google::protobuf::internal::WireFormatLite::WriteDouble(7, this->sim_time(), output);
+  }
+
+  if (!unknown_fields().empty()) {
+    ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
+        unknown_fields(), output);
+  }
+}
+
+::google::protobuf::uint8* SharedMemoryFrame::SerializeWithCachedSizesToArray(
+    ::google::protobuf::uint8* target) const {
+  // required string shm_name = 1;
+  if (has_shm_name()) {
+    ::google::protobuf::internal::WireFormat::VerifyUTF8String(
+      this->shm_name().data(), this->shm_name().length(),
+      ::google::protobuf::internal::WireFormat::SERIALIZE);
+    target =
+      ::google::protobuf::internal::WireFormatLite::WriteStringToArray(
+        1, this->shm_name(), target);
+  }
+
+  // required uint64 frame = 2;
+  if (has_frame()) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteUInt64ToArray(2, this->frame(), target);
+  }
+
+  // required uint32 slot = 3;
+  if (has_slot()) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteUInt32ToArray(3, this->slot(), target);
+  }
+
+  // required uint32 width = 4;
+  if (has_width()) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteUInt32ToArray(4, this->width(), target);
+  }
+
+  // required uint32 height = 5;
+  if (has_height()) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteUInt32ToArray(5, this->height(), target);
+  }
+
+  // optional uint64 sequence = 6;
+  if (has_sequence()) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteUInt64ToArray(6, this->sequence(), target);
+  }
+
+  // optional double sim_time = 7;
+  if (has_sim_time()) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteDoubleToArray(7, this->sim_time(), target);
+  }
+
+  if (!unknown_fields().empty()) {
+    target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
+        unknown_fields(), target);
+  }
+  return target;
+}
+
+int SharedMemoryFrame::ByteSize() const {
+  int total_size = 0;
+
+  if (_has_bits_[0 / 32] & (0xffu << (0 % 32))) {
+    // required string shm_name = 1;
+    if (has_shm_name()) {
+      total_size += 1 +
+        ::google::protobuf::internal::WireFormatLite::StringSize(
+          this->shm_name());
+    }
+
+    // required uint64 frame = 2;
+    if (has_frame()) {
+      total_size += 1 +
+        ::google::protobuf::internal::WireFormatLite::UInt64Size(
+          this->frame());
+    }
+
+    // required uint32 slot = 3;
+    if (has_slot()) {
+      total_size += 1 +
+        ::google::protobuf::internal::WireFormatLite::UInt32Size(
+          this->slot());
+    }
+
+    // required uint32 width = 4;
+    if (has_width()) {
+      total_size += 1 +
+        ::google::protobuf::internal::WireFormatLite::UInt32Size(
+          this->width());
+    }
+
+    // required uint32 height = 5;
+    if (has_height()) {
+      total_size += 1 +
+        ::google::protobuf::internal::WireFormatLite::UInt32Size(
+          this->height());
+    }
+
+    // optional uint64 sequence = 6;
+    if (has_sequence()) {
+      total_size += 1 +
+        ::google::protobuf::internal::WireFormatLite::UInt64Size(
+          this->sequence());
+    }
+
+    // optional double sim_time = 7;
+    if (has_sim_time()) {
+      total_size += 1 + 8;
+    }
+
+  }
+  if (!unknown_fields().empty()) {
+    total_size +=
+      ::google::protobuf::internal::WireFormat::ComputeUnknownFieldsSize(
+        unknown_fields());
+  }
+  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
+  _cached_size_ = total_size;
+  GOOGLE_SAFE_CONCURRENT_WRITES_END();
+  return total_size;
+}
+
+void SharedMemoryFrame::MergeFrom(const ::google::protobuf::Message& from) {
+  GOOGLE_CHECK_NE(&from, this);
+  const SharedMemoryFrame* source =
+    ::google::protobuf::internal::dynamic_cast_if_available<const SharedMemoryFrame*>(
+      &from);
+  if (source == NULL) {
+    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
+  } else {
+    MergeFrom(*source);
+  }
+}
+
+void SharedMemoryFrame::MergeFrom(const SharedMemoryFrame& from) {
+  GOOGLE_CHECK_NE(&from, this);
+  if (from._has_bits_[0 / 32] & (0xffu << (0 % 32))) {
+    if (from.has_shm_name()) {
+      set_shm_name(from.shm_name());
+    }
+    if (from.has_frame()) {
+      set_frame(from.frame());
+    }
+    if (from.has_slot()) {
+      set_slot(from.slot());
+    }
+    if (from.has_width()) {
+      set_width(from.width());
+    }
+    if (from.has_height()) {
+      set_height(from.height());
+    }
+    if (from.has_sequence()) {
+      set_sequence(from.sequence());
+    }
+    if (from.has_sim_time()) {
+      set_sim_time(from.sim_time());
+    }
+  }
+  mutable_unknown_fields()->MergeFrom(from.unknown_fields());
+}
+
+void SharedMemoryFrame::CopyFrom(const ::google::protobuf::Message& from) {
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+void SharedMemoryFrame::CopyFrom(const SharedMemoryFrame& from) {
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool SharedMemoryFrame::IsInitialized() const {
+  if ((_has_bits_[0] & 0x0000001f) != 0x0000001f) return false;
+
+  return true;
+}
+
+void SharedMemoryFrame::Swap(SharedMemoryFrame* other) {
+  if (other != this) {
+    std::swap(shm_name_, other->shm_name_);
+    std::swap(frame_, other->frame_);
+    std::swap(slot_, other->slot_);
+    std::swap(width_, other->width_);
+    std::swap(height_, other->height_);
+    std::swap(sequence_, other->sequence_);
+    std::swap(sim_time_, other->sim_time_);
+    std::swap(_has_bits_[0], other->_has_bits_[0]);
+    _unknown_fields_.Swap(&other->_unknown_fields_);
+    std::swap(_cached_size_, other->_cached_size_);
+  }
+}
+
+::google::protobuf::Metadata SharedMemoryFrame::GetMetadata() const {
+  protobuf_AssignDescriptorsOnce();
+  ::google::protobuf::Metadata metadata;
+  metadata.descriptor = SharedMemoryFrame_descriptor_;
+  metadata.reflection = SharedMemoryFrame_reflection_;
+  return metadata;
+}
+
+
+// @@protoc_insertion_point(namespace_scope)
+
+}  // namespace msgs
+}  // namespace pcl
+
+// @@protoc_insertion_point(global_scope)
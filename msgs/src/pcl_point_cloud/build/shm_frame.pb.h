@@ -0,0 +1,412 @@
+// Generated by the protocol buffer compiler.  DO NOT EDIT!
+// source: shm_frame.proto
+
+#ifndef PROTOBUF_shm_5fframe_2eproto__INCLUDED
+#define PROTOBUF_shm_5fframe_2eproto__INCLUDED
+
+#include <string>
+
+#include <google/protobuf/stubs/common.h>
+
+#if GOOGLE_PROTOBUF_VERSION < 2005000
+#error This file was generated by a newer version of protoc which is
+#error incompatible with your Protocol Buffer headers.  Please update
+#error your headers.
+#endif
+#if 2005000 < GOOGLE_PROTOBUF_MIN_PROTOC_VERSION
+#error This file was generated by an older version of protoc which is
+#error incompatible with your Protocol Buffer headers.  Please
+#error regenerate this file with a newer version of protoc.
+#endif
+
+#include <google/protobuf/generated_message_util.h>
+#include <google/protobuf/message.h>
+#include <google/protobuf/repeated_field.h>
+#include <google/protobuf/extension_set.h>
+#include <google/protobuf/unknown_field_set.h>
+// @@protoc_insertion_point(includes)
+
+namespace pcl {
+namespace msgs {
+
+// Internal implementation detail -- do not call these.
+void  protobuf_AddDesc_shm_5fframe_2eproto();
+void protobuf_AssignDesc_shm_5fframe_2eproto();
+void protobuf_ShutdownFile_shm_5fframe_2eproto();
+
+class SharedMemoryFrame;
+
+// ===================================================================
+
+class SharedMemoryFrame : public ::google::protobuf::Message {
+ public:
+  SharedMemoryFrame();
+  virtual ~SharedMemoryFrame();
+
+  SharedMemoryFrame(const SharedMemoryFrame& from);
+
+  inline SharedMemoryFrame& operator=(const SharedMemoryFrame& from) {
+    CopyFrom(from);
+    return *this;
+  }
+
+  inline const ::google::protobuf::UnknownFieldSet& unknown_fields() const {
+    return _unknown_fields_;
+  }
+
+  inline ::google::protobuf::UnknownFieldSet* mutable_unknown_fields() {
+    return &_unknown_fields_;
+  }
+
+  static const ::google::protobuf::Descriptor* descriptor();
+  static const SharedMemoryFrame& default_instance();
+
+  void Swap(SharedMemoryFrame* other);
+
+  // implements Message ----------------------------------------------
+
+  SharedMemoryFrame* New() const;
+  void CopyFrom(const ::google::protobuf::Message& from);
+  void MergeFrom(const ::google::protobuf::Message& from);
+  void CopyFrom(const SharedMemoryFrame& from);
+  void MergeFrom(const SharedMemoryFrame& from);
+  void Clear();
+  bool IsInitialized() const;
+
+  int ByteSize() const;
+  bool MergePartialFromCodedStream(
+      ::google::protobuf::io::CodedInputStream* input);
+  void SerializeWithCachedSizes(
+      ::google::protobuf::io::CodedOutputStream* output) const;
+  ::google::protobuf::uint8* SerializeWithCachedSizesToArray(::google::protobuf::uint8* output) const;
+  int GetCachedSize() const { return _cached_size_; }
+  private:
+  void SharedCtor();
+  void SharedDtor();
+  void SetCachedSize(int size) const;
+  public:
+
+  ::google::protobuf::Metadata GetMetadata() const;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  // required string shm_name = 1;
+  inline bool has_shm_name() const;
+  inline void clear_shm_name();
+  static const int kShmNameFieldNumber = 1;
+  inline const ::std::string& shm_name() const;
+  inline void set_shm_name(const ::std::string& value);
+  inline void set_shm_name(const char* value);
+  inline void set_shm_name(const char* value, size_t size);
+  inline ::std::string* mutable_shm_name();
+  inline ::std::string* release_shm_name();
+  inline void set_allocated_shm_name(::std::string* shm_name);
+
+  // required uint64 frame = 2;
+  inline bool has_frame() const;
+  inline void clear_frame();
+  static const int kFrameFieldNumber = 2;
+  inline ::google::protobuf::uint64 frame() const;
+  inline void set_frame(::google::protobuf::uint64 value);
+
+  // required uint32 slot = 3;
+  inline bool has_slot() const;
+  inline void clear_slot();
+  static const int kSlotFieldNumber = 3;
+  inline ::google::protobuf::uint32 slot() const;
+  inline void set_slot(::google::protobuf::uint32 value);
+
+  // required uint32 width = 4;
+  inline bool has_width() const;
+  inline void clear_width();
+  static const int kWidthFieldNumber = 4;
+  inline ::google::protobuf::uint32 width() const;
+  inline void set_width(::google::protobuf::uint32 value);
+
+  // required uint32 height = 5;
+  inline bool has_height() const;
+  inline void clear_height();
+  static const int kHeightFieldNumber = 5;
+  inline ::google::protobuf::uint32 height() const;
+  inline void set_height(::google::protobuf::uint32 value);
+
+  // optional uint64 sequence = 6;
+  inline bool has_sequence() const;
+  inline void clear_sequence();
+  static const int kSequenceFieldNumber = 6;
+  inline ::google::protobuf::uint64 sequence() const;
+  inline void set_sequence(::google::protobuf::uint64 value);
+
+  // optional double sim_time = 7;
+  inline bool has_sim_time() const;
+  inline void clear_sim_time();
+  static const int kSimTimeFieldNumber = 7;
+  inline double sim_time() const;
+  inline void set_sim_time(double value);
+
+  // @@protoc_insertion_point(class_scope:pcl.msgs.SharedMemoryFrame)
+ private:
+  inline void set_has_shm_name();
+  inline void clear_has_shm_name();
+  inline void set_has_frame();
+  inline void clear_has_frame();
+  inline void set_has_slot();
+  inline void clear_has_slot();
+  inline void set_has_width();
+  inline void clear_has_width();
+  inline void set_has_height();
+  inline void clear_has_height();
+  inline void set_has_sequence();
+  inline void clear_has_sequence();
+  inline void set_has_sim_time();
+  inline void clear_has_sim_time();
+
+  ::google::protobuf::UnknownFieldSet _unknown_fields_;
+
+  ::std::string* shm_name_;
+  ::google::protobuf::uint64 frame_;
+  ::google::protobuf::uint32 slot_;
+  ::google::protobuf::uint32 width_;
+  ::google::protobuf::uint64 sequence_;
+  double sim_time_;
+  ::google::protobuf::uint32 height_;
+
+  mutable int _cached_size_;
+  ::google::protobuf::uint32 _has_bits_[(7 + 31) / 32];
+
+  friend void  protobuf_AddDesc_shm_5fframe_2eproto();
+  friend void protobuf_AssignDesc_shm_5fframe_2eproto();
+  friend void protobuf_ShutdownFile_shm_5fframe_2eproto();
+
+  void InitAsDefaultInstance();
+  static SharedMemoryFrame* default_instance_;
+};
+// ===================================================================
+
+
+// ===================================================================
+
+// SharedMemoryFrame
+
+// required string shm_name = 1;
+inline bool SharedMemoryFrame::has_shm_name() const {
+  return (_has_bits_[0] & 0x00000001u) != 0;
+}
+inline void SharedMemoryFrame::set_has_shm_name() {
+  _has_bits_[0] |= 0x00000001u;
+}
+inline void SharedMemoryFrame::clear_has_shm_name() {
+  _has_bits_[0] &= ~0x00000001u;
+}
+inline void SharedMemoryFrame::clear_shm_name() {
+  if (shm_name_ != &::google::protobuf::internal::kEmptyString) {
+    shm_name_->clear();
+  }
+  clear_has_shm_name();
+}
+inline const ::std::string& SharedMemoryFrame::shm_name() const {
+  return *shm_name_;
+}
+inline void SharedMemoryFrame::set_shm_name(const ::std::string& value) {
+  set_has_shm_name();
+  if (shm_name_ == &::google::protobuf::internal::kEmptyString) {
+    shm_name_ = new ::std::string;
+  }
+  shm_name_->assign(value);
+}
+inline void SharedMemoryFrame::set_shm_name(const char* value) {
+  set_has_shm_name();
+  if (shm_name_ == &::google::protobuf::internal::kEmptyString) {
+    shm_name_ = new ::std::string;
+  }
+  shm_name_->assign(value);
+}
+inline void SharedMemoryFrame::set_shm_name(const char* value, size_t size) {
+  set_has_shm_name();
+  if (shm_name_ == &::google::protobuf::internal::kEmptyString) {
+    shm_name_ = new ::std::string;
+  }
+  shm_name_->assign(reinterpret_cast<const char*>(value), size);
+}
+inline ::std::string* SharedMemoryFrame::mutable_shm_name() {
+  set_has_shm_name();
+  if (shm_name_ == &::google::protobuf::internal::kEmptyString) {
+    shm_name_ = new ::std::string;
+  }
+  return shm_name_;
+}
+inline ::std::string* SharedMemoryFrame::release_shm_name() {
+  clear_has_shm_name();
+  if (shm_name_ == &::google::protobuf::internal::kEmptyString) {
+    return NULL;
+  } else {
+    ::std::string* temp = shm_name_;
+    shm_name_ = const_cast< ::std::string*>(&::google::protobuf::internal::kEmptyString);
+    return temp;
+  }
+}
+inline void SharedMemoryFrame::set_allocated_shm_name(::std::string* shm_name) {
+  if (shm_name_ != &::google::protobuf::internal::kEmptyString) {
+    delete shm_name_;
+  }
+  if (shm_name) {
+    set_has_shm_name();
+    shm_name_ = shm_name;
+  } else {
+    clear_has_shm_name();
+    shm_name_ = const_cast< ::std::string*>(&::google::protobuf::internal::kEmptyString);
+  }
+}
+
+// required uint64 frame = 2;
+inline bool SharedMemoryFrame::has_frame() const {
+  return (_has_bits_[0] & 0x00000002u) != 0;
+}
+inline void SharedMemoryFrame::set_has_frame() {
+  _has_bits_[0] |= 0x00000002u;
+}
+inline void SharedMemoryFrame::clear_has_frame() {
+  _has_bits_[0] &= ~0x00000002u;
+}
+inline void SharedMemoryFrame::clear_frame() {
+  frame_ = GOOGLE_ULONGLONG(0);
+  clear_has_frame();
+}
+inline ::google::protobuf::uint64 SharedMemoryFrame::frame() const {
+  return frame_;
+}
+inline void SharedMemoryFrame::set_frame(::google::protobuf::uint64 value) {
+  set_has_frame();
+  frame_ = value;
+}
+
+// required uint32 slot = 3;
+inline bool SharedMemoryFrame::has_slot() const {
+  return (_has_bits_[0] & 0x00000004u) != 0;
+}
+inline void SharedMemoryFrame::set_has_slot() {
+  _has_bits_[0] |= 0x00000004u;
+}
+inline void SharedMemoryFrame::clear_has_slot() {
+  _has_bits_[0] &= ~0x00000004u;
+}
+inline void SharedMemoryFrame::clear_slot() {
+  slot_ = 0u;
+  clear_has_slot();
+}
+inline ::google::protobuf::uint32 SharedMemoryFrame::slot() const {
+  return slot_;
+}
+inline void SharedMemoryFrame::set_slot(::google::protobuf::uint32 value) {
+  set_has_slot();
+  slot_ = value;
+}
+
+// required uint32 width = 4;
+inline bool SharedMemoryFrame::has_width() const {
+  return (_has_bits_[0] & 0x00000008u) != 0;
+}
+inline void SharedMemoryFrame::set_has_width() {
+  _has_bits_[0] |= 0x00000008u;
+}
+inline void SharedMemoryFrame::clear_has_width() {
+  _has_bits_[0] &= ~0x00000008u;
+}
+inline void SharedMemoryFrame::clear_width() {
+  width_ = 0u;
+  clear_has_width();
+}
+inline ::google::protobuf::uint32 SharedMemoryFrame::width() const {
+  return width_;
+}
+inline void SharedMemoryFrame::set_width(::google::protobuf::uint32 value) {
+  set_has_width();
+  width_ = value;
+}
+
+// required uint32 height = 5;
+inline bool SharedMemoryFrame::has_height() const {
+  return (_has_bits_[0] & 0x00000010u) != 0;
+}
+inline void SharedMemoryFrame::set_has_height() {
+  _has_bits_[0] |= 0x00000010u;
+}
+inline void SharedMemoryFrame::clear_has_height() {
+  _has_bits_[0] &= ~0x00000010u;
+}
+inline void SharedMemoryFrame::clear_height() {
+  height_ = 0u;
+  clear_has_height();
+}
+inline ::google::protobuf::uint32 SharedMemoryFrame::height() const {
+  return height_;
+}
+inline void SharedMemoryFrame::set_height(::google::protobuf::uint32 value) {
+  set_has_height();
+  height_ = value;
+}
+
+// optional uint64 sequence = 6;
+inline bool SharedMemoryFrame::has_sequence() const {
+  return (_has_bits_[0] & 0x00000020u) != 0;
+}
+inline void SharedMemoryFrame::set_has_sequence() {
+  _has_bits_[0] |= 0x00000020u;
+}
+inline void SharedMemoryFrame::clear_has_sequence() {
+  _has_bits_[0] &= ~0x00000020u;
+}
+inline void SharedMemoryFrame::clear_sequence() {
+  sequence_ = GOOGLE_ULONGLONG(0);
+  clear_has_sequence();
+}
+inline ::google::protobuf::uint64 SharedMemoryFrame::sequence() const {
+  return sequence_;
+}
+inline void SharedMemoryFrame::set_sequence(::google::protobuf::uint64 value) {
+  set_has_sequence();
+  sequence_ = value;
+}
+
+// optional double sim_time = 7;
+inline bool SharedMemoryFrame::has_sim_time() const {
+  return (_has_bits_[0] & 0x00000040u) != 0;
+}
+inline void SharedMemoryFrame::set_has_sim_time() {
+  _has_bits_[0] |= 0x00000040u;
+}
+inline void SharedMemoryFrame::clear_has_sim_time() {
+  _has_bits_[0] &= ~0x00000040u;
+}
+inline void SharedMemoryFrame::clear_sim_time() {
+  sim_time_ = 0;
+  clear_has_sim_time();
+}
+inline double SharedMemoryFrame::sim_time() const {
+  return sim_time_;
+}
+inline void SharedMemoryFrame::set_sim_time(double value) {
+  set_has_sim_time();
+  sim_time_ = value;
+}
+
+
+// @@protoc_insertion_point(namespace_scope)
+
+}  // namespace msgs
+}  // namespace pcl
+
+#ifndef SWIG
+namespace google {
+namespace protobuf {
+
+
+}  // namespace google
+}  // namespace protobuf
+#endif  // SWIG
+
+// @@protoc_insertion_point(global_scope)
+
+#endif  // PROTOBUF_shm_5fframe_2eproto__INCLUDED
@@ -0,0 +1,31 @@
+// Depth + RayConf + label in a single pass ( multiple render target )
+//	gl_FragData[0] : ( depth, 1 - label.x, 1 - label.y, depth ), depth = 1 when IR projector can't reach
+//	gl_FragData[1] : ( ray.xyz, confidence ), ( 0, 0, 0, -1 ) when IR projector can't reach
+// label is the grey level in every component, or the instance id in x & the class id in y
+// label is stored as ( 1 - label ) so the white background decodes to label 0
+#version 120
+
+uniform sampler2D	shadowMap;
+uniform float		fixedDepthBias;
+uniform vec4		label;
+
+varying vec4	shadow_uv;
+varying vec4	rayconf;
+varying float	depth;
+varying float	check;
+
+void main()
+{
+	// point on shadowmap
+	vec4 uv = shadow_uv / shadow_uv.w;
+
+	// shadow map's pixel format is PF_FLOAT32_R, only r channel (x channel) have value
+	float final_center_depth = texture2D( shadowMap, uv.xy ).x + fixedDepthBias;
+
+	// (final_center_depth > uv.z) means object is closer to light( not in shadow)
+	bool lit = ( final_center_depth > uv.z && check >= 0.5 );
+
+	// segmentation doesn't care about shadow
+	gl_FragData[0] = lit ? vec4( depth, 1.0 - label.x, 1.0 - label.y, depth ) : vec4( 1.0, 1.0 - label.x, 1.0 - label.y, 1.0 );
+	gl_FragData[1] = lit ? rayconf : vec4( 0.0, 0.0, 0.0, -1.0 );
+}
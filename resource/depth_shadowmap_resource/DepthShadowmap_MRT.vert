@@ -0,0 +1,47 @@
+// Depth + RayConf + label in a single pass ( multiple render target )
+// GLSL is used instead of Cg so the pass also runs on software GL renderer ( Mesa llvmpipe )
+#version 120
+
+uniform mat4	world_mat;
+uniform mat4	it_world_mat;
+uniform mat4	world_view_mat;
+uniform mat4	it_world_view_mat;
+uniform mat4	world_view_proj_mat;
+uniform mat4	tex_view_proj_mat;
+uniform vec4	light_pos;		// light position in world space
+uniform float	near_clip;
+uniform float	far_clip;
+
+varying vec4	shadow_uv;
+varying vec4	rayconf;
+varying float	depth;
+varying float	check;
+
+void main()
+{
+	// current vertex position in world space
+	vec4 pos_wld = world_mat * gl_Vertex;
+	// current vertex normal in world space
+	vec3 nml_wld = ( it_world_mat * vec4( gl_Normal, 0.0 ) ).xyz;
+	// current vertex position in camera space
+	vec4 pos_cam = world_view_mat * gl_Vertex;
+	// current vertex normal in camera space
+	vec3 nml_cam = ( it_world_view_mat * vec4( gl_Normal, 0.0 ) ).xyz;
+
+	// light direction vector
+	vec3 light_dir = normalize( light_pos.xyz - ( pos_wld.xyz * light_pos.w ) );
+
+	// normalize depth to range 0 ~ 1,  nearclip->0, farclip->1
+	depth = ( abs( pos_cam.z ) - near_clip ) / ( far_clip - near_clip );
+
+	// ray and confidence
+	rayconf = vec4( pos_cam.xyz, dot( normalize( -pos_cam.xyz ), normalize( nml_cam ) ) );
+
+	// check whether light can reach current vertex
+	check = ( dot( light_dir, nml_wld ) > 0.0 ) ? 1.0 : 0.0;
+
+	// calculate shadow map coords
+	shadow_uv = tex_view_proj_mat * pos_wld;	// current vertex in "light view"
+
+	gl_Position = world_view_proj_mat * gl_Vertex;
+}
@@ -0,0 +1,37 @@
+// Masking pass of the depth sensor, one fragment per sensor pixel ( see DepthMaskPass.h )
+//	gl_FragColor.x : depth if the pixel has no flags, else -flags, flags = invalid + 2 * rejected
+//	invalid : depth out of range or intensity saturation, the occlusion edge is still disturbed on the cpu
+//	rejected : confidence below cos( 75 + conf noise ) or no point ( IR projector can't reach & background )
+// same decisions as DepthPostProcessKernel::maskFlags()
+#version 120
+
+uniform sampler2D	depthMap;		// depth render target, depth in x
+uniform sampler2D	rayconfMap;		// rayconf render target
+uniform sampler2D	rgbMap;			// specular map, 8 bit rgb
+uniform sampler2D	noise40Map;		// perlin noise of grid 40
+uniform sampler2D	confNoiseMap;	// perlin noise of grid 5, 10 & 20
+uniform float		confChannel;	// 1 : ( ray.xyz, confidence ), 0 : confidence only
+
+varying vec2	uv;
+
+void main()
+{
+	float depth = texture2D( depthMap, uv ).x;
+	vec4 rayconf = texture2D( rayconfMap, uv );
+	float conf = confChannel > 0.5 ? rayconf.w : rayconf.x;
+
+	// 8 bit red of specular map, saturation threshold disturbed by perlin noise
+	float red = floor( texture2D( rgbMap, uv ).x * 255.0 + 0.5 );
+	float thres = 180.0 + texture2D( noise40Map, uv ).x * 10.0;
+	thres = thres > 0.0 ? thres : 1.0;
+	// same comparison as DepthMask::outOfRange()
+	bool invalid = depth * 255.0 >= 255.0 || red > thres;
+
+	bool has_point = conf != -1.0 && ( confChannel > 0.5 ? rayconf.z < 0.0 : depth < 1.0 );
+	float conf_thres = 75.0 + texture2D( confNoiseMap, uv ).x;
+	bool rejected = !has_point || conf < cos( radians( conf_thres ) );
+
+	// only a pixel without flags becomes a point, so depth & flags share one channel without loss
+	float flags = ( invalid ? 1.0 : 0.0 ) + ( rejected ? 2.0 : 0.0 );
+	gl_FragColor = vec4( flags > 0.0 ? -flags : depth, 0.0, 0.0, 1.0 );
+}
@@ -0,0 +1,16 @@
+// Masking pass of the depth sensor, a fullscreen quad ( Ogre::Rectangle2D ) over the sensor's render targets
+#version 120
+
+uniform mat4	world_view_proj_mat;
+
+attribute vec4	vertex;
+attribute vec2	uv0;
+
+varying vec2	uv;
+
+void main()
+{
+	// identity projection, the quad covers the viewport
+	gl_Position = world_view_proj_mat * vertex;
+	uv = uv0;
+}
@@ -0,0 +1,137 @@
+/*
+ * sensor_calibration_tool.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+// Writes & checks the sensor calibration files read by the depth sensor ( see SensorCalibration.h ).
+// usage :
+//   sensor_calibration_tool convert <mag.bin> <output> [ <width>x<height> ... ]
+//   sensor_calibration_tool info <file>
+// convert reads the noise magnitude from the old boost archive and writes it as table noise_magnitude,
+// at its own resolution & resized to every given resolution ( 640x480 1280x960 if none ),
+// with the same cv::resize the sensor used to run at every start.
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+#include <opencv2/core/core.hpp>
+#include <opencv2/imgproc/imgproc.hpp>
+
+#include <boost/archive/binary_iarchive.hpp>
+
+#include "cvmat_serialization.h"
+#include "SensorCalibration.h"
+
+using namespace std;
+
+static const char *NOISE_MAGNITUDE = "noise_magnitude";
+
+static const char *typeName( uint32_t _type )
+{
+	switch( _type )
+	{
+	case SENSOR_CALIBRATION_FLOAT32:	return "float32";
+	case SENSOR_CALIBRATION_UINT8:		return "uint8";
+	case SENSOR_CALIBRATION_UINT16:		return "uint16";
+	default:							return "unknown";
+	}
+}
+
+static int printInfo( const string &_path )
+{
+	SensorCalibrationReader reader;
+	if( !reader.open( _path ) )
+	{
+		return 1;
+	}
+
+	printf( "%d tables, every checksum is valid\n", reader.getNumTables() );
+	for( int i = 0; i < reader.getNumTables(); i++ )
+	{
+		const SensorCalibrationTable &table = reader.getTable( i );
+		printf( "%-20s %4u x %4u x %u %-8s source %4u x %4u  %8.1f KB  checksum %016llx\n",
+				string( table.name, strnlen( table.name, sizeof( table.name ) ) ).c_str(),
+				table.width, table.height, table.channels, typeName( table.type ),
+				table.source_width, table.source_height, table.bytes / 1024.0, (unsigned long long)table.checksum );
+	}
+	return 0;
+}
+
+static int convert( const string &_archive, const string &_output, const vector< cv::Size > &_resolutions )
+{
+	cv::Mat noise_mag;
+	{
+		ifstream ifs( _archive.c_str(), ios::in | ios::binary );
+		if( !ifs )
+		{
+			fprintf( stderr, "can't open %s\n", _archive.c_str() );
+			return 1;
+		}
+		boost::archive::binary_iarchive ia( ifs );
+		ia >> noise_mag;
+	}
+	if( noise_mag.type() != CV_32FC1 || noise_mag.empty() )
+	{
+		fprintf( stderr, "%s is not a single channel float magnitude\n", _archive.c_str() );
+		return 1;
+	}
+
+	SensorCalibrationWriter writer;
+	writer.addTable( NOISE_MAGNITUDE, SENSOR_CALIBRATION_FLOAT32, 1, noise_mag.cols, noise_mag.rows, noise_mag.cols, noise_mag.rows, noise_mag.ptr() );
+	printf( "%s %d x %d ( source )\n", NOISE_MAGNITUDE, noise_mag.cols, noise_mag.rows );
+
+	for( unsigned int i = 0; i < _resolutions.size(); i++ )
+	{
+		if( _resolutions[i] == noise_mag.size() )
+		{
+			continue;
+		}
+		cv::Mat resized;
+		cv::resize( noise_mag, resized, _resolutions[i] );
+		writer.addTable( NOISE_MAGNITUDE, SENSOR_CALIBRATION_FLOAT32, 1, resized.cols, resized.rows, noise_mag.cols, noise_mag.rows, resized.ptr() );
+		printf( "%s %d x %d\n", NOISE_MAGNITUDE, resized.cols, resized.rows );
+	}
+
+	if( !writer.write( _output ) )
+	{
+		return 1;
+	}
+	printf( "-> %s\n", _output.c_str() );
+	return 0;
+}
+
+int main( int argc, char **argv )
+{
+	string command = argc > 1 ? argv[1] : "";
+	if( ( command != "convert" || argc < 4 ) && ( command != "info" || argc < 3 ) )
+	{
+		fprintf( stderr, "usage : %s convert <mag.bin> <output> [ <width>x<height> ... ]\n", argv[0] );
+		fprintf( stderr, "        %s info <file>\n", argv[0] );
+		return 1;
+	}
+
+	if( command == "info" )
+	{
+		return printInfo( argv[2] );
+	}
+
+	vector< cv::Size > resolutions;
+	for( int i = 4; i < argc; i++ )
+	{
+		int width, height;
+		if( sscanf( argv[i], "%dx%d", &width, &height ) != 2 || width <= 0 || height <= 0 )
+		{
+			fprintf( stderr, "bad resolution : %s\n", argv[i] );
+			return 1;
+		}
+		resolutions.push_back( cv::Size( width, height ) );
+	}
+	if( resolutions.empty() )
+	{
+		resolutions.push_back( cv::Size( 640, 480 ) );
+		resolutions.push_back( cv::Size( 1280, 960 ) );
+	}
+	return convert( argv[2], argv[3], resolutions );
+}
@@ -0,0 +1,199 @@
+/*
+ * ShmPointCloudReader.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include "ShmPointCloudReader.h"
+
+ShmPointCloudReader::ShmPointCloudReader()
+	: m_memory( NULL ),
+	  m_bytes( 0 ),
+	  m_header( NULL )
+{
+}
+
+ShmPointCloudReader::~ShmPointCloudReader()
+{
+	close();
+}
+
+bool ShmPointCloudReader::open( const string &_name )
+{
+	close();
+
+	string name = "/" + _name;
+	int fd = shm_open( name.c_str(), O_RDWR, 0 );
+	if( fd < 0 )
+	{
+		cerr << "ShmPointCloudReader : shm_open " << name << " failed, " << strerror( errno ) << endl;
+		return false;
+	}
+
+	struct stat st;
+	if( fstat( fd, &st ) != 0 || (size_t)st.st_size < sizeof( SharedMemoryRingHeader ) )
+	{
+		cerr << "ShmPointCloudReader : " << name << " is not a ring" << endl;
+		::close( fd );
+		return false;
+	}
+
+	// read / write because futex wait needs a writable mapping on some kernels, nothing but the futex is written
+	void *memory = mmap( NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+	::close( fd );
+	if( memory == MAP_FAILED )
+	{
+		cerr << "ShmPointCloudReader : mmap failed, " << strerror( errno ) << endl;
+		return false;
+	}
+	m_memory = (unsigned char*)memory;
+	m_bytes = st.st_size;
+	m_header = (SharedMemoryRingHeader*)m_memory;
+
+	// the writer sets magic after everything else
+	uint32_t magic = m_header->magic;
+	atomic_thread_fence( memory_order_acquire );
+	if(	magic != SHARED_MEMORY_RING_MAGIC ||
+		m_header->version != SHARED_MEMORY_RING_VERSION ||
+		sizeof( SharedMemoryRingHeader ) + m_header->slot_bytes * m_header->num_slots > m_bytes )
+	{
+		cerr << "ShmPointCloudReader : " << name << " is not a ring of version " << SHARED_MEMORY_RING_VERSION << endl;
+		close();
+		return false;
+	}
+
+	return true;
+}
+
+void ShmPointCloudReader::close()
+{
+	if( m_memory )
+	{
+		munmap( m_memory, m_bytes );
+	}
+	m_memory = NULL;
+	m_bytes = 0;
+	m_header = NULL;
+}
+
+bool ShmPointCloudReader::isOpen() const
+{
+	return m_memory != NULL;
+}
+
+uint32_t ShmPointCloudReader::getWidth() const
+{
+	return m_header->width;
+}
+
+uint32_t ShmPointCloudReader::getHeight() const
+{
+	return m_header->height;
+}
+
+uint32_t ShmPointCloudReader::getNumSlots() const
+{
+	return m_header->num_slots;
+}
+
+uint64_t ShmPointCloudReader::getLastFrame() const
+{
+	return m_header->last_frame.load( memory_order_acquire );
+}
+
+uint64_t ShmPointCloudReader::waitForFrame( uint64_t _after, int _timeout_ms )
+{
+	struct timespec timeout;
+	timeout.tv_sec = _timeout_ms / 1000;
+	timeout.tv_nsec = (long)( _timeout_ms % 1000 ) * 1000000;
+
+	while( true )
+	{
+		// read the futex word first, a commit after this changes it and the wait returns immediately
+		uint32_t word = m_header->futex_word.load( memory_order_acquire );
+		uint64_t last_frame = getLastFrame();
+		if( last_frame > _after )
+		{
+			return last_frame;
+		}
+
+		long result = sharedMemoryFutex( &m_header->futex_word, FUTEX_WAIT, word, _timeout_ms < 0 ? NULL : &timeout );
+		if( result != 0 && errno == ETIMEDOUT )
+		{
+			last_frame = getLastFrame();
+			return last_frame > _after ? last_frame : 0;
+		}
+	}
+}
+
+bool ShmPointCloudReader::acquireFrame( int _slot, uint64_t _frame, Frame &_result ) const
+{
+	if( _slot < 0 || (uint32_t)_slot >= m_header->num_slots )
+	{
+		return false;
+	}
+
+	const SharedMemorySlotHeader *header = _slotHeader( _slot );
+	uint64_t sequence = header->sequence.load( memory_order_acquire );
+	if( sequence % 2 != 0 || header->frame != _frame )
+	{
+		return false;
+	}
+
+	_result.frame = _frame;
+	_result.slot = _slot;
+	_result.width = header->width;
+	_result.height = header->height;
+	_result.has_label = header->has_label;
+	_result.has_rgb = header->has_rgb;
+	_result.points = (const unsigned char*)header + m_header->points_offset;
+	_result.rgb = (const unsigned char*)header + m_header->rgb_offset;
+	_result.sequence = sequence;
+
+	// header fields read above must belong to this sequence
+	return validateFrame( _result );
+}
+
+bool ShmPointCloudReader::acquireLastFrame( Frame &_result ) const
+{
+	uint64_t frame = getLastFrame();
+	if( frame == 0 )
+	{
+		return false;
+	}
+	// the writer fills slots round robin from slot 0 with frame 1
+	return acquireFrame( ( frame - 1 ) % m_header->num_slots, frame, _result );
+}
+
+bool ShmPointCloudReader::validateFrame( const Frame &_frame ) const
+{
+	// every read of the frame must be done before the sequence is checked again
+	atomic_thread_fence( memory_order_acquire );
+	return _slotHeader( _frame.slot )->sequence.load( memory_order_relaxed ) == _frame.sequence;
+}
+
+bool ShmPointCloudReader::copyFrame( int _slot, uint64_t _frame, vector< unsigned char > &_points, vector< unsigned char > &_rgb ) const
+{
+	Frame frame;
+	if( !acquireFrame( _slot, _frame, frame ) )
+	{
+		return false;
+	}
+
+	_points.assign( frame.points, frame.points + (size_t)frame.width * frame.height * m_header->point_step );
+	if( frame.has_rgb )
+	{
+		_rgb.assign( frame.rgb, frame.rgb + (size_t)frame.width * frame.height * 3 );
+	}
+	else
+	{
+		_rgb.clear();
+	}
+
+	return validateFrame( frame );
+}
+
+const SharedMemorySlotHeader *ShmPointCloudReader::_slotHeader( int _slot ) const
+{
+	return (const SharedMemorySlotHeader*)( m_memory + sizeof( SharedMemoryRingHeader ) + _slot * m_header->slot_bytes );
+}
@@ -0,0 +1,80 @@
+/*
+ * ShmPointCloudReader.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef SHM_POINT_CLOUD_READER_H_
+#define SHM_POINT_CLOUD_READER_H_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "SharedMemoryRing.h"
+
+using namespace std;
+
+// Reference reader of the depth sensor's shared memory ring ( <cloud_message> shm ).
+// Frames are read in place : acquireFrame() gives pointers into shared memory, validateFrame() tells afterwards
+// if the writer reused the slot meanwhile, in which case whatever was read must be dropped.
+class ShmPointCloudReader
+{
+public:
+	struct Frame
+	{
+		uint64_t frame;
+		int slot;
+		uint32_t width;
+		uint32_t height;
+		bool has_label;
+		bool has_rgb;
+		// width * height points, 16 bytes each : float x, y, z, uint32 label
+		const unsigned char *points;
+		// width * height * 3 bytes
+		const unsigned char *rgb;
+		// slot sequence when acquired
+		uint64_t sequence;
+	};
+
+public:
+	ShmPointCloudReader();
+	~ShmPointCloudReader();
+
+	// map the ring created by the depth sensor, _name without the leading '/'
+	bool open( const string &_name );
+	void close();
+	bool isOpen() const;
+
+	uint32_t getWidth() const;
+	uint32_t getHeight() const;
+	uint32_t getNumSlots() const;
+
+	// number of the last committed frame, 0 if none
+	uint64_t getLastFrame() const;
+
+	// block until a frame newer than _after is committed, return its number, 0 if timed out ( _timeout_ms < 0 waits forever )
+	uint64_t waitForFrame( uint64_t _after, int _timeout_ms );
+
+	// zero-copy access to _frame stored in _slot, false if the slot is being written or holds another frame
+	bool acquireFrame( int _slot, uint64_t _frame, Frame &_result ) const;
+	// same as acquireFrame() on the slot of the last committed frame
+	bool acquireLastFrame( Frame &_result ) const;
+	// true if the slot of _frame hasn't been touched since acquireFrame()
+	bool validateFrame( const Frame &_frame ) const;
+
+	// copy _frame out of shared memory, false if it was overwritten before the copy ended
+	bool copyFrame( int _slot, uint64_t _frame, vector< unsigned char > &_points, vector< unsigned char > &_rgb ) const;
+
+private:
+	const SharedMemorySlotHeader *_slotHeader( int _slot ) const;
+
+public:
+
+private:
+	unsigned char *m_memory;
+	size_t m_bytes;
+	SharedMemoryRingHeader *m_header;
+};
+
+#endif /* SHM_POINT_CLOUD_READER_H_ */
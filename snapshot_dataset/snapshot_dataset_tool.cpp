@@ -0,0 +1,254 @@
+/*
+ * snapshot_dataset_tool.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+// Reads a snapshot dataset written by the depth sensor in <snapshot_format> dataset mode.
+// usage :
+//   snapshot_dataset_tool info <dataset>
+//   snapshot_dataset_tool export <dataset> <frame> [ output prefix ]
+// export writes the same files as the files mode : <prefix>_rgb.png, <prefix>.pcd,
+// plus <prefix>_label.png & <prefix>_poses.txt if the record has them.
+// 4 byte labels ( ids ) are written as <prefix>_label.png of 16 bit instance ids & <prefix>_class.png of 8 bit class ids,
+// the cloud keeps the whole 32 bit label.
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#include <opencv2/core/core.hpp>
+#include <opencv2/imgproc/imgproc.hpp>
+#include <opencv2/highgui/highgui.hpp>
+
+#include <pcl/io/pcd_io.h>
+#include <pcl/point_types.h>
+
+#include "SnapshotDataset.h"
+#include "DepthStreamCodec.h"
+
+using namespace std;
+
+static const char *cloudFormatName( uint32_t _format )
+{
+	switch( _format )
+	{
+	case SNAPSHOT_CLOUD_FORMAT_NONE:			return "none";
+	case SNAPSHOT_CLOUD_FORMAT_XYZ:				return "xyz";
+	case SNAPSHOT_CLOUD_FORMAT_DEPTH_STREAM:	return "depth stream";
+	default:									return "unknown";
+	}
+}
+
+static int printInfo( const SnapshotDatasetReader &_reader )
+{
+	const SnapshotDatasetHeader &header = _reader.getHeader();
+	printf( "%u x %u, cloud %s, %u byte labels, %d records%s\n",
+			header.width, header.height, cloudFormatName( header.cloud_format ), _reader.getLabelBytes(), _reader.getNumRecords(),
+			_reader.isRecovered() ? " ( no index, recovered from record headers )" : "" );
+
+	for( int i = 0; i < _reader.getNumRecords(); i++ )
+	{
+		SnapshotDatasetReader::Record record;
+		if( !_reader.getRecord( i, record ) )
+		{
+			printf( "%6d broken record\n", i );
+			continue;
+		}
+		printf( "%6d frame %6lu  sim time %10.3f  rgb %s  cloud %8.1f KB  label %s  poses %u\n",
+				i, (unsigned long)record.frame, record.sim_time,
+				record.rgb ? "yes" : "no ", record.cloud_bytes / 1024.0, record.label ? "yes" : "no ", record.num_poses );
+	}
+	return 0;
+}
+
+// ****************************************** //
+// organized cloud of a record, x, y, z in mm //
+// ****************************************** //
+static bool readCloud( const SnapshotDatasetReader &_reader, const SnapshotDatasetReader::Record &_record, pcl::PointCloud< pcl::PointXYZ > &_cloud )
+{
+	const SnapshotDatasetHeader &header = _reader.getHeader();
+	_cloud.width = header.width;
+	_cloud.height = header.height;
+	_cloud.is_dense = false;
+	_cloud.points.resize( header.width * header.height );
+
+	if( header.cloud_format == SNAPSHOT_CLOUD_FORMAT_XYZ )
+	{
+		if( _record.cloud_bytes != _cloud.points.size() * 3 * sizeof( float ) )
+		{
+			return false;
+		}
+		const float *xyz = (const float*)_record.cloud;
+		for( unsigned int i = 0; i < _cloud.points.size(); i++ )
+		{
+			_cloud.points[i].x = xyz[ i * 3 ];
+			_cloud.points[i].y = xyz[ i * 3 + 1 ];
+			_cloud.points[i].z = xyz[ i * 3 + 2 ];
+		}
+		return true;
+	}
+	if( header.cloud_format == SNAPSHOT_CLOUD_FORMAT_DEPTH_STREAM )
+	{
+		DepthStreamCodec codec( header.width, header.height, DepthStreamCodec::Intrinsics() );
+		if( !codec.decode( (const unsigned char*)_record.cloud, _record.cloud_bytes ) )
+		{
+			return false;
+		}
+		codec.reconstruct( &_cloud.points[0], sizeof( pcl::PointXYZ ) );
+		return true;
+	}
+	return false;
+}
+
+static int exportFrame( const SnapshotDatasetReader &_reader, uint64_t _frame, const string &_prefix )
+{
+	int idx = _reader.findFrame( _frame );
+	SnapshotDatasetReader::Record record;
+	if( idx < 0 || !_reader.getRecord( idx, record ) )
+	{
+		fprintf( stderr, "frame %lu not found\n", (unsigned long)_frame );
+		return 1;
+	}
+
+	const SnapshotDatasetHeader &header = _reader.getHeader();
+	int width = header.width;
+	int height = header.height;
+	bool success = true;
+
+	if( record.rgb )
+	{
+		cv::Mat rgb( height, width, CV_8UC3, (void*)record.rgb );
+		cv::Mat bgr;
+		cv::cvtColor( rgb, bgr, CV_RGB2BGR );
+		string path = _prefix + "_rgb.png";
+		success &= cv::imwrite( path, bgr );
+		printf( "rgb   -> %s\n", path.c_str() );
+	}
+
+	bool ids = _reader.getLabelBytes() == 4;
+	if( record.label && !ids )
+	{
+		cv::Mat label( height, width, CV_8UC1, (void*)record.label );
+		string path = _prefix + "_label.png";
+		success &= cv::imwrite( path, label );
+		printf( "label -> %s\n", path.c_str() );
+	}
+	else if( record.label )
+	{
+		const uint32_t *id = (const uint32_t*)record.label;
+		cv::Mat instance( height, width, CV_16UC1 );
+		cv::Mat label_class( height, width, CV_8UC1 );
+		for( int i = 0; i < width * height; i++ )
+		{
+			instance.at< uint16_t >( i ) = id[i] & 0xffff;
+			label_class.at< uint8_t >( i ) = id[i] >> 24;
+		}
+		string path = _prefix + "_label.png";
+		success &= cv::imwrite( path, instance );
+		printf( "label -> %s\n", path.c_str() );
+		path = _prefix + "_class.png";
+		success &= cv::imwrite( path, label_class );
+		printf( "class -> %s\n", path.c_str() );
+	}
+
+	if( record.cloud )
+	{
+		pcl::PointCloud< pcl::PointXYZ > cloud;
+		string path = _prefix + ".pcd";
+		if( !readCloud( _reader, record, cloud ) )
+		{
+			fprintf( stderr, "cloud of frame %lu is broken\n", (unsigned long)_frame );
+			success = false;
+		}
+		else if( record.label )
+		{
+			pcl::PointCloud< pcl::PointXYZL > cloud_xyzl;
+			cloud_xyzl.width = cloud.width;
+			cloud_xyzl.height = cloud.height;
+			cloud_xyzl.is_dense = false;
+			cloud_xyzl.points.resize( cloud.points.size() );
+			for( unsigned int i = 0; i < cloud.points.size(); i++ )
+			{
+				cloud_xyzl.points[i].x = cloud.points[i].x;
+				cloud_xyzl.points[i].y = cloud.points[i].y;
+				cloud_xyzl.points[i].z = cloud.points[i].z;
+				cloud_xyzl.points[i].label = ids ? ( (const uint32_t*)record.label )[i] : record.label[i];
+			}
+			success &= pcl::io::savePCDFileBinary( path, cloud_xyzl ) == 0;
+			printf( "cloud -> %s\n", path.c_str() );
+		}
+		else
+		{
+			success &= pcl::io::savePCDFileBinary( path, cloud ) == 0;
+			printf( "cloud -> %s\n", path.c_str() );
+		}
+	}
+
+	if( record.num_poses > 0 )
+	{
+		string path = _prefix + "_poses.txt";
+		ofstream file( path.c_str() );
+		file << "# model label x y z qw qx qy qz" << endl;
+		for( unsigned int i = 0; i < record.num_poses; i++ )
+		{
+			const SnapshotPose &pose = record.poses[i];
+			file << string( pose.model_name, strnlen( pose.model_name, sizeof( pose.model_name ) ) ) << " " << pose.label;
+			for( int k = 0; k < 3; k++ )
+			{
+				file << " " << pose.position[k];
+			}
+			for( int k = 0; k < 4; k++ )
+			{
+				file << " " << pose.orientation[k];
+			}
+			file << endl;
+		}
+		success &= (bool)file;
+		printf( "poses -> %s\n", path.c_str() );
+	}
+
+	return success ? 0 : 1;
+}
+
+int main( int argc, char **argv )
+{
+	if( argc < 3 || ( string( argv[1] ) == "export" && argc < 4 ) )
+	{
+		fprintf( stderr, "usage : %s info <dataset>\n", argv[0] );
+		fprintf( stderr, "        %s export <dataset> <frame> [ output prefix ]\n", argv[0] );
+		return 1;
+	}
+
+	string command = argv[1];
+	SnapshotDatasetReader reader;
+	if( !reader.open( argv[2] ) )
+	{
+		return 1;
+	}
+
+	if( command == "info" )
+	{
+		return printInfo( reader );
+	}
+	if( command == "export" )
+	{
+		uint64_t frame = strtoull( argv[3], NULL, 10 );
+		string prefix;
+		if( argc > 4 )
+		{
+			prefix = argv[4];
+		}
+		else
+		{
+			ostringstream ss;
+			ss << "frame_" << frame;
+			prefix = ss.str();
+		}
+		return exportFrame( reader, frame, prefix );
+	}
+
+	fprintf( stderr, "unknown command : %s\n", command.c_str() );
+	return 1;
+}